@@ -51,7 +51,9 @@ CPDF_Font::CPDF_Font(CPDF_Document* document,
                      RetainPtr<CPDF_Dictionary> font_dict)
     : document_(document),
       font_dict_(std::move(font_dict)),
-      base_font_name_(font_dict_->GetByteStringFor("BaseFont")) {}
+      base_font_name_(font_dict_->GetByteStringFor("BaseFont")) {
+  font_.SetOwner(this);
+}
 
 CPDF_Font::~CPDF_Font() {
   if (!will_be_destroyed_ && font_file_) {
@@ -396,6 +398,7 @@ const char* CPDF_Font::GetAdobeCharName(
 uint32_t CPDF_Font::FallbackFontFromCharcode(uint32_t charcode) {
   if (font_fallbacks_.empty()) {
     font_fallbacks_.push_back(std::make_unique<CFX_Font>());
+    font_fallbacks_[0]->SetOwner(this);
     FX_SAFE_INT32 safe_weight = stem_v_;
     safe_weight *= 5;
     font_fallbacks_[0]->LoadSubst(
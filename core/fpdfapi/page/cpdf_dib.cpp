@@ -246,7 +246,7 @@ bool CPDF_DIB::Load() {
     return false;
   }
 
-  if (CreateDecoder(0) == LoadState::kFail) {
+  if (CreateDecoder(0, FX_RECT()) == LoadState::kFail) {
     return false;
   }
 
@@ -307,7 +307,8 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadDIBBase(
     bool bStdCS,
     CPDF_ColorSpace::Family GroupFamily,
     bool bLoadMask,
-    const CFX_Size& max_size_required) {
+    const CFX_Size& max_size_required,
+    const FX_RECT& decode_area) {
   std_cs_ = bStdCS;
   has_mask_ = bHasMask;
   group_family_ = GroupFamily;
@@ -328,7 +329,8 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadDIBBase(
                              GetHeight() / max_size_required.height))));
   }
 
-  LoadState iCreatedDecoder = CreateDecoder(resolution_levels_to_skip);
+  LoadState iCreatedDecoder =
+      CreateDecoder(resolution_levels_to_skip, decode_area);
   if (iCreatedDecoder == LoadState::kFail) {
     return LoadState::kFail;
   }
@@ -561,7 +563,8 @@ bool CPDF_DIB::GetDecodeAndMaskArray() {
   return true;
 }
 
-CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
+CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip,
+                                            const FX_RECT& decode_area) {
   ByteString decoder = stream_acc_->GetImageDecoder();
   if (decoder.IsEmpty()) {
     return LoadState::kSuccess;
@@ -572,7 +575,7 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
   }
 
   if (decoder == "JPXDecode") {
-    cached_bitmap_ = LoadJpxBitmap(resolution_levels_to_skip);
+    cached_bitmap_ = LoadJpxBitmap(resolution_levels_to_skip, decode_area);
     return cached_bitmap_ ? LoadState::kSuccess : LoadState::kFail;
   }
 
@@ -599,7 +602,7 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
     decoder_ = BasicModule::CreateRunLengthDecoder(
         src_span, GetWidth(), GetHeight(), components_, bpc_);
   } else if (decoder == "DCTDecode") {
-    if (!CreateDCTDecoder(src_span, pParams)) {
+    if (!CreateDCTDecoder(src_span, pParams, resolution_levels_to_skip)) {
       return LoadState::kFail;
     }
   }
@@ -624,11 +627,14 @@ CPDF_DIB::LoadState CPDF_DIB::CreateDecoder(uint8_t resolution_levels_to_skip) {
 }
 
 bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
-                                const CPDF_Dictionary* pParams) {
+                                const CPDF_Dictionary* pParams,
+                                uint8_t resolution_levels_to_skip) {
   decoder_ = JpegModule::CreateDecoder(
       src_span, GetWidth(), GetHeight(), components_,
-      !pParams || pParams->GetIntegerFor("ColorTransform", 1));
+      !pParams || pParams->GetIntegerFor("ColorTransform", 1),
+      resolution_levels_to_skip);
   if (decoder_) {
+    SetScaledJpegSize(resolution_levels_to_skip);
     return true;
   }
 
@@ -650,7 +656,9 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
   if (components_ == static_cast<uint32_t>(info.num_components)) {
     bpc_ = info.bits_per_components;
     decoder_ = JpegModule::CreateDecoder(src_span, GetWidth(), GetHeight(),
-                                         components_, info.color_transform);
+                                         components_, info.color_transform,
+                                         resolution_levels_to_skip);
+    SetScaledJpegSize(resolution_levels_to_skip);
     return true;
   }
 
@@ -700,12 +708,61 @@ bool CPDF_DIB::CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
 
   bpc_ = info.bits_per_components;
   decoder_ = JpegModule::CreateDecoder(src_span, GetWidth(), GetHeight(),
-                                       components_, info.color_transform);
+                                       components_, info.color_transform,
+                                       resolution_levels_to_skip);
+  SetScaledJpegSize(resolution_levels_to_skip);
   return true;
 }
 
+void CPDF_DIB::SetScaledJpegSize(uint8_t resolution_levels_to_skip) {
+  SetWidth(static_cast<int>(JpegModule::GetScaledDimension(
+      GetWidth(), resolution_levels_to_skip)));
+  SetHeight(static_cast<int>(JpegModule::GetScaledDimension(
+      GetHeight(), resolution_levels_to_skip)));
+}
+
+FX_RECT CPDF_DIB::GetJpxDecodeArea(const FX_RECT& decode_area,
+                                   uint8_t resolution_levels_to_skip) const {
+  // Masks are loaded whole, so the image has to be as well.
+  if (decode_area.IsEmpty() || dict_->KeyExist("SMask") ||
+      dict_->KeyExist("Mask") || dict_->GetIntegerFor("SMaskInData") != 0) {
+    return FX_RECT();
+  }
+
+  FX_RECT area = decode_area;
+  area.Intersect(FX_RECT(0, 0, GetWidth(), GetHeight()));
+  if (area.IsEmpty()) {
+    return FX_RECT();
+  }
+
+  // Keep the area on the pixel grid of the reduced resolution, so that its
+  // decoded pixels line up with the ones of the whole image. Add two of those
+  // pixels all around, for the resamplers to blend in at the edges.
+  const int64_t step = int64_t{1} << resolution_levels_to_skip;
+  const int64_t padding = 2 * step;
+  const int64_t left = std::max<int64_t>(area.left - padding, 0) / step * step;
+  const int64_t top = std::max<int64_t>(area.top - padding, 0) / step * step;
+  const int64_t right = std::min<int64_t>(
+      (area.right + padding + step - 1) / step * step, GetWidth());
+  const int64_t bottom = std::min<int64_t>(
+      (area.bottom + padding + step - 1) / step * step, GetHeight());
+  if ((right - left) < step || (bottom - top) < step) {
+    return FX_RECT();
+  }
+
+  // When most of the image is needed anyway, decoding all of it costs little
+  // more, and the result serves any later area.
+  if ((right - left) * (bottom - top) * 2 >=
+      int64_t{GetWidth()} * GetHeight()) {
+    return FX_RECT();
+  }
+  return FX_RECT(static_cast<int>(left), static_cast<int>(top),
+                 static_cast<int>(right), static_cast<int>(bottom));
+}
+
 RetainPtr<CFX_DIBitmap> CPDF_DIB::LoadJpxBitmap(
-    uint8_t resolution_levels_to_skip) {
+    uint8_t resolution_levels_to_skip,
+    const FX_RECT& decode_area) {
   std::unique_ptr<CJPX_Decoder> decoder =
       CJPX_Decoder::Create(stream_acc_->GetSpan(),
                            ColorSpaceOptionFromColorSpace(color_space_.Get()),
@@ -714,8 +771,15 @@ RetainPtr<CFX_DIBitmap> CPDF_DIB::LoadJpxBitmap(
     return nullptr;
   }
 
-  SetWidth(GetWidth() >> resolution_levels_to_skip);
-  SetHeight(GetHeight() >> resolution_levels_to_skip);
+  FX_RECT area = GetJpxDecodeArea(decode_area, resolution_levels_to_skip);
+  if (!area.IsEmpty() && decoder->SetDecodeArea(area)) {
+    decoded_area_ = area;
+    SetWidth(area.Width() >> resolution_levels_to_skip);
+    SetHeight(area.Height() >> resolution_levels_to_skip);
+  } else {
+    SetWidth(GetWidth() >> resolution_levels_to_skip);
+    SetHeight(GetHeight() >> resolution_levels_to_skip);
+  }
 
   if (!decoder->StartDecode()) {
     return nullptr;
@@ -976,7 +1040,8 @@ CPDF_DIB::LoadState CPDF_DIB::StartLoadMaskDIB(
   mask_ = pdfium::MakeRetain<CPDF_DIB>(document_, std::move(mask_stream));
   LoadState ret =
       mask_->StartLoadDIBBase(false, nullptr, nullptr, true,
-                              CPDF_ColorSpace::Family::kUnknown, false, {0, 0});
+                              CPDF_ColorSpace::Family::kUnknown, false, {0, 0},
+                              FX_RECT());
   if (ret == LoadState::kContinue) {
     if (status_ == LoadState::kFail) {
       status_ = LoadState::kContinue;
@@ -14,6 +14,7 @@
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
 #include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -53,6 +54,10 @@ class CPDF_DIB final : public CFX_DIBBase {
   uint32_t GetMatteColor() const { return matte_color_; }
   bool IsJBigImage() const;
 
+  // The part of the image that was decoded, in pixels of the full resolution
+  // image. Empty when all of it was.
+  const FX_RECT& GetDecodedArea() const { return decoded_area_; }
+
   bool Load();
   LoadState StartLoadDIBBase(bool bHasMask,
                              const CPDF_Dictionary* pFormResources,
@@ -60,7 +65,8 @@ class CPDF_DIB final : public CFX_DIBBase {
                              bool bStdCS,
                              CPDF_ColorSpace::Family GroupFamily,
                              bool bLoadMask,
-                             const CFX_Size& max_size_required);
+                             const CFX_Size& max_size_required,
+                             const FX_RECT& decode_area);
   LoadState ContinueLoadDIBBase(PauseIndicatorIface* pPause);
   RetainPtr<CPDF_DIB> DetachMask();
 
@@ -87,11 +93,21 @@ class CPDF_DIB final : public CFX_DIBBase {
   bool LoadColorInfo(const CPDF_Dictionary* pFormResources,
                      const CPDF_Dictionary* pPageResources);
   bool GetDecodeAndMaskArray();
-  RetainPtr<CFX_DIBitmap> LoadJpxBitmap(uint8_t resolution_levels_to_skip);
+  RetainPtr<CFX_DIBitmap> LoadJpxBitmap(uint8_t resolution_levels_to_skip,
+                                        const FX_RECT& decode_area);
+  // Returns the part of `decode_area` worth decoding on its own, grown to
+  // whole pixels at the reduced resolution and padded for resampling, or an
+  // empty rect to decode all of the image.
+  FX_RECT GetJpxDecodeArea(const FX_RECT& decode_area,
+                           uint8_t resolution_levels_to_skip) const;
   void LoadPalette();
-  LoadState CreateDecoder(uint8_t resolution_levels_to_skip);
+  LoadState CreateDecoder(uint8_t resolution_levels_to_skip,
+                          const FX_RECT& decode_area);
   bool CreateDCTDecoder(pdfium::span<const uint8_t> src_span,
-                        const CPDF_Dictionary* pParams);
+                        const CPDF_Dictionary* pParams,
+                        uint8_t resolution_levels_to_skip);
+  // Shrinks the size to what the JPEG decoder outputs.
+  void SetScaledJpegSize(uint8_t resolution_levels_to_skip);
   void TranslateScanline24bpp(pdfium::span<uint8_t> dest_scan,
                               pdfium::span<const uint8_t> src_scan) const;
   bool TranslateScanline24bppDefaultDecode(
@@ -116,6 +132,7 @@ class CPDF_DIB final : public CFX_DIBBase {
   CPDF_ColorSpace::Family group_family_ = CPDF_ColorSpace::Family::kUnknown;
   uint32_t matte_color_ = 0;
   LoadState status_ = LoadState::kFail;
+  FX_RECT decoded_area_;
   bool load_mask_ = false;
   bool default_decode_ = true;
   bool image_mask_ = false;
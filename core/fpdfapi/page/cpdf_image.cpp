@@ -362,11 +362,12 @@ bool CPDF_Image::StartLoadDIBBase(const CPDF_Dictionary* pFormResource,
                                   bool bStdCS,
                                   CPDF_ColorSpace::Family GroupFamily,
                                   bool bLoadMask,
-                                  const CFX_Size& max_size_required) {
+                                  const CFX_Size& max_size_required,
+                                  const FX_RECT& decode_area) {
   RetainPtr<CPDF_DIB> source = CreateNewDIB();
-  CPDF_DIB::LoadState ret =
-      source->StartLoadDIBBase(true, pFormResource, pPageResource, bStdCS,
-                               GroupFamily, bLoadMask, max_size_required);
+  CPDF_DIB::LoadState ret = source->StartLoadDIBBase(
+      true, pFormResource, pPageResource, bStdCS, GroupFamily, bLoadMask,
+      max_size_required, decode_area);
   if (ret == CPDF_DIB::LoadState::kFail) {
     dibbase_.Reset();
     return false;
@@ -378,6 +379,7 @@ bool CPDF_Image::StartLoadDIBBase(const CPDF_Dictionary* pFormResource,
 
   mask_ = source->DetachMask();
   matte_color_ = source->GetMatteColor();
+  decoded_area_ = source->GetDecodedArea();
   return false;
 }
 
@@ -391,6 +393,7 @@ bool CPDF_Image::Continue(PauseIndicatorIface* pPause) {
   if (ret == CPDF_DIB::LoadState::kSuccess) {
     mask_ = pSource->DetachMask();
     matte_color_ = pSource->GetMatteColor();
+    decoded_area_ = pSource->GetDecodedArea();
   } else {
     dibbase_.Reset();
   }
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
@@ -44,6 +45,7 @@ class CPDF_Image final : public Retainable {
   int32_t GetPixelHeight() const { return height_; }
   int32_t GetPixelWidth() const { return width_; }
   uint32_t GetMatteColor() const { return matte_color_; }
+  const FX_RECT& GetDecodedArea() const { return decoded_area_; }
   bool IsInline() const { return is_inline_; }
   bool IsMask() const { return is_mask_; }
   bool IsInterpol() const { return interpolate_; }
@@ -66,7 +68,8 @@ class CPDF_Image final : public Retainable {
                         bool bStdCS,
                         CPDF_ColorSpace::Family GroupFamily,
                         bool bLoadMask,
-                        const CFX_Size& max_size_required);
+                        const CFX_Size& max_size_required,
+                        const FX_RECT& decode_area);
 
   // Returns whether to Continue() or not.
   bool Continue(PauseIndicatorIface* pPause);
@@ -87,6 +90,7 @@ class CPDF_Image final : public Retainable {
   int32_t height_ = 0;
   int32_t width_ = 0;
   uint32_t matte_color_ = 0;
+  FX_RECT decoded_area_;
   bool is_inline_ = false;
   bool is_mask_ = false;
   bool interpolate_ = false;
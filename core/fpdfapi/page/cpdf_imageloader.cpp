@@ -27,18 +27,19 @@ bool CPDF_ImageLoader::Start(const CPDF_ImageObject* pImage,
                              bool bStdCS,
                              CPDF_ColorSpace::Family eFamily,
                              bool bLoadMask,
-                             const CFX_Size& max_size_required) {
+                             const CFX_Size& max_size_required,
+                             const FX_RECT& decode_area) {
   cache_ = pPageImageCache;
   image_object_ = pImage;
   bool should_continue;
   if (cache_) {
     should_continue = cache_->StartGetCachedBitmap(
         image_object_->GetImage(), pFormResource, pPageResource, bStdCS,
-        eFamily, bLoadMask, max_size_required);
+        eFamily, bLoadMask, max_size_required, decode_area);
   } else {
     should_continue = image_object_->GetImage()->StartLoadDIBBase(
         pFormResource, pPageResource, bStdCS, eFamily, bLoadMask,
-        max_size_required);
+        max_size_required, decode_area);
   }
   if (!should_continue) {
     Finish();
@@ -73,6 +74,7 @@ void CPDF_ImageLoader::Finish() {
     bitmap_ = cache_->DetachCurBitmap();
     mask_ = cache_->DetachCurMask();
     matte_color_ = cache_->GetCurMatteColor();
+    decoded_area_ = cache_->GetCurDecodedArea();
     return;
   }
   RetainPtr<CPDF_Image> pImage = image_object_->GetImage();
@@ -80,4 +82,5 @@ void CPDF_ImageLoader::Finish() {
   bitmap_ = pImage->DetachBitmap();
   mask_ = pImage->DetachMask();
   matte_color_ = pImage->GetMatteColor();
+  decoded_area_ = pImage->GetDecodedArea();
 }
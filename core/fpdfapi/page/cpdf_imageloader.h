@@ -8,6 +8,7 @@
 #define CORE_FPDFAPI_PAGE_CPDF_IMAGELOADER_H_
 
 #include "core/fpdfapi/page/cpdf_colorspace.h"
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -30,7 +31,8 @@ class CPDF_ImageLoader {
              bool bStdCS,
              CPDF_ColorSpace::Family eFamily,
              bool bLoadMask,
-             const CFX_Size& max_size_required);
+             const CFX_Size& max_size_required,
+             const FX_RECT& decode_area);
   bool Continue(PauseIndicatorIface* pPause);
 
   RetainPtr<CFX_DIBBase> TranslateImage(
@@ -40,10 +42,15 @@ class CPDF_ImageLoader {
   const RetainPtr<CFX_DIBBase>& GetMask() const { return mask_; }
   uint32_t MatteColor() const { return matte_color_; }
 
+  // The part of the image that GetBitmap() holds, in pixels of the full
+  // resolution image. Empty when it holds all of it.
+  const FX_RECT& GetDecodedArea() const { return decoded_area_; }
+
  private:
   void Finish();
 
   uint32_t matte_color_ = 0;
+  FX_RECT decoded_area_;
   bool cached_ = false;
   RetainPtr<CFX_DIBBase> bitmap_;
   RetainPtr<CFX_DIBBase> mask_;
@@ -20,6 +20,7 @@
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxge/dib/cfx_dibbase.h"
@@ -174,7 +175,8 @@ bool CPDF_PageImageCache::StartGetCachedBitmap(
     bool bStdCS,
     CPDF_ColorSpace::Family eFamily,
     bool bLoadMask,
-    const CFX_Size& max_size_required) {
+    const CFX_Size& max_size_required,
+    const FX_RECT& decode_area) {
   // A cross-document image may have come from the embedder.
   if (page_->GetDocument() != pImage->GetDocument()) {
     return false;
@@ -190,7 +192,7 @@ bool CPDF_PageImageCache::StartGetCachedBitmap(
   }
   CPDF_DIB::LoadState ret = cur_image_cache_entry_->StartGetCachedBitmap(
       this, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
-      max_size_required);
+      max_size_required, decode_area);
   if (ret == CPDF_DIB::LoadState::kContinue) {
     return true;
   }
@@ -239,6 +241,10 @@ uint32_t CPDF_PageImageCache::GetCurMatteColor() const {
   return cur_image_cache_entry_->GetMatteColor();
 }
 
+const FX_RECT& CPDF_PageImageCache::GetCurDecodedArea() const {
+  return cur_image_cache_entry_->GetDecodedArea();
+}
+
 RetainPtr<CFX_DIBBase> CPDF_PageImageCache::DetachCurBitmap() {
   return cur_image_cache_entry_->DetachBitmap();
 }
@@ -272,17 +278,19 @@ CPDF_DIB::LoadState CPDF_PageImageCache::Entry::StartGetCachedBitmap(
     bool bStdCS,
     CPDF_ColorSpace::Family eFamily,
     bool bLoadMask,
-    const CFX_Size& max_size_required) {
-  if (cached_bitmap_ && IsCacheValid(max_size_required)) {
+    const CFX_Size& max_size_required,
+    const FX_RECT& decode_area) {
+  if (cached_bitmap_ && IsCacheValid(max_size_required, decode_area)) {
     cur_bitmap_ = cached_bitmap_;
     cur_mask_ = cached_mask_;
+    cur_decoded_area_ = cached_decoded_area_;
     return CPDF_DIB::LoadState::kSuccess;
   }
 
   cur_bitmap_ = image_->CreateNewDIB();
   CPDF_DIB::LoadState ret = cur_bitmap_.AsRaw<CPDF_DIB>()->StartLoadDIBBase(
       true, pFormResources, pPageResources, bStdCS, eFamily, bLoadMask,
-      max_size_required);
+      max_size_required, decode_area);
   cached_set_max_size_required_ =
       (max_size_required.width != 0 && max_size_required.height != 0);
   if (ret == CPDF_DIB::LoadState::kContinue) {
@@ -318,6 +326,8 @@ void CPDF_PageImageCache::Entry::ContinueGetCachedBitmap(
     CPDF_PageImageCache* pPageImageCache) {
   matte_color_ = cur_bitmap_.AsRaw<CPDF_DIB>()->GetMatteColor();
   cur_mask_ = cur_bitmap_.AsRaw<CPDF_DIB>()->DetachMask();
+  cached_decoded_area_ = cur_bitmap_.AsRaw<CPDF_DIB>()->GetDecodedArea();
+  cur_decoded_area_ = cached_decoded_area_;
   time_count_ = pPageImageCache->GetTimeCount();
   if (cur_bitmap_->GetPitch() * cur_bitmap_->GetHeight() < kHugeImageSize) {
     cached_bitmap_ = MakeCachedImage(cur_bitmap_, /*realize_hint=*/true);
@@ -345,7 +355,18 @@ void CPDF_PageImageCache::Entry::CalcSize() {
 }
 
 bool CPDF_PageImageCache::Entry::IsCacheValid(
-    const CFX_Size& max_size_required) const {
+    const CFX_Size& max_size_required,
+    const FX_RECT& decode_area) const {
+  if (!cached_decoded_area_.IsEmpty()) {
+    if (decode_area.IsEmpty()) {
+      return false;
+    }
+    FX_RECT covered = cached_decoded_area_;
+    covered.Intersect(decode_area);
+    if (covered != decode_area) {
+      return false;
+    }
+  }
   if (!cached_set_max_size_required_) {
     return true;
   }
@@ -353,6 +374,19 @@ bool CPDF_PageImageCache::Entry::IsCacheValid(
     return false;
   }
 
-  return (cached_bitmap_->GetWidth() >= max_size_required.width) &&
-         (cached_bitmap_->GetHeight() >= max_size_required.height);
+  // Compare the resolution of a partial bitmap as if it covered all of the
+  // image.
+  FX_SAFE_INT32 width = cached_bitmap_->GetWidth();
+  FX_SAFE_INT32 height = cached_bitmap_->GetHeight();
+  if (!cached_decoded_area_.IsEmpty()) {
+    width *= image_->GetPixelWidth();
+    width /= cached_decoded_area_.Width();
+    height *= image_->GetPixelHeight();
+    height /= cached_decoded_area_.Height();
+  }
+  // Nothing larger than the image itself can be decoded.
+  return width.ValueOrDefault(0) >=
+             std::min(max_size_required.width, image_->GetPixelWidth()) &&
+         height.ValueOrDefault(0) >=
+             std::min(max_size_required.height, image_->GetPixelHeight());
 }
@@ -40,11 +40,13 @@ class CPDF_PageImageCache {
                             bool bStdCS,
                             CPDF_ColorSpace::Family eFamily,
                             bool bLoadMask,
-                            const CFX_Size& max_size_required);
+                            const CFX_Size& max_size_required,
+                            const FX_RECT& decode_area);
 
   bool Continue(PauseIndicatorIface* pPause);
 
   uint32_t GetCurMatteColor() const;
+  const FX_RECT& GetCurDecodedArea() const;
   RetainPtr<CFX_DIBBase> DetachCurBitmap();
   RetainPtr<CFX_DIBBase> DetachCurMask();
 
@@ -57,6 +59,7 @@ class CPDF_PageImageCache {
     void Reset();
     uint32_t EstimateSize() const { return cache_size_; }
     uint32_t GetMatteColor() const { return matte_color_; }
+    const FX_RECT& GetDecodedArea() const { return cur_decoded_area_; }
     uint32_t GetTimeCount() const { return time_count_; }
     void SetTimeCount(uint32_t count) { time_count_ = count; }
     CPDF_Image* GetImage() const { return image_.Get(); }
@@ -68,7 +71,8 @@ class CPDF_PageImageCache {
         bool bStdCS,
         CPDF_ColorSpace::Family eFamily,
         bool bLoadMask,
-        const CFX_Size& max_size_required);
+        const CFX_Size& max_size_required,
+        const FX_RECT& decode_area);
 
     // Returns whether to Continue() or not.
     bool Continue(PauseIndicatorIface* pPause,
@@ -80,7 +84,8 @@ class CPDF_PageImageCache {
    private:
     void ContinueGetCachedBitmap(CPDF_PageImageCache* pPageImageCache);
     void CalcSize();
-    bool IsCacheValid(const CFX_Size& max_size_required) const;
+    bool IsCacheValid(const CFX_Size& max_size_required,
+                      const FX_RECT& decode_area) const;
 
     uint32_t time_count_ = 0;
     uint32_t matte_color_ = 0;
@@ -91,6 +96,10 @@ class CPDF_PageImageCache {
     RetainPtr<CFX_DIBBase> cached_bitmap_;
     RetainPtr<CFX_DIBBase> cached_mask_;
     bool cached_set_max_size_required_ = false;
+    // The part of the image that `cached_bitmap_` holds. Empty when it holds
+    // all of it.
+    FX_RECT cached_decoded_area_;
+    FX_RECT cur_decoded_area_;
   };
 
   void ClearImageCacheEntry(const CPDF_Stream* pStream);
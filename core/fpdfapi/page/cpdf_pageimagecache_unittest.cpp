@@ -36,7 +36,7 @@ TEST(CPDFPageImageCache, RenderBug1924) {
                                         std::make_unique<CPDF_DocPageData>());
     ASSERT_EQ(document->LoadDoc(
                   IFX_SeekableReadStream::CreateFromFilename(file_path.c_str()),
-                  nullptr),
+                  nullptr, /*load_flags=*/0),
               CPDF_Parser::SUCCESS);
 
     RetainPtr<CPDF_Dictionary> page_dict =
@@ -58,7 +58,8 @@ TEST(CPDFPageImageCache, RenderBug1924) {
     // Render with small scale.
     bool should_continue = page_image_cache->StartGetCachedBitmap(
         image->GetImage(), nullptr, page->GetMutablePageResources(), true,
-        CPDF_ColorSpace::Family::kICCBased, false, {50, 50});
+        CPDF_ColorSpace::Family::kICCBased, false, {50, 50},
+        FX_RECT());
     while (should_continue) {
       should_continue = page_image_cache->Continue(nullptr);
     }
@@ -68,7 +69,8 @@ TEST(CPDFPageImageCache, RenderBug1924) {
     // And render with large scale.
     should_continue = page_image_cache->StartGetCachedBitmap(
         image->GetImage(), nullptr, page->GetMutablePageResources(), true,
-        CPDF_ColorSpace::Family::kICCBased, false, {100, 100});
+        CPDF_ColorSpace::Family::kICCBased, false, {100, 100},
+        FX_RECT());
     while (should_continue) {
       should_continue = page_image_cache->Continue(nullptr);
     }
@@ -84,4 +86,78 @@ TEST(CPDFPageImageCache, RenderBug1924) {
   DestroyPageModule();
 }
 
+TEST(CPDFPageImageCache, JpxDecodeArea) {
+  InitializePageModule();
+  {
+    std::string file_path = PathService::GetTestFilePath("jpx_lzw.pdf");
+    ASSERT_FALSE(file_path.empty());
+    auto document =
+        std::make_unique<CPDF_Document>(std::make_unique<CPDF_DocRenderData>(),
+                                        std::make_unique<CPDF_DocPageData>());
+    ASSERT_EQ(document->LoadDoc(
+                  IFX_SeekableReadStream::CreateFromFilename(file_path.c_str()),
+                  nullptr, /*load_flags=*/0),
+              CPDF_Parser::SUCCESS);
+
+    RetainPtr<CPDF_Dictionary> page_dict =
+        document->GetMutablePageDictionary(0);
+    ASSERT_TRUE(page_dict);
+    auto page =
+        pdfium::MakeRetain<CPDF_Page>(document.get(), std::move(page_dict));
+    page->AddPageImageCache();
+    page->ParseContent();
+
+    CPDF_PageImageCache* page_image_cache = page->GetPageImageCache();
+    ASSERT_TRUE(page_image_cache);
+
+    CPDF_PageObject* page_obj = page->GetPageObjectByIndex(0);
+    ASSERT_TRUE(page_obj);
+    CPDF_ImageObject* image = page_obj->AsImage();
+    ASSERT_TRUE(image);
+
+    auto get_bitmap = [&](const FX_RECT& decode_area) {
+      bool should_continue = page_image_cache->StartGetCachedBitmap(
+          image->GetImage(), nullptr, page->GetMutablePageResources(), true,
+          CPDF_ColorSpace::Family::kICCBased, false, {792, 792}, decode_area);
+      while (should_continue) {
+        should_continue = page_image_cache->Continue(nullptr);
+      }
+      return page_image_cache->DetachCurBitmap();
+    };
+
+    // Decode just a corner of the 612x792 image.
+    RetainPtr<CFX_DIBBase> corner = get_bitmap(FX_RECT(0, 0, 100, 100));
+    ASSERT_TRUE(corner);
+    EXPECT_EQ(100, corner->GetWidth());
+    EXPECT_EQ(100, corner->GetHeight());
+    EXPECT_EQ(FX_RECT(0, 0, 100, 100), page_image_cache->GetCurDecodedArea());
+
+    // An area within the cached one reuses it.
+    RetainPtr<CFX_DIBBase> inside = get_bitmap(FX_RECT(10, 10, 50, 50));
+    EXPECT_EQ(corner, inside);
+    EXPECT_EQ(FX_RECT(0, 0, 100, 100), page_image_cache->GetCurDecodedArea());
+
+    // One outside of it does not.
+    RetainPtr<CFX_DIBBase> middle = get_bitmap(FX_RECT(200, 300, 260, 340));
+    ASSERT_TRUE(middle);
+    EXPECT_EQ(60, middle->GetWidth());
+    EXPECT_EQ(40, middle->GetHeight());
+    EXPECT_EQ(FX_RECT(200, 300, 260, 340),
+              page_image_cache->GetCurDecodedArea());
+
+    // Most of the image is as good as all of it, which then serves any area.
+    RetainPtr<CFX_DIBBase> most = get_bitmap(FX_RECT(0, 0, 600, 700));
+    ASSERT_TRUE(most);
+    EXPECT_EQ(612, most->GetWidth());
+    EXPECT_EQ(792, most->GetHeight());
+    EXPECT_TRUE(page_image_cache->GetCurDecodedArea().IsEmpty());
+    EXPECT_EQ(most, get_bitmap(FX_RECT(0, 0, 100, 100)));
+    EXPECT_TRUE(page_image_cache->GetCurDecodedArea().IsEmpty());
+
+    ASSERT_TRUE(page->AsPDFPage());
+    page->AsPDFPage()->ClearView();
+  }
+  DestroyPageModule();
+}
+
 }  // namespace pdfium
@@ -8,6 +8,7 @@
 
 #include <utility>
 
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fxcrt/fx_coordinates.h"
 
 CPDF_PageObject::CPDF_PageObject(int32_t content_stream)
@@ -94,10 +95,34 @@ void CPDF_PageObject::InitializeOriginalMatrix(const CFX_Matrix& matrix) {
   original_matrix_ = matrix;
 }
 
+void CPDF_PageObject::SetDirty(bool value) {
+  dirty_ = value;
+  if (value) {
+    InvalidateDrawnRect();
+  }
+}
+
+void CPDF_PageObject::SetMatrixDirty(bool value) {
+  matrix_dirty_ = value;
+  if (value) {
+    InvalidateDrawnRect();
+  }
+}
+
 void CPDF_PageObject::SetIsActive(bool value) {
   if (is_active_ != value) {
     is_active_ = value;
-    dirty_ = true;
+    SetDirty(true);
+  }
+}
+
+void CPDF_PageObject::SetRect(const CFX_FloatRect& rect) {
+  // Whatever was drawn at the old rect needs drawing over too.
+  InvalidateDrawnRect();
+  rect_ = rect;
+  InvalidateDrawnRect();
+  if (holder_) {
+    holder_->InvalidateObjectIndex();
   }
 }
 
@@ -117,3 +142,13 @@ FX_RECT CPDF_PageObject::GetBBox() const {
 FX_RECT CPDF_PageObject::GetTransformedBBox(const CFX_Matrix& matrix) const {
   return matrix.TransformRect(GetRect()).GetOuterRect();
 }
+
+CFX_FloatRect CPDF_PageObject::GetDrawnRect() const {
+  return GetRect();
+}
+
+void CPDF_PageObject::InvalidateDrawnRect() const {
+  if (holder_) {
+    holder_->AddDirtyRect(GetDrawnRect());
+  }
+}
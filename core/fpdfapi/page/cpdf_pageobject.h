@@ -14,9 +14,11 @@
 #include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_FormObject;
 class CPDF_ImageObject;
+class CPDF_PageObjectHolder;
 class CPDF_PathObject;
 class CPDF_ShadingObject;
 class CPDF_TextObject;
@@ -60,20 +62,28 @@ class CPDF_PageObject {
   virtual CPDF_FormObject* AsForm();
   virtual const CPDF_FormObject* AsForm() const;
 
-  void SetDirty(bool value) { dirty_ = value; }
+  // Setting either flag also marks GetDrawnRect() dirty in the holder.
+  void SetDirty(bool value);
   bool IsDirty() const { return dirty_ || matrix_dirty_; }
-  void SetMatrixDirty(bool value) { matrix_dirty_ = value; }
+  void SetMatrixDirty(bool value);
   void SetIsActive(bool value);
   bool IsActive() const { return is_active_; }
   void TransformClipPath(const CFX_Matrix& matrix);
 
   void SetOriginalRect(const CFX_FloatRect& rect) { original_rect_ = rect; }
   const CFX_FloatRect& GetOriginalRect() const { return original_rect_; }
-  void SetRect(const CFX_FloatRect& rect) { rect_ = rect; }
+  void SetRect(const CFX_FloatRect& rect);
   const CFX_FloatRect& GetRect() const { return rect_; }
   FX_RECT GetBBox() const;
   FX_RECT GetTransformedBBox(const CFX_Matrix& matrix) const;
 
+  // Returns GetRect(), grown to cover everything drawing the object touches.
+  virtual CFX_FloatRect GetDrawnRect() const;
+  // Adds GetDrawnRect() to the holder's dirty rect. SetRect() does so before
+  // and after a change, so this is only needed before changes that shrink
+  // GetDrawnRect() without going through SetRect().
+  void InvalidateDrawnRect() const;
+
   CPDF_ContentMarks* GetContentMarks() { return &content_marks_; }
   const CPDF_ContentMarks* GetContentMarks() const { return &content_marks_; }
   void SetContentMarks(const CPDF_ContentMarks& marks) {
@@ -138,6 +148,11 @@ class CPDF_PageObject {
 
   const CFX_Matrix& original_matrix() const { return original_matrix_; }
 
+  // Called by the CPDF_PageObjectHolder this object is added to or removed
+  // from, which needs to hear when the bounding box changes.
+  void SetHolder(CPDF_PageObjectHolder* holder) { holder_ = holder; }
+  bool HasHolder() const { return !!holder_; }
+
  protected:
   void CopyData(const CPDF_PageObject* pSrcObject);
   void InitializeOriginalMatrix(const CFX_Matrix& matrix);
@@ -162,6 +177,7 @@ class CPDF_PageObject {
   int32_t content_stream_;
   // The resource name for this object.
   ByteString resource_name_;
+  UnownedPtr<CPDF_PageObjectHolder> holder_;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECT_H_
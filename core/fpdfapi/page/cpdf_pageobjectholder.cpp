@@ -13,6 +13,7 @@
 #include "core/fpdfapi/page/cpdf_allstates.h"
 #include "core/fpdfapi/page/cpdf_contentparser.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fxcrt/check.h"
@@ -21,6 +22,13 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/stl_util.h"
 
+namespace {
+
+// Below this many objects, testing each one beats building an index.
+constexpr size_t kMinIndexedObjectCount = 1024;
+
+}  // namespace
+
 bool GraphicsData::operator<(const GraphicsData& other) const {
   if (!FXSYS_SafeEQ(fillAlpha, other.fillAlpha)) {
     return FXSYS_SafeLT(fillAlpha, other.fillAlpha);
@@ -186,7 +194,9 @@ CPDF_PageObject* CPDF_PageObjectHolder::GetPageObjectByIndex(
 void CPDF_PageObjectHolder::AppendPageObject(
     std::unique_ptr<CPDF_PageObject> pPageObj) {
   CHECK(pPageObj);
+  pPageObj->SetHolder(this);
   page_object_list_.push_back(std::move(pPageObj));
+  InvalidateObjectIndex();
 }
 
 std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
@@ -199,6 +209,8 @@ std::unique_ptr<CPDF_PageObject> CPDF_PageObjectHolder::RemovePageObject(
 
   std::unique_ptr<CPDF_PageObject> result = std::move(*it);
   page_object_list_.erase(it);
+  result->SetHolder(nullptr);
+  InvalidateObjectIndex();
 
   int32_t content_stream = pPageObj->GetContentStream();
   if (content_stream >= 0) {
@@ -214,5 +226,47 @@ bool CPDF_PageObjectHolder::ErasePageObjectAtIndex(size_t index) {
   }
 
   page_object_list_.erase(page_object_list_.begin() + index);
+  InvalidateObjectIndex();
   return true;
 }
+
+std::vector<size_t> CPDF_PageObjectHolder::GetPageObjectIndicesInRect(
+    const CFX_FloatRect& rect) const {
+  // Objects keep coming while parsing, so only index finished lists.
+  if (parse_state_ == ParseState::kParsed &&
+      page_object_list_.size() >= kMinIndexedObjectCount) {
+    if (!object_index_) {
+      std::vector<CFX_FloatRect> rects;
+      rects.reserve(page_object_list_.size());
+      for (const auto& page_object : page_object_list_) {
+        rects.push_back(page_object->GetRect());
+      }
+      object_index_ = std::make_unique<CPDF_PageObjectIndex>(std::move(rects));
+    }
+    return object_index_->GetObjectsInRect(rect);
+  }
+
+  std::vector<size_t> result;
+  for (size_t i = 0; i < page_object_list_.size(); ++i) {
+    if (CPDF_PageObjectIndex::Overlaps(page_object_list_[i]->GetRect(),
+                                       rect)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+void CPDF_PageObjectHolder::InvalidateObjectIndex() {
+  object_index_.reset();
+}
+
+void CPDF_PageObjectHolder::AddDirtyRect(const CFX_FloatRect& rect) {
+  if (parse_state_ != ParseState::kParsed) {
+    return;
+  }
+  if (dirty_rect_.has_value()) {
+    dirty_rect_->Union(rect);
+  } else {
+    dirty_rect_ = rect;
+  }
+}
@@ -30,6 +30,7 @@
 class CPDF_ContentParser;
 class CPDF_Document;
 class CPDF_PageObject;
+class CPDF_PageObjectIndex;
 class PauseIndicatorIface;
 
 // These structs are used to keep track of resources that have already been
@@ -105,6 +106,23 @@ class CPDF_PageObjectHolder {
   std::unique_ptr<CPDF_PageObject> RemovePageObject(CPDF_PageObject* pPageObj);
   bool ErasePageObjectAtIndex(size_t index);
 
+  // Returns the indices of the objects whose bounding boxes overlap `rect`, in
+  // z-order. Once parsed, holders with many objects answer from a spatial
+  // index, built on first use.
+  std::vector<size_t> GetPageObjectIndicesInRect(
+      const CFX_FloatRect& rect) const;
+
+  // Drops the spatial index, for when objects move.
+  void InvalidateObjectIndex();
+
+  // Marks `rect`, in the holder's space, as changed since it was last
+  // rendered. Ignored while parsing, as new objects are not changes.
+  void AddDirtyRect(const CFX_FloatRect& rect);
+  // Returns the union of the rects added since the last call, if any.
+  std::optional<CFX_FloatRect> TakeDirtyRect() {
+    return std::exchange(dirty_rect_, std::nullopt);
+  }
+
   iterator begin() { return page_object_list_.begin(); }
   const_iterator begin() const { return page_object_list_.begin(); }
 
@@ -161,6 +179,8 @@ class CPDF_PageObjectHolder {
   std::vector<CFX_FloatRect> mask_bounding_boxes_;
   std::unique_ptr<CPDF_ContentParser> parser_;
   std::deque<std::unique_ptr<CPDF_PageObject>> page_object_list_;
+  mutable std::unique_ptr<CPDF_PageObjectIndex> object_index_;
+  std::optional<CFX_FloatRect> dirty_rect_;
 
   CTMMap all_ctms_;
 
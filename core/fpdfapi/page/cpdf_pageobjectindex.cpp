@@ -0,0 +1,201 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "core/fxcrt/check_op.h"
+
+namespace {
+
+// Aim for this many objects per cell, when they are spread evenly.
+constexpr size_t kObjectsPerCell = 8;
+
+constexpr size_t kMaxCellCount = 1 << 16;
+
+// Objects spanning more cells than this are left out of the grid, so that a
+// few page-sized backgrounds do not fill every cell.
+constexpr int kMaxCellsPerObject = 64;
+
+bool IsFinite(const CFX_FloatRect& rect) {
+  return isfinite(rect.left) && isfinite(rect.bottom) &&
+         isfinite(rect.right) && isfinite(rect.top);
+}
+
+bool IsPlaceable(const CFX_FloatRect& rect) {
+  return IsFinite(rect) && rect.left <= rect.right && rect.bottom <= rect.top;
+}
+
+int ToCell(float offset, float cell_size, int cell_count) {
+  float cell = floorf(offset / cell_size);
+  return static_cast<int>(
+      std::clamp(cell, 0.0f, static_cast<float>(cell_count - 1)));
+}
+
+}  // namespace
+
+// static
+bool CPDF_PageObjectIndex::Overlaps(const CFX_FloatRect& object_rect,
+                                    const CFX_FloatRect& rect) {
+  return !(object_rect.left > rect.right || object_rect.right < rect.left ||
+           object_rect.bottom > rect.top || object_rect.top < rect.bottom);
+}
+
+CPDF_PageObjectIndex::CPDF_PageObjectIndex(std::vector<CFX_FloatRect> rects)
+    : rects_(std::move(rects)) {
+  CHECK_LE(rects_.size(), std::numeric_limits<uint32_t>::max());
+
+  bool has_bounds = false;
+  for (const CFX_FloatRect& rect : rects_) {
+    if (!IsPlaceable(rect)) {
+      continue;
+    }
+    if (has_bounds) {
+      bounds_.Union(rect);
+    } else {
+      bounds_ = rect;
+      has_bounds = true;
+    }
+  }
+
+  // Shape the cells after the bounds, so they come out roughly square.
+  const size_t max_cells =
+      std::clamp<size_t>(rects_.size() / kObjectsPerCell, 1, kMaxCellCount);
+  const double width = bounds_.Width();
+  const double height = bounds_.Height();
+  if (width > 0 && height > 0) {
+    const double columns = sqrt(max_cells * width / height);
+    columns_ = static_cast<int>(
+        std::clamp(columns, 1.0, static_cast<double>(max_cells)));
+    rows_ = static_cast<int>(max_cells / columns_);
+  } else if (width > 0) {
+    columns_ = static_cast<int>(max_cells);
+  } else if (height > 0) {
+    rows_ = static_cast<int>(max_cells);
+  }
+  if (width > 0) {
+    cell_width_ = static_cast<float>(width / columns_);
+  }
+  if (height > 0) {
+    cell_height_ = static_cast<float>(height / rows_);
+  }
+
+  auto get_placement = [this](const CFX_FloatRect& rect) {
+    std::optional<CellRange> range;
+    if (IsPlaceable(rect)) {
+      range = GetCellRange(rect);
+      if ((range->right - range->left + 1) * (range->top - range->bottom + 1) >
+          kMaxCellsPerObject) {
+        range.reset();
+      }
+    }
+    return range;
+  };
+
+  // Count the objects in each cell, then lay the cells out back to back.
+  cell_starts_.resize(static_cast<size_t>(columns_) * rows_ + 1);
+  for (const CFX_FloatRect& rect : rects_) {
+    std::optional<CellRange> range = get_placement(rect);
+    if (!range.has_value()) {
+      continue;
+    }
+    for (int row = range->bottom; row <= range->top; ++row) {
+      for (int column = range->left; column <= range->right; ++column) {
+        ++cell_starts_[GetCellIndex(column, row) + 1];
+      }
+    }
+  }
+  for (size_t i = 1; i < cell_starts_.size(); ++i) {
+    cell_starts_[i] += cell_starts_[i - 1];
+  }
+
+  cell_objects_.resize(cell_starts_.back());
+  std::vector<uint32_t> cell_ends(cell_starts_.begin(), cell_starts_.end() - 1);
+  for (size_t i = 0; i < rects_.size(); ++i) {
+    std::optional<CellRange> range = get_placement(rects_[i]);
+    if (!range.has_value()) {
+      unplaced_objects_.push_back(static_cast<uint32_t>(i));
+      continue;
+    }
+    for (int row = range->bottom; row <= range->top; ++row) {
+      for (int column = range->left; column <= range->right; ++column) {
+        cell_objects_[cell_ends[GetCellIndex(column, row)]++] =
+            static_cast<uint32_t>(i);
+      }
+    }
+  }
+}
+
+CPDF_PageObjectIndex::~CPDF_PageObjectIndex() = default;
+
+std::vector<size_t> CPDF_PageObjectIndex::GetObjectsInRect(
+    const CFX_FloatRect& rect) const {
+  std::vector<size_t> result;
+  if (!IsFinite(rect)) {
+    AppendAllInRect(rect, &result);
+    return result;
+  }
+
+  std::vector<uint32_t> candidates = unplaced_objects_;
+  if (!cell_objects_.empty() && Overlaps(bounds_, rect)) {
+    const CellRange range = GetCellRange(rect);
+    size_t entry_count = candidates.size();
+    for (int row = range.bottom; row <= range.top; ++row) {
+      entry_count += cell_starts_[GetCellIndex(range.right, row) + 1] -
+                     cell_starts_[GetCellIndex(range.left, row)];
+    }
+    // When the area covers much of the page, sorting out the duplicates
+    // costs more than testing every object.
+    if (entry_count >= rects_.size() / 2) {
+      AppendAllInRect(rect, &result);
+      return result;
+    }
+
+    // The cells in a row are adjacent, so each row is one run of entries.
+    for (int row = range.bottom; row <= range.top; ++row) {
+      candidates.insert(
+          candidates.end(),
+          cell_objects_.begin() + cell_starts_[GetCellIndex(range.left, row)],
+          cell_objects_.begin() +
+              cell_starts_[GetCellIndex(range.right, row) + 1]);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+  }
+
+  for (uint32_t index : candidates) {
+    if (Overlaps(rects_[index], rect)) {
+      result.push_back(index);
+    }
+  }
+  return result;
+}
+
+CPDF_PageObjectIndex::CellRange CPDF_PageObjectIndex::GetCellRange(
+    const CFX_FloatRect& rect) const {
+  return {ToCell(rect.left - bounds_.left, cell_width_, columns_),
+          ToCell(rect.bottom - bounds_.bottom, cell_height_, rows_),
+          ToCell(rect.right - bounds_.left, cell_width_, columns_),
+          ToCell(rect.top - bounds_.bottom, cell_height_, rows_)};
+}
+
+size_t CPDF_PageObjectIndex::GetCellIndex(int column, int row) const {
+  return static_cast<size_t>(row) * columns_ + column;
+}
+
+void CPDF_PageObjectIndex::AppendAllInRect(const CFX_FloatRect& rect,
+                                           std::vector<size_t>* result) const {
+  for (size_t i = 0; i < rects_.size(); ++i) {
+    if (Overlaps(rects_[i], rect)) {
+      result->push_back(i);
+    }
+  }
+}
@@ -0,0 +1,63 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+#define CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+
+// A uniform grid over the bounding boxes of a list of page objects, so that
+// the ones overlapping a small area, like a tile, can be found without testing
+// all of them. Objects are identified by their position in the list, so
+// results come back in z-order.
+class CPDF_PageObjectIndex {
+ public:
+  // Whether an object with bounding box `object_rect` is considered to touch
+  // `rect`. Edges count as overlapping.
+  static bool Overlaps(const CFX_FloatRect& object_rect,
+                       const CFX_FloatRect& rect);
+
+  explicit CPDF_PageObjectIndex(std::vector<CFX_FloatRect> rects);
+  CPDF_PageObjectIndex(const CPDF_PageObjectIndex&) = delete;
+  CPDF_PageObjectIndex& operator=(const CPDF_PageObjectIndex&) = delete;
+  ~CPDF_PageObjectIndex();
+
+  // Returns the positions of the objects that overlap `rect`, in increasing
+  // order.
+  std::vector<size_t> GetObjectsInRect(const CFX_FloatRect& rect) const;
+
+ private:
+  struct CellRange {
+    int left;
+    int bottom;
+    int right;
+    int top;
+  };
+
+  CellRange GetCellRange(const CFX_FloatRect& rect) const;
+  size_t GetCellIndex(int column, int row) const;
+  void AppendAllInRect(const CFX_FloatRect& rect,
+                       std::vector<size_t>* result) const;
+
+  const std::vector<CFX_FloatRect> rects_;
+  CFX_FloatRect bounds_;
+  int columns_ = 1;
+  int rows_ = 1;
+  float cell_width_ = 1.0f;
+  float cell_height_ = 1.0f;
+  // The objects in cell `i` are `cell_objects_[cell_starts_[i]]` up to
+  // `cell_objects_[cell_starts_[i + 1]]`. Cells are stored row by row.
+  std::vector<uint32_t> cell_starts_;
+  std::vector<uint32_t> cell_objects_;
+  // Objects too large, or too odd, to be worth placing in cells. They get
+  // tested against every query.
+  std::vector<uint32_t> unplaced_objects_;
+};
+
+#endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEOBJECTINDEX_H_
@@ -0,0 +1,94 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
+
+#include <limits>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace {
+
+std::vector<size_t> GetObjectsInRectSlowly(
+    const std::vector<CFX_FloatRect>& rects,
+    const CFX_FloatRect& rect) {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < rects.size(); ++i) {
+    if (CPDF_PageObjectIndex::Overlaps(rects[i], rect)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CPDFPageObjectIndex, Empty) {
+  CPDF_PageObjectIndex index({});
+  EXPECT_THAT(index.GetObjectsInRect(CFX_FloatRect(0, 0, 100, 100)),
+              IsEmpty());
+}
+
+TEST(CPDFPageObjectIndex, Overlaps) {
+  const CFX_FloatRect rect(10, 10, 20, 20);
+  EXPECT_TRUE(
+      CPDF_PageObjectIndex::Overlaps(CFX_FloatRect(0, 0, 15, 15), rect));
+  EXPECT_TRUE(
+      CPDF_PageObjectIndex::Overlaps(CFX_FloatRect(0, 0, 10, 10), rect));
+  EXPECT_TRUE(
+      CPDF_PageObjectIndex::Overlaps(CFX_FloatRect(0, 0, 30, 30), rect));
+  EXPECT_FALSE(
+      CPDF_PageObjectIndex::Overlaps(CFX_FloatRect(0, 0, 5, 30), rect));
+  EXPECT_FALSE(
+      CPDF_PageObjectIndex::Overlaps(CFX_FloatRect(21, 0, 30, 30), rect));
+}
+
+TEST(CPDFPageObjectIndex, KeepsZOrder) {
+  // A page-sized background, then a row of small boxes on top.
+  std::vector<CFX_FloatRect> rects = {CFX_FloatRect(0, 0, 1000, 1000)};
+  for (int i = 0; i < 100; ++i) {
+    rects.emplace_back(i * 10, 0, i * 10 + 5, 5);
+  }
+  CPDF_PageObjectIndex index(rects);
+  EXPECT_THAT(index.GetObjectsInRect(CFX_FloatRect(201, 1, 204, 4)),
+              ElementsAre(0, 21));
+  EXPECT_THAT(index.GetObjectsInRect(CFX_FloatRect(206, 1, 209, 4)),
+              ElementsAre(0));
+  EXPECT_THAT(index.GetObjectsInRect(CFX_FloatRect(2000, 0, 3000, 10)),
+              IsEmpty());
+}
+
+TEST(CPDFPageObjectIndex, MatchesTestingEachObject) {
+  constexpr float kNan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<CFX_FloatRect> rects;
+  for (int y = 0; y < 50; ++y) {
+    for (int x = 0; x < 50; ++x) {
+      rects.emplace_back(x * 20, y * 20, x * 20 + 25, y * 20 + 15);
+    }
+  }
+  rects.emplace_back(0, 0, 1000, 1000);
+  rects.emplace_back(500, 500, 500, 500);
+  rects.emplace_back(600, 600, 590, 610);
+  rects.emplace_back(kNan, 0, 10, 10);
+  CPDF_PageObjectIndex index(rects);
+
+  const CFX_FloatRect kQueries[] = {
+      CFX_FloatRect(0, 0, 1, 1),
+      CFX_FloatRect(490, 490, 510, 510),
+      CFX_FloatRect(595, 595, 596, 596),
+      CFX_FloatRect(-50, -50, -10, -10),
+      CFX_FloatRect(-10, -10, 2000, 2000),
+      CFX_FloatRect(999, 0, 2000, 10),
+      CFX_FloatRect(20, 20, 20, 20),
+  };
+  for (const CFX_FloatRect& query : kQueries) {
+    EXPECT_EQ(GetObjectsInRectSlowly(rects, query),
+              index.GetObjectsInRect(query));
+  }
+}
@@ -183,6 +183,25 @@ bool CPDF_TextObject::IsText() const {
   return true;
 }
 
+CFX_FloatRect CPDF_TextObject::GetDrawnRect() const {
+  CFX_FloatRect rect = GetRect();
+  if (!TextRenderingModeIsStrokeMode(GetTextRenderMode())) {
+    return rect;
+  }
+
+  // The rect only covers the glyph outlines. Strokes reach half the line width
+  // past them, and miter joins up to the miter limit times that at corners.
+  float reach = graph_state().GetLineWidth() / 2;
+  if (graph_state().GetLineJoin() == CFX_GraphStateData::LineJoin::kMiter) {
+    reach *= std::max(graph_state().GetMiterLimit(), 1.0f);
+  }
+  pdfium::span<const float> ctm = text_state().GetCTM();
+  const CFX_Matrix line_matrix(ctm[0], ctm[1], ctm[2], ctm[3], 0, 0);
+  reach *= std::max(line_matrix.GetXUnit(), line_matrix.GetYUnit());
+  rect.Inflate(reach, reach);
+  return rect;
+}
+
 CPDF_TextObject* CPDF_TextObject::AsText() {
   return this;
 }
@@ -267,6 +286,8 @@ TextRenderingMode CPDF_TextObject::GetTextRenderMode() const {
 }
 
 void CPDF_TextObject::SetTextRenderMode(TextRenderingMode mode) {
+  // Dropping the stroke shrinks GetDrawnRect().
+  InvalidateDrawnRect();
   mutable_text_state().SetTextMode(mode);
   SetDirty(true);
 }
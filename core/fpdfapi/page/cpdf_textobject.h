@@ -40,6 +40,7 @@ class CPDF_TextObject final : public CPDF_PageObject {
   bool IsText() const override;
   CPDF_TextObject* AsText() override;
   const CPDF_TextObject* AsText() const override;
+  CFX_FloatRect GetDrawnRect() const override;
 
   std::unique_ptr<CPDF_TextObject> Clone() const;
 
@@ -0,0 +1,323 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/fdrm/fx_crypt_sha.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/binary_buffer.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/ptr_util.h"
+
+using ObjectType = CPDF_CrossRefTable::ObjectType;
+using ObjectInfo = CPDF_CrossRefTable::ObjectInfo;
+
+namespace {
+
+constexpr std::array<uint8_t, 8> kMagic = {'P', 'D', 'F', 'X', 'R', 'I', 'D',
+                                           'X'};
+// Version 1 digests covered the start and the end of the file, and version 2
+// digests the whole file.
+constexpr uint32_t kVersion = 3;
+
+constexpr uint8_t kFlagXRefStream = 1 << 0;
+constexpr uint8_t kFlagXRefTableRebuilt = 1 << 1;
+
+constexpr uint8_t kObjectStreamFlag = 1 << 2;
+constexpr uint8_t kObjectTypeMask = 0x3;
+
+// Writes unsigned integers in LEB128 form, so small values and the deltas
+// between sorted object numbers take few bytes.
+class IndexWriter {
+ public:
+  void WriteBytes(pdfium::span<const uint8_t> bytes) {
+    buffer_.AppendSpan(bytes);
+  }
+
+  void WriteUint8(uint8_t value) { buffer_.AppendUint8(value); }
+
+  void WriteVarInt(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.AppendUint8(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    buffer_.AppendUint8(static_cast<uint8_t>(value));
+  }
+
+  DataVector<uint8_t> Detach() { return buffer_.DetachBuffer(); }
+
+ private:
+  fxcrt::BinaryBuffer buffer_;
+};
+
+// Reads what IndexWriter writes. Any read past the end of the data, or of an
+// out of range value, makes the reader fail, and all later reads fail too.
+class IndexReader {
+ public:
+  explicit IndexReader(pdfium::span<const uint8_t> data) : data_(data) {}
+
+  bool failed() const { return failed_; }
+  size_t remaining() const { return data_.size(); }
+
+  pdfium::span<const uint8_t> ReadBytes(size_t size) {
+    if (failed_ || size > data_.size()) {
+      failed_ = true;
+      return {};
+    }
+    pdfium::span<const uint8_t> result = data_.first(size);
+    data_ = data_.subspan(size);
+    return result;
+  }
+
+  uint8_t ReadUint8() {
+    pdfium::span<const uint8_t> bytes = ReadBytes(1);
+    return bytes.empty() ? 0 : bytes[0];
+  }
+
+  uint64_t ReadVarInt() {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = ReadUint8();
+      if (failed_) {
+        return 0;
+      }
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return result;
+      }
+    }
+    failed_ = true;
+    return 0;
+  }
+
+  // Reads a value that must be at most `max_value`.
+  uint64_t ReadVarIntUpTo(uint64_t max_value) {
+    const uint64_t result = ReadVarInt();
+    if (result > max_value) {
+      failed_ = true;
+      return 0;
+    }
+    return result;
+  }
+
+ private:
+  pdfium::span<const uint8_t> data_;
+  bool failed_ = false;
+};
+
+constexpr uint64_t kMaxFileSize = std::numeric_limits<FX_FILESIZE>::max();
+
+}  // namespace
+
+CPDF_CrossRefIndex::ObjectStreamInfo::ObjectStreamInfo() = default;
+
+CPDF_CrossRefIndex::ObjectStreamInfo::ObjectStreamInfo(
+    uint32_t obj_num,
+    std::vector<CPDF_ObjectStream::ObjectInfo> object_info)
+    : obj_num(obj_num), object_info(std::move(object_info)) {}
+
+CPDF_CrossRefIndex::ObjectStreamInfo::ObjectStreamInfo(
+    ObjectStreamInfo&& that) noexcept = default;
+
+CPDF_CrossRefIndex::ObjectStreamInfo&
+CPDF_CrossRefIndex::ObjectStreamInfo::operator=(
+    ObjectStreamInfo&& that) noexcept = default;
+
+CPDF_CrossRefIndex::ObjectStreamInfo::~ObjectStreamInfo() = default;
+
+// static
+std::optional<CPDF_CrossRefIndex::Digest>
+CPDF_CrossRefIndex::ComputeFileDigest(IFX_SeekableReadStream* file) {
+  const FX_FILESIZE file_size = file->GetSize();
+  if (file_size < 0) {
+    return std::nullopt;
+  }
+
+  DataVector<uint8_t> tail(static_cast<size_t>(
+      std::min<FX_FILESIZE>(file_size, kDigestTailSize)));
+  if (!file->ReadBlockAtOffset(
+          tail, file_size - static_cast<FX_FILESIZE>(tail.size()))) {
+    return std::nullopt;
+  }
+
+  CRYPT_sha2_context context;
+  CRYPT_SHA256Start(&context);
+  const uint64_t size_for_digest = static_cast<uint64_t>(file_size);
+  CRYPT_SHA256Update(&context,
+                     pdfium::as_bytes(pdfium::span_from_ref(size_for_digest)));
+  CRYPT_SHA256Update(&context, tail);
+
+  Digest digest;
+  CRYPT_SHA256Finish(&context, digest);
+  return digest;
+}
+
+// static
+std::unique_ptr<CPDF_CrossRefIndex> CPDF_CrossRefIndex::Parse(
+    pdfium::span<const uint8_t> data) {
+  IndexReader reader(data);
+  if (!std::ranges::equal(reader.ReadBytes(kMagic.size()), kMagic) ||
+      reader.ReadVarInt() != kVersion) {
+    return nullptr;
+  }
+
+  auto index = std::make_unique<CPDF_CrossRefIndex>();
+  index->file_size =
+      static_cast<FX_FILESIZE>(reader.ReadVarIntUpTo(kMaxFileSize));
+  pdfium::span<const uint8_t> digest = reader.ReadBytes(kDigestSize);
+  if (reader.failed()) {
+    return nullptr;
+  }
+  std::ranges::copy(digest, index->file_digest.begin());
+
+  index->last_xref_offset =
+      static_cast<FX_FILESIZE>(reader.ReadVarIntUpTo(kMaxFileSize));
+  const uint8_t flags = reader.ReadUint8();
+  index->xref_stream = !!(flags & kFlagXRefStream);
+  index->xref_table_rebuilt = !!(flags & kFlagXRefTableRebuilt);
+  index->trailer_object_number =
+      reader.ReadVarIntUpTo(CPDF_Parser::kMaxObjectNumber);
+  const size_t trailer_size = reader.ReadVarIntUpTo(reader.remaining());
+  index->trailer = ByteString(ByteStringView(reader.ReadBytes(trailer_size)));
+
+  // Every object takes at least 3 bytes, which bounds the count.
+  const size_t object_count = reader.ReadVarIntUpTo(reader.remaining() / 3);
+  if (reader.failed()) {
+    return nullptr;
+  }
+  index->objects.reserve(object_count);
+  uint64_t obj_num = 0;
+  for (size_t i = 0; i < object_count; ++i) {
+    // Object numbers are stored as the delta to the previous one, minus 1.
+    // They can go past CPDF_Parser::kMaxObjectNumber, as the table keeps
+    // placeholders for bogus /Size values.
+    obj_num += reader.ReadVarIntUpTo(std::numeric_limits<uint32_t>::max()) +
+               (i ? 1 : 0);
+    const uint8_t type_and_flags = reader.ReadUint8();
+    ObjectInfo info;
+    info.is_object_stream_flag = !!(type_and_flags & kObjectStreamFlag);
+    info.gennum = static_cast<uint16_t>(
+        reader.ReadVarIntUpTo(std::numeric_limits<uint16_t>::max()));
+    switch (type_and_flags & kObjectTypeMask) {
+      case static_cast<uint8_t>(ObjectType::kFree):
+        info.type = ObjectType::kFree;
+        break;
+      case static_cast<uint8_t>(ObjectType::kNormal):
+        info.type = ObjectType::kNormal;
+        info.pos =
+            static_cast<FX_FILESIZE>(reader.ReadVarIntUpTo(kMaxFileSize));
+        break;
+      case static_cast<uint8_t>(ObjectType::kCompressed):
+        info.type = ObjectType::kCompressed;
+        info.archive.obj_num =
+            reader.ReadVarIntUpTo(CPDF_Parser::kMaxObjectNumber - 1);
+        info.archive.obj_index =
+            reader.ReadVarIntUpTo(std::numeric_limits<uint32_t>::max());
+        break;
+      default:
+        return nullptr;
+    }
+    if (reader.failed() || obj_num > std::numeric_limits<uint32_t>::max()) {
+      return nullptr;
+    }
+    index->objects.emplace_back(static_cast<uint32_t>(obj_num), info);
+  }
+
+  // Every object stream takes at least 2 bytes, and every object in it at
+  // least 2 more.
+  const size_t object_stream_count =
+      reader.ReadVarIntUpTo(reader.remaining() / 2);
+  if (reader.failed()) {
+    return nullptr;
+  }
+  index->object_streams.reserve(object_stream_count);
+  for (size_t i = 0; i < object_stream_count; ++i) {
+    const uint32_t stream_obj_num =
+        reader.ReadVarIntUpTo(CPDF_Parser::kMaxObjectNumber - 1);
+    const size_t count = reader.ReadVarIntUpTo(reader.remaining() / 2);
+    std::vector<CPDF_ObjectStream::ObjectInfo> object_info;
+    object_info.reserve(count);
+    for (size_t j = 0; j < count; ++j) {
+      const uint32_t object_obj_num =
+          reader.ReadVarIntUpTo(std::numeric_limits<uint32_t>::max());
+      const uint32_t object_offset =
+          reader.ReadVarIntUpTo(std::numeric_limits<uint32_t>::max());
+      object_info.emplace_back(object_obj_num, object_offset);
+    }
+    // Sorted by object number, so lookups can do a binary search.
+    if (reader.failed() || (!index->object_streams.empty() &&
+                            stream_obj_num <=
+                                index->object_streams.back().obj_num)) {
+      return nullptr;
+    }
+    index->object_streams.emplace_back(stream_obj_num, std::move(object_info));
+  }
+
+  if (reader.failed() || reader.remaining()) {
+    return nullptr;
+  }
+  return index;
+}
+
+CPDF_CrossRefIndex::CPDF_CrossRefIndex() = default;
+
+CPDF_CrossRefIndex::~CPDF_CrossRefIndex() = default;
+
+DataVector<uint8_t> CPDF_CrossRefIndex::Serialize() const {
+  IndexWriter writer;
+  writer.WriteBytes(kMagic);
+  writer.WriteVarInt(kVersion);
+  writer.WriteVarInt(file_size);
+  writer.WriteBytes(file_digest);
+  writer.WriteVarInt(last_xref_offset);
+  uint8_t flags = 0;
+  if (xref_stream) {
+    flags |= kFlagXRefStream;
+  }
+  if (xref_table_rebuilt) {
+    flags |= kFlagXRefTableRebuilt;
+  }
+  writer.WriteUint8(flags);
+  writer.WriteVarInt(trailer_object_number);
+  writer.WriteVarInt(trailer.GetLength());
+  writer.WriteBytes(trailer.unsigned_span());
+
+  writer.WriteVarInt(objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto& [obj_num, info] = objects[i];
+    writer.WriteVarInt(i ? obj_num - objects[i - 1].first - 1 : obj_num);
+    uint8_t type_and_flags = static_cast<uint8_t>(info.type);
+    if (info.is_object_stream_flag) {
+      type_and_flags |= kObjectStreamFlag;
+    }
+    writer.WriteUint8(type_and_flags);
+    writer.WriteVarInt(info.gennum);
+    switch (info.type) {
+      case ObjectType::kFree:
+        break;
+      case ObjectType::kNormal:
+        writer.WriteVarInt(std::max<FX_FILESIZE>(info.pos, 0));
+        break;
+      case ObjectType::kCompressed:
+        writer.WriteVarInt(info.archive.obj_num);
+        writer.WriteVarInt(info.archive.obj_index);
+        break;
+    }
+  }
+
+  writer.WriteVarInt(object_streams.size());
+  for (const ObjectStreamInfo& object_stream : object_streams) {
+    writer.WriteVarInt(object_stream.obj_num);
+    writer.WriteVarInt(object_stream.object_info.size());
+    for (const CPDF_ObjectStream::ObjectInfo& info :
+         object_stream.object_info) {
+      writer.WriteVarInt(info.obj_num);
+      writer.WriteVarInt(info.obj_offset);
+    }
+  }
+  return writer.Detach();
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
+#define CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/span.h"
+
+class IFX_SeekableReadStream;
+
+// Compact binary form of the cross reference data that CPDF_Parser loads for
+// a file: the resolved cross reference table, the trailer, and the object
+// numbers and offsets inside the object streams parsed so far. Lets later
+// opens of the same file skip parsing, or rebuilding, the cross reference data.
+//
+// An index is tied to its file by the file size and a digest of the end of the
+// file, where the newest trailer and the startxref offset are. That catches
+// saving a different file, and appending an incremental update, without
+// reading the whole file. CPDF_Parser checks the object header at each offset
+// when it uses one, and reads the cross reference data from the file instead
+// if the header does not match.
+struct CPDF_CrossRefIndex {
+  static constexpr size_t kDigestSize = 32;
+  static constexpr size_t kDigestTailSize = 1024;
+  using Digest = std::array<uint8_t, kDigestSize>;
+
+  struct ObjectStreamInfo {
+    ObjectStreamInfo();
+    ObjectStreamInfo(uint32_t obj_num,
+                     std::vector<CPDF_ObjectStream::ObjectInfo> object_info);
+    ObjectStreamInfo(ObjectStreamInfo&& that) noexcept;
+    ObjectStreamInfo& operator=(ObjectStreamInfo&& that) noexcept;
+    ~ObjectStreamInfo();
+
+    uint32_t obj_num = 0;
+    std::vector<CPDF_ObjectStream::ObjectInfo> object_info;
+  };
+
+  // Returns the digest to store in `file_digest` for `file`, which covers its
+  // size and last kDigestTailSize bytes, or std::nullopt if `file` cannot be
+  // read.
+  static std::optional<Digest> ComputeFileDigest(IFX_SeekableReadStream* file);
+
+  // Returns nullptr if `data` is not a well-formed index. Does not check if
+  // the index matches any particular file.
+  static std::unique_ptr<CPDF_CrossRefIndex> Parse(
+      pdfium::span<const uint8_t> data);
+
+  CPDF_CrossRefIndex();
+  ~CPDF_CrossRefIndex();
+
+  DataVector<uint8_t> Serialize() const;
+
+  FX_FILESIZE file_size = 0;
+  Digest file_digest = {};
+  FX_FILESIZE last_xref_offset = 0;
+  bool xref_stream = false;
+  bool xref_table_rebuilt = false;
+  uint32_t trailer_object_number = 0;
+  // The trailer dictionary, in PDF syntax.
+  ByteString trailer;
+  // Sorted by object number.
+  std::vector<std::pair<uint32_t, CPDF_CrossRefTable::ObjectInfo>> objects;
+  // Sorted by object number.
+  std::vector<ObjectStreamInfo> object_streams;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_INDEX_H_
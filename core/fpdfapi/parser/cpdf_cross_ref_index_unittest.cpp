@@ -0,0 +1,218 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ObjectType = CPDF_CrossRefTable::ObjectType;
+using ObjectInfo = CPDF_CrossRefTable::ObjectInfo;
+
+namespace {
+
+ObjectInfo NormalObject(uint16_t gennum, FX_FILESIZE pos) {
+  ObjectInfo info;
+  info.type = ObjectType::kNormal;
+  info.gennum = gennum;
+  info.pos = pos;
+  return info;
+}
+
+ObjectInfo CompressedObject(uint32_t archive_obj_num,
+                            uint32_t archive_obj_index) {
+  ObjectInfo info;
+  info.type = ObjectType::kCompressed;
+  info.archive.obj_num = archive_obj_num;
+  info.archive.obj_index = archive_obj_index;
+  return info;
+}
+
+std::unique_ptr<CPDF_CrossRefIndex> MakeIndex() {
+  auto index = std::make_unique<CPDF_CrossRefIndex>();
+  index->file_size = 123456;
+  for (size_t i = 0; i < index->file_digest.size(); ++i) {
+    index->file_digest[i] = static_cast<uint8_t>(i * 7);
+  }
+  index->last_xref_offset = 120000;
+  index->xref_stream = true;
+  index->trailer_object_number = 40;
+  index->trailer = "<</Root 1 0 R/Size 41>>";
+
+  ObjectInfo free_info;
+  free_info.gennum = 65535;
+  index->objects.emplace_back(0, free_info);
+  index->objects.emplace_back(1, NormalObject(0, 15));
+  index->objects.emplace_back(2, CompressedObject(7, 0));
+  index->objects.emplace_back(3, CompressedObject(7, 1));
+  ObjectInfo stream_info = NormalObject(2, 99999);
+  stream_info.is_object_stream_flag = true;
+  index->objects.emplace_back(7, stream_info);
+  // Placeholder for a bogus /Size value.
+  index->objects.emplace_back(CPDF_Parser::kMaxObjectNumber + 5,
+                              ObjectInfo());
+
+  index->object_streams.emplace_back(
+      7, std::vector<CPDF_ObjectStream::ObjectInfo>{{2, 0}, {3, 250}});
+  index->object_streams.emplace_back(
+      9, std::vector<CPDF_ObjectStream::ObjectInfo>());
+  return index;
+}
+
+void ExpectSameObjectInfo(const ObjectInfo& expected, const ObjectInfo& info) {
+  EXPECT_EQ(expected.type, info.type);
+  EXPECT_EQ(expected.is_object_stream_flag, info.is_object_stream_flag);
+  EXPECT_EQ(expected.gennum, info.gennum);
+  switch (expected.type) {
+    case ObjectType::kFree:
+      break;
+    case ObjectType::kNormal:
+      EXPECT_EQ(expected.pos, info.pos);
+      break;
+    case ObjectType::kCompressed:
+      EXPECT_EQ(expected.archive.obj_num, info.archive.obj_num);
+      EXPECT_EQ(expected.archive.obj_index, info.archive.obj_index);
+      break;
+  }
+}
+
+}  // namespace
+
+TEST(CPDFCrossRefIndexTest, RoundTrip) {
+  std::unique_ptr<CPDF_CrossRefIndex> expected = MakeIndex();
+  DataVector<uint8_t> data = expected->Serialize();
+  std::unique_ptr<CPDF_CrossRefIndex> index = CPDF_CrossRefIndex::Parse(data);
+  ASSERT_TRUE(index);
+
+  EXPECT_EQ(expected->file_size, index->file_size);
+  EXPECT_EQ(expected->file_digest, index->file_digest);
+  EXPECT_EQ(expected->last_xref_offset, index->last_xref_offset);
+  EXPECT_EQ(expected->xref_stream, index->xref_stream);
+  EXPECT_EQ(expected->xref_table_rebuilt, index->xref_table_rebuilt);
+  EXPECT_EQ(expected->trailer_object_number, index->trailer_object_number);
+  EXPECT_EQ(expected->trailer, index->trailer);
+
+  ASSERT_EQ(expected->objects.size(), index->objects.size());
+  for (size_t i = 0; i < expected->objects.size(); ++i) {
+    EXPECT_EQ(expected->objects[i].first, index->objects[i].first);
+    ExpectSameObjectInfo(expected->objects[i].second, index->objects[i].second);
+  }
+
+  ASSERT_EQ(2u, index->object_streams.size());
+  EXPECT_EQ(7u, index->object_streams[0].obj_num);
+  ASSERT_EQ(2u, index->object_streams[0].object_info.size());
+  EXPECT_EQ(3u, index->object_streams[0].object_info[1].obj_num);
+  EXPECT_EQ(250u, index->object_streams[0].object_info[1].obj_offset);
+  EXPECT_EQ(9u, index->object_streams[1].obj_num);
+  EXPECT_TRUE(index->object_streams[1].object_info.empty());
+
+  // Serializing again gives the same bytes.
+  EXPECT_EQ(data, index->Serialize());
+}
+
+TEST(CPDFCrossRefIndexTest, Empty) {
+  CPDF_CrossRefIndex empty;
+  std::unique_ptr<CPDF_CrossRefIndex> index =
+      CPDF_CrossRefIndex::Parse(empty.Serialize());
+  ASSERT_TRUE(index);
+  EXPECT_TRUE(index->trailer.IsEmpty());
+  EXPECT_TRUE(index->objects.empty());
+  EXPECT_TRUE(index->object_streams.empty());
+}
+
+TEST(CPDFCrossRefIndexTest, Truncated) {
+  DataVector<uint8_t> data = MakeIndex()->Serialize();
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(pdfium::span(data).first(size)))
+        << size;
+  }
+}
+
+TEST(CPDFCrossRefIndexTest, Malformed) {
+  const DataVector<uint8_t> data = MakeIndex()->Serialize();
+  {
+    // Bad magic.
+    DataVector<uint8_t> bad = data;
+    bad[0] = 'X';
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(bad));
+  }
+  {
+    // Unknown version.
+    DataVector<uint8_t> bad = data;
+    bad[8] = 4;
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(bad));
+  }
+  for (uint8_t version : {1, 2}) {
+    // Older versions, whose digests covered other parts of the file.
+    DataVector<uint8_t> bad = data;
+    bad[8] = version;
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(bad));
+  }
+  {
+    // Trailing data.
+    DataVector<uint8_t> bad = data;
+    bad.push_back(0);
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(bad));
+  }
+  {
+    // Object streams out of order.
+    std::unique_ptr<CPDF_CrossRefIndex> index = MakeIndex();
+    std::swap(index->object_streams[0], index->object_streams[1]);
+    EXPECT_FALSE(CPDF_CrossRefIndex::Parse(index->Serialize()));
+  }
+}
+
+TEST(CPDFCrossRefIndexTest, ComputeFileDigest) {
+  static const char kSmall[] = "%PDF-1.7\nsmall file";
+  auto small_stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(kSmall));
+  std::optional<CPDF_CrossRefIndex::Digest> small_digest =
+      CPDF_CrossRefIndex::ComputeFileDigest(small_stream.Get());
+  ASSERT_TRUE(small_digest.has_value());
+
+  // Same size, different contents.
+  static const char kOther[] = "%PDF-1.7\nsmall fild";
+  auto other_stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(kOther));
+  std::optional<CPDF_CrossRefIndex::Digest> other_digest =
+      CPDF_CrossRefIndex::ComputeFileDigest(other_stream.Get());
+  ASSERT_TRUE(other_digest.has_value());
+  EXPECT_NE(small_digest.value(), other_digest.value());
+
+  // Only changes to the end of a large file, where the newest trailer is,
+  // show up in the digest. CPDF_Parser checks the other offsets as it uses
+  // them.
+  std::vector<uint8_t> large(300000, ' ');
+  auto large_stream = pdfium::MakeRetain<CFX_ReadOnlySpanStream>(large);
+  std::optional<CPDF_CrossRefIndex::Digest> large_digest =
+      CPDF_CrossRefIndex::ComputeFileDigest(large_stream.Get());
+  ASSERT_TRUE(large_digest.has_value());
+  for (size_t pos :
+       {large.size() - CPDF_CrossRefIndex::kDigestTailSize, large.size() - 1}) {
+    large[pos] = 'x';
+    std::optional<CPDF_CrossRefIndex::Digest> changed_digest =
+        CPDF_CrossRefIndex::ComputeFileDigest(large_stream.Get());
+    ASSERT_TRUE(changed_digest.has_value());
+    EXPECT_NE(large_digest.value(), changed_digest.value());
+    large[pos] = ' ';
+  }
+  for (size_t pos : {size_t{0}, large.size() / 2,
+                     large.size() - CPDF_CrossRefIndex::kDigestTailSize - 1}) {
+    large[pos] = 'x';
+    EXPECT_EQ(large_digest,
+              CPDF_CrossRefIndex::ComputeFileDigest(large_stream.Get()));
+    large[pos] = ' ';
+  }
+  EXPECT_EQ(large_digest,
+            CPDF_CrossRefIndex::ComputeFileDigest(large_stream.Get()));
+}
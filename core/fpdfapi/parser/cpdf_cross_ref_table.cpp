@@ -9,7 +9,16 @@
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fxcrt/check_op.h"
-#include "core/fxcrt/containers/contains.h"
+
+static_assert(
+    CPDF_ObjectNumberMap<CPDF_CrossRefTable::ObjectInfo>::kMaxPagedKey ==
+        CPDF_Parser::kMaxObjectNumber,
+    "Object numbers from cross reference tables must be paged");
+
+// static
+bool CPDF_CrossRefTable::IsUnusedEntry(const ObjectInfo& info) {
+  return info.type == ObjectType::kFree && info.gennum == 0;
+}
 
 // static
 std::unique_ptr<CPDF_CrossRefTable> CPDF_CrossRefTable::MergeUp(
@@ -34,6 +43,14 @@ CPDF_CrossRefTable::CPDF_CrossRefTable(RetainPtr<CPDF_Dictionary> trailer,
     : trailer_(std::move(trailer)),
       trailer_object_number_(trailer_object_number) {}
 
+CPDF_CrossRefTable::CPDF_CrossRefTable(
+    RetainPtr<CPDF_Dictionary> trailer,
+    uint32_t trailer_object_number,
+    CPDF_ObjectNumberMap<ObjectInfo> objects_info)
+    : trailer_(std::move(trailer)),
+      trailer_object_number_(trailer_object_number),
+      objects_info_(std::move(objects_info)) {}
+
 CPDF_CrossRefTable::~CPDF_CrossRefTable() = default;
 
 void CPDF_CrossRefTable::AddCompressed(uint32_t obj_num,
@@ -94,8 +111,7 @@ void CPDF_CrossRefTable::SetTrailer(RetainPtr<CPDF_Dictionary> trailer,
 
 const CPDF_CrossRefTable::ObjectInfo* CPDF_CrossRefTable::GetObjectInfo(
     uint32_t obj_num) const {
-  const auto it = objects_info_.find(obj_num);
-  return it != objects_info_.end() ? &it->second : nullptr;
+  return objects_info_.Find(obj_num);
 }
 
 void CPDF_CrossRefTable::Update(
@@ -104,21 +120,56 @@ void CPDF_CrossRefTable::Update(
   UpdateTrailer(std::move(new_cross_ref->trailer_));
 }
 
+void CPDF_CrossRefTable::UpdateFromPrev(
+    std::unique_ptr<CPDF_CrossRefTable> prev_cross_ref) {
+  for (const auto& [obj_num, prev_info] : prev_cross_ref->objects_info_) {
+    ObjectInfo* info = objects_info_.Find(obj_num);
+    if (!info) {
+      objects_info_[obj_num] = prev_info;
+      continue;
+    }
+    if (!IsUnusedEntry(*info) || IsUnusedEntry(prev_info)) {
+      continue;
+    }
+    const bool is_object_stream = info->is_object_stream_flag;
+    *info = prev_info;
+    if (prev_info.type == ObjectType::kNormal) {
+      info->is_object_stream_flag |= is_object_stream;
+    }
+  }
+}
+
+void CPDF_CrossRefTable::UpdateTrailerFromPrev(
+    const CPDF_Dictionary& prev_trailer) {
+  if (!trailer_) {
+    return;
+  }
+
+  for (const auto& key : prev_trailer.GetKeys()) {
+    if (key == "Prev" || key == "XRefStm" ||
+        trailer_->KeyExist(key.AsStringView())) {
+      continue;
+    }
+    trailer_->SetFor(key,
+                     prev_trailer.GetObjectFor(key.AsStringView())->Clone());
+  }
+}
+
 void CPDF_CrossRefTable::SetObjectMapSize(uint32_t size) {
   if (size == 0) {
     objects_info_.clear();
     return;
   }
 
-  objects_info_.erase(objects_info_.lower_bound(size), objects_info_.end());
+  objects_info_.EraseFrom(size);
 
-  if (!pdfium::Contains(objects_info_, size - 1)) {
+  if (!objects_info_.Contains(size - 1)) {
     objects_info_[size - 1].pos = 0;
   }
 }
 
 void CPDF_CrossRefTable::UpdateInfo(
-    std::map<uint32_t, ObjectInfo> new_objects_info) {
+    CPDF_ObjectNumberMap<ObjectInfo> new_objects_info) {
   if (new_objects_info.empty()) {
     return;
   }
@@ -128,28 +179,18 @@ void CPDF_CrossRefTable::UpdateInfo(
     return;
   }
 
-  auto cur_it = objects_info_.begin();
-  auto new_it = new_objects_info.begin();
-  while (cur_it != objects_info_.end() && new_it != new_objects_info.end()) {
-    if (cur_it->first == new_it->first) {
-      if (new_it->second.type == ObjectType::kNormal &&
-          cur_it->second.type == ObjectType::kNormal &&
-          cur_it->second.is_object_stream_flag) {
-        new_it->second.is_object_stream_flag = true;
-      }
-      ++cur_it;
-      ++new_it;
-    } else if (cur_it->first < new_it->first) {
-      new_objects_info.insert(new_it, *cur_it);
-      ++cur_it;
-    } else {
-      new_it = new_objects_info.lower_bound(cur_it->first);
+  // Entries from `new_objects_info` win, but keep track of object streams
+  // that are still referenced as such.
+  for (const auto& [obj_num, new_info] : new_objects_info) {
+    ObjectInfo& info = objects_info_[obj_num];
+    const bool keep_object_stream_flag = new_info.type == ObjectType::kNormal &&
+                                         info.type == ObjectType::kNormal &&
+                                         info.is_object_stream_flag;
+    info = new_info;
+    if (keep_object_stream_flag) {
+      info.is_object_stream_flag = true;
     }
   }
-  for (; cur_it != objects_info_.end(); ++cur_it) {
-    new_objects_info.insert(new_objects_info.end(), *cur_it);
-  }
-  objects_info_ = std::move(new_objects_info);
 }
 
 void CPDF_CrossRefTable::UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer) {
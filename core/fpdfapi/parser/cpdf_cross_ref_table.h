@@ -7,9 +7,9 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 
+#include "core/fpdfapi/parser/cpdf_object_number_map.h"
 #include "core/fxcrt/fx_types.h"
 #include "core/fxcrt/retain_ptr.h"
 
@@ -40,6 +40,12 @@ class CPDF_CrossRefTable {
     };
   };
 
+  // Whether `info` is a free entry with generation 0. Object numbers that
+  // were never used, and placeholders created by SetObjectMapSize() or for
+  // object streams, look like this. An older cross reference section may still
+  // have a real entry for them.
+  static bool IsUnusedEntry(const ObjectInfo& info);
+
   // Merge cross reference tables.  Apply top on current.
   static std::unique_ptr<CPDF_CrossRefTable> MergeUp(
       std::unique_ptr<CPDF_CrossRefTable> current,
@@ -48,6 +54,10 @@ class CPDF_CrossRefTable {
   CPDF_CrossRefTable();
   CPDF_CrossRefTable(RetainPtr<CPDF_Dictionary> trailer,
                      uint32_t trailer_object_number);
+  // Restores a table from entries that objects_info() returned earlier.
+  CPDF_CrossRefTable(RetainPtr<CPDF_Dictionary> trailer,
+                     uint32_t trailer_object_number,
+                     CPDF_ObjectNumberMap<ObjectInfo> objects_info);
   ~CPDF_CrossRefTable();
 
   void AddCompressed(uint32_t obj_num,
@@ -67,17 +77,28 @@ class CPDF_CrossRefTable {
 
   const ObjectInfo* GetObjectInfo(uint32_t obj_num) const;
 
-  const std::map<uint32_t, ObjectInfo>& objects_info() const {
+  const CPDF_ObjectNumberMap<ObjectInfo>& objects_info() const {
     return objects_info_;
   }
 
   void Update(std::unique_ptr<CPDF_CrossRefTable> new_cross_ref);
 
+  // The opposite of Update(): takes the entries from `prev_cross_ref`, which
+  // is an older cross reference section, for object numbers that only have
+  // unused entries in this table. Keeps the trailer as is.
+  void UpdateFromPrev(std::unique_ptr<CPDF_CrossRefTable> prev_cross_ref);
+
+  // Like UpdateFromPrev(), but for the trailer: copies the entries that the
+  // trailer lacks from `prev_trailer`, the trailer of an older cross reference
+  // section. /Prev and /XRefStm only describe the older section, so they are
+  // skipped.
+  void UpdateTrailerFromPrev(const CPDF_Dictionary& prev_trailer);
+
   // Objects with object number >= `size` will be removed.
   void SetObjectMapSize(uint32_t size);
 
  private:
-  void UpdateInfo(std::map<uint32_t, ObjectInfo> new_objects_info);
+  void UpdateInfo(CPDF_ObjectNumberMap<ObjectInfo> new_objects_info);
   void UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer);
 
   RetainPtr<CPDF_Dictionary> trailer_;
@@ -85,7 +106,7 @@ class CPDF_CrossRefTable {
   // inline, it has no object number. Store the stream's object number, or 0 if
   // there is none.
   uint32_t trailer_object_number_ = 0;
-  std::map<uint32_t, ObjectInfo> objects_info_;
+  CPDF_ObjectNumberMap<ObjectInfo> objects_info_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
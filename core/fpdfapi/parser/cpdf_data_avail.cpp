@@ -9,9 +9,11 @@
 #include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_cross_ref_avail.h"
+#include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_hint_tables.h"
@@ -54,6 +56,37 @@ RetainPtr<CPDF_Object> GetResourceObject(RetainPtr<CPDF_Dictionary> pDict) {
   return nullptr;
 }
 
+// Returns where the object streams in `table` are, each up to the next object
+// in the file. That includes the block the parser reads after the stream data
+// to find "endstream".
+std::vector<CPDF_ReadValidator::Extent> GetObjectStreamExtents(
+    const CPDF_CrossRefTable& table,
+    FX_FILESIZE file_size) {
+  std::vector<FX_FILESIZE> positions;
+  std::vector<FX_FILESIZE> object_stream_positions;
+  for (const auto& [obj_num, info] : table.objects_info()) {
+    if (info.type != CPDF_CrossRefTable::ObjectType::kNormal) {
+      continue;
+    }
+    positions.push_back(info.pos);
+    if (info.is_object_stream_flag) {
+      object_stream_positions.push_back(info.pos);
+    }
+  }
+  std::sort(positions.begin(), positions.end());
+
+  std::vector<CPDF_ReadValidator::Extent> extents;
+  for (FX_FILESIZE pos : object_stream_positions) {
+    auto next = std::upper_bound(positions.begin(), positions.end(), pos);
+    const FX_FILESIZE end =
+        next != positions.end()
+            ? std::min(*next + CPDF_Stream::kFileBufSize, file_size)
+            : file_size;
+    extents.push_back({pos, end - pos});
+  }
+  return extents;
+}
+
 class HintsScope {
  public:
   HintsScope(RetainPtr<CPDF_ReadValidator> validator,
@@ -208,6 +241,11 @@ bool CPDF_DataAvail::CheckAndLoadAllXref() {
     return false;
   }
 
+  // Objects in object streams get read one at a time. Let read-ahead fetch
+  // each object stream as a whole on the first read instead.
+  GetValidator()->SetExtents(
+      GetObjectStreamExtents(*parser_.cross_ref_table_, file_len_));
+
   internal_status_ = InternalStatus::kRoot;
   return true;
 }
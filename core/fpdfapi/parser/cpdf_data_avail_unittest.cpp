@@ -0,0 +1,287 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_data_avail.h"
+
+#include <stdint.h>
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
+#include "core/fpdfapi/page/test_with_page_module.h"
+#include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_read_validator.h"
+#include "core/fpdfapi/render/cpdf_docrenderdata.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_read_only_string_stream.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
+
+namespace {
+
+constexpr int kLatencyMs = 50;
+constexpr int kBytesPerMs = 1000;
+
+// Stands in for an embedder that downloads the file over a network with a
+// fixed latency and bandwidth. The segments requested during an availability
+// check are sent as one batch, and arrive together after one round trip.
+class SimulatedNetwork final : public CPDF_DataAvail::FileAvail,
+                               public CPDF_DataAvail::DownloadHints {
+ public:
+  explicit SimulatedNetwork(FX_FILESIZE file_size)
+      : available_(pdfium::checked_cast<size_t>(file_size)) {}
+  ~SimulatedNetwork() override = default;
+
+  // CPDF_DataAvail::FileAvail:
+  bool IsDataAvail(FX_FILESIZE offset, size_t size) override {
+    const size_t start = pdfium::checked_cast<size_t>(offset);
+    if (start > available_.size() || size > available_.size() - start) {
+      return false;
+    }
+    for (size_t i = start; i < start + size; ++i) {
+      if (!available_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // CPDF_DataAvail::DownloadHints:
+  void AddSegment(FX_FILESIZE offset, size_t size) override {
+    requested_.emplace_back(pdfium::checked_cast<size_t>(offset), size);
+    all_requested_.emplace_back(pdfium::checked_cast<size_t>(offset), size);
+  }
+
+  // Delivers the requested segments. Returns false if there were none.
+  bool RoundTrip() {
+    if (requested_.empty()) {
+      return false;
+    }
+    size_t transferred = 0;
+    for (const auto& [offset, size] : requested_) {
+      for (size_t i = offset; i < offset + size && i < available_.size(); ++i) {
+        if (!available_[i]) {
+          available_[i] = true;
+          ++transferred;
+        }
+      }
+    }
+    requested_.clear();
+    ++round_trips_;
+    elapsed_ms_ += kLatencyMs + static_cast<int>(transferred / kBytesPerMs);
+    return true;
+  }
+
+  int round_trips() const { return round_trips_; }
+  int elapsed_ms() const { return elapsed_ms_; }
+
+  // Every segment requested so far, as (offset, size) pairs.
+  const std::vector<std::pair<size_t, size_t>>& all_requested() const {
+    return all_requested_;
+  }
+
+ private:
+  std::vector<bool> available_;
+  std::vector<std::pair<size_t, size_t>> requested_;
+  std::vector<std::pair<size_t, size_t>> all_requested_;
+  int round_trips_ = 0;
+  int elapsed_ms_ = 0;
+};
+
+struct LoadResult {
+  int doc_round_trips = 0;
+  std::vector<int> page_round_trips;
+  int elapsed_ms = 0;
+  CPDF_ReadValidator::DownloadStats stats;
+};
+
+// Loads `file_name` over a SimulatedNetwork, first the document and then each
+// page in order, and counts the round trips each step takes.
+LoadResult LoadProgressively(const std::string& file_name, bool read_ahead) {
+  LoadResult result;
+  const std::string file_path = PathService::GetTestFilePath(file_name);
+  EXPECT_FALSE(file_path.empty());
+  RetainPtr<IFX_SeekableReadStream> file =
+      IFX_SeekableReadStream::CreateFromFilename(file_path.c_str());
+  if (!file) {
+    ADD_FAILURE();
+    return result;
+  }
+
+  SimulatedNetwork network(file->GetSize());
+  CPDF_DataAvail data_avail(&network, file);
+  data_avail.GetValidator()->SetReadAheadEnabled(read_ahead);
+
+  CPDF_DataAvail::DocAvailStatus status = CPDF_DataAvail::kDataNotAvailable;
+  while ((status = data_avail.IsDocAvail(&network)) ==
+         CPDF_DataAvail::kDataNotAvailable) {
+    if (!network.RoundTrip()) {
+      break;
+    }
+  }
+  EXPECT_EQ(CPDF_DataAvail::kDataAvailable, status);
+  result.doc_round_trips = network.round_trips();
+
+  auto [error, document] = data_avail.ParseDocument(
+      std::make_unique<CPDF_DocRenderData>(),
+      std::make_unique<CPDF_DocPageData>(), ByteString());
+  EXPECT_EQ(CPDF_Parser::SUCCESS, error);
+  if (!document) {
+    return result;
+  }
+
+  for (int i = 0; i < document->GetPageCount(); ++i) {
+    const int round_trips_before = network.round_trips();
+    while ((status = data_avail.IsPageAvail(i, &network)) ==
+           CPDF_DataAvail::kDataNotAvailable) {
+      if (!network.RoundTrip()) {
+        break;
+      }
+    }
+    EXPECT_EQ(CPDF_DataAvail::kDataAvailable, status);
+    result.page_round_trips.push_back(network.round_trips() -
+                                      round_trips_before);
+  }
+  result.elapsed_ms = network.elapsed_ms();
+  result.stats = data_avail.GetValidator()->download_stats();
+  return result;
+}
+
+// Appends a cross reference stream entry with the field widths [1 4 2].
+void AppendCrossRefEntry(std::string& pdf,
+                         uint8_t type,
+                         uint32_t field2,
+                         uint16_t field3) {
+  pdf += static_cast<char>(type);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    pdf += static_cast<char>((field2 >> shift) & 0xff);
+  }
+  pdf += static_cast<char>(field3 >> 8);
+  pdf += static_cast<char>(field3 & 0xff);
+}
+
+int TotalRoundTrips(const LoadResult& result) {
+  int total = result.doc_round_trips;
+  for (int round_trips : result.page_round_trips) {
+    total += round_trips;
+  }
+  return total;
+}
+
+}  // namespace
+
+using DataAvailTest = TestWithPageModule;
+
+TEST_F(DataAvailTest, ReadAheadReducesRoundTrips) {
+  for (const char* file_name :
+       {"feature_linearized_loading.pdf", "linearized.pdf",
+        "annotation_stamp_with_ap.pdf"}) {
+    SCOPED_TRACE(file_name);
+    const LoadResult plain = LoadProgressively(file_name, false);
+    const LoadResult read_ahead = LoadProgressively(file_name, true);
+    ASSERT_EQ(plain.page_round_trips.size(),
+              read_ahead.page_round_trips.size());
+    ASSERT_FALSE(plain.page_round_trips.empty());
+
+    EXPECT_LT(TotalRoundTrips(read_ahead), TotalRoundTrips(plain));
+    EXPECT_LT(read_ahead.elapsed_ms, plain.elapsed_ms);
+    EXPECT_LE(read_ahead.doc_round_trips, plain.doc_round_trips);
+    for (size_t i = 0; i < plain.page_round_trips.size(); ++i) {
+      EXPECT_LE(read_ahead.page_round_trips[i], plain.page_round_trips[i]);
+    }
+
+    // Every round trip waits on at least one request.
+    EXPECT_LE(static_cast<size_t>(TotalRoundTrips(plain)),
+              plain.stats.requests);
+    EXPECT_LE(read_ahead.stats.requests, plain.stats.requests);
+    EXPECT_LT(read_ahead.stats.stalls, plain.stats.stalls);
+    EXPECT_GE(read_ahead.stats.requested_bytes,
+              read_ahead.stats.over_fetched_bytes);
+  }
+}
+
+TEST_F(DataAvailTest, ReadAheadFetchesObjectStreamsWhole) {
+  // A non-linearized file where the catalog, the page tree and the page are
+  // in object 4, an object stream that spans several blocks. It sits between
+  // two large filler objects, so no other read brings it in.
+  const std::string objects[] = {
+      "<</Type/Catalog/Pages 2 0 R>>",
+      "<</Type/Pages/Kids[3 0 R]/Count 1>>",
+      "<</Type/Page/Parent 2 0 R/MediaBox[0 0 100 100]>>",
+  };
+  std::string object_stream_header;
+  std::string object_stream_body;
+  for (size_t i = 0; i < std::size(objects); ++i) {
+    object_stream_header += std::to_string(i + 1) + " " +
+                            std::to_string(object_stream_body.size()) + " ";
+    object_stream_body += objects[i] + "\n";
+  }
+  object_stream_body += std::string(100000, ' ');
+
+  const std::string filler =
+      "<</Length 65536>>stream\n" + std::string(65536, 'x') + "\nendstream";
+  std::vector<uint32_t> positions(7);
+  std::string pdf = "%PDF-1.7\n";
+  positions[5] = pdf.size();
+  pdf += "5 0 obj\n<<>>\nendobj\n";
+  positions[6] = pdf.size();
+  pdf += "6 0 obj\n" + filler + "\nendobj\n";
+  positions[4] = pdf.size();
+  pdf += "4 0 obj\n<</Type/ObjStm/N " + std::to_string(std::size(objects)) +
+         "/First " + std::to_string(object_stream_header.size()) +
+         "/Length " +
+         std::to_string(object_stream_header.size() +
+                        object_stream_body.size()) +
+         ">>stream\n" + object_stream_header + object_stream_body +
+         "\nendstream\nendobj\n";
+  const size_t object_stream_end = pdf.size();
+  pdf += "7 0 obj\n" + filler + "\nendobj\n";
+  const size_t cross_ref_pos = pdf.size();
+  pdf += "8 0 obj\n<</Type/XRef/Size 9/W[1 4 2]/Root 1 0 R/Length 63>>stream\n";
+  AppendCrossRefEntry(pdf, 0, 0, 0xffff);
+  for (uint16_t i = 0; i < std::size(objects); ++i) {
+    AppendCrossRefEntry(pdf, 2, 4, i);
+  }
+  positions.push_back(pdfium::checked_cast<uint32_t>(object_stream_end));
+  positions.push_back(pdfium::checked_cast<uint32_t>(cross_ref_pos));
+  for (size_t i = 4; i < positions.size(); ++i) {
+    AppendCrossRefEntry(pdf, 1, positions[i], 0);
+  }
+  pdf += "\nendstream\nendobj\nstartxref\n" + std::to_string(cross_ref_pos) +
+         "\n%%EOF\n";
+
+  auto file = pdfium::MakeRetain<CFX_ReadOnlyStringStream>(
+      ByteString(ByteStringView(pdf.data(), pdf.size())));
+  SimulatedNetwork network(file->GetSize());
+  CPDF_DataAvail data_avail(&network, file);
+  data_avail.GetValidator()->SetReadAheadEnabled(true);
+
+  CPDF_DataAvail::DocAvailStatus status = CPDF_DataAvail::kDataNotAvailable;
+  while ((status = data_avail.IsDocAvail(&network)) ==
+         CPDF_DataAvail::kDataNotAvailable) {
+    if (!network.RoundTrip()) {
+      break;
+    }
+  }
+  ASSERT_EQ(CPDF_DataAvail::kDataAvailable, status);
+
+  // The object stream comes in with the first request that touches it.
+  size_t requests_in_object_stream = 0;
+  for (const auto& [offset, size] : network.all_requested()) {
+    if (offset >= object_stream_end || offset + size <= positions[4]) {
+      continue;
+    }
+    ++requests_in_object_stream;
+    EXPECT_LE(offset, positions[4]);
+    EXPECT_GE(offset + size, object_stream_end);
+  }
+  EXPECT_EQ(1u, requests_in_object_stream);
+}
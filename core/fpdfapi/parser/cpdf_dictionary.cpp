@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <algorithm>
 #include <set>
 #include <utility>
 
@@ -32,7 +33,7 @@ CPDF_Dictionary::~CPDF_Dictionary() {
   // Mark the object as deleted so that it will not be deleted again,
   // and break cyclic references.
   obj_num_ = kInvalidObjNum;
-  for (auto& it : map_) {
+  for (auto& it : entries_) {
     if (it.second->GetObjNum() == kInvalidObjNum) {
       it.second.Leak();
     }
@@ -56,23 +57,54 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     std::set<const CPDF_Object*>* pVisited) const {
   pVisited->insert(this);
   auto pCopy = pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+  pCopy->entries_.reserve(entries_.size());
   CPDF_DictionaryLocker locker(this);
   for (const auto& it : locker) {
     if (!pdfium::Contains(*pVisited, it.second.Get())) {
       std::set<const CPDF_Object*> visited(*pVisited);
       auto obj = it.second->CloneNonCyclic(bDirect, &visited);
       if (obj) {
-        pCopy->map_.insert(std::make_pair(it.first, std::move(obj)));
+        // Appending keeps the copy sorted.
+        pCopy->entries_.emplace_back(it.first, std::move(obj));
       }
     }
   }
   return pCopy;
 }
 
+size_t CPDF_Dictionary::Find(ByteStringView key) const {
+  if (entries_.size() <= kMaxLinearSearchSize) {
+    // Keys are usually interned, so a caller passing a key it got from a
+    // dictionary often matches by pointer.
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const ByteString& entry_key = entries_[i].first;
+      if (entry_key.GetLength() == key.GetLength() &&
+          (entry_key.unsigned_str() == key.unterminated_unsigned_str() ||
+           entry_key == key)) {
+        return i;
+      }
+    }
+    return entries_.size();
+  }
+
+  const size_t index = LowerBound(key);
+  if (index < entries_.size() && entries_[index].first == key) {
+    return index;
+  }
+  return entries_.size();
+}
+
+size_t CPDF_Dictionary::LowerBound(ByteStringView key) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), key,
+      [](const Entry& entry, ByteStringView k) { return entry.first < k; });
+  return it - entries_.begin();
+}
+
 const CPDF_Object* CPDF_Dictionary::GetObjectForInternal(
     ByteStringView key) const {
-  auto it = map_.find(key);
-  return it != map_.end() ? it->second.Get() : nullptr;
+  const size_t index = Find(key);
+  return index < entries_.size() ? entries_[index].second.Get() : nullptr;
 }
 
 RetainPtr<const CPDF_Object> CPDF_Dictionary::GetObjectFor(
@@ -257,7 +289,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(ByteStringView key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(ByteStringView key) const {
-  return pdfium::Contains(map_, key);
+  return Find(key) < entries_.size();
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -278,36 +310,68 @@ CPDF_Object* CPDF_Dictionary::SetForInternal(const ByteString& key,
                                              RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
   if (!pObj) {
-    map_.erase(key);
+    (void)RemoveFor(key.AsStringView());
     return nullptr;
   }
   CHECK(pObj->IsInline());
   CHECK(!pObj->IsStream());
   CPDF_Object* pRet = pObj.Get();
-  map_[MaybeIntern(key)] = std::move(pObj);
+  // Parsed and copied dictionaries mostly add keys in sorted order.
+  if (entries_.empty() || entries_.back().first < key) {
+    entries_.emplace_back(MaybeIntern(key), std::move(pObj));
+    return pRet;
+  }
+  const size_t index = LowerBound(key.AsStringView());
+  if (entries_[index].first == key) {
+    entries_[index].second = std::move(pObj);
+  } else {
+    entries_.emplace(entries_.begin() + index, MaybeIntern(key),
+                     std::move(pObj));
+  }
   return pRet;
 }
 
+void CPDF_Dictionary::SetEntries(EntryVector entries) {
+  CHECK(!IsLocked());
+  CHECK(entries_.empty());
+  std::stable_sort(
+      entries.begin(), entries.end(),
+      [](const Entry& a, const Entry& b) { return a.first < b.first; });
+  // Of the entries with the same key, keep the last one.
+  entries_.reserve(entries.size());
+  for (Entry& entry : entries) {
+    CHECK(entry.second);
+    CHECK(entry.second->IsInline());
+    CHECK(!entry.second->IsStream());
+    if (!entries_.empty() && entries_.back().first == entry.first) {
+      entries_.back().second = std::move(entry.second);
+      continue;
+    }
+    entries_.emplace_back(MaybeIntern(entry.first), std::move(entry.second));
+  }
+}
+
 void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = map_.find(key);
-  if (it == map_.end() || it->second->IsReference()) {
+  const size_t index = Find(key.AsStringView());
+  if (index == entries_.size() || entries_[index].second->IsReference()) {
     return;
   }
 
-  pHolder->AddIndirectObject(it->second);
-  it->second = it->second->MakeReference(pHolder);
+  RetainPtr<CPDF_Object>& object = entries_[index].second;
+  pHolder->AddIndirectObject(object);
+  object = object->MakeReference(pHolder);
 }
 
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
   CHECK(!IsLocked());
   RetainPtr<CPDF_Object> result;
-  auto it = map_.find(key);
-  if (it != map_.end()) {
-    result = std::move(it->second);
-    map_.erase(it);
+  const size_t index = Find(key);
+  if (index < entries_.size()) {
+    result = std::move(entries_[index].second);
+    entries_.erase(entries_.begin() + index);
   }
   return result;
 }
@@ -315,18 +379,14 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(ByteStringView key) {
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = map_.find(oldkey);
-  if (old_it == map_.end()) {
-    return;
-  }
-
-  auto new_it = map_.find(newkey);
-  if (new_it == old_it) {
+  const size_t old_index = Find(oldkey.AsStringView());
+  if (old_index == entries_.size() || oldkey == newkey) {
     return;
   }
 
-  map_[MaybeIntern(newkey)] = std::move(old_it->second);
-  map_.erase(old_it);
+  RetainPtr<CPDF_Object> object = std::move(entries_[old_index].second);
+  entries_.erase(entries_.begin() + old_index);
+  SetForInternal(newkey, std::move(object));
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
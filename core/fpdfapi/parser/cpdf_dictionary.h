@@ -7,8 +7,8 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <functional>
-#include <map>
+#include <stddef.h>
+
 #include <set>
 #include <type_traits>
 #include <utility>
@@ -28,8 +28,11 @@ class CPDF_IndirectObjectHolder;
 // will return nullptr to indicate non-existent keys.
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using DictMap = std::map<ByteString, RetainPtr<CPDF_Object>, std::less<>>;
-  using const_iterator = DictMap::const_iterator;
+  // Entries sorted by key. Most dictionaries have only a handful of keys, and
+  // a flat vector needs fewer allocations and is faster to search than a map.
+  using Entry = std::pair<ByteString, RetainPtr<CPDF_Object>>;
+  using EntryVector = std::vector<Entry>;
+  using const_iterator = EntryVector::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
 
@@ -42,7 +45,7 @@ class CPDF_Dictionary final : public CPDF_Object {
 
   bool IsLocked() const { return !!lock_count_; }
 
-  size_t size() const { return map_.size(); }
+  size_t size() const { return entries_.size(); }
   RetainPtr<const CPDF_Object> GetObjectFor(ByteStringView key) const;
   RetainPtr<CPDF_Object> GetMutableObjectFor(ByteStringView key);
 
@@ -83,7 +86,7 @@ class CPDF_Dictionary final : public CPDF_Object {
   std::vector<ByteString> GetKeys() const;
 
   // Creates a new object owned by the dictionary and returns an unowned
-  // pointer to it. Invalidates iterators for the element with the key |key|.
+  // pointer to it. Invalidates iterators.
   // Prefer using these templates over calls to SetFor(), since by creating
   // a new object with no previous references, they ensure cycles can not be
   // introduced.
@@ -103,9 +106,9 @@ class CPDF_Dictionary final : public CPDF_Object {
         key, pdfium::MakeRetain<T>(pool_, std::forward<Args>(args)...))));
   }
 
-  // If `object` is null, then `key` is erased from the map. Otherwise, takes
-  // ownership of `object` and stores in in the map. Invalidates iterators for
-  // the element with the key `key`.
+  // If `object` is null, then `key` is erased from the dictionary. Otherwise,
+  // takes ownership of `object` and stores it in the dictionary. Invalidates
+  // iterators.
   void SetFor(const ByteString& key, RetainPtr<CPDF_Object> object);
   // A stream must be indirect and added as a `CPDF_Reference` instead.
   void SetFor(const ByteString& key, RetainPtr<CPDF_Stream> stream) = delete;
@@ -127,6 +130,10 @@ class CPDF_Dictionary final : public CPDF_Object {
 
  private:
   friend class CPDF_DictionaryLocker;
+  friend class CPDF_SyntaxParser;
+
+  // Dictionaries up to this size are searched linearly.
+  static constexpr size_t kMaxLinearSearchSize = 8;
 
   CPDF_Dictionary();
   explicit CPDF_Dictionary(const WeakPtr<ByteStringPool>& pPool);
@@ -142,6 +149,13 @@ class CPDF_Dictionary final : public CPDF_Object {
   const CPDF_String* GetStringForInternal(ByteStringView key) const;
   CPDF_Object* SetForInternal(const ByteString& key,
                               RetainPtr<CPDF_Object> pObj);
+  // Like calling SetFor() for each of `entries` in order, but sorts them all
+  // at once. For the parser, which does not know how many keys follow.
+  void SetEntries(EntryVector entries);
+  // Returns the position of `key`, or `entries_.size()` if it is not there.
+  size_t Find(ByteStringView key) const;
+  // Returns the position of the first entry not less than `key`.
+  size_t LowerBound(ByteStringView key) const;
 
   ByteString MaybeIntern(const ByteString& str);
   const CPDF_Dictionary* GetDictInternal() const override;
@@ -151,7 +165,7 @@ class CPDF_Dictionary final : public CPDF_Object {
 
   mutable uint32_t lock_count_ = 0;
   WeakPtr<ByteStringPool> pool_;
-  DictMap map_;
+  EntryVector entries_;
 };
 
 class CPDF_DictionaryLocker {
@@ -166,11 +180,11 @@ class CPDF_DictionaryLocker {
 
   const_iterator begin() const {
     CHECK(dictionary_->IsLocked());
-    return dictionary_->map_.begin();
+    return dictionary_->entries_.begin();
   }
   const_iterator end() const {
     CHECK(dictionary_->IsLocked());
-    return dictionary_->map_.end();
+    return dictionary_->entries_.end();
   }
 
  private:
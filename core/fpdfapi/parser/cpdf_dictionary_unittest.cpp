@@ -4,12 +4,21 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/span.h"
+#include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+
 TEST(DictionaryTest, Iterators) {
   auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
   dict->SetNewFor<CPDF_Dictionary>("the-dictionary");
@@ -35,3 +44,90 @@ TEST(DictionaryTest, Iterators) {
   ++it;
   EXPECT_EQ(it, locked_dict.end());
 }
+
+TEST(DictionaryTest, KeysStaySorted) {
+  // Enough keys to go past the linear search, added out of order.
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  std::vector<ByteString> expected_keys;
+  for (int i = 0; i < 40; ++i) {
+    const int value = (i * 17) % 40;
+    dict->SetNewFor<CPDF_Number>(ByteString::Format("Key%02d", value), value);
+    expected_keys.push_back(ByteString::Format("Key%02d", i));
+  }
+  EXPECT_EQ(40u, dict->size());
+  EXPECT_THAT(dict->GetKeys(), ElementsAreArray(expected_keys));
+  for (int i = 0; i < 40; ++i) {
+    EXPECT_EQ(i, dict->GetIntegerFor(expected_keys[i].AsStringView()));
+  }
+  EXPECT_FALSE(dict->KeyExist("Key"));
+  EXPECT_FALSE(dict->KeyExist("Key40"));
+  EXPECT_FALSE(dict->KeyExist("Key000"));
+
+  // Replacing a value keeps the key in place.
+  dict->SetNewFor<CPDF_Number>("Key07", 70);
+  EXPECT_EQ(40u, dict->size());
+  EXPECT_EQ(70, dict->GetIntegerFor("Key07"));
+
+  RetainPtr<CPDF_Object> removed = dict->RemoveFor("Key20");
+  ASSERT_TRUE(removed);
+  EXPECT_EQ(20, removed->GetInteger());
+  EXPECT_FALSE(dict->KeyExist("Key20"));
+  EXPECT_FALSE(dict->RemoveFor("Key20"));
+
+  dict->SetFor("Key21", RetainPtr<CPDF_Object>());
+  EXPECT_FALSE(dict->KeyExist("Key21"));
+  EXPECT_EQ(38u, dict->size());
+
+  dict->ReplaceKey("Key00", "Key99");
+  EXPECT_FALSE(dict->KeyExist("Key00"));
+  EXPECT_EQ(0, dict->GetIntegerFor("Key99"));
+  EXPECT_EQ("Key99", dict->GetKeys().back());
+
+  // Replacing onto an existing key overwrites its value.
+  dict->ReplaceKey("Key01", "Key02");
+  EXPECT_FALSE(dict->KeyExist("Key01"));
+  EXPECT_EQ(1, dict->GetIntegerFor("Key02"));
+  EXPECT_EQ(37u, dict->size());
+}
+
+TEST(DictionaryTest, LookupByKeyFromDictionary) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Number>("A", 1);
+  dict->SetNewFor<CPDF_Number>("B", 2);
+  for (const ByteString& key : dict->GetKeys()) {
+    EXPECT_TRUE(dict->GetNumberFor(key.AsStringView()));
+  }
+  // Keys that are equal but stored elsewhere match too.
+  const std::string key = "B";
+  EXPECT_EQ(2, dict->GetIntegerFor(ByteStringView(key.c_str())));
+}
+
+TEST(DictionaryTest, ParsedDuplicateKeys) {
+  static const char kData[] = "<< /Z 1 /B 2 /A 3 /B 4 /Z 5 /B 6 >>";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      ByteStringView(kData).unsigned_span()));
+  RetainPtr<CPDF_Dictionary> dict = ToDictionary(parser.GetObjectBody(nullptr));
+  ASSERT_TRUE(dict);
+
+  // The last value of a key wins, like SetFor() in file order.
+  EXPECT_THAT(dict->GetKeys(), ElementsAre("A", "B", "Z"));
+  EXPECT_EQ(3, dict->GetIntegerFor("A"));
+  EXPECT_EQ(6, dict->GetIntegerFor("B"));
+  EXPECT_EQ(5, dict->GetIntegerFor("Z"));
+
+  // Adding keys after parsing works as usual.
+  dict->SetNewFor<CPDF_Number>("C", 7);
+  EXPECT_THAT(dict->GetKeys(), ElementsAre("A", "B", "C", "Z"));
+}
+
+TEST(DictionaryTest, CloneKeepsOrder) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  for (const char* key : {"Type", "Subtype", "Rect", "Border", "F", "P"}) {
+    dict->SetNewFor<CPDF_Number>(key, 1);
+  }
+  RetainPtr<CPDF_Dictionary> clone = ToDictionary(dict->Clone());
+  ASSERT_TRUE(clone);
+  EXPECT_EQ(dict->GetKeys(), clone->GetKeys());
+  clone->SetNewFor<CPDF_Number>("A", 2);
+  EXPECT_EQ("A", clone->GetKeys().front());
+}
@@ -214,13 +214,26 @@ bool CPDF_Document::TryInit() {
 
 CPDF_Parser::Error CPDF_Document::LoadDoc(
     RetainPtr<IFX_SeekableReadStream> pFileAccess,
-    const ByteString& password) {
+    const ByteString& password,
+    uint32_t load_flags) {
   if (!parser_) {
     SetParser(std::make_unique<CPDF_Parser>(this));
   }
 
   return HandleLoadResult(
-      parser_->StartParse(std::move(pFileAccess), password));
+      parser_->StartParse(std::move(pFileAccess), password, load_flags));
+}
+
+CPDF_Parser::Error CPDF_Document::LoadDocWithCrossRefIndex(
+    RetainPtr<IFX_SeekableReadStream> pFileAccess,
+    const ByteString& password,
+    pdfium::span<const uint8_t> cross_ref_index) {
+  if (!parser_) {
+    SetParser(std::make_unique<CPDF_Parser>(this));
+  }
+
+  return HandleLoadResult(parser_->StartParseWithCrossRefIndex(
+      std::move(pFileAccess), password, cross_ref_index));
 }
 
 CPDF_Parser::Error CPDF_Document::LoadLinearizedDoc(
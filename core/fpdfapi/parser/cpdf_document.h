@@ -7,6 +7,8 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DOCUMENT_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <set>
 #include <utility>
@@ -146,8 +148,15 @@ class CPDF_Document : public Observable,
   bool TryInit() override;
   RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum) override;
 
+  // `load_flags` are CPDF_Parser::StartParse() flags.
   CPDF_Parser::Error LoadDoc(RetainPtr<IFX_SeekableReadStream> pFileAccess,
-                             const ByteString& password);
+                             const ByteString& password,
+                             uint32_t load_flags);
+  // Same as LoadDoc(), but see CPDF_Parser::StartParseWithCrossRefIndex().
+  CPDF_Parser::Error LoadDocWithCrossRefIndex(
+      RetainPtr<IFX_SeekableReadStream> pFileAccess,
+      const ByteString& password,
+      pdfium::span<const uint8_t> cross_ref_index);
   CPDF_Parser::Error LoadLinearizedDoc(RetainPtr<CPDF_ReadValidator> validator,
                                        const ByteString& password);
   bool has_valid_cross_reference_table() const {
@@ -74,6 +74,7 @@ std::unique_ptr<CPDF_HintTables> CPDF_HintTables::Parse(
     return nullptr;
   }
 
+  parser->GetValidator()->SetExtents(pHintTables->GetExtents());
   return pHintTables;
 }
 
@@ -463,12 +464,11 @@ CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
     return CPDF_DataAvail::kDataError;
   }
 
-  if (!validator_->CheckDataRangeAndRequestIfUnavailable(
-          page_infos_[index].page_offset(), dwLength)) {
-    return CPDF_DataAvail::kDataNotAvailable;
-  }
+  // Request the page and all of its shared objects at once, so that they can
+  // be downloaded in a single round trip.
+  bool available = validator_->CheckDataRangeAndRequestIfUnavailable(
+      page_infos_[index].page_offset(), dwLength);
 
-  // Download data of shared objects in the page.
   for (const uint32_t dwIndex : page_infos_[index].Identifiers()) {
     if (dwIndex >= shared_obj_group_infos_.size()) {
       continue;
@@ -482,10 +482,22 @@ CPDF_DataAvail::DocAvailStatus CPDF_HintTables::CheckPage(uint32_t index) {
 
     if (!validator_->CheckDataRangeAndRequestIfUnavailable(
             shared_group_info.offset_, shared_group_info.length_)) {
-      return CPDF_DataAvail::kDataNotAvailable;
+      available = false;
     }
   }
-  return CPDF_DataAvail::kDataAvailable;
+  return available ? CPDF_DataAvail::kDataAvailable
+                   : CPDF_DataAvail::kDataNotAvailable;
+}
+
+std::vector<CPDF_ReadValidator::Extent> CPDF_HintTables::GetExtents() const {
+  std::vector<CPDF_ReadValidator::Extent> extents;
+  for (const PageInfo& page_info : page_infos_) {
+    extents.push_back({page_info.page_offset(), page_info.page_length()});
+  }
+  for (const SharedObjGroupInfo& shared_group_info : shared_obj_group_infos_) {
+    extents.push_back({shared_group_info.offset_, shared_group_info.length_});
+  }
+  return extents;
 }
 
 bool CPDF_HintTables::LoadHintStream(CPDF_Stream* pHintStream) {
@@ -11,11 +11,11 @@
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
+#include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fxcrt/unowned_ptr.h"
 
 class CFX_BitStream;
 class CPDF_LinearizedHeader;
-class CPDF_ReadValidator;
 class CPDF_Stream;
 class CPDF_SyntaxParser;
 
@@ -92,6 +92,9 @@ class CPDF_HintTables {
 
   FX_FILESIZE GetFirstPageObjOffset() const { return first_page_obj_offset_; }
 
+  // Returns the file ranges of the pages and of the shared object groups.
+  std::vector<CPDF_ReadValidator::Extent> GetExtents() const;
+
  protected:
   bool ReadPageHintTable(CFX_BitStream* hStream);
   bool ReadSharedObjHintTable(CFX_BitStream* hStream, uint32_t offset);
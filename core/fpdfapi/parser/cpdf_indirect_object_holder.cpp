@@ -42,12 +42,12 @@ RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetMutableIndirectObject(
 
 const CPDF_Object* CPDF_IndirectObjectHolder::GetIndirectObjectInternal(
     uint32_t objnum) const {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end()) {
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.Find(objnum);
+  if (!obj) {
     return nullptr;
   }
 
-  return FilterInvalidObjNum(it->second.Get());
+  return FilterInvalidObjNum(obj->Get());
 }
 
 RetainPtr<CPDF_Object> CPDF_IndirectObjectHolder::GetOrParseIndirectObject(
@@ -61,15 +61,17 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObjectInternal(
     return nullptr;
   }
 
-  // Add item anyway to prevent recursively parsing of same object.
-  auto insert_result = indirect_objs_.insert(std::make_pair(objnum, nullptr));
-  if (!insert_result.second) {
-    return const_cast<CPDF_Object*>(
-        FilterInvalidObjNum(insert_result.first->second.Get()));
+  const RetainPtr<CPDF_Object>* existing = indirect_objs_.Find(objnum);
+  if (existing) {
+    return const_cast<CPDF_Object*>(FilterInvalidObjNum(existing->Get()));
   }
+
+  // Add item anyway to prevent recursively parsing of same object. Parsing may
+  // add other objects, which can move it, so it is looked up again below.
+  indirect_objs_[objnum];
   RetainPtr<CPDF_Object> pNewObj = ParseIndirectObject(objnum);
   if (!pNewObj) {
-    indirect_objs_.erase(insert_result.first);
+    indirect_objs_.Erase(objnum);
     return nullptr;
   }
 
@@ -77,7 +79,7 @@ CPDF_Object* CPDF_IndirectObjectHolder::GetOrParseIndirectObjectInternal(
   last_obj_num_ = std::max(last_obj_num_, objnum);
 
   CPDF_Object* result = pNewObj.Get();
-  insert_result.first->second = std::move(pNewObj);
+  indirect_objs_[objnum] = std::move(pNewObj);
   return result;
 }
 
@@ -115,10 +117,10 @@ bool CPDF_IndirectObjectHolder::ReplaceIndirectObjectIfHigherGeneration(
 }
 
 void CPDF_IndirectObjectHolder::DeleteIndirectObject(uint32_t objnum) {
-  auto it = indirect_objs_.find(objnum);
-  if (it == indirect_objs_.end() || !FilterInvalidObjNum(it->second.Get())) {
+  const RetainPtr<CPDF_Object>* obj = indirect_objs_.Find(objnum);
+  if (!obj || !FilterInvalidObjNum(obj->Get())) {
     return;
   }
 
-  indirect_objs_.erase(it);
+  indirect_objs_.Erase(objnum);
 }
@@ -9,11 +9,11 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <type_traits>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fpdfapi/parser/cpdf_object_number_map.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/string_pool_template.h"
 #include "core/fxcrt/weak_ptr.h"
@@ -21,7 +21,7 @@
 class CPDF_IndirectObjectHolder {
  public:
   using const_iterator =
-      std::map<uint32_t, RetainPtr<CPDF_Object>>::const_iterator;
+      CPDF_ObjectNumberMap<RetainPtr<CPDF_Object>>::const_iterator;
 
   CPDF_IndirectObjectHolder();
   virtual ~CPDF_IndirectObjectHolder();
@@ -82,7 +82,7 @@ class CPDF_IndirectObjectHolder {
   CPDF_Object* GetOrParseIndirectObjectInternal(uint32_t objnum);
 
   uint32_t last_obj_num_ = 0;
-  std::map<uint32_t, RetainPtr<CPDF_Object>> indirect_objs_;
+  CPDF_ObjectNumberMap<RetainPtr<CPDF_Object>> indirect_objs_;
   WeakPtr<ByteStringPool> byte_string_pool_;
 };
 
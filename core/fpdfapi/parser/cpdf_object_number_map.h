@@ -0,0 +1,350 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_NUMBER_MAP_H_
+#define CORE_FPDFAPI_PARSER_CPDF_OBJECT_NUMBER_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+
+// Map keyed by PDF object number, optimized for the dense numbering found in
+// real documents. Runs of keys below `kMaxPagedKey` live in fixed-size pages
+// that are indexed directly, so lookups do not chase tree nodes, and inserting
+// N objects allocates N / `kPageSize` times instead of N times.
+//
+// A page is only allocated once enough of its keys are in use, so that
+// sparse object numbers, e.g. from a small but hostile cross reference table,
+// cannot make the map allocate far more memory than its entries need. Keys
+// that have no page live in a std::map, as do keys >= `kMaxPagedKey`, which
+// only show up as placeholders for bogus /Size values.
+//
+// Iterates in ascending key order, like std::map. References to values stay
+// valid until the key is erased, the map is cleared, or a page is allocated
+// for the key.
+template <typename T>
+class CPDF_ObjectNumberMap {
+ public:
+  static constexpr uint32_t kPageBits = 10;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  // Matches CPDF_Parser::kMaxObjectNumber.
+  static constexpr uint32_t kMaxPagedKey = 4 * 1024 * 1024;
+  // A page is allocated once this many of its keys are in use, or once the
+  // page before it is at least half full, as when objects are numbered
+  // sequentially. Either way, every page holds a fair share of entries.
+  static constexpr uint32_t kMinPageOccupancy = kPageSize / 16;
+
+  using value_type = std::pair<const uint32_t, T>;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CPDF_ObjectNumberMap::value_type;
+    using difference_type = ptrdiff_t;
+    using reference = std::pair<const uint32_t, const T&>;
+
+    class pointer {
+     public:
+      explicit pointer(reference ref) : ref_(ref) {}
+      const reference* operator->() const { return &ref_; }
+
+     private:
+      reference ref_;
+    };
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      if (AtPagedKey()) {
+        return {paged_key_, map_->pages_[paged_key_ >> kPageBits]
+                                ->values[paged_key_ & (kPageSize - 1)]};
+      }
+      return {map_it_->first, map_it_->second};
+    }
+    pointer operator->() const { return pointer(**this); }
+
+    const_iterator& operator++() {
+      if (AtPagedKey()) {
+        SeekPaged(paged_key_ + 1);
+      } else {
+        ++map_it_;
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    bool operator==(const const_iterator& that) const {
+      return map_ == that.map_ && paged_done_ == that.paged_done_ &&
+             (paged_done_ || paged_key_ == that.paged_key_) &&
+             map_it_ == that.map_it_;
+    }
+
+   private:
+    friend class CPDF_ObjectNumberMap;
+
+    const_iterator(const CPDF_ObjectNumberMap* map, uint32_t start)
+        : map_(map), map_it_(map->sparse_.lower_bound(start)) {
+      SeekPaged(start);
+    }
+
+    static const_iterator End(const CPDF_ObjectNumberMap* map) {
+      const_iterator it;
+      it.map_ = map;
+      it.map_it_ = map->sparse_.end();
+      it.paged_done_ = true;
+      return it;
+    }
+
+    // Whether the current key comes from the pages rather than `sparse_`. A
+    // key is never in both.
+    bool AtPagedKey() const {
+      return !paged_done_ &&
+             (map_it_ == map_->sparse_.end() || paged_key_ < map_it_->first);
+    }
+
+    // Moves `paged_key_` to the first paged key >= `key`.
+    void SeekPaged(uint32_t key) {
+      const size_t page_count = map_->pages_.size();
+      for (size_t page_index = key >> kPageBits; page_index < page_count;
+           ++page_index) {
+        const Page* page = map_->pages_[page_index].get();
+        if (page) {
+          for (uint32_t slot = key & (kPageSize - 1); slot < kPageSize;
+               ++slot) {
+            if (page->present[slot]) {
+              paged_key_ = static_cast<uint32_t>(page_index << kPageBits) |
+                           slot;
+              return;
+            }
+          }
+        }
+        key = static_cast<uint32_t>(page_index + 1) << kPageBits;
+      }
+      paged_done_ = true;
+      paged_key_ = 0;
+    }
+
+    const CPDF_ObjectNumberMap* map_ = nullptr;
+    typename std::map<uint32_t, T>::const_iterator map_it_;
+    uint32_t paged_key_ = 0;
+    bool paged_done_ = false;
+  };
+
+  CPDF_ObjectNumberMap() = default;
+  CPDF_ObjectNumberMap(const CPDF_ObjectNumberMap&) = delete;
+  CPDF_ObjectNumberMap& operator=(const CPDF_ObjectNumberMap&) = delete;
+  CPDF_ObjectNumberMap(CPDF_ObjectNumberMap&& that) noexcept
+      : pages_(std::move(that.pages_)),
+        sparse_(std::move(that.sparse_)),
+        size_(std::exchange(that.size_, 0)),
+        page_count_(std::exchange(that.page_count_, 0)) {}
+  CPDF_ObjectNumberMap& operator=(CPDF_ObjectNumberMap&& that) noexcept {
+    pages_ = std::move(that.pages_);
+    sparse_ = std::move(that.sparse_);
+    size_ = std::exchange(that.size_, 0);
+    page_count_ = std::exchange(that.page_count_, 0);
+    return *this;
+  }
+  ~CPDF_ObjectNumberMap() = default;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator::End(this); }
+
+  // Returns nullptr if `key` is not present.
+  T* Find(uint32_t key) {
+    return const_cast<T*>(std::as_const(*this).Find(key));
+  }
+  const T* Find(uint32_t key) const {
+    const Page* page = GetPage(key);
+    if (!page) {
+      auto it = sparse_.find(key);
+      return it != sparse_.end() ? &it->second : nullptr;
+    }
+    const uint32_t slot = key & (kPageSize - 1);
+    return page->present[slot] ? &page->values[slot] : nullptr;
+  }
+  bool Contains(uint32_t key) const { return !!Find(key); }
+
+  // Inserts a default-constructed value if `key` is not present.
+  T& operator[](uint32_t key) {
+    Page* page = GetPage(key);
+    if (!page) {
+      auto result = sparse_.try_emplace(key);
+      if (!result.second) {
+        return result.first->second;
+      }
+      ++size_;
+      if (!ShouldAllocatePage(key)) {
+        return result.first->second;
+      }
+      page = AllocatePage(key >> kPageBits);
+    }
+    const uint32_t slot = key & (kPageSize - 1);
+    if (!page->present[slot]) {
+      page->present[slot] = true;
+      ++page->count;
+      ++size_;
+    }
+    return page->values[slot];
+  }
+
+  void Erase(uint32_t key) {
+    Page* page = GetPage(key);
+    if (!page) {
+      size_ -= sparse_.erase(key);
+      return;
+    }
+    const uint32_t slot = key & (kPageSize - 1);
+    if (!page->present[slot]) {
+      return;
+    }
+    page->present[slot] = false;
+    page->values[slot] = T();
+    --page->count;
+    --size_;
+    if (!page->count) {
+      pages_[key >> kPageBits].reset();
+      --page_count_;
+    }
+  }
+
+  // Erases all keys >= `key`.
+  void EraseFrom(uint32_t key) {
+    while (!sparse_.empty() && sparse_.rbegin()->first >= key) {
+      sparse_.erase(std::prev(sparse_.end()));
+      --size_;
+    }
+    if (key >= kMaxPagedKey) {
+      return;
+    }
+    const size_t first_whole_page = (key + kPageSize - 1) >> kPageBits;
+    for (size_t i = first_whole_page; i < pages_.size(); ++i) {
+      if (pages_[i]) {
+        size_ -= pages_[i]->count;
+        --page_count_;
+      }
+    }
+    if (first_whole_page < pages_.size()) {
+      pages_.resize(first_whole_page);
+    }
+    for (uint32_t k = key; k < first_whole_page << kPageBits; ++k) {
+      Erase(k);
+    }
+  }
+
+  // Returns the largest key. Must not be called when empty.
+  uint32_t LastKey() const {
+    CHECK(!empty());
+    const uint32_t last_sparse_key =
+        sparse_.empty() ? 0 : sparse_.rbegin()->first;
+    for (size_t page_index = pages_.size(); page_index > 0; --page_index) {
+      const Page* page = pages_[page_index - 1].get();
+      if (!page) {
+        continue;
+      }
+      for (uint32_t slot = kPageSize; slot > 0; --slot) {
+        if (page->present[slot - 1]) {
+          return std::max(
+              last_sparse_key,
+              static_cast<uint32_t>((page_index - 1) << kPageBits) |
+                  (slot - 1));
+        }
+      }
+    }
+    return last_sparse_key;
+  }
+
+  void clear() {
+    pages_.clear();
+    sparse_.clear();
+    size_ = 0;
+    page_count_ = 0;
+  }
+
+  size_t GetPageCountForTesting() const { return page_count_; }
+
+ private:
+  struct Page {
+    std::array<T, kPageSize> values = {};
+    std::bitset<kPageSize> present;
+    uint32_t count = 0;
+  };
+
+  Page* GetPage(uint32_t key) const {
+    const size_t page_index = key >> kPageBits;
+    return page_index < pages_.size() ? pages_[page_index].get() : nullptr;
+  }
+
+  // Decides whether the page for `key`, which is in `sparse_`, has become
+  // worth allocating.
+  bool ShouldAllocatePage(uint32_t key) const {
+    if (key >= kMaxPagedKey) {
+      return false;
+    }
+    const size_t page_index = key >> kPageBits;
+    if (page_index > 0) {
+      const Page* previous = pages_.size() >= page_index
+                                 ? pages_[page_index - 1].get()
+                                 : nullptr;
+      if (previous && previous->count >= kPageSize / 2) {
+        return true;
+      }
+    }
+    const uint32_t first_key = static_cast<uint32_t>(page_index << kPageBits);
+    auto it = sparse_.lower_bound(first_key);
+    uint32_t count = 0;
+    while (it != sparse_.end() && it->first < first_key + kPageSize) {
+      if (++count >= kMinPageOccupancy) {
+        return true;
+      }
+      ++it;
+    }
+    return false;
+  }
+
+  // Allocates the page at `page_index` and moves its keys out of `sparse_`.
+  Page* AllocatePage(size_t page_index) {
+    if (page_index >= pages_.size()) {
+      pages_.resize(page_index + 1);
+    }
+    CHECK(!pages_[page_index]);
+    pages_[page_index] = std::make_unique<Page>();
+    ++page_count_;
+    Page* page = pages_[page_index].get();
+    const uint32_t first_key = static_cast<uint32_t>(page_index << kPageBits);
+    auto it = sparse_.lower_bound(first_key);
+    while (it != sparse_.end() && it->first < first_key + kPageSize) {
+      const uint32_t slot = it->first & (kPageSize - 1);
+      page->values[slot] = std::move(it->second);
+      page->present[slot] = true;
+      ++page->count;
+      it = sparse_.erase(it);
+    }
+    return page;
+  }
+
+  std::vector<std::unique_ptr<Page>> pages_;
+  std::map<uint32_t, T> sparse_;
+  size_t size_ = 0;
+  size_t page_count_ = 0;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_OBJECT_NUMBER_MAP_H_
@@ -0,0 +1,202 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_object_number_map.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::Pair;
+
+TEST(CPDFObjectNumberMapTest, Empty) {
+  CPDF_ObjectNumberMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.Find(0));
+  EXPECT_FALSE(map.Contains(12345));
+  EXPECT_FALSE(map.Contains(CPDF_ObjectNumberMap<int>::kMaxPagedKey + 1));
+}
+
+TEST(CPDFObjectNumberMapTest, InsertAndFind) {
+  CPDF_ObjectNumberMap<int> map;
+  map[5] = 50;
+  map[1] = 10;
+  map[4000] = 400;
+  map[CPDF_ObjectNumberMap<int>::kMaxPagedKey + 7] = 70;
+  EXPECT_FALSE(map.empty());
+  EXPECT_EQ(4u, map.size());
+
+  ASSERT_TRUE(map.Find(5));
+  EXPECT_EQ(50, *map.Find(5));
+  ASSERT_TRUE(map.Find(4000));
+  EXPECT_EQ(400, *map.Find(4000));
+  ASSERT_TRUE(map.Find(CPDF_ObjectNumberMap<int>::kMaxPagedKey + 7));
+  EXPECT_EQ(70, *map.Find(CPDF_ObjectNumberMap<int>::kMaxPagedKey + 7));
+  EXPECT_FALSE(map.Find(2));
+  EXPECT_FALSE(map.Find(3999));
+
+  // Re-inserting an existing key does not change the size.
+  map[5] = 55;
+  EXPECT_EQ(4u, map.size());
+  EXPECT_EQ(55, *map.Find(5));
+
+  // A default-constructed value still counts as present.
+  map[6];
+  EXPECT_EQ(5u, map.size());
+  ASSERT_TRUE(map.Find(6));
+  EXPECT_EQ(0, *map.Find(6));
+}
+
+TEST(CPDFObjectNumberMapTest, IteratesInKeyOrder) {
+  CPDF_ObjectNumberMap<int> map;
+  map[CPDF_ObjectNumberMap<int>::kMaxPagedKey] = 4;
+  map[2048] = 3;
+  map[1023] = 2;
+  map[0] = 1;
+  EXPECT_THAT(
+      map, ElementsAre(Pair(0, 1), Pair(1023, 2), Pair(2048, 3),
+                       Pair(CPDF_ObjectNumberMap<int>::kMaxPagedKey, 4)));
+  EXPECT_EQ(CPDF_ObjectNumberMap<int>::kMaxPagedKey, map.LastKey());
+
+  auto it = map.begin();
+  EXPECT_EQ(0u, it->first);
+  EXPECT_EQ(1, it->second);
+}
+
+TEST(CPDFObjectNumberMapTest, Erase) {
+  CPDF_ObjectNumberMap<int> map;
+  map[1] = 1;
+  map[2] = 2;
+  map[CPDF_ObjectNumberMap<int>::kMaxPagedKey + 1] = 3;
+
+  map.Erase(1);
+  map.Erase(1);
+  map.Erase(100);
+  map.Erase(CPDF_ObjectNumberMap<int>::kMaxPagedKey + 1);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_THAT(map, ElementsAre(Pair(2, 2)));
+  EXPECT_EQ(2u, map.LastKey());
+
+  // Erased slots are reset, so re-inserting gives a default value.
+  EXPECT_EQ(0, map[1]);
+}
+
+TEST(CPDFObjectNumberMapTest, EraseFrom) {
+  CPDF_ObjectNumberMap<int> map;
+  for (uint32_t i = 0; i < 3000; i += 10) {
+    map[i] = static_cast<int>(i);
+  }
+  map[CPDF_ObjectNumberMap<int>::kMaxPagedKey + 1] = -1;
+  EXPECT_EQ(301u, map.size());
+
+  map.EraseFrom(1500);
+  EXPECT_EQ(150u, map.size());
+  EXPECT_EQ(1490u, map.LastKey());
+  EXPECT_TRUE(map.Contains(1490));
+  EXPECT_FALSE(map.Contains(1500));
+  EXPECT_FALSE(map.Contains(2990));
+
+  map.EraseFrom(CPDF_ObjectNumberMap<int>::kMaxPagedKey);
+  EXPECT_EQ(150u, map.size());
+
+  map.EraseFrom(0);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(CPDFObjectNumberMapTest, Move) {
+  CPDF_ObjectNumberMap<int> map;
+  map[3] = 30;
+  map[CPDF_ObjectNumberMap<int>::kMaxPagedKey + 3] = 40;
+
+  CPDF_ObjectNumberMap<int> other = std::move(map);
+  EXPECT_EQ(2u, other.size());
+  EXPECT_THAT(other,
+              ElementsAre(Pair(3, 30),
+                          Pair(CPDF_ObjectNumberMap<int>::kMaxPagedKey + 3,
+                               40)));
+
+  other.clear();
+  EXPECT_TRUE(other.empty());
+  EXPECT_FALSE(other.Contains(3));
+}
+
+TEST(CPDFObjectNumberMapTest, DenseKeysUsePages) {
+  CPDF_ObjectNumberMap<int> map;
+  for (uint32_t i = 1; i <= 10000; ++i) {
+    map[i] = static_cast<int>(i);
+  }
+  EXPECT_EQ(10000u, map.size());
+  EXPECT_EQ(10u, map.GetPageCountForTesting());
+  EXPECT_EQ(10000u, map.LastKey());
+  uint32_t expected_key = 1;
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(expected_key, key);
+    EXPECT_EQ(static_cast<int>(key), value);
+    ++expected_key;
+  }
+  EXPECT_EQ(10001u, expected_key);
+}
+
+TEST(CPDFObjectNumberMapTest, SparseKeysDoNotUsePages) {
+  // One key per page, up to the largest paged key, as a hostile cross
+  // reference table could have.
+  CPDF_ObjectNumberMap<int> map;
+  constexpr uint32_t kStep = CPDF_ObjectNumberMap<int>::kPageSize;
+  for (uint32_t i = 0; i < CPDF_ObjectNumberMap<int>::kMaxPagedKey;
+       i += kStep) {
+    map[i] = 1;
+  }
+  EXPECT_EQ(CPDF_ObjectNumberMap<int>::kMaxPagedKey / kStep, map.size());
+  EXPECT_EQ(0u, map.GetPageCountForTesting());
+  EXPECT_TRUE(map.Contains(kStep * 7));
+  EXPECT_FALSE(map.Contains(kStep * 7 + 1));
+  EXPECT_EQ(CPDF_ObjectNumberMap<int>::kMaxPagedKey - kStep, map.LastKey());
+}
+
+TEST(CPDFObjectNumberMapTest, PageAllocatedOnceOccupied) {
+  CPDF_ObjectNumberMap<int> map;
+  map[5000] = -1;
+  map[2 * CPDF_ObjectNumberMap<int>::kPageSize] = -2;
+  for (uint32_t i = 0; i < CPDF_ObjectNumberMap<int>::kMinPageOccupancy - 1;
+       ++i) {
+    map[i * 3] = static_cast<int>(i);
+  }
+  EXPECT_EQ(0u, map.GetPageCountForTesting());
+
+  // One more key on the first page moves its keys into a page. The other keys
+  // stay where they are, and everything iterates in order.
+  const uint32_t last_key = CPDF_ObjectNumberMap<int>::kMinPageOccupancy * 3;
+  map[last_key] = 1000;
+  EXPECT_EQ(1u, map.GetPageCountForTesting());
+  EXPECT_EQ(CPDF_ObjectNumberMap<int>::kMinPageOccupancy + 2, map.size());
+  ASSERT_TRUE(map.Find(3));
+  EXPECT_EQ(1, *map.Find(3));
+  EXPECT_EQ(1000, *map.Find(last_key));
+  EXPECT_EQ(-1, *map.Find(5000));
+  EXPECT_EQ(5000u, map.LastKey());
+
+  uint32_t previous_key = 0;
+  size_t count = 0;
+  for (const auto& entry : map) {
+    if (count) {
+      EXPECT_LT(previous_key, entry.first);
+    }
+    previous_key = entry.first;
+    ++count;
+  }
+  EXPECT_EQ(map.size(), count);
+
+  // Emptying a page releases it.
+  map.EraseFrom(1);
+  map.Erase(0);
+  EXPECT_EQ(0u, map.GetPageCountForTesting());
+  EXPECT_TRUE(map.empty());
+}
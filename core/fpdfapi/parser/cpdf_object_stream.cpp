@@ -4,6 +4,10 @@
 
 #include "core/fpdfapi/parser/cpdf_object_stream.h"
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
@@ -13,11 +17,16 @@
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_stream_acc.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fpdfapi/parser/fpdf_parser_decode.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/cfx_read_only_vector_stream.h"
 #include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/ptr_util.h"
+#include "core/fxcrt/raw_span.h"
+#include "core/fxcrt/span.h"
 
 namespace {
 
@@ -51,24 +60,195 @@ bool IsObjectStream(const CPDF_Stream* stream) {
   return true;
 }
 
+// Decoding the stream data is the costly part of creating an object stream,
+// and the only part CreateInParallel() does on worker threads. Neither the
+// reference counts of objects nor those of strings are thread-safe, so a job
+// holds its own copies of everything the decoders read.
+struct DecodeJob {
+  pdfium::span<const uint8_t> src_data() const {
+    if (!shared_src_data.empty()) {
+      return shared_src_data;
+    }
+    return owned_src_data;
+  }
+
+  pdfium::raw_span<const uint8_t> shared_src_data;
+  DataVector<uint8_t> owned_src_data;
+  DecoderArray decoders;
+  std::optional<DataVector<uint8_t>> decoded_data;
+};
+
+// Returns whether the decoders can read `params` on a worker thread. Indirect
+// objects may be shared with other streams, and references would go through
+// the document.
+bool CanDecodeWithParams(const CPDF_Object* params) {
+  if (!params) {
+    return true;
+  }
+  if (!params->IsInline()) {
+    return false;
+  }
+  const CPDF_Dictionary* dict = params->AsDictionary();
+  if (!dict) {
+    return false;
+  }
+  CPDF_DictionaryLocker locker(dict);
+  for (const auto& it : locker) {
+    if (it.second->IsReference()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns std::nullopt when `stream` has to be decoded on the calling thread.
+std::optional<DecodeJob> PrepareDecodeJob(const CPDF_Stream* stream) {
+  if (!IsObjectStream(stream) || !stream->HasFilter()) {
+    return std::nullopt;
+  }
+
+  std::optional<DecoderArray> decoders = GetDecoderArray(stream->GetDict());
+  if (!decoders.has_value() || decoders.value().empty()) {
+    return std::nullopt;
+  }
+
+  DecodeJob job;
+  for (auto& [name, params] : decoders.value()) {
+    if (!CanDecodeWithParams(params.Get())) {
+      return std::nullopt;
+    }
+    // Names come from the parser's string pool and are shared.
+    name = ByteString(name.AsStringView());
+  }
+  job.decoders = std::move(decoders.value());
+
+  if (stream->IsMemoryBased()) {
+    job.shared_src_data = stream->GetInMemoryRawData();
+  } else {
+    job.shared_src_data = stream->GetSharedRawData();
+    if (job.shared_src_data.empty() && stream->GetRawSize() > 0) {
+      job.owned_src_data = stream->ReadAllRawData();
+    }
+  }
+  if (job.src_data().empty()) {
+    return std::nullopt;
+  }
+  return job;
+}
+
+// Matches what CPDF_StreamAcc::LoadAllDataFiltered() does. Leaves
+// `job->decoded_data` empty on failure, so the caller falls back to
+// CPDF_StreamAcc, which then uses the raw data.
+void Decode(DecodeJob* job) {
+  std::optional<PDFDataDecodeResult> result =
+      PDF_DataDecode(job->src_data(), /*estimated_size=*/0,
+                     /*bImageAcc=*/false, job->decoders);
+  if (result.has_value() && !result.value().data.empty()) {
+    job->decoded_data = std::move(result.value().data);
+  }
+}
+
 }  // namespace
 
+CPDF_ObjectStream::CreateParams::CreateParams(
+    RetainPtr<const CPDF_Stream> stream,
+    std::vector<ObjectInfo> object_info)
+    : stream(std::move(stream)), object_info(std::move(object_info)) {}
+
+CPDF_ObjectStream::CreateParams::CreateParams(CreateParams&& that) noexcept =
+    default;
+
+CPDF_ObjectStream::CreateParams& CPDF_ObjectStream::CreateParams::operator=(
+    CreateParams&& that) noexcept = default;
+
+CPDF_ObjectStream::CreateParams::~CreateParams() = default;
+
 //  static
 std::unique_ptr<CPDF_ObjectStream> CPDF_ObjectStream::Create(
     RetainPtr<const CPDF_Stream> stream) {
+  return CreateWithObjectInfo(std::move(stream), /*object_info=*/{});
+}
+
+//  static
+std::unique_ptr<CPDF_ObjectStream> CPDF_ObjectStream::CreateWithObjectInfo(
+    RetainPtr<const CPDF_Stream> stream,
+    std::vector<ObjectInfo> object_info) {
   if (!IsObjectStream(stream.Get())) {
     return nullptr;
   }
 
   // Protected constructor.
-  return pdfium::WrapUnique(new CPDF_ObjectStream(std::move(stream)));
+  return pdfium::WrapUnique(
+      new CPDF_ObjectStream(std::move(stream), std::move(object_info)));
 }
 
-CPDF_ObjectStream::CPDF_ObjectStream(RetainPtr<const CPDF_Stream> obj_stream)
+//  static
+std::vector<std::unique_ptr<CPDF_ObjectStream>>
+CPDF_ObjectStream::CreateInParallel(std::vector<CreateParams> params,
+                                    size_t thread_count) {
+  CHECK_GT(thread_count, 0u);
+
+  std::vector<std::optional<DecodeJob>> jobs;
+  jobs.reserve(params.size());
+  for (const CreateParams& param : params) {
+    jobs.push_back(PrepareDecodeJob(param.stream.Get()));
+  }
+
+  // Jobs vary a lot in size, so threads take the next one when they are done
+  // with the last.
+  std::atomic<size_t> next_job = 0;
+  auto run_jobs = [&jobs, &next_job] {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      if (jobs[i].has_value()) {
+        Decode(&jobs[i].value());
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(thread_count, jobs.size()); ++i) {
+    threads.emplace_back(run_jobs);
+  }
+  run_jobs();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<std::unique_ptr<CPDF_ObjectStream>> results;
+  results.reserve(params.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    CreateParams& param = params[i];
+    if (jobs[i].has_value() && jobs[i].value().decoded_data.has_value()) {
+      results.push_back(pdfium::WrapUnique(new CPDF_ObjectStream(
+          std::move(param.stream),
+          std::move(jobs[i].value().decoded_data.value()),
+          std::move(param.object_info))));
+    } else {
+      results.push_back(CreateWithObjectInfo(std::move(param.stream),
+                                             std::move(param.object_info)));
+    }
+  }
+  return results;
+}
+
+CPDF_ObjectStream::CPDF_ObjectStream(RetainPtr<const CPDF_Stream> obj_stream,
+                                     std::vector<ObjectInfo> object_info)
     : stream_acc_(pdfium::MakeRetain<CPDF_StreamAcc>(obj_stream)),
-      first_object_offset_(obj_stream->GetDict()->GetIntegerFor("First")) {
+      first_object_offset_(obj_stream->GetDict()->GetIntegerFor("First")),
+      object_info_(std::move(object_info)) {
   DCHECK(IsObjectStream(obj_stream.Get()));
-  Init(obj_stream.Get());
+  stream_acc_->LoadAllDataFiltered();
+  Init(obj_stream.Get(),
+       pdfium::MakeRetain<CFX_ReadOnlySpanStream>(stream_acc_->GetSpan()));
+}
+
+CPDF_ObjectStream::CPDF_ObjectStream(RetainPtr<const CPDF_Stream> obj_stream,
+                                     DataVector<uint8_t> decoded_data,
+                                     std::vector<ObjectInfo> object_info)
+    : first_object_offset_(obj_stream->GetDict()->GetIntegerFor("First")),
+      object_info_(std::move(object_info)) {
+  DCHECK(IsObjectStream(obj_stream.Get()));
+  Init(obj_stream.Get(), pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(
+                             std::move(decoded_data)));
 }
 
 CPDF_ObjectStream::~CPDF_ObjectStream() = default;
@@ -94,10 +274,12 @@ RetainPtr<CPDF_Object> CPDF_ObjectStream::ParseObject(
   return result;
 }
 
-void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
-  stream_acc_->LoadAllDataFiltered();
-  data_stream_ =
-      pdfium::MakeRetain<CFX_ReadOnlySpanStream>(stream_acc_->GetSpan());
+void CPDF_ObjectStream::Init(const CPDF_Stream* stream,
+                             RetainPtr<IFX_SeekableReadStream> data_stream) {
+  data_stream_ = std::move(data_stream);
+  if (!object_info_.empty()) {
+    return;
+  }
 
   CPDF_SyntaxParser syntax(data_stream_);
   const int object_count = stream->GetDict()->GetIntegerFor("N");
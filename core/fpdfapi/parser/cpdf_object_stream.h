@@ -5,10 +5,14 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 #define CORE_FPDFAPI_PARSER_CPDF_OBJECT_STREAM_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/retain_ptr.h"
 
 class CPDF_IndirectObjectHolder;
@@ -33,9 +37,34 @@ class CPDF_ObjectStream {
     uint32_t obj_offset;
   };
 
+  // The arguments to one CreateWithObjectInfo() call.
+  struct CreateParams {
+    CreateParams(RetainPtr<const CPDF_Stream> stream,
+                 std::vector<ObjectInfo> object_info);
+    CreateParams(CreateParams&& that) noexcept;
+    CreateParams& operator=(CreateParams&& that) noexcept;
+    ~CreateParams();
+
+    RetainPtr<const CPDF_Stream> stream;
+    std::vector<ObjectInfo> object_info;
+  };
+
   static std::unique_ptr<CPDF_ObjectStream> Create(
       RetainPtr<const CPDF_Stream> stream);
 
+  // Same as Create(), but uses `object_info` from an earlier Create() call for
+  // the same stream, instead of parsing it again.
+  static std::unique_ptr<CPDF_ObjectStream> CreateWithObjectInfo(
+      RetainPtr<const CPDF_Stream> stream,
+      std::vector<ObjectInfo> object_info);
+
+  // Same as calling CreateWithObjectInfo() for each entry in `params`, in
+  // order, but decodes the stream data on up to `thread_count` threads at
+  // once. The streams must not be in use elsewhere during the call.
+  static std::vector<std::unique_ptr<CPDF_ObjectStream>> CreateInParallel(
+      std::vector<CreateParams> params,
+      size_t thread_count);
+
   ~CPDF_ObjectStream();
 
   RetainPtr<CPDF_Object> ParseObject(CPDF_IndirectObjectHolder* pObjList,
@@ -44,14 +73,20 @@ class CPDF_ObjectStream {
   const std::vector<ObjectInfo>& object_info() const { return object_info_; }
 
  private:
-  explicit CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream);
+  CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream,
+                    std::vector<ObjectInfo> object_info);
+  // Takes the already decoded data of `stream` instead of decoding it.
+  CPDF_ObjectStream(RetainPtr<const CPDF_Stream> stream,
+                    DataVector<uint8_t> decoded_data,
+                    std::vector<ObjectInfo> object_info);
 
-  void Init(const CPDF_Stream* stream);
+  void Init(const CPDF_Stream* stream,
+            RetainPtr<IFX_SeekableReadStream> data_stream);
   RetainPtr<CPDF_Object> ParseObjectAtOffset(
       CPDF_IndirectObjectHolder* pObjList,
       uint32_t object_offset) const;
 
-  // Must outlive `data_stream_`.
+  // Must outlive `data_stream_`. Null when the data was decoded up front.
   RetainPtr<CPDF_StreamAcc> const stream_acc_;
   RetainPtr<IFX_SeekableReadStream> data_stream_;
   int first_object_offset_ = 0;
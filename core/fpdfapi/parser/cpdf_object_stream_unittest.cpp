@@ -5,12 +5,15 @@
 #include "core/fpdfapi/parser/cpdf_object_stream.h"
 
 #include <iterator>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
+#include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fxcrt/data_vector.h"
@@ -29,6 +32,25 @@ static_assert(kNormalStreamContent[kNormalStreamContentOffset] == '<',
 static_assert(kNormalStreamContent[kNormalStreamContentOffset + 1] == '<',
               "Wrong offset");
 
+RetainPtr<CPDF_Stream> CreateNormalStream(bool hex_encode) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+  dict->SetNewFor<CPDF_Number>("N", 3);
+  dict->SetNewFor<CPDF_Number>("First", kNormalStreamContentOffset);
+
+  ByteString contents(kNormalStreamContent);
+  if (hex_encode) {
+    dict->SetNewFor<CPDF_Name>("Filter", "ASCIIHexDecode");
+    ByteString hex_contents;
+    for (char ch : contents) {
+      hex_contents += ByteString::Format("%02x", static_cast<uint8_t>(ch));
+    }
+    contents = hex_contents + ">";
+  }
+  return pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(contents.begin(), contents.end()), dict);
+}
+
 }  // namespace
 
 TEST(ObjectStreamTest, StreamDictNormal) {
@@ -80,6 +102,79 @@ TEST(ObjectStreamTest, StreamDictNormal) {
   EXPECT_FALSE(obj_stream->ParseObject(&holder, 12, 3));
 }
 
+TEST(ObjectStreamTest, CreateWithObjectInfo) {
+  auto dict = pdfium::MakeRetain<CPDF_Dictionary>();
+  dict->SetNewFor<CPDF_Name>("Type", "ObjStm");
+  dict->SetNewFor<CPDF_Number>("N", 3);
+  dict->SetNewFor<CPDF_Number>("First", kNormalStreamContentOffset);
+
+  ByteStringView contents_view(kNormalStreamContent);
+  auto stream = pdfium::MakeRetain<CPDF_Stream>(
+      DataVector<uint8_t>(contents_view.begin(), contents_view.end()), dict);
+
+  // The given info wins over the header in the stream data.
+  auto obj_stream = CPDF_ObjectStream::CreateWithObjectInfo(
+      std::move(stream), {CPDF_ObjectStream::ObjectInfo(20, 14)});
+  ASSERT_TRUE(obj_stream);
+  EXPECT_THAT(obj_stream->object_info(),
+              ElementsAre(CPDF_ObjectStream::ObjectInfo(20, 14)));
+
+  CPDF_IndirectObjectHolder holder;
+  RetainPtr<CPDF_Object> obj20 = obj_stream->ParseObject(&holder, 20, 0);
+  ASSERT_TRUE(obj20);
+  EXPECT_EQ(20u, obj20->GetObjNum());
+  EXPECT_TRUE(obj20->IsArray());
+  EXPECT_FALSE(obj_stream->ParseObject(&holder, 10, 0));
+}
+
+TEST(ObjectStreamTest, CreateInParallel) {
+  CPDF_IndirectObjectHolder holder;
+  for (size_t thread_count : {1u, 3u}) {
+    SCOPED_TRACE(thread_count);
+    std::vector<CPDF_ObjectStream::CreateParams> params;
+    params.emplace_back(CreateNormalStream(/*hex_encode=*/true),
+                        std::vector<CPDF_ObjectStream::ObjectInfo>());
+    params.emplace_back(CreateNormalStream(/*hex_encode=*/false),
+                        std::vector<CPDF_ObjectStream::ObjectInfo>());
+    params.emplace_back(
+        CreateNormalStream(/*hex_encode=*/true),
+        std::vector<CPDF_ObjectStream::ObjectInfo>{{20, 14}});
+    // Decode parameters behind a reference get decoded on the calling thread.
+    RetainPtr<CPDF_Stream> stream = CreateNormalStream(/*hex_encode=*/true);
+    stream->GetMutableDict()->SetNewFor<CPDF_Reference>(
+        "DecodeParms", &holder,
+        holder.AddIndirectObject(pdfium::MakeRetain<CPDF_Dictionary>()));
+    params.emplace_back(std::move(stream),
+                        std::vector<CPDF_ObjectStream::ObjectInfo>());
+    stream = CreateNormalStream(/*hex_encode=*/true);
+    stream->GetMutableDict()->SetNewFor<CPDF_Name>("Type", "XObject");
+    params.emplace_back(std::move(stream),
+                        std::vector<CPDF_ObjectStream::ObjectInfo>());
+
+    std::vector<std::unique_ptr<CPDF_ObjectStream>> obj_streams =
+        CPDF_ObjectStream::CreateInParallel(std::move(params), thread_count);
+    ASSERT_EQ(5u, obj_streams.size());
+    for (size_t i : {0u, 1u, 3u}) {
+      ASSERT_TRUE(obj_streams[i]);
+      EXPECT_THAT(obj_streams[i]->object_info(),
+                  ElementsAre(CPDF_ObjectStream::ObjectInfo(10, 0),
+                              CPDF_ObjectStream::ObjectInfo(11, 14),
+                              CPDF_ObjectStream::ObjectInfo(12, 21)));
+      RetainPtr<CPDF_Object> obj11 =
+          obj_streams[i]->ParseObject(&holder, 11, 1);
+      ASSERT_TRUE(obj11);
+      EXPECT_TRUE(obj11->IsArray());
+    }
+    ASSERT_TRUE(obj_streams[2]);
+    EXPECT_THAT(obj_streams[2]->object_info(),
+                ElementsAre(CPDF_ObjectStream::ObjectInfo(20, 14)));
+    RetainPtr<CPDF_Object> obj20 = obj_streams[2]->ParseObject(&holder, 20, 0);
+    ASSERT_TRUE(obj20);
+    EXPECT_TRUE(obj20->IsArray());
+    EXPECT_FALSE(obj_streams[4]);
+  }
+}
+
 TEST(ObjectStreamTest, StreamEmptyDict) {
   ByteStringView contents_view(kNormalStreamContent);
   auto stream = pdfium::MakeRetain<CPDF_Stream>(
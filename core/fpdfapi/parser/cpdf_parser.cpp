@@ -10,10 +10,12 @@
 
 #include <algorithm>
 #include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
 #include "core/fpdfapi/parser/cpdf_crypto_handler.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
@@ -28,11 +30,13 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/containers/contains.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/notreached.h"
@@ -59,6 +63,8 @@ constexpr size_t kMinFieldCount = 3;
 // Trailers are inline.
 constexpr uint32_t kNoTrailerObjectNumber = 0;
 
+constexpr size_t kMaxObjectStreamPrefetchThreads = 8;
+
 struct CrossRefStreamIndexEntry {
   uint32_t start_obj_num;
   uint32_t obj_count;
@@ -160,6 +166,24 @@ class ObjectsHolderStub final : public CPDF_Parser::ParsedObjectsHolder {
   bool TryInit() override { return true; }
 };
 
+class ByteStringArchiveStream final : public IFX_ArchiveStream {
+ public:
+  ByteStringArchiveStream() = default;
+  ~ByteStringArchiveStream() override = default;
+
+  // IFX_ArchiveStream:
+  bool WriteBlock(pdfium::span<const uint8_t> buffer) override {
+    str_ += ByteStringView(buffer);
+    return true;
+  }
+  FX_FILESIZE CurrentOffset() const override { NOTREACHED(); }
+
+  const ByteString& str() const { return str_; }
+
+ private:
+  ByteString str_;
+};
+
 }  // namespace
 
 CPDF_Parser::CPDF_Parser(ParsedObjectsHolder* holder)
@@ -178,22 +202,44 @@ CPDF_Parser::~CPDF_Parser() = default;
 uint32_t CPDF_Parser::GetLastObjNum() const {
   return cross_ref_table_->objects_info().empty()
              ? 0
-             : cross_ref_table_->objects_info().rbegin()->first;
+             : cross_ref_table_->objects_info().LastKey();
 }
 
 bool CPDF_Parser::IsValidObjectNumber(uint32_t objnum) const {
   return objnum <= GetLastObjNum();
 }
 
-FX_FILESIZE CPDF_Parser::GetObjectPositionOrZero(uint32_t objnum) const {
-  const auto* info = cross_ref_table_->GetObjectInfo(objnum);
-  return (info && info->type == ObjectType::kNormal) ? info->pos : 0;
+FX_FILESIZE CPDF_Parser::GetObjectPositionOrZero(uint32_t objnum) {
+  const std::optional<ObjectInfo> info = GetObjectInfo(objnum);
+  return (info.has_value() && info->type == ObjectType::kNormal) ? info->pos
+                                                                  : 0;
 }
 
-bool CPDF_Parser::IsObjectFree(uint32_t objnum) const {
+bool CPDF_Parser::IsObjectFree(uint32_t objnum) {
   DCHECK(IsValidObjectNumber(objnum));
-  const auto* info = cross_ref_table_->GetObjectInfo(objnum);
-  return !info || info->type == ObjectType::kFree;
+  const std::optional<ObjectInfo> info = GetObjectInfo(objnum);
+  return !info.has_value() || info->type == ObjectType::kFree;
+}
+
+std::optional<ObjectInfo> CPDF_Parser::GetObjectInfo(uint32_t objnum) {
+  const ObjectInfo* info = cross_ref_table_->GetObjectInfo(objnum);
+  while ((!info || CPDF_CrossRefTable::IsUnusedEntry(*info)) &&
+         LoadPrevCrossRefSection()) {
+    info = cross_ref_table_->GetObjectInfo(objnum);
+  }
+  if (!info) {
+    return std::nullopt;
+  }
+  // The index only ties itself to the end of the file, so check the offsets
+  // it holds as they get used.
+  if (loaded_cross_ref_index_ && info->type == ObjectType::kNormal &&
+      info->pos > 0 && !IsObjectHeaderAt(info->pos, objnum, info->gennum)) {
+    if (!ReloadCrossRefDataWithoutIndex()) {
+      return std::nullopt;
+    }
+    return GetObjectInfo(objnum);
+  }
+  return *info;
 }
 
 bool CPDF_Parser::InitSyntaxParser(RetainPtr<CPDF_ReadValidator> validator) {
@@ -235,37 +281,35 @@ bool CPDF_Parser::ParseFileVersion() {
 
 CPDF_Parser::Error CPDF_Parser::StartParse(
     RetainPtr<IFX_SeekableReadStream> pFileAccess,
-    const ByteString& password) {
+    const ByteString& password,
+    uint32_t load_flags) {
   if (!InitSyntaxParser(pdfium::MakeRetain<CPDF_ReadValidator>(
           std::move(pFileAccess), nullptr))) {
     return FORMAT_ERROR;
   }
   SetPassword(password);
+  load_flags_ = load_flags;
   return StartParseInternal();
 }
 
+CPDF_Parser::Error CPDF_Parser::StartParseWithCrossRefIndex(
+    RetainPtr<IFX_SeekableReadStream> pFileAccess,
+    const ByteString& password,
+    pdfium::span<const uint8_t> index) {
+  cross_ref_index_ = CPDF_CrossRefIndex::Parse(index);
+  return StartParse(std::move(pFileAccess), password, /*load_flags=*/0);
+}
+
 CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
   DCHECK(!has_parsed_);
   DCHECK(!xref_table_rebuilt_);
   has_parsed_ = true;
   xref_stream_ = false;
 
-  last_xref_offset_ = ParseStartXRef();
-  if (last_xref_offset_ >= kPDFHeaderSize) {
-    if (!LoadAllCrossRefTablesAndStreams(last_xref_offset_)) {
-      if (!RebuildCrossRef()) {
-        return FORMAT_ERROR;
-      }
-
-      xref_table_rebuilt_ = true;
-      last_xref_offset_ = 0;
-    }
-  } else {
-    if (!RebuildCrossRef()) {
-      return FORMAT_ERROR;
-    }
-
-    xref_table_rebuilt_ = true;
+  // The index holds what LoadCrossRefData() would produce, so the checks that
+  // follow apply either way.
+  if (!LoadCrossRefIndex() && !LoadCrossRefData()) {
+    return FORMAT_ERROR;
   }
   Error eRet = SetEncryptHandler();
   if (eRet != SUCCESS) {
@@ -310,6 +354,9 @@ CPDF_Parser::Error CPDF_Parser::StartParseInternal() {
       metadata_objnum_ = pMetadata->GetRefObjNum();
     }
   }
+  if (load_flags_ & kPrefetchObjectStreams) {
+    PrefetchObjectStreams();
+  }
   return SUCCESS;
 }
 
@@ -342,7 +389,7 @@ FX_FILESIZE CPDF_Parser::ParseStartXRef() {
 
 CPDF_Parser::Error CPDF_Parser::SetEncryptHandler() {
   ReleaseEncryptHandler();
-  if (!GetTrailer()) {
+  if (!cross_ref_table_->trailer()) {
     return FORMAT_ERROR;
   }
 
@@ -393,6 +440,158 @@ bool CPDF_Parser::VerifyCrossRefTable() {
   return true;
 }
 
+bool CPDF_Parser::LoadCrossRefData() {
+  last_xref_offset_ = ParseStartXRef();
+  if (last_xref_offset_ >= kPDFHeaderSize) {
+    const bool loaded =
+        (load_flags_ & kLoadCrossRefLazily)
+            ? LoadNewestCrossRefTableOrStream(last_xref_offset_)
+            : LoadAllCrossRefTablesAndStreams(last_xref_offset_);
+    if (loaded) {
+      return true;
+    }
+    last_xref_offset_ = 0;
+  }
+  if (!RebuildCrossRef()) {
+    return false;
+  }
+
+  xref_table_rebuilt_ = true;
+  return true;
+}
+
+bool CPDF_Parser::ReloadCrossRefDataWithoutIndex() {
+  loaded_cross_ref_index_ = false;
+  cross_ref_index_.reset();
+  xref_stream_ = false;
+  xref_table_rebuilt_ = false;
+  cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>();
+  return LoadCrossRefData();
+}
+
+bool CPDF_Parser::IsObjectHeaderAt(FX_FILESIZE pos,
+                                   uint32_t objnum,
+                                   uint16_t gennum) {
+  RetainPtr<CPDF_ReadValidator> validator = syntax_->GetValidator();
+  CPDF_ReadValidator::ScopedSession read_session(validator);
+  const FX_FILESIZE saved_pos = syntax_->GetPos();
+  syntax_->SetPos(pos);
+  const CPDF_SyntaxParser::WordResult objnum_result = syntax_->GetNextWord();
+  const CPDF_SyntaxParser::WordResult gennum_result = syntax_->GetNextWord();
+  const bool matches =
+      objnum_result.is_number && !objnum_result.word.IsEmpty() &&
+      FXSYS_atoui(objnum_result.word.c_str()) == objnum &&
+      gennum_result.is_number && !gennum_result.word.IsEmpty() &&
+      FXSYS_atoui(gennum_result.word.c_str()) == gennum &&
+      syntax_->GetKeyword() == "obj";
+  syntax_->SetPos(saved_pos);
+  // Data that is not available yet says nothing about the index.
+  return matches || validator->has_read_problems();
+}
+
+bool CPDF_Parser::LoadCrossRefIndex() {
+  if (!cross_ref_index_) {
+    return false;
+  }
+
+  const CPDF_CrossRefIndex& index = *cross_ref_index_;
+  RetainPtr<CPDF_ReadValidator> validator = syntax_->GetValidator();
+  if (index.file_size != validator->GetSize() ||
+      CPDF_CrossRefIndex::ComputeFileDigest(validator.Get()) !=
+          index.file_digest) {
+    cross_ref_index_.reset();
+    return false;
+  }
+
+  CPDF_SyntaxParser trailer_syntax(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      index.trailer.unsigned_span()));
+  RetainPtr<CPDF_Dictionary> trailer =
+      ToDictionary(trailer_syntax.GetObjectBody(objects_holder_));
+  if (!trailer) {
+    cross_ref_index_.reset();
+    return false;
+  }
+
+  const FX_FILESIZE document_size = GetDocumentSize();
+  CPDF_ObjectNumberMap<ObjectInfo> objects_info;
+  for (const auto& [obj_num, info] : index.objects) {
+    if (info.type == ObjectType::kNormal && info.pos >= document_size) {
+      cross_ref_index_.reset();
+      return false;
+    }
+    objects_info[obj_num] = info;
+  }
+
+  auto saved_cross_ref_table = std::move(cross_ref_table_);
+  cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>(
+      std::move(trailer), index.trailer_object_number,
+      std::move(objects_info));
+  if (!index.xref_table_rebuilt && !VerifyCrossRefTable()) {
+    cross_ref_table_ = std::move(saved_cross_ref_table);
+    cross_ref_index_.reset();
+    return false;
+  }
+
+  last_xref_offset_ = index.last_xref_offset;
+  xref_stream_ = index.xref_stream;
+  xref_table_rebuilt_ = index.xref_table_rebuilt;
+  loaded_cross_ref_index_ = true;
+  // Only the object stream data is needed from now on.
+  cross_ref_index_->trailer.clear();
+  cross_ref_index_->objects.clear();
+  cross_ref_index_->objects.shrink_to_fit();
+  return true;
+}
+
+DataVector<uint8_t> CPDF_Parser::SerializeCrossRefIndex() {
+  while (LoadPrevCrossRefSection()) {
+  }
+
+  RetainPtr<CPDF_ReadValidator> validator = syntax_->GetValidator();
+  std::optional<CPDF_CrossRefIndex::Digest> digest =
+      CPDF_CrossRefIndex::ComputeFileDigest(validator.Get());
+  if (!digest.has_value() || !GetTrailer()) {
+    return {};
+  }
+
+  ByteStringArchiveStream trailer_stream;
+  if (!GetTrailer()->WriteTo(&trailer_stream, /*encryptor=*/nullptr)) {
+    return {};
+  }
+
+  CPDF_CrossRefIndex index;
+  index.file_size = validator->GetSize();
+  index.file_digest = digest.value();
+  index.last_xref_offset = last_xref_offset_;
+  index.xref_stream = xref_stream_;
+  index.xref_table_rebuilt = xref_table_rebuilt_;
+  index.trailer_object_number = GetTrailerObjectNumber();
+  index.trailer = trailer_stream.str();
+  index.objects.reserve(cross_ref_table_->objects_info().size());
+  for (const auto& [obj_num, info] : cross_ref_table_->objects_info()) {
+    index.objects.emplace_back(obj_num, info);
+  }
+
+  // Object streams parsed so far, plus the ones a loaded index still knows
+  // about, in object number order.
+  std::map<uint32_t, std::vector<CPDF_ObjectStream::ObjectInfo>>
+      object_streams;
+  if (cross_ref_index_) {
+    for (const auto& object_stream : cross_ref_index_->object_streams) {
+      object_streams[object_stream.obj_num] = object_stream.object_info;
+    }
+  }
+  for (const auto& [obj_num, object_stream] : object_stream_map_) {
+    if (object_stream) {
+      object_streams[obj_num] = object_stream->object_info();
+    }
+  }
+  for (auto& [obj_num, object_info] : object_streams) {
+    index.object_streams.emplace_back(obj_num, std::move(object_info));
+  }
+  return index.Serialize();
+}
+
 bool CPDF_Parser::LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset) {
   const bool is_xref_stream = !LoadCrossRefTable(xref_offset, /*skip=*/true);
   if (is_xref_stream) {
@@ -472,6 +671,121 @@ bool CPDF_Parser::LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset) {
   return true;
 }
 
+bool CPDF_Parser::LoadNewestCrossRefTableOrStream(FX_FILESIZE xref_offset) {
+  cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>();
+  std::optional<FX_FILESIZE> prev_offset = LoadCrossRefSection(xref_offset);
+  if (!prev_offset.has_value()) {
+    return false;
+  }
+
+  lazy_seen_xref_offsets_ = {xref_offset};
+  if (!cross_ref_table_->trailer()->KeyExist("Root")) {
+    cross_ref_table_ = std::make_unique<CPDF_CrossRefTable>();
+    return LoadAllCrossRefTablesAndStreams(xref_offset);
+  }
+
+  xref_stream_ = GetTrailerObjectNumber() != kNoTrailerObjectNumber;
+  if (xref_stream_) {
+    object_stream_map_.clear();
+  } else if (!VerifyCrossRefTable()) {
+    return false;
+  }
+
+  lazy_prev_xref_offset_ = prev_offset.value();
+  // Entries such as /Info or /ID may only be in older trailers, which get
+  // merged in when needed.
+  lazy_prev_trailer_offset_ = prev_offset.value();
+  return true;
+}
+
+void CPDF_Parser::MergePrevTrailers() {
+  FX_FILESIZE xref_offset = std::exchange(lazy_prev_trailer_offset_, 0);
+  std::set<FX_FILESIZE> seen_xref_offsets = lazy_seen_xref_offsets_;
+  while (xref_offset > 0 && seen_xref_offsets.insert(xref_offset).second) {
+    syntax_->SetPos(xref_offset);
+    RetainPtr<const CPDF_Dictionary> trailer;
+    if (ParseCrossRefTable(/*out_objects=*/nullptr)) {
+      trailer = LoadTrailer();
+    } else {
+      RetainPtr<const CPDF_Stream> stream =
+          ToStream(ParseIndirectObjectAt(xref_offset, 0));
+      if (stream) {
+        trailer = stream->GetDict();
+      }
+    }
+    if (!trailer) {
+      return;
+    }
+
+    cross_ref_table_->UpdateTrailerFromPrev(*trailer);
+    xref_offset = trailer->GetDirectIntegerFor("Prev");
+  }
+}
+
+bool CPDF_Parser::LoadPrevCrossRefSection() {
+  const FX_FILESIZE xref_offset = std::exchange(lazy_prev_xref_offset_, 0);
+  if (xref_offset <= 0 || !lazy_seen_xref_offsets_.insert(xref_offset).second) {
+    return false;
+  }
+
+  // Load the section by itself, then put it underneath the ones loaded so far.
+  std::unique_ptr<CPDF_CrossRefTable> newer_cross_ref_table =
+      std::exchange(cross_ref_table_, std::make_unique<CPDF_CrossRefTable>());
+  std::optional<FX_FILESIZE> prev_offset = LoadCrossRefSection(xref_offset);
+  std::unique_ptr<CPDF_CrossRefTable> prev_cross_ref_table =
+      std::exchange(cross_ref_table_, std::move(newer_cross_ref_table));
+  if (!prev_offset.has_value()) {
+    // Objects only found in this section and older ones stay missing.
+    return false;
+  }
+
+  // Merge the trailer too, unless MergePrevTrailers() already has.
+  if (xref_offset == lazy_prev_trailer_offset_ &&
+      prev_cross_ref_table->trailer()) {
+    cross_ref_table_->UpdateTrailerFromPrev(*prev_cross_ref_table->trailer());
+    lazy_prev_trailer_offset_ = prev_offset.value();
+  }
+  cross_ref_table_->UpdateFromPrev(std::move(prev_cross_ref_table));
+  lazy_prev_xref_offset_ = prev_offset.value();
+  return true;
+}
+
+std::optional<FX_FILESIZE> CPDF_Parser::LoadCrossRefSection(
+    FX_FILESIZE xref_offset) {
+  DCHECK(cross_ref_table_->objects_info().empty());
+  syntax_->SetPos(xref_offset);
+  std::vector<CrossRefObjData> objects;
+  if (!ParseCrossRefTable(&objects)) {
+    FX_FILESIZE prev_offset = xref_offset;
+    if (!LoadCrossRefStream(&prev_offset, /*is_main_xref=*/true)) {
+      return std::nullopt;
+    }
+    return prev_offset;
+  }
+
+  RetainPtr<CPDF_Dictionary> trailer = LoadTrailer();
+  if (!trailer) {
+    return std::nullopt;
+  }
+
+  const FX_FILESIZE prev_offset = trailer->GetDirectIntegerFor("Prev");
+  FX_FILESIZE xref_stream_offset = trailer->GetDirectIntegerFor("XRefStm");
+  const int32_t xrefsize = trailer->GetDirectIntegerFor("Size");
+  cross_ref_table_->SetTrailer(std::move(trailer), kNoTrailerObjectNumber);
+  if (xrefsize > 0 && xrefsize <= kMaxXRefSize) {
+    cross_ref_table_->SetObjectMapSize(xrefsize);
+  }
+
+  // As in LoadAllCrossRefTablesAndStreams(), cross reference table entries take
+  // precedence over the entries from the /XRefStm stream in the same section.
+  if (xref_stream_offset > 0 &&
+      !LoadCrossRefStream(&xref_stream_offset, /*is_main_xref=*/false)) {
+    return std::nullopt;
+  }
+  MergeCrossRefObjectsData(objects);
+  return std::max<FX_FILESIZE>(prev_offset, 0);
+}
+
 bool CPDF_Parser::LoadLinearizedAllCrossRefTable(FX_FILESIZE main_xref_offset) {
   if (!LoadCrossRefTable(main_xref_offset, /*skip=*/false)) {
     return false;
@@ -754,15 +1068,37 @@ bool CPDF_Parser::FindAllCrossReferenceTablesAndStream(
 }
 
 bool CPDF_Parser::RebuildCrossRef() {
+  // The rebuilt table covers all sections.
+  lazy_prev_xref_offset_ = 0;
+  lazy_prev_trailer_offset_ = 0;
+  // The index may name object streams the rebuilt table does not.
+  cross_ref_index_.reset();
+
   auto cross_ref_table = std::make_unique<CPDF_CrossRefTable>();
 
   const uint32_t kBufferSize = 4096;
   syntax_->SetReadBufferSize(kBufferSize);
   syntax_->SetPos(0);
 
+  // Finding the objects in a large file word by word is slow, so scan the
+  // whole file up front to find where they can be.
+  std::unique_ptr<CPDF_RebuildScanner> scanner;
+  if (rebuild_scan_chunk_size_ &&
+      syntax_->GetValidator()->IsWholeFileAvailable()) {
+    scanner =
+        CPDF_RebuildScanner::Scan(syntax_.get(), rebuild_scan_chunk_size_);
+  }
+  syntax_->SetRebuildScanner(scanner.get());
+
   std::vector<std::pair<uint32_t, FX_FILESIZE>> numbers;
-  for (CPDF_SyntaxParser::WordResult result = syntax_->GetNextWord();
-       !result.word.IsEmpty(); result = syntax_->GetNextWord()) {
+  while (true) {
+    if (scanner) {
+      SkipToNextRebuildEvent(*scanner);
+    }
+    CPDF_SyntaxParser::WordResult result = syntax_->GetNextWord();
+    if (result.word.IsEmpty()) {
+      break;
+    }
     const ByteString& word = result.word;
     if (result.is_number) {
       numbers.emplace_back(FXSYS_atoui(word.c_str()),
@@ -830,12 +1166,39 @@ bool CPDF_Parser::RebuildCrossRef() {
 
   cross_ref_table_ = CPDF_CrossRefTable::MergeUp(std::move(cross_ref_table_),
                                                  std::move(cross_ref_table));
+  syntax_->SetRebuildScanner(nullptr);
   // Resore default buffer size.
   syntax_->SetReadBufferSize(CPDF_Stream::kFileBufSize);
 
   return GetTrailer() && !cross_ref_table_->objects_info().empty();
 }
 
+void CPDF_Parser::SkipToNextRebuildEvent(const CPDF_RebuildScanner& scanner) {
+  const FX_FILESIZE pos = syntax_->GetPos();
+
+  // The scanner only knows about words that start after a word boundary. If
+  // `pos` is in the middle of a word, leave it to the syntax parser.
+  uint8_t ch;
+  uint8_t prev_ch;
+  if (pos > 0 && syntax_->GetCharAt(pos, ch) &&
+      (PDFCharIsNumeric(ch) || PDFCharIsOther(ch)) &&
+      syntax_->GetCharAt(pos - 1, prev_ch) &&
+      (PDFCharIsNumeric(prev_ch) || PDFCharIsOther(prev_ch) ||
+       prev_ch == '/')) {
+    return;
+  }
+
+  FX_FILESIZE next_pos = scanner.FindNextEvent(pos);
+  if (next_pos < 0) {
+    next_pos = syntax_->GetDocumentSize();
+  }
+  // Words before `next_pos` in a clean range are neither object headers nor
+  // trailers, and do not affect how the words after them get read.
+  if (next_pos > pos && scanner.IsClean(pos, next_pos)) {
+    syntax_->SetPos(next_pos);
+  }
+}
+
 bool CPDF_Parser::LoadCrossRefStream(FX_FILESIZE* pos, bool is_main_xref) {
   RetainPtr<const CPDF_Stream> pStream =
       ToStream(ParseIndirectObjectAt(*pos, 0));
@@ -990,8 +1353,8 @@ void CPDF_Parser::ProcessCrossRefStreamEntry(
   cross_ref_table_->AddCompressed(obj_num, archive_obj_num, archive_obj_index);
 }
 
-RetainPtr<const CPDF_Array> CPDF_Parser::GetIDArray() const {
-  return GetTrailer() ? GetTrailer()->GetArrayFor("ID") : nullptr;
+RetainPtr<const CPDF_Array> CPDF_Parser::GetIDArray() {
+  return ToArray(GetTrailerObjectFor("ID"));
 }
 
 RetainPtr<const CPDF_Dictionary> CPDF_Parser::GetRoot() const {
@@ -1001,12 +1364,13 @@ RetainPtr<const CPDF_Dictionary> CPDF_Parser::GetRoot() const {
 }
 
 RetainPtr<const CPDF_Dictionary> CPDF_Parser::GetEncryptDict() const {
-  if (!GetTrailer()) {
+  // Only look at the trailers merged so far, like SetEncryptHandler() did.
+  const CPDF_Dictionary* trailer = cross_ref_table_->trailer();
+  if (!trailer) {
     return nullptr;
   }
 
-  RetainPtr<const CPDF_Object> pEncryptObj =
-      GetTrailer()->GetObjectFor("Encrypt");
+  RetainPtr<const CPDF_Object> pEncryptObj = trailer->GetObjectFor("Encrypt");
   if (!pEncryptObj) {
     return nullptr;
   }
@@ -1026,7 +1390,8 @@ ByteString CPDF_Parser::GetEncodedPassword() const {
   return GetSecurityHandler()->GetEncodedPassword(GetPassword().AsStringView());
 }
 
-const CPDF_Dictionary* CPDF_Parser::GetTrailer() const {
+const CPDF_Dictionary* CPDF_Parser::GetTrailer() {
+  MergePrevTrailers();
   return cross_ref_table_->trailer();
 }
 
@@ -1038,17 +1403,30 @@ uint32_t CPDF_Parser::GetTrailerObjectNumber() const {
   return cross_ref_table_->trailer_object_number();
 }
 
-RetainPtr<CPDF_Dictionary> CPDF_Parser::GetCombinedTrailer() const {
-  return cross_ref_table_->trailer()
-             ? ToDictionary(cross_ref_table_->trailer()->Clone())
-             : RetainPtr<CPDF_Dictionary>();
+RetainPtr<CPDF_Dictionary> CPDF_Parser::GetCombinedTrailer() {
+  const CPDF_Dictionary* trailer = GetTrailer();
+  return trailer ? ToDictionary(trailer->Clone())
+                 : RetainPtr<CPDF_Dictionary>();
 }
 
-uint32_t CPDF_Parser::GetInfoObjNum() const {
+RetainPtr<const CPDF_Object> CPDF_Parser::GetTrailerObjectFor(
+    ByteStringView key) {
+  const CPDF_Dictionary* trailer = cross_ref_table_->trailer();
+  if (!trailer) {
+    return nullptr;
+  }
+
+  RetainPtr<const CPDF_Object> object = trailer->GetObjectFor(key);
+  if (!object && lazy_prev_trailer_offset_ > 0) {
+    MergePrevTrailers();
+    object = trailer->GetObjectFor(key);
+  }
+  return object;
+}
+
+uint32_t CPDF_Parser::GetInfoObjNum() {
   RetainPtr<const CPDF_Reference> pRef =
-      ToReference(cross_ref_table_->trailer()
-                      ? cross_ref_table_->trailer()->GetObjectFor("Info")
-                      : nullptr);
+      ToReference(GetTrailerObjectFor("Info"));
   return pRef ? pRef->GetRefObjNum() : CPDF_Object::kInvalidObjNum;
 }
 
@@ -1071,8 +1449,10 @@ RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObject(uint32_t objnum) {
   }
 
   ScopedSetInsertion local_insert(&parsing_obj_nums_, objnum);
-  const auto* info = cross_ref_table_->GetObjectInfo(objnum);
-  if (!info) {
+  // GetObjectStream() below may load older cross reference sections, so
+  // `info` has to be a copy.
+  const std::optional<ObjectInfo> info = GetObjectInfo(objnum);
+  if (!info.has_value()) {
     return nullptr;
   }
 
@@ -1108,8 +1488,8 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
     return it->second.get();
   }
 
-  const auto* info = cross_ref_table_->GetObjectInfo(object_number);
-  if (!info || !info->is_object_stream_flag) {
+  const std::optional<ObjectInfo> info = GetObjectInfo(object_number);
+  if (!info.has_value() || !info->is_object_stream_flag) {
     return nullptr;
   }
 
@@ -1128,13 +1508,76 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
   }
 
   std::unique_ptr<CPDF_ObjectStream> objs_stream =
-      CPDF_ObjectStream::Create(ToStream(object));
+      CPDF_ObjectStream::CreateWithObjectInfo(
+          ToStream(object), TakeIndexedObjectInfo(object_number));
   const CPDF_ObjectStream* result = objs_stream.get();
   object_stream_map_[object_number] = std::move(objs_stream);
 
   return result;
 }
 
+std::vector<CPDF_ObjectStream::ObjectInfo> CPDF_Parser::TakeIndexedObjectInfo(
+    uint32_t object_number) {
+  if (!cross_ref_index_) {
+    return {};
+  }
+
+  auto& object_streams = cross_ref_index_->object_streams;
+  auto index_it = std::ranges::lower_bound(
+      object_streams, object_number, {},
+      &CPDF_CrossRefIndex::ObjectStreamInfo::obj_num);
+  if (index_it == object_streams.end() || index_it->obj_num != object_number) {
+    return {};
+  }
+  return std::move(index_it->object_info);
+}
+
+void CPDF_Parser::PrefetchObjectStreams() {
+  // Parsing may load more cross reference sections, so collect the object
+  // streams first.
+  std::vector<std::pair<uint32_t, FX_FILESIZE>> positions;
+  for (const auto& [obj_num, info] : cross_ref_table_->objects_info()) {
+    if (info.type == ObjectType::kNormal && info.is_object_stream_flag &&
+        info.pos > 0) {
+      positions.emplace_back(obj_num, info.pos);
+    }
+  }
+
+  // Reading the streams from the file has to happen on this thread. Only the
+  // decoding runs in parallel.
+  std::vector<uint32_t> object_numbers;
+  std::vector<CPDF_ObjectStream::CreateParams> params;
+  for (const auto& [obj_num, pos] : positions) {
+    // Parsing an earlier object stream may have needed this one.
+    if (pdfium::Contains(object_stream_map_, obj_num)) {
+      continue;
+    }
+
+    RetainPtr<CPDF_Object> object;
+    {
+      ScopedSetInsertion local_insert(&parsing_obj_nums_, obj_num);
+      object = ParseIndirectObjectAt(pos, obj_num);
+    }
+    RetainPtr<const CPDF_Stream> stream = ToStream(std::move(object));
+    if (!stream) {
+      continue;
+    }
+
+    object_numbers.push_back(obj_num);
+    params.emplace_back(std::move(stream), TakeIndexedObjectInfo(obj_num));
+  }
+
+  std::vector<std::unique_ptr<CPDF_ObjectStream>> object_streams =
+      CPDF_ObjectStream::CreateInParallel(
+          std::move(params), std::clamp<size_t>(
+                                 std::thread::hardware_concurrency(), 1,
+                                 kMaxObjectStreamPrefetchThreads));
+  for (size_t i = 0; i < object_numbers.size(); ++i) {
+    object_stream_map_.emplace(object_numbers[i],
+                               std::move(object_streams[i]));
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAt(FX_FILESIZE pos,
                                                           uint32_t objnum) {
   const FX_FILESIZE saved_pos = syntax_->GetPos();
@@ -1283,6 +1726,9 @@ CPDF_Parser::Error CPDF_Parser::StartLinearizedParse(
       metadata_objnum_ = pMetadata->GetRefObjNum();
     }
   }
+  if (load_flags_ & kPrefetchObjectStreams) {
+    PrefetchObjectStreams();
+  }
   return SUCCESS;
 }
 
@@ -13,21 +13,26 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 #include "core/fpdfapi/parser/cpdf_indirect_object_holder.h"
+#include "core/fpdfapi/parser/cpdf_object_stream.h"
+#include "core/fpdfapi/parser/cpdf_rebuild_scanner.h"
 #include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_types.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
 
 class CPDF_Array;
+struct CPDF_CrossRefIndex;
 class CPDF_Dictionary;
 class CPDF_LinearizedHeader;
 class CPDF_Object;
-class CPDF_ObjectStream;
 class CPDF_ReadValidator;
 class CPDF_SecurityHandler;
 class CPDF_SyntaxParser;
@@ -58,12 +63,38 @@ class CPDF_Parser {
 
   static constexpr size_t kInvalidPos = std::numeric_limits<size_t>::max();
 
+  // Flags for StartParse().
+  //
+  // Only load the newest cross reference section up front. Older sections,
+  // reached through /Prev, are loaded one at a time when an object is not
+  // found in the sections loaded so far. Speeds up opening documents with many
+  // incremental updates.
+  //
+  // Opening only looks at the newest trailer, which ISO 32000-1:2008, section
+  // 7.5.6, requires to repeat the /Root and /Encrypt entries of older ones.
+  // Entries only older trailers have, like a missing /Info or /ID, are merged
+  // in when first asked for.
+  static constexpr uint32_t kLoadCrossRefLazily = 1 << 0;
+  // Decode all the object streams in the cross reference table on worker
+  // threads once parsing succeeds, instead of one at a time as objects in them
+  // are first needed. Speeds up uses that read most objects, like extracting
+  // all the text, at the cost of memory for the streams that go unused.
+  static constexpr uint32_t kPrefetchObjectStreams = 1 << 1;
+
   explicit CPDF_Parser(ParsedObjectsHolder* holder);
   CPDF_Parser();
   ~CPDF_Parser();
 
   Error StartParse(RetainPtr<IFX_SeekableReadStream> pFile,
-                   const ByteString& password);
+                   const ByteString& password,
+                   uint32_t load_flags);
+  // Like StartParse(), but takes the cross reference data from `index`, which
+  // SerializeCrossRefIndex() returned for the same file, instead of reading
+  // it from the file. Reads it from the file as usual if `index` is malformed
+  // or belongs to a different file.
+  Error StartParseWithCrossRefIndex(RetainPtr<IFX_SeekableReadStream> pFile,
+                                    const ByteString& password,
+                                    pdfium::span<const uint8_t> index);
   Error StartLinearizedParse(RetainPtr<CPDF_ReadValidator> validator,
                              const ByteString& password);
 
@@ -73,30 +104,31 @@ class CPDF_Parser {
   // password encoding conversion.
   ByteString GetEncodedPassword() const;
 
-  const CPDF_Dictionary* GetTrailer() const;
+  // Not const, as it may need to merge in older trailers.
+  const CPDF_Dictionary* GetTrailer();
   uint32_t GetTrailerObjectNumber() const;
 
   // Returns a new trailer which combines the last read trailer with the /Root
   // and /Info from previous ones.
-  RetainPtr<CPDF_Dictionary> GetCombinedTrailer() const;
+  RetainPtr<CPDF_Dictionary> GetCombinedTrailer();
 
   FX_FILESIZE GetLastXRefOffset() const { return last_xref_offset_; }
 
   uint32_t GetPermissions(bool get_owner_perms) const;
   uint32_t GetRootObjNum() const;
-  uint32_t GetInfoObjNum() const;
-  RetainPtr<const CPDF_Array> GetIDArray() const;
+  uint32_t GetInfoObjNum();
+  RetainPtr<const CPDF_Array> GetIDArray();
   RetainPtr<const CPDF_Dictionary> GetEncryptDict() const;
 
   RetainPtr<CPDF_Object> ParseIndirectObject(uint32_t objnum);
 
   uint32_t GetLastObjNum() const;
   bool IsValidObjectNumber(uint32_t objnum) const;
-  FX_FILESIZE GetObjectPositionOrZero(uint32_t objnum) const;
+  FX_FILESIZE GetObjectPositionOrZero(uint32_t objnum);
   const RetainPtr<CPDF_SecurityHandler>& GetSecurityHandler() const {
     return security_handler_;
   }
-  bool IsObjectFree(uint32_t objnum) const;
+  bool IsObjectFree(uint32_t objnum);
 
   int GetFileVersion() const { return file_version_; }
   bool IsXRefStream() const { return xref_stream_; }
@@ -108,6 +140,12 @@ class CPDF_Parser {
   }
 
   bool xref_table_rebuilt() const { return xref_table_rebuilt_; }
+  bool loaded_cross_ref_index() const { return loaded_cross_ref_index_; }
+
+  // Returns the cross reference data for StartParseWithCrossRefIndex(), in
+  // the form described in CPDF_CrossRefIndex, or an empty vector on failure.
+  // Loads any cross reference sections that are still pending first.
+  DataVector<uint8_t> SerializeCrossRefIndex();
 
   std::vector<unsigned int> GetTrailerEnds();
   bool WriteToArchive(IFX_ArchiveStream* archive, FX_FILESIZE src_size);
@@ -125,6 +163,16 @@ class CPDF_Parser {
   void SetLinearizedHeaderForTesting(
       std::unique_ptr<CPDF_LinearizedHeader> pLinearized);
 
+  size_t GetObjectStreamCountForTesting() const {
+    return object_stream_map_.size();
+  }
+
+  // Sets the chunk size RebuildCrossRef() scans the file with. 0 turns off
+  // the scan.
+  void SetRebuildScanChunkSizeForTesting(size_t chunk_size) {
+    rebuild_scan_chunk_size_ = chunk_size;
+  }
+
  protected:
   bool LoadCrossRefTable(FX_FILESIZE pos, bool skip);
   bool RebuildCrossRef();
@@ -142,7 +190,31 @@ class CPDF_Parser {
     CPDF_CrossRefTable::ObjectInfo info;
   };
 
+  // Replaces the cross reference data with `cross_ref_index_`. Returns false,
+  // leaving the parser as is, if the index does not match the file.
+  bool LoadCrossRefIndex();
+  // Loads the cross reference data from the file, rebuilding it if needed.
+  bool LoadCrossRefData();
+  // Drops the loaded index, for when one of its offsets turns out to be
+  // wrong, and loads the cross reference data from the file instead.
+  bool ReloadCrossRefDataWithoutIndex();
+  // Returns whether the object at `pos` starts with "`objnum` `gennum` obj",
+  // or whether that cannot be read yet.
+  bool IsObjectHeaderAt(FX_FILESIZE pos, uint32_t objnum, uint16_t gennum);
   bool LoadAllCrossRefTablesAndStreams(FX_FILESIZE xref_offset);
+  bool LoadNewestCrossRefTableOrStream(FX_FILESIZE xref_offset);
+  bool LoadPrevCrossRefSection();
+  // Fills in the entries the trailer lacks from the trailers of the sections
+  // that are not loaded yet, without loading their entries, so the trailer
+  // ends up as if all sections had been loaded.
+  void MergePrevTrailers();
+  // Returns the trailer entry for `key`, merging in older trailers if the
+  // ones merged so far lack it.
+  RetainPtr<const CPDF_Object> GetTrailerObjectFor(ByteStringView key);
+  // Loads the cross reference table or stream at `xref_offset` into
+  // `cross_ref_table_`, which must be empty. Returns the /Prev offset on
+  // success.
+  std::optional<FX_FILESIZE> LoadCrossRefSection(FX_FILESIZE xref_offset);
   bool FindAllCrossReferenceTablesAndStream(
       FX_FILESIZE main_xref_offset,
       std::vector<FX_FILESIZE>& xref_list,
@@ -158,13 +230,27 @@ class CPDF_Parser {
   bool LoadLinearizedAllCrossRefStream(FX_FILESIZE main_xref_offset);
   Error LoadLinearizedMainXRefTable();
 
+  // Like CPDF_CrossRefTable::GetObjectInfo(), but loads older cross reference
+  // sections as needed when loading them lazily. Returns a copy, as loading
+  // any section, including for other objects, moves the entries around.
+  std::optional<CPDF_CrossRefTable::ObjectInfo> GetObjectInfo(uint32_t objnum);
   const CPDF_ObjectStream* GetObjectStream(uint32_t object_number);
+  // Returns the object offsets `cross_ref_index_` holds for the object stream
+  // `object_number`, if any.
+  std::vector<CPDF_ObjectStream::ObjectInfo> TakeIndexedObjectInfo(
+      uint32_t object_number);
+  // Fills `object_stream_map_` for kPrefetchObjectStreams.
+  void PrefetchObjectStreams();
   RetainPtr<const CPDF_Dictionary> GetRoot() const;
 
   // A simple check whether the cross reference table matches with
   // the objects.
   bool VerifyCrossRefTable();
 
+  // Moves the syntax parser past the bytes `scanner` shows RebuildCrossRef()
+  // has no use for.
+  void SkipToNextRebuildEvent(const CPDF_RebuildScanner& scanner);
+
   RetainPtr<CPDF_Object> ParseIndirectObjectAt(FX_FILESIZE pos,
                                                uint32_t objnum);
 
@@ -185,15 +271,27 @@ class CPDF_Parser {
   std::unique_ptr<ParsedObjectsHolder> owned_objects_holder_;
   UnownedPtr<ParsedObjectsHolder> objects_holder_;
 
+  uint32_t load_flags_ = 0;
   bool has_parsed_ = false;
   bool xref_stream_ = false;
   bool xref_table_rebuilt_ = false;
+  bool loaded_cross_ref_index_ = false;
   int file_version_ = 0;
   uint32_t metadata_objnum_ = 0;
   // cross_ref_table_ must be destroyed after security_handler_ due to the
   // ownership of the ID array data.
   std::unique_ptr<CPDF_CrossRefTable> cross_ref_table_;
   FX_FILESIZE last_xref_offset_ = 0;
+  // When loading cross reference sections lazily, the offset of the next
+  // section to load, or 0 once there are none left.
+  FX_FILESIZE lazy_prev_xref_offset_ = 0;
+  // Likewise for the next trailer to merge into the trailer.
+  FX_FILESIZE lazy_prev_trailer_offset_ = 0;
+  std::set<FX_FILESIZE> lazy_seen_xref_offsets_;
+  // Set by StartParseWithCrossRefIndex(). Once loaded, only the object stream
+  // data is kept, for GetObjectStream().
+  std::unique_ptr<CPDF_CrossRefIndex> cross_ref_index_;
+  size_t rebuild_scan_chunk_size_ = CPDF_RebuildScanner::kDefaultChunkSize;
   ByteString password_;
   std::unique_ptr<CPDF_LinearizedHeader> linearized_;
 
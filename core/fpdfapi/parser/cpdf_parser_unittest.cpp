@@ -5,18 +5,25 @@
 #include "core/fpdfapi/parser/cpdf_parser.h"
 
 #include <array>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "core/fpdfapi/parser/cpdf_array.h"
+#include "core/fpdfapi/parser/cpdf_cross_ref_index.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_linearized_header.h"
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_stream.h"
 #include "core/fxcrt/retain_ptr.h"
@@ -42,6 +49,44 @@ CPDF_CrossRefTable::ObjectInfo GetObjInfo(const CPDF_Parser& parser,
   return info ? *info : CPDF_CrossRefTable::ObjectInfo();
 }
 
+std::string ObjectToString(const CPDF_Object* object) {
+  std::ostringstream os;
+  os << object;
+  return os.str();
+}
+
+// Records the ranges read from a span.
+class ReadRecordingStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns whether any read so far overlapped [offset, offset + size).
+  bool WasRead(FX_FILESIZE offset, FX_FILESIZE size) const {
+    for (const auto& [read_offset, read_size] : reads_) {
+      if (read_offset < offset + size && offset < read_offset + read_size) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override { return stream_->GetSize(); }
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override {
+    reads_.emplace_back(offset, static_cast<FX_FILESIZE>(buffer.size()));
+    return stream_->ReadBlockAtOffset(buffer, offset);
+  }
+
+ private:
+  explicit ReadRecordingStream(pdfium::span<const uint8_t> span)
+      : stream_(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(span)) {}
+  ~ReadRecordingStream() override = default;
+
+  const RetainPtr<CFX_ReadOnlySpanStream> stream_;
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> reads_;
+};
+
 class TestObjectsHolder final : public CPDF_Parser::ParsedObjectsHolder {
  public:
   TestObjectsHolder() = default;
@@ -177,6 +222,54 @@ TEST(ParserTest, RebuildCrossRefFailed) {
   ASSERT_FALSE(parser.RebuildCrossRef());
 }
 
+TEST(ParserTest, RebuildCrossRefWithScanner) {
+  // A file without a cross reference table, with objects that span several
+  // scan chunks, a stream with a bad /Length, and object headers in comments
+  // and strings.
+  std::string data = "%PDF-1.7\n";
+  for (int i = 1; data.size() < 20000; ++i) {
+    data += std::to_string(i) + " 0 obj\n<</Index " + std::to_string(i) +
+            ">>\nendobj\n";
+    if (i % 40 == 0) {
+      data += "% " + std::to_string(i + 1000) + " 0 obj\n";
+    }
+    if (i % 70 == 0) {
+      data += std::to_string(i + 2000) + " 0 obj\n(" + std::to_string(i + 3000) +
+              " 0 obj)\nendobj\n";
+    }
+    if (i % 90 == 0) {
+      data += std::to_string(i + 4000) +
+              " 1 obj\n<</Length 100000>>stream\n1 0 obj\nendstream\nendobj\n";
+    }
+    if (i % 100 == 0) {
+      // A later copy of an existing object.
+      data += std::to_string(i / 2) + " 0 obj\n<<>>\nendobj\n";
+    }
+  }
+  data += "trailer\n<</Root 1 0 R>>\n";
+
+  auto rebuild = [&data](size_t chunk_size) {
+    CPDF_TestParser parser;
+    parser.SetRebuildScanChunkSizeForTesting(chunk_size);
+    EXPECT_TRUE(parser.InitTestFromBuffer(pdfium::as_byte_span(data)));
+    EXPECT_TRUE(parser.RebuildCrossRef());
+    std::vector<std::tuple<uint32_t, uint16_t, FX_FILESIZE>> objects;
+    for (const auto& it : parser.GetCrossRefTableForTesting()->objects_info()) {
+      objects.emplace_back(it.first, it.second.gennum, it.second.pos);
+    }
+    return objects;
+  };
+
+  const auto expected = rebuild(/*chunk_size=*/0);
+  ASSERT_FALSE(expected.empty());
+  EXPECT_EQ(expected, rebuild(CPDF_RebuildScanner::kChunkAlignment));
+  EXPECT_EQ(expected, rebuild(CPDF_RebuildScanner::kDefaultChunkSize));
+
+  ASSERT_TRUE(CPDF_RebuildScanner::SetThreadCount(4));
+  EXPECT_EQ(expected, rebuild(CPDF_RebuildScanner::kChunkAlignment));
+  CPDF_RebuildScanner::SetThreadCount(0);
+}
+
 TEST(ParserTest, LoadCrossRefTable) {
   {
     static const unsigned char kXrefTable[] =
@@ -388,6 +481,51 @@ TEST(ParserTest, ParseLinearizedWithHeaderOffset) {
   EXPECT_EQ(0u, cross_ref_table->trailer_object_number());
 }
 
+TEST(ParserTest, PrefetchObjectStreams) {
+  std::string test_file =
+      PathService::GetTestFilePath("annotation_stamp_with_ap.pdf");
+  ASSERT_FALSE(test_file.empty());
+  RetainPtr<IFX_SeekableReadStream> file =
+      IFX_SeekableReadStream::CreateFromFilename(test_file.c_str());
+  ASSERT_TRUE(file);
+
+  auto dummy_root = pdfium::MakeRetain<CPDF_Dictionary>();
+  CPDF_TestParser expected_parser;
+  EXPECT_CALL(expected_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(dummy_root));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            expected_parser.StartParse(file, "", /*load_flags=*/0));
+  EXPECT_EQ(0u, expected_parser.GetObjectStreamCountForTesting());
+
+  CPDF_TestParser parser;
+  EXPECT_CALL(parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(dummy_root));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser.StartParse(file, "", CPDF_Parser::kPrefetchObjectStreams));
+  const size_t object_stream_count = parser.GetObjectStreamCountForTesting();
+  EXPECT_GT(object_stream_count, 0u);
+
+  // The prefetched object streams hold the same objects, and no more object
+  // streams get created.
+  size_t compressed_count = 0;
+  for (const auto& it : parser.GetCrossRefTableForTesting()->objects_info()) {
+    if (it.second.type != CPDF_CrossRefTable::ObjectType::kCompressed) {
+      continue;
+    }
+    ++compressed_count;
+    RetainPtr<CPDF_Object> expected =
+        expected_parser.ParseIndirectObject(it.first);
+    ASSERT_TRUE(expected);
+    RetainPtr<CPDF_Object> object = parser.ParseIndirectObject(it.first);
+    ASSERT_TRUE(object);
+    EXPECT_EQ(ObjectToString(expected.Get()), ObjectToString(object.Get()));
+  }
+  EXPECT_GT(compressed_count, 0u);
+  EXPECT_EQ(object_stream_count, parser.GetObjectStreamCountForTesting());
+  EXPECT_EQ(object_stream_count,
+            expected_parser.GetObjectStreamCountForTesting());
+}
+
 TEST(ParserTest, BadStartXrefShouldNotBuildCrossRefTable) {
   const unsigned char kData[] =
       "%PDF1-7 0 obj <</Size 2 /W [0 0 0]\n>>\n"
@@ -805,3 +943,467 @@ TEST_F(ParserXRefTest, XrefWithIndexAndWrongSize) {
                                         Pair(80, expected_result[1]),
                                         Pair(81, expected_result[2])));
 }
+
+// A document with one incremental update, which changes object 2.
+const unsigned char kIncrementallyUpdatedData[] =
+    "%PDF-1.7\n"
+    "1 0 obj\n"
+    "<< /Type /Catalog >>\n"
+    "endobj\n"
+    "2 0 obj\n"
+    "(old)\n"
+    "endobj\n"
+    "3 0 obj\n"
+    "(three)\n"
+    "endobj\n"
+    "xref\n"
+    "0 4\n"
+    "0000000000 65535 f\r\n"
+    "0000000009 00000 n\r\n"
+    "0000000045 00000 n\r\n"
+    "0000000066 00000 n\r\n"
+    "trailer\n"
+    "<< /Size 4 /Root 1 0 R >>\n"
+    "startxref\n"
+    "89\n"
+    "%%EOF\n"
+    "2 0 obj\n"
+    "(new)\n"
+    "endobj\n"
+    "xref\n"
+    "0 1\n"
+    "0000000000 65535 f\r\n"
+    "2 1\n"
+    "0000000231 00000 n\r\n"
+    "trailer\n"
+    "<< /Size 4 /Root 1 0 R /Prev 89 >>\n"
+    "startxref\n"
+    "252\n"
+    "%%EOF\n";
+
+TEST_F(ParserXRefTest, LoadCrossRefLazily) {
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                    kIncrementallyUpdatedData),
+                                "", CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_EQ(3u, parser().GetLastObjNum());
+
+  const CPDF_CrossRefTable::ObjectInfo kPlaceholderObject = {
+      .type = CPDF_CrossRefTable::ObjectType::kFree};
+  const CPDF_CrossRefTable::ObjectInfo kNormalObjects[] = {
+      {.type = CPDF_CrossRefTable::ObjectType::kNormal, .pos = 9},
+      {.type = CPDF_CrossRefTable::ObjectType::kNormal, .pos = 231},
+      {.type = CPDF_CrossRefTable::ObjectType::kNormal, .pos = 66}};
+
+  // Only the newest section has been loaded.
+  const auto& objects_info =
+      parser().GetCrossRefTableForTesting()->objects_info();
+  EXPECT_THAT(objects_info, ElementsAre(Pair(2, kNormalObjects[1]),
+                                        Pair(3, kPlaceholderObject)));
+
+  RetainPtr<CPDF_Object> object = parser().ParseIndirectObject(2);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("new", object->GetString());
+  EXPECT_THAT(objects_info, ElementsAre(Pair(2, kNormalObjects[1]),
+                                        Pair(3, kPlaceholderObject)));
+
+  // Object 3 is only in the older section, which gets loaded and merged in.
+  object = parser().ParseIndirectObject(3);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("three", object->GetString());
+  EXPECT_THAT(objects_info, ElementsAre(Pair(1, kNormalObjects[0]),
+                                        Pair(2, kNormalObjects[1]),
+                                        Pair(3, kNormalObjects[2])));
+  EXPECT_FALSE(parser().IsObjectFree(1));
+  EXPECT_EQ(9, parser().GetObjectPositionOrZero(1));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefLazilyMatchesLoadingEagerly) {
+  CPDF_TestParser eager_parser;
+  EXPECT_CALL(eager_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(pdfium::MakeRetain<CPDF_Dictionary>()));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            eager_parser.StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                        kIncrementallyUpdatedData),
+                                    "", /*load_flags=*/0));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                    kIncrementallyUpdatedData),
+                                "", CPDF_Parser::kLoadCrossRefLazily));
+
+  // Looking up an object that does not exist loads all sections.
+  EXPECT_FALSE(parser().GetObjectPositionOrZero(4));
+
+  std::vector<std::pair<uint32_t, CPDF_CrossRefTable::ObjectInfo>> expected;
+  for (const auto& [obj_num, info] :
+       eager_parser.GetCrossRefTableForTesting()->objects_info()) {
+    expected.emplace_back(obj_num, info);
+  }
+  EXPECT_THAT(parser().GetCrossRefTableForTesting()->objects_info(),
+              testing::ElementsAreArray(expected));
+  EXPECT_EQ(eager_parser.GetLastObjNum(), parser().GetLastObjNum());
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefLazilyWithCircularPrev) {
+  // Object 2 is missing, and /Prev points back to the same section.
+  const unsigned char kData[] =
+      "%PDF-1.7\n"
+      "1 0 obj\n"
+      "<< /Type /Catalog >>\n"
+      "endobj\n"
+      "xref\n"
+      "0 2\n"
+      "0000000000 65535 f\r\n"
+      "0000000009 00000 n\r\n"
+      "trailer\n"
+      "<< /Size 3 /Root 1 0 R /Prev 45 >>\n"
+      "startxref\n"
+      "45\n"
+      "%%EOF\n";
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kData), "",
+                CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_FALSE(parser().ParseIndirectObject(2));
+  EXPECT_TRUE(parser().IsObjectFree(2));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefLazilyWithObjectStreamInOlderSection) {
+  // Object 5 is in object stream 4, which only the older section has. The
+  // older section also has enough entries for the merged table to move its
+  // entries around, so it points most of them at the catalog.
+  std::string data =
+      "%PDF-1.7\n"
+      "1 0 obj\n"
+      "<< /Type /Catalog >>\n"
+      "endobj\n";
+  const std::string object_stream_pos = std::to_string(data.size());
+  data +=
+      "4 0 obj\n"
+      "<< /Type /ObjStm /N 1 /First 4 /Length 10 >>\n"
+      "stream\n"
+      "5 0 (five)\n"
+      "endstream\n"
+      "endobj\n";
+  const std::string prev_xref_pos = std::to_string(data.size());
+  data += "xref\n0 100\n0000000000 65535 f\r\n0000000009 00000 n\r\n";
+  for (int i = 2; i < 100; ++i) {
+    if (i == 4) {
+      data += std::string(10 - object_stream_pos.size(), '0') +
+              object_stream_pos + " 00000 n\r\n";
+    } else {
+      data += "0000000009 00000 n\r\n";
+    }
+  }
+  data += "trailer\n<< /Size 100 /Root 1 0 R >>\nstartxref\n" +
+          prev_xref_pos + "\n%%EOF\n";
+  const size_t xref_pos = data.size();
+  ASSERT_LT(xref_pos, 0x1000u);
+  const char kHexDigits[] = "0123456789ABCDEF";
+  data +=
+      "100 0 obj\n"
+      "<< /Type /XRef /Filter /ASCIIHexDecode /Index [5 1 100 1]\n"
+      "   /W [1 2 1] /Size 101 /Root 1 0 R /Prev " +
+      prev_xref_pos +
+      " >>\n"
+      "stream\n"
+      "02 0004 00\n"
+      "01 0" +
+      kHexDigits[xref_pos >> 8] + kHexDigits[(xref_pos >> 4) & 0xF] +
+      kHexDigits[xref_pos & 0xF] +
+      " 00\n"
+      "endstream\n"
+      "endobj\n"
+      "startxref\n" +
+      std::to_string(xref_pos) + "\n%%EOF\n";
+
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                    pdfium::as_byte_span(data)),
+                                "", CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_FALSE(parser().GetCrossRefTableForTesting()->GetObjectInfo(1));
+
+  // Loading the object stream loads the older section while the entry for
+  // object 5 is in use.
+  RetainPtr<CPDF_Object> object = parser().ParseIndirectObject(5);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("five", object->GetString());
+  EXPECT_EQ(9, parser().GetObjectPositionOrZero(1));
+  EXPECT_EQ(std::stoi(object_stream_pos), parser().GetObjectPositionOrZero(4));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefLazilyMergesOlderTrailers) {
+  // Only the trailer of the older section has /Info and /ID.
+  const unsigned char kData[] =
+      "%PDF-1.7\n"
+      "1 0 obj\n"
+      "<< /Type /Catalog >>\n"
+      "endobj\n"
+      "2 0 obj\n"
+      "(old)\n"
+      "endobj\n"
+      "3 0 obj\n"
+      "<< /Title (Title) >>\n"
+      "endobj\n"
+      "xref\n"
+      "0 4\n"
+      "0000000000 65535 f\r\n"
+      "0000000009 00000 n\r\n"
+      "0000000045 00000 n\r\n"
+      "0000000066 00000 n\r\n"
+      "trailer\n"
+      "<< /Size 4 /Root 1 0 R /Info 3 0 R /ID [<01> <02>] >>\n"
+      "startxref\n"
+      "102\n"
+      "%%EOF\n"
+      "2 0 obj\n"
+      "(new)\n"
+      "endobj\n"
+      "xref\n"
+      "0 1\n"
+      "0000000000 65535 f\r\n"
+      "2 1\n"
+      "0000000273 00000 n\r\n"
+      "trailer\n"
+      "<< /Size 4 /Root 1 0 R /Prev 102 >>\n"
+      "startxref\n"
+      "294\n"
+      "%%EOF\n";
+  CPDF_TestParser eager_parser;
+  EXPECT_CALL(eager_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(pdfium::MakeRetain<CPDF_Dictionary>()));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            eager_parser.StartParse(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kData), "",
+                /*load_flags=*/0));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(kData), "",
+                CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+
+  // Same as when loading all sections.
+  EXPECT_EQ(3u, eager_parser.GetInfoObjNum());
+  EXPECT_EQ(3u, parser().GetInfoObjNum());
+  RetainPtr<const CPDF_Array> id_array = parser().GetIDArray();
+  ASSERT_TRUE(id_array);
+  EXPECT_EQ(2u, id_array->size());
+  EXPECT_EQ("\x02", id_array->GetByteStringAt(1));
+
+  // Merging the trailers does not load the older section's entries.
+  EXPECT_FALSE(parser().GetCrossRefTableForTesting()->GetObjectInfo(1));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefLazilyReadsOlderTrailersOnDemand) {
+  // Only the trailer of the older section has /Info, and padding keeps the
+  // older section away from the pages of the file read when opening it.
+  const std::string padding = "%" + std::string(300000, ' ') + "\n";
+  std::string data =
+      "%PDF-1.7\n"
+      "1 0 obj\n"
+      "<< /Type /Catalog >>\n"
+      "endobj\n"
+      "3 0 obj\n"
+      "<< /Title (Title) >>\n"
+      "endobj\n" +
+      padding;
+  const size_t prev_xref_pos = data.size();
+  data +=
+      "xref\n"
+      "0 4\n"
+      "0000000000 65535 f\r\n"
+      "0000000009 00000 n\r\n"
+      "0000000000 00000 f\r\n"
+      "0000000045 00000 n\r\n"
+      "trailer\n"
+      "<< /Size 4 /Root 1 0 R /Info 3 0 R >>\n"
+      "startxref\n" +
+      std::to_string(prev_xref_pos) + "\n%%EOF\n";
+  const size_t prev_xref_size = data.size() - prev_xref_pos;
+  data += padding;
+  const std::string object_pos = std::to_string(data.size());
+  data += "2 0 obj\n(new)\nendobj\n";
+  const size_t xref_pos = data.size();
+  data += "xref\n2 1\n" + std::string(10 - object_pos.size(), '0') +
+          object_pos +
+          " 00000 n\r\n"
+          "trailer\n"
+          "<< /Size 4 /Root 1 0 R /Prev " +
+          std::to_string(prev_xref_pos) +
+          " >>\n"
+          "startxref\n" +
+          std::to_string(xref_pos) + "\n%%EOF\n";
+
+  auto stream =
+      pdfium::MakeRetain<ReadRecordingStream>(pdfium::as_byte_span(data));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParse(stream, "", CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_FALSE(stream->WasRead(prev_xref_pos, prev_xref_size));
+  EXPECT_FALSE(
+      parser().GetCrossRefTableForTesting()->trailer()->KeyExist("Info"));
+
+  // Entries the newest trailer has do not need the older one.
+  EXPECT_EQ(1u, parser().GetRootObjNum());
+  EXPECT_FALSE(parser().GetEncryptDict());
+  EXPECT_FALSE(stream->WasRead(prev_xref_pos, prev_xref_size));
+
+  // Asking for /Info merges in the older trailer, and keeps the result, but
+  // still does not load the older section's entries.
+  EXPECT_EQ(3u, parser().GetInfoObjNum());
+  EXPECT_TRUE(stream->WasRead(prev_xref_pos, prev_xref_size));
+  EXPECT_TRUE(
+      parser().GetCrossRefTableForTesting()->trailer()->KeyExist("Info"));
+  EXPECT_FALSE(parser().GetCrossRefTableForTesting()->GetObjectInfo(1));
+  EXPECT_EQ(3u, parser().GetInfoObjNum());
+  EXPECT_EQ(45, parser().GetObjectPositionOrZero(3));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefIndex) {
+  CPDF_TestParser first_parser;
+  EXPECT_CALL(first_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(pdfium::MakeRetain<CPDF_Dictionary>()));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            first_parser.StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                        kIncrementallyUpdatedData),
+                                    "", CPDF_Parser::kLoadCrossRefLazily));
+  EXPECT_FALSE(first_parser.loaded_cross_ref_index());
+
+  // Serializing loads the pending sections, so the index covers them too.
+  const DataVector<uint8_t> index = first_parser.SerializeCrossRefIndex();
+  ASSERT_FALSE(index.empty());
+
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParseWithCrossRefIndex(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                    kIncrementallyUpdatedData),
+                "", index));
+  EXPECT_TRUE(parser().loaded_cross_ref_index());
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_EQ(first_parser.GetLastXRefOffset(), parser().GetLastXRefOffset());
+  EXPECT_EQ(first_parser.GetRootObjNum(), parser().GetRootObjNum());
+
+  std::vector<std::pair<uint32_t, CPDF_CrossRefTable::ObjectInfo>> expected;
+  for (const auto& [obj_num, info] :
+       first_parser.GetCrossRefTableForTesting()->objects_info()) {
+    expected.emplace_back(obj_num, info);
+  }
+  EXPECT_THAT(parser().GetCrossRefTableForTesting()->objects_info(),
+              testing::ElementsAreArray(expected));
+
+  RetainPtr<CPDF_Object> object = parser().ParseIndirectObject(3);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("three", object->GetString());
+
+  // An index from a parser that loaded an index matches the original.
+  EXPECT_EQ(index, parser().SerializeCrossRefIndex());
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefIndexForOtherFile) {
+  CPDF_TestParser first_parser;
+  EXPECT_CALL(first_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(pdfium::MakeRetain<CPDF_Dictionary>()));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            first_parser.StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                        kIncrementallyUpdatedData),
+                                    "", /*load_flags=*/0));
+  const DataVector<uint8_t> index = first_parser.SerializeCrossRefIndex();
+  ASSERT_FALSE(index.empty());
+
+  // Same size, but the first object differs.
+  DataVector<uint8_t> data(std::begin(kIncrementallyUpdatedData),
+                           std::end(kIncrementallyUpdatedData));
+  data[24] = 'X';
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParseWithCrossRefIndex(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data), "", index));
+  EXPECT_FALSE(parser().loaded_cross_ref_index());
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+  EXPECT_EQ(9, parser().GetObjectPositionOrZero(1));
+}
+
+TEST_F(ParserXRefTest, LoadCrossRefIndexWithMovedObject) {
+  // Objects 2 and 3 have the same size, so swapping them, along with their
+  // cross reference entries, keeps the file size. The free entries after them
+  // keep their entries out of the end of the file the index digest covers.
+  auto make_data = [](bool swapped) {
+    const std::string objects[] = {"2 0 obj\n(two)\nendobj\n",
+                                   "3 0 obj\n(six)\nendobj\n"};
+    std::string data =
+        "%PDF-1.7\n"
+        "1 0 obj\n"
+        "<< /Type /Catalog >>\n"
+        "endobj\n";
+    const size_t first_pos = data.size();
+    data += objects[swapped ? 1 : 0];
+    const size_t second_pos = data.size();
+    data += objects[swapped ? 0 : 1];
+    const size_t xref_pos = data.size();
+    auto entry = [](size_t pos) {
+      const std::string offset = std::to_string(pos);
+      return std::string(10 - offset.size(), '0') + offset + " 00000 n\r\n";
+    };
+    data += "xref\n0 104\n0000000000 65535 f\r\n" + entry(9) +
+            entry(swapped ? second_pos : first_pos) +
+            entry(swapped ? first_pos : second_pos);
+    for (int i = 4; i < 104; ++i) {
+      data += "0000000000 65535 f\r\n";
+    }
+    data +=
+        "trailer\n"
+        "<< /Size 104 /Root 1 0 R >>\n"
+        "startxref\n" +
+        std::to_string(xref_pos) + "\n%%EOF\n";
+    return data;
+  };
+  const std::string data = make_data(/*swapped=*/false);
+  const std::string swapped_data = make_data(/*swapped=*/true);
+  ASSERT_EQ(data.size(), swapped_data.size());
+  ASSERT_LT(data.find("xref\n") + 100,
+            data.size() - CPDF_CrossRefIndex::kDigestTailSize);
+
+  CPDF_TestParser first_parser;
+  EXPECT_CALL(first_parser.object_holder(), ParseIndirectObject)
+      .WillRepeatedly(Return(pdfium::MakeRetain<CPDF_Dictionary>()));
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            first_parser.StartParse(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                                        pdfium::as_byte_span(data)),
+                                    "", /*load_flags=*/0));
+  const DataVector<uint8_t> index = first_parser.SerializeCrossRefIndex();
+  ASSERT_FALSE(index.empty());
+
+  // The end of the file matches, so the index loads.
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParseWithCrossRefIndex(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                    pdfium::as_byte_span(swapped_data)),
+                "", index));
+  EXPECT_TRUE(parser().loaded_cross_ref_index());
+
+  // The header at the indexed offset of object 2 belongs to object 3, so the
+  // parser drops the index and reads the cross reference table instead.
+  RetainPtr<CPDF_Object> object = parser().ParseIndirectObject(2);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("two", object->GetString());
+  EXPECT_FALSE(parser().loaded_cross_ref_index());
+  EXPECT_FALSE(parser().xref_table_rebuilt());
+
+  object = parser().ParseIndirectObject(3);
+  ASSERT_TRUE(object);
+  EXPECT_EQ("six", object->GetString());
+}
+
+TEST_F(ParserXRefTest, LoadMalformedCrossRefIndex) {
+  const uint8_t kIndex[] = {'P', 'D', 'F', 'X', 'R', 'I', 'D', 'X', 1};
+  ASSERT_EQ(CPDF_Parser::SUCCESS,
+            parser().StartParseWithCrossRefIndex(
+                pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+                    kIncrementallyUpdatedData),
+                "", kIndex));
+  EXPECT_FALSE(parser().loaded_cross_ref_index());
+  EXPECT_EQ(3u, parser().GetLastObjNum());
+  EXPECT_EQ(66, parser().GetObjectPositionOrZero(3));
+}
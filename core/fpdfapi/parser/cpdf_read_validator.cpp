@@ -8,13 +8,24 @@
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/notreached.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 
 namespace {
 
 constexpr FX_FILESIZE kAlignBlockValue = CPDF_Stream::kFileBufSize;
 
+// Read-ahead limits. Held back requests that are at most
+// `kMaxCoalesceGap` apart are sent as one, since one round trip costs more
+// than downloading a few extra KB. Extents larger than `kMaxExtentSize` are
+// not fetched as a whole.
+constexpr FX_FILESIZE kMinReadAheadSize = 4 * 1024;
+constexpr FX_FILESIZE kMaxReadAheadSize = 256 * 1024;
+constexpr FX_FILESIZE kMaxCoalesceGap = 8 * 1024;
+constexpr FX_FILESIZE kMaxExtentSize = 1024 * 1024;
+
 FX_FILESIZE AlignDown(FX_FILESIZE offset) {
   return offset > 0 ? (offset - offset % kAlignBlockValue) : 0;
 }
@@ -49,6 +60,36 @@ CPDF_ReadValidator::CPDF_ReadValidator(
 
 CPDF_ReadValidator::~CPDF_ReadValidator() = default;
 
+void CPDF_ReadValidator::SetDownloadHints(
+    CPDF_DataAvail::DownloadHints* hints) {
+  if (hints_ != hints) {
+    FlushPendingDownloads();
+  }
+  hints_ = hints;
+}
+
+void CPDF_ReadValidator::SetReadAheadEnabled(bool enabled) {
+  if (!enabled) {
+    FlushPendingDownloads();
+    read_ahead_size_ = 0;
+  }
+  read_ahead_enabled_ = enabled;
+}
+
+void CPDF_ReadValidator::SetExtents(std::vector<Extent> extents) {
+  auto it = std::remove_if(
+      extents.begin(), extents.end(), [this](const Extent& extent) {
+        return extent.offset < 0 || extent.length <= 0 ||
+               extent.offset >= file_size_ || extent.length > kMaxExtentSize;
+      });
+  extents.erase(it, extents.end());
+  std::sort(extents.begin(), extents.end(),
+            [](const Extent& a, const Extent& b) {
+              return a.offset < b.offset;
+            });
+  extents_ = std::move(extents);
+}
+
 void CPDF_ReadValidator::ResetErrors() {
   read_error_ = false;
   has_unavailable_data_ = false;
@@ -87,33 +128,152 @@ FX_FILESIZE CPDF_ReadValidator::GetSize() {
   return file_size_;
 }
 
+pdfium::span<const uint8_t> CPDF_ReadValidator::GetSpanAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  if (offset < 0) {
+    return {};
+  }
+
+  FX_SAFE_FILESIZE end_offset = offset;
+  end_offset += size;
+  if (!end_offset.IsValid() || end_offset.ValueOrDie() > file_size_) {
+    return {};
+  }
+
+  pdfium::span<const uint8_t> view = file_read_->GetSpanAtOffset(offset, size);
+  if (view.empty() || !IsDataRangeAvailable(offset, size)) {
+    return {};
+  }
+  return view;
+}
+
+RetainPtr<IFX_SeekableReadStream> CPDF_ReadValidator::CreateSharedSubStream(
+    FX_FILESIZE offset,
+    size_t size) {
+  pdfium::span<const uint8_t> view = GetSpanAtOffset(offset, size);
+  if (view.empty()) {
+    return nullptr;
+  }
+  return pdfium::MakeRetain<CFX_ReadOnlySpanStream>(view, file_read_);
+}
+
 void CPDF_ReadValidator::ScheduleDownload(FX_FILESIZE offset, size_t size) {
   has_unavailable_data_ = true;
+  ++download_stats_.stalls;
   if (!hints_ || size == 0) {
     return;
   }
 
-  const FX_FILESIZE start_segment_offset = AlignDown(offset);
-  FX_SAFE_FILESIZE end_segment_offset = offset;
-  end_segment_offset += size;
-  if (!end_segment_offset.IsValid()) {
+  FX_SAFE_FILESIZE end_offset = offset;
+  end_offset += size;
+  if (!end_offset.IsValid()) {
     // TODO(crbug.com/42271016): Figure out if this should be a CHECK() or the
     // DCHECK() removed.
     DCHECK(false);
     return;
   }
-  end_segment_offset =
-      std::min(file_size_, AlignUp(end_segment_offset.ValueOrDie()));
 
-  FX_SAFE_SIZE_T segment_size = end_segment_offset;
-  segment_size -= start_segment_offset;
-  if (!segment_size.IsValid()) {
+  const Range read = {offset,
+                      std::min(file_size_, static_cast<FX_FILESIZE>(
+                                               end_offset.ValueOrDie()))};
+  Range segment = {AlignDown(read.start),
+                   std::min(file_size_, AlignUp(read.end))};
+  if (segment.end <= segment.start) {
+    return;
+  }
+
+  if (read_ahead_enabled_) {
+    pending_reads_.push_back(read);
+    pending_segments_.push_back(ExtendForReadAhead(read, segment));
+    return;
+  }
+
+  FX_SAFE_SIZE_T safe_segment_size = segment.end;
+  safe_segment_size -= segment.start;
+  if (!safe_segment_size.IsValid()) {
     // TODO(crbug.com/42271016): Figure out if this should be a CHECK() or the
     // DCHECK() removed.
     DCHECK(false);
     return;
   }
-  hints_->AddSegment(start_segment_offset, segment_size.ValueOrDie());
+  const size_t segment_size = safe_segment_size.ValueOrDie();
+  ++download_stats_.requests;
+  download_stats_.requested_bytes += segment_size;
+  download_stats_.over_fetched_bytes += segment_size - (read.end - read.start);
+  hints_->AddSegment(segment.start, segment_size);
+}
+
+CPDF_ReadValidator::Range CPDF_ReadValidator::ExtendForReadAhead(
+    const Range& read,
+    Range segment) {
+  // Grow the read-ahead while requests continue where the previous one
+  // ended, and drop it on the first jump elsewhere.
+  const bool sequential = last_request_.end > 0 &&
+                          segment.start >= last_request_.start &&
+                          segment.start <= last_request_.end;
+  read_ahead_size_ =
+      sequential ? std::clamp(read_ahead_size_ * 2, kMinReadAheadSize,
+                              kMaxReadAheadSize)
+                 : 0;
+  segment.end = std::min(file_size_, segment.end + read_ahead_size_);
+
+  auto it = std::upper_bound(extents_.begin(), extents_.end(), read.start,
+                             [](FX_FILESIZE offset, const Extent& extent) {
+                               return offset < extent.offset;
+                             });
+  if (it != extents_.begin()) {
+    --it;
+    if (read.start < it->offset + it->length) {
+      segment.start = std::min(segment.start, AlignDown(it->offset));
+      segment.end = std::max(
+          segment.end, std::min(file_size_, AlignUp(it->offset + it->length)));
+    }
+  }
+  last_request_ = segment;
+  return segment;
+}
+
+void CPDF_ReadValidator::FlushPendingDownloads() {
+  if (pending_segments_.empty()) {
+    return;
+  }
+
+  auto merge = [](std::vector<Range>& ranges, FX_FILESIZE max_gap) {
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+      return a.start < b.start;
+    });
+    size_t merged_count = 0;
+    for (const Range& range : ranges) {
+      if (merged_count > 0 &&
+          range.start <= ranges[merged_count - 1].end + max_gap) {
+        Range& last = ranges[merged_count - 1];
+        last.end = std::max(last.end, range.end);
+        continue;
+      }
+      ranges[merged_count++] = range;
+    }
+    ranges.resize(merged_count);
+  };
+  merge(pending_reads_, 0);
+  merge(pending_segments_, kMaxCoalesceGap);
+
+  uint64_t read_bytes = 0;
+  for (const Range& read : pending_reads_) {
+    read_bytes += read.end - read.start;
+  }
+  uint64_t segment_bytes = 0;
+  for (const Range& segment : pending_segments_) {
+    const size_t segment_size =
+        pdfium::checked_cast<size_t>(segment.end - segment.start);
+    segment_bytes += segment_size;
+    ++download_stats_.requests;
+    hints_->AddSegment(segment.start, segment_size);
+  }
+  download_stats_.requested_bytes += segment_bytes;
+  download_stats_.over_fetched_bytes += segment_bytes - read_bytes;
+  pending_reads_.clear();
+  pending_segments_.clear();
 }
 
 bool CPDF_ReadValidator::IsDataRangeAvailable(FX_FILESIZE offset,
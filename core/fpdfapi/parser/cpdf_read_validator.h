@@ -5,6 +5,11 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 #define CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
 #include "core/fxcrt/fx_memory.h"
 #include "core/fxcrt/fx_stream.h"
@@ -28,11 +33,41 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
     const bool saved_has_unavailable_data_;
   };
 
+  // Counters for the download requests made through the download hints.
+  struct DownloadStats {
+    // Number of segments passed to DownloadHints::AddSegment().
+    size_t requests = 0;
+    // Total size of those segments.
+    uint64_t requested_bytes = 0;
+    // Part of `requested_bytes` that no read asked for, because of block
+    // alignment, merged gaps and read-ahead.
+    uint64_t over_fetched_bytes = 0;
+    // Number of reads and range checks that found their data unavailable.
+    size_t stalls = 0;
+  };
+
+  // A part of the file that is likely to be read as a whole, such as the
+  // objects of one page of a linearized file.
+  struct Extent {
+    FX_FILESIZE offset;
+    FX_FILESIZE length;
+  };
+
   CONSTRUCT_VIA_MAKE_RETAIN;
 
-  void SetDownloadHints(CPDF_DataAvail::DownloadHints* hints) {
-    hints_ = hints;
-  }
+  // Changing the download hints sends any requests held back by read-ahead
+  // to the previous hints.
+  void SetDownloadHints(CPDF_DataAvail::DownloadHints* hints);
+
+  // With read-ahead enabled, requests are held back until the download hints
+  // change, and then sent with nearby requests merged. Requests that continue
+  // where the previous one ended double the read-ahead size, up to a limit,
+  // and requests that fall into a known extent cover the whole extent.
+  void SetReadAheadEnabled(bool enabled);
+  bool read_ahead_enabled() const { return read_ahead_enabled_; }
+  void SetExtents(std::vector<Extent> extents);
+  const DownloadStats& download_stats() const { return download_stats_; }
+
   bool read_error() const { return read_error_; }
   bool has_unavailable_data() const { return has_unavailable_data_; }
   bool has_read_problems() const {
@@ -44,10 +79,20 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   bool CheckDataRangeAndRequestIfUnavailable(FX_FILESIZE offset, size_t size);
   bool CheckWholeFileAndRequestIfUnavailable();
 
+  // Returns a stream over the given range that shares memory with the
+  // underlying file and keeps it alive, or nullptr if the underlying file does
+  // not keep its contents in memory or the range is not available yet.
+  RetainPtr<IFX_SeekableReadStream> CreateSharedSubStream(FX_FILESIZE offset,
+                                                          size_t size);
+
   // IFX_SeekableReadStream overrides:
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
   FX_FILESIZE GetSize() override;
+  // Never schedules downloads. Returns an empty span for ranges that are not
+  // available yet, leaving it to ReadBlockAtOffset() to request them.
+  pdfium::span<const uint8_t> GetSpanAtOffset(FX_FILESIZE offset,
+                                              size_t size) override;
 
  protected:
   CPDF_ReadValidator(RetainPtr<IFX_SeekableReadStream> file_read,
@@ -55,7 +100,14 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   ~CPDF_ReadValidator() override;
 
  private:
+  struct Range {
+    FX_FILESIZE start;
+    FX_FILESIZE end;
+  };
+
   void ScheduleDownload(FX_FILESIZE offset, size_t size);
+  Range ExtendForReadAhead(const Range& read, Range segment);
+  void FlushPendingDownloads();
   bool IsDataRangeAvailable(FX_FILESIZE offset, size_t size) const;
 
   RetainPtr<IFX_SeekableReadStream> const file_read_;
@@ -64,7 +116,17 @@ class CPDF_ReadValidator : public IFX_SeekableReadStream {
   bool read_error_ = false;
   bool has_unavailable_data_ = false;
   bool whole_file_already_available_ = false;
+  bool read_ahead_enabled_ = false;
   const FX_FILESIZE file_size_;
+  FX_FILESIZE read_ahead_size_ = 0;
+  Range last_request_ = {0, 0};
+  // Sorted by offset.
+  std::vector<Extent> extents_;
+  // Requests held back by read-ahead, as asked for by the readers and as
+  // extended for download.
+  std::vector<Range> pending_reads_;
+  std::vector<Range> pending_segments_;
+  DownloadStats download_stats_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_READ_VALIDATOR_H_
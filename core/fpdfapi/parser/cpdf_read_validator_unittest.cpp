@@ -8,10 +8,12 @@
 
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/cfx_read_only_vector_stream.h"
 #include "core/fxcrt/data_vector.h"
+#include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/invalid_seekable_read_stream.h"
 
@@ -53,16 +55,26 @@ class MockDownloadHints final : public CPDF_DataAvail::DownloadHints {
   void AddSegment(FX_FILESIZE offset, size_t size) override {
     last_requested_range_.first = offset;
     last_requested_range_.second = offset + size;
+    requested_ranges_.push_back(last_requested_range_);
   }
 
   const std::pair<FX_FILESIZE, FX_FILESIZE>& GetLastRequstedRange() const {
     return last_requested_range_;
   }
 
-  void Reset() { last_requested_range_ = MakeRange(0, 0); }
+  const std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>>& GetRequestedRanges()
+      const {
+    return requested_ranges_;
+  }
+
+  void Reset() {
+    last_requested_range_ = MakeRange(0, 0);
+    requested_ranges_.clear();
+  }
 
  private:
   std::pair<FX_FILESIZE, FX_FILESIZE> last_requested_range_;
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> requested_ranges_;
 };
 
 }  // namespace
@@ -300,3 +312,129 @@ TEST(ReadValidatorTest, CheckDataRangeAndRequestIfUnavailable) {
 
   validator->SetDownloadHints(nullptr);
 }
+
+TEST(ReadValidatorTest, DownloadStats) {
+  DataVector<uint8_t> test_data(kTestDataSize);
+  auto file =
+      pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(test_data));
+  MockFileAvail file_avail;
+  auto validator =
+      pdfium::MakeRetain<CPDF_ReadValidator>(std::move(file), &file_avail);
+
+  // Stalls are counted even when there is nowhere to send requests to.
+  DataVector<uint8_t> read_buffer(100);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 5000));
+  EXPECT_EQ(1u, validator->download_stats().stalls);
+  EXPECT_EQ(0u, validator->download_stats().requests);
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 5000));
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 6000));
+  validator->SetDownloadHints(nullptr);
+
+  const CPDF_ReadValidator::DownloadStats& stats =
+      validator->download_stats();
+  EXPECT_EQ(3u, stats.stalls);
+  EXPECT_EQ(2u, stats.requests);
+  EXPECT_EQ(1024u, stats.requested_bytes);
+  EXPECT_EQ(824u, stats.over_fetched_bytes);
+}
+
+TEST(ReadValidatorTest, ReadAheadMergesNearbyRequests) {
+  DataVector<uint8_t> test_data(kTestDataSize);
+  auto file =
+      pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(test_data));
+  MockFileAvail file_avail;
+  auto validator =
+      pdfium::MakeRetain<CPDF_ReadValidator>(std::move(file), &file_avail);
+  validator->SetReadAheadEnabled(true);
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+  DataVector<uint8_t> read_buffer(100);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 40000));
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 5000));
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 8000));
+
+  // Nothing is sent until the hints change.
+  EXPECT_TRUE(hints.GetRequestedRanges().empty());
+  validator->SetDownloadHints(nullptr);
+
+  // The two requests that are close together are merged, and the one far
+  // away stays separate.
+  EXPECT_THAT(hints.GetRequestedRanges(),
+              testing::ElementsAre(MakeRange(4608, 8192),
+                                   MakeRange(39936, 40448)));
+  const CPDF_ReadValidator::DownloadStats& stats =
+      validator->download_stats();
+  EXPECT_EQ(3u, stats.stalls);
+  EXPECT_EQ(2u, stats.requests);
+  EXPECT_EQ(4096u, stats.requested_bytes);
+  EXPECT_EQ(3796u, stats.over_fetched_bytes);
+}
+
+TEST(ReadValidatorTest, ReadAheadGrowsOnSequentialRequests) {
+  DataVector<uint8_t> test_data(kTestDataSize);
+  auto file =
+      pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(test_data));
+  MockFileAvail file_avail;
+  auto validator =
+      pdfium::MakeRetain<CPDF_ReadValidator>(std::move(file), &file_avail);
+  validator->SetReadAheadEnabled(true);
+
+  MockDownloadHints hints;
+  DataVector<uint8_t> read_buffer(100);
+  FX_FILESIZE offset = 0;
+  std::vector<FX_FILESIZE> request_sizes;
+  for (int i = 0; i < 4; ++i) {
+    hints.Reset();
+    validator->SetDownloadHints(&hints);
+    EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, offset));
+    validator->SetDownloadHints(nullptr);
+    ASSERT_EQ(1u, hints.GetRequestedRanges().size());
+    const auto& range = hints.GetLastRequstedRange();
+    request_sizes.push_back(range.second - range.first);
+
+    // Receive the data and continue reading right after it.
+    file_avail.SetAvailableRange(0, range.second);
+    offset = range.second;
+  }
+  EXPECT_THAT(request_sizes, testing::ElementsAre(512, 4608, 8704, 16896));
+
+  // A jump elsewhere resets the read-ahead.
+  hints.Reset();
+  validator->SetDownloadHints(&hints);
+  EXPECT_FALSE(validator->ReadBlockAtOffset(read_buffer, 50000));
+  validator->SetDownloadHints(nullptr);
+  EXPECT_THAT(hints.GetRequestedRanges(),
+              testing::ElementsAre(MakeRange(49664, 50176)));
+}
+
+TEST(ReadValidatorTest, ReadAheadCoversExtents) {
+  DataVector<uint8_t> test_data(kTestDataSize);
+  auto file =
+      pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(test_data));
+  MockFileAvail file_avail;
+  auto validator =
+      pdfium::MakeRetain<CPDF_ReadValidator>(std::move(file), &file_avail);
+  validator->SetExtents({{30000, 10000}, {10000, 3000}});
+
+  MockDownloadHints hints;
+  validator->SetDownloadHints(&hints);
+  EXPECT_FALSE(validator->CheckDataRangeAndRequestIfUnavailable(11000, 10));
+  validator->SetDownloadHints(nullptr);
+  // Extents are ignored without read-ahead.
+  EXPECT_THAT(hints.GetRequestedRanges(),
+              testing::ElementsAre(MakeRange(10752, 11776)));
+
+  hints.Reset();
+  validator->SetReadAheadEnabled(true);
+  validator->SetDownloadHints(&hints);
+  EXPECT_FALSE(validator->CheckDataRangeAndRequestIfUnavailable(11000, 10));
+  EXPECT_FALSE(validator->CheckDataRangeAndRequestIfUnavailable(35000, 10));
+  validator->SetDownloadHints(nullptr);
+  EXPECT_THAT(hints.GetRequestedRanges(),
+              testing::ElementsAre(MakeRange(9728, 13312),
+                                   MakeRange(29696, 40448)));
+}
@@ -0,0 +1,584 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_rebuild_scanner.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fpdfapi/parser/fpdf_parser_simd.h"
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/ptr_util.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
+
+namespace {
+
+using UncleanBytes = CPDF_RebuildScanner::UncleanBytes;
+
+constexpr size_t kBlockSize = CPDF_RebuildScanner::kBlockSize;
+static_assert(CPDF_RebuildScanner::kChunkAlignment % kBlockSize == 0);
+
+// Bytes read in front of each chunk, so the object headers that end in a
+// chunk can usually be checked without looking at other chunks.
+constexpr FX_FILESIZE kLeadingContext = 256;
+
+// Bytes read after each chunk. Enough to check the end of any keyword that
+// starts in the chunk.
+constexpr FX_FILESIZE kTrailingContext = 16;
+
+// CPDF_SyntaxParser truncates longer words, which throws off the positions
+// RebuildCrossRef() records for them.
+constexpr FX_FILESIZE kMaxWordLength = 256;
+
+constexpr size_t kMaxThreads = 8;
+
+constexpr char kEndObjStr[] = "endobj";
+constexpr char kEndStreamStr[] = "endstream";
+constexpr char kStreamStr[] = "stream";
+constexpr char kTrailerStr[] = "trailer";
+static_assert(sizeof(kEndStreamStr) <= kTrailingContext);
+
+// The first three bytes of "obj", "endobj" / "endstream", "stream" and
+// "trailer".
+constexpr std::array<uint8_t, 3> kKeywordPrefixes[] = {
+    {'o', 'b', 'j'}, {'e', 'n', 'd'}, {'s', 't', 'r'}, {'t', 'r', 'a'}};
+
+constexpr uint8_t kUncleanChars[] = {'(', '<', '%'};
+
+enum class Match { kNo, kYes, kUnknown };
+
+// Set through CPDF_RebuildScanner::SetThreadCount().
+std::atomic<int> g_thread_count = 0;
+
+using StreamBody = std::pair<FX_FILESIZE, FX_FILESIZE>;
+
+// A chunk of the document, and what ScanChunk() found in it.
+struct Chunk {
+  // The positions the chunk covers.
+  FX_FILESIZE begin = 0;
+  FX_FILESIZE end = 0;
+  // The document contents at `data_offset`. Includes the context around the
+  // chunk.
+  FX_FILESIZE data_offset = 0;
+  DataVector<uint8_t> data;
+
+  // Keywords are listed in the chunk that holds their first byte, and object
+  // headers in the chunk that holds the "obj" keyword.
+  std::vector<FX_FILESIZE> events;
+  std::vector<FX_FILESIZE> endstream_positions;
+  std::vector<FX_FILESIZE> endobj_positions;
+  std::vector<FX_FILESIZE> stream_positions;
+
+  // The stream bodies found in the chunk, assuming that it does not start in
+  // one. If it does, the body ends at the first "endstream" keyword.
+  std::vector<StreamBody> stream_bodies;
+  bool ends_in_stream_body = false;
+
+  // The unclean bytes in each block before the first "endstream" keyword in
+  // the chunk, which only count if the chunk does not start in a stream body,
+  // and after it.
+  std::vector<UncleanBytes> leading_unclean_blocks;
+  std::vector<UncleanBytes> unclean_blocks;
+};
+
+bool IsRegular(uint8_t ch) {
+  return PDFCharIsNumeric(ch) || PDFCharIsOther(ch);
+}
+
+bool IsUncleanByte(uint8_t ch) {
+  return ch == '(' || ch == '<' || ch == '%';
+}
+
+bool IsCandidate(pdfium::span<const uint8_t> data, size_t offset) {
+  pdfium::span<const uint8_t> bytes = data.subspan(offset, 3u);
+  return std::any_of(std::begin(kKeywordPrefixes), std::end(kKeywordPrefixes),
+                     [bytes](const std::array<uint8_t, 3>& prefix) {
+                       return std::equal(bytes.begin(), bytes.end(),
+                                         prefix.begin());
+                     });
+}
+
+// Calls `callback` with the offsets in [`begin`, `end`) where `data` holds the
+// first three bytes of a keyword the scanner looks for.
+template <typename Callback>
+void ForEachCandidate(pdfium::span<const uint8_t> data,
+                      size_t begin,
+                      size_t end,
+                      Callback callback) {
+  if (data.size() < 3) {
+    return;
+  }
+  end = std::min(end, data.size() - 2);
+  if (begin >= end) {
+    return;
+  }
+  std::vector<size_t> offsets;
+  size_t offset = begin + pdfium::FindPrefixesVectorized(
+                              data.subspan(begin, end + 2 - begin),
+                              kKeywordPrefixes, offsets);
+  for (size_t found : offsets) {
+    callback(begin + found);
+  }
+  for (; offset < end; ++offset) {
+    if (IsCandidate(data, offset)) {
+      callback(offset);
+    }
+  }
+}
+
+bool HasUncleanByte(pdfium::span<const uint8_t> block) {
+  block = block.subspan(pdfium::CountUntilVectorized(block, kUncleanChars));
+  return std::any_of(block.begin(), block.end(), IsUncleanByte);
+}
+
+class ChunkScanner {
+ public:
+  ChunkScanner(Chunk* chunk, FX_FILESIZE size) : chunk_(chunk), size_(size) {}
+
+  void Scan() {
+    pdfium::span<const uint8_t> data = chunk_->data;
+    const size_t begin = static_cast<size_t>(chunk_->begin - chunk_->data_offset);
+    const size_t end = static_cast<size_t>(chunk_->end - chunk_->data_offset);
+    const size_t block_count = (end - begin + kBlockSize - 1) / kBlockSize;
+    chunk_->leading_unclean_blocks.assign(block_count, UncleanBytes());
+    chunk_->unclean_blocks.assign(block_count, UncleanBytes());
+
+    ForEachCandidate(data, begin, end, [this, data](size_t offset) {
+      const FX_FILESIZE pos = chunk_->data_offset + offset;
+      switch (data[offset]) {
+        case 'o':
+          CheckObjectHeader(pos);
+          break;
+        case 't':
+          CheckTrailer(pos);
+          break;
+        case 'e':
+          if (MatchKeyword(pos, kEndStreamStr)) {
+            chunk_->endstream_positions.push_back(pos);
+          } else if (MatchKeyword(pos, kEndObjStr)) {
+            chunk_->endobj_positions.push_back(pos);
+          }
+          break;
+        case 's':
+          CheckStream(pos);
+          break;
+      }
+    });
+
+    FindStreamBodies();
+
+    // Bytes in stream bodies are not marked, as the bodies are unclean as a
+    // whole. Otherwise the binary data in most streams would leave hardly any
+    // clean blocks.
+    FX_FILESIZE pos = chunk_->begin;
+    for (const auto& [body_begin, body_end] : chunk_->stream_bodies) {
+      MarkUncleanBytes(pos, body_begin);
+      pos = body_end;
+    }
+    MarkUncleanBytes(pos, chunk_->end);
+  }
+
+ private:
+  static constexpr int kOutsideDocument = -1;
+  static constexpr int kOutsideData = -2;
+
+  // Returns the byte at `pos`, or one of the constants above.
+  int ByteAt(FX_FILESIZE pos) const {
+    if (pos < 0 || pos >= size_) {
+      return kOutsideDocument;
+    }
+    const FX_FILESIZE offset = pos - chunk_->data_offset;
+    if (offset < 0 || offset >= static_cast<FX_FILESIZE>(chunk_->data.size())) {
+      return kOutsideData;
+    }
+    return chunk_->data[static_cast<size_t>(offset)];
+  }
+
+  bool MatchBytes(FX_FILESIZE pos, ByteStringView word) const {
+    for (size_t i = 0; i < word.GetLength(); ++i) {
+      if (ByteAt(pos + static_cast<FX_FILESIZE>(i)) != word[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void MarkUnclean(FX_FILESIZE pos) {
+    MarkUnclean(pos, chunk_->unclean_blocks);
+  }
+
+  void MarkUnclean(FX_FILESIZE pos,
+                   std::vector<UncleanBytes>& unclean_blocks) {
+    const size_t offset = static_cast<size_t>(pos - chunk_->begin);
+    UncleanBytes& unclean = unclean_blocks[offset / kBlockSize];
+    unclean.first =
+        std::min(unclean.first, static_cast<uint8_t>(offset % kBlockSize));
+    unclean.last =
+        std::max(unclean.last, static_cast<uint8_t>(offset % kBlockSize));
+  }
+
+  // Marks the bytes that start strings, hex strings or comments in [`begin`,
+  // `end`).
+  void MarkUncleanBytes(FX_FILESIZE begin, FX_FILESIZE end) {
+    const FX_FILESIZE leading_end = chunk_->endstream_positions.empty()
+                                        ? chunk_->end
+                                        : chunk_->endstream_positions.front();
+    while (begin < end) {
+      const FX_FILESIZE block_end = std::min<FX_FILESIZE>(
+          end, begin + kBlockSize - (begin - chunk_->begin) % kBlockSize);
+      const FX_FILESIZE part_end =
+          begin < leading_end ? std::min(block_end, leading_end) : block_end;
+      const size_t offset = static_cast<size_t>(begin - chunk_->data_offset);
+      pdfium::span<const uint8_t> part =
+          pdfium::span<const uint8_t>(chunk_->data)
+              .subspan(offset, static_cast<size_t>(part_end - begin));
+      if (HasUncleanByte(part)) {
+        std::vector<UncleanBytes>& unclean_blocks =
+            begin < leading_end ? chunk_->leading_unclean_blocks
+                                : chunk_->unclean_blocks;
+        // Only the first and last unclean bytes in each block count.
+        auto first = std::find_if(part.begin(), part.end(), IsUncleanByte);
+        auto last = std::find_if(part.rbegin(), part.rend(), IsUncleanByte);
+        MarkUnclean(begin + (first - part.begin()), unclean_blocks);
+        MarkUnclean(part_end - 1 - (last - part.rbegin()), unclean_blocks);
+      }
+      begin = part_end;
+    }
+  }
+
+  void AddEvent(Match match, FX_FILESIZE event_pos, FX_FILESIZE keyword_pos) {
+    if (match == Match::kYes) {
+      chunk_->events.push_back(event_pos);
+    } else if (match == Match::kUnknown) {
+      MarkUnclean(keyword_pos);
+    }
+  }
+
+  // Same as IsWholeWord() with `checkKeyword` set.
+  bool MatchKeyword(FX_FILESIZE pos, ByteStringView word) const {
+    if (!MatchBytes(pos, word)) {
+      return false;
+    }
+    const int before = ByteAt(pos - 1);
+    const int after =
+        ByteAt(pos + static_cast<FX_FILESIZE>(word.GetLength()));
+    CHECK_NE(before, kOutsideData);
+    CHECK_NE(after, kOutsideData);
+    return (before == kOutsideDocument || PDFCharIsWhitespace(before)) &&
+           (after == kOutsideDocument || PDFCharIsWhitespace(after));
+  }
+
+  // Checks for the words "N", "G" and "obj" in a row, where N and G are
+  // numbers, as CPDF_SyntaxParser::GetNextWord() would read them.
+  void CheckObjectHeader(FX_FILESIZE obj_pos) {
+    const int after = ByteAt(obj_pos + 3);
+    if (after >= 0 && IsRegular(after)) {
+      return;
+    }
+
+    FX_FILESIZE pos = obj_pos - 1;
+    int ch = kOutsideDocument;
+    for (int i = 0; i < 2; ++i) {
+      const FX_FILESIZE whitespace_end = pos;
+      while ((ch = ByteAt(pos)) >= 0 && PDFCharIsWhitespace(ch)) {
+        --pos;
+      }
+      if (ch == kOutsideData) {
+        AddEvent(Match::kUnknown, 0, obj_pos);
+        return;
+      }
+      if (pos == whitespace_end) {
+        return;
+      }
+      const FX_FILESIZE number_end = pos;
+      while ((ch = ByteAt(pos)) >= 0 && PDFCharIsNumeric(ch)) {
+        --pos;
+      }
+      if (ch == kOutsideData || number_end - pos > kMaxWordLength) {
+        AddEvent(Match::kUnknown, 0, obj_pos);
+        return;
+      }
+      if (pos == number_end) {
+        return;
+      }
+    }
+    // A number that follows other regular characters is part of a longer
+    // word, and one that follows a '/' is part of a name.
+    if (ch >= 0 && (IsRegular(ch) || ch == '/')) {
+      return;
+    }
+    AddEvent(Match::kYes, pos + 1, obj_pos);
+  }
+
+  void CheckTrailer(FX_FILESIZE pos) {
+    const ByteStringView trailer(kTrailerStr);
+    if (!MatchBytes(pos, trailer)) {
+      return;
+    }
+    const int before = ByteAt(pos - 1);
+    const int after =
+        ByteAt(pos + static_cast<FX_FILESIZE>(trailer.GetLength()));
+    if (before == kOutsideData || after == kOutsideData) {
+      AddEvent(Match::kUnknown, 0, pos);
+      return;
+    }
+    if ((before >= 0 && (IsRegular(before) || before == '/')) ||
+        (after >= 0 && IsRegular(after))) {
+      return;
+    }
+    AddEvent(Match::kYes, pos, pos);
+  }
+
+  // Checks for a whole-word "stream" keyword. Missing a keyword, or taking
+  // some other word for one, only makes the scan find fewer clean blocks.
+  void CheckStream(FX_FILESIZE pos) {
+    const ByteStringView stream(kStreamStr);
+    if (!MatchBytes(pos, stream)) {
+      return;
+    }
+    const int before = ByteAt(pos - 1);
+    const int after =
+        ByteAt(pos + static_cast<FX_FILESIZE>(stream.GetLength()));
+    CHECK_NE(before, kOutsideData);
+    CHECK_NE(after, kOutsideData);
+    if ((before >= 0 && IsRegular(before)) ||
+        (after >= 0 && IsRegular(after))) {
+      return;
+    }
+    chunk_->stream_positions.push_back(pos);
+  }
+
+  // Pairs each "stream" keyword outside of a stream body with the first
+  // "endstream" keyword after it. A body that does not end in the chunk
+  // continues into the next one.
+  void FindStreamBodies() {
+    const std::vector<FX_FILESIZE>& endstream_positions =
+        chunk_->endstream_positions;
+    auto endstream_it = endstream_positions.begin();
+    for (FX_FILESIZE stream_pos : chunk_->stream_positions) {
+      if (!chunk_->stream_bodies.empty() &&
+          stream_pos < chunk_->stream_bodies.back().second) {
+        continue;
+      }
+      endstream_it =
+          std::lower_bound(endstream_it, endstream_positions.end(), stream_pos);
+      if (endstream_it == endstream_positions.end()) {
+        chunk_->stream_bodies.emplace_back(stream_pos, chunk_->end);
+        chunk_->ends_in_stream_body = true;
+        return;
+      }
+      chunk_->stream_bodies.emplace_back(stream_pos, *endstream_it);
+    }
+  }
+
+  const UnownedPtr<Chunk> chunk_;
+  const FX_FILESIZE size_;
+};
+
+bool ReadChunk(CPDF_SyntaxParser* syntax,
+               FX_FILESIZE size,
+               FX_FILESIZE begin,
+               size_t chunk_size,
+               Chunk* chunk) {
+  chunk->begin = begin;
+  chunk->end =
+      std::min<FX_FILESIZE>(begin + static_cast<FX_FILESIZE>(chunk_size), size);
+  chunk->data_offset = std::max<FX_FILESIZE>(begin - kLeadingContext, 0);
+  const FX_FILESIZE data_end =
+      std::min<FX_FILESIZE>(chunk->end + kTrailingContext, size);
+  chunk->data =
+      DataVector<uint8_t>(static_cast<size_t>(data_end - chunk->data_offset));
+  syntax->SetPos(chunk->data_offset);
+  return syntax->ReadBlock(chunk->data);
+}
+
+void ScanChunk(Chunk* chunk, FX_FILESIZE size) {
+  ChunkScanner(chunk, size).Scan();
+}
+
+// Each chunk only touches its own data and results, so they can all be
+// scanned at the same time.
+void ScanChunks(pdfium::span<Chunk> chunks, FX_FILESIZE size) {
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    threads.emplace_back(ScanChunk, &chunks[i], size);
+  }
+  ScanChunk(&chunks[0], size);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+template <typename T>
+void Append(std::vector<T>& dest, const std::vector<T>& src) {
+  dest.insert(dest.end(), src.begin(), src.end());
+}
+
+// Appends the stream bodies in `chunk` to `bodies`. `in_stream_body` says
+// whether the last body in `bodies` continues into `chunk`, and gets updated
+// for the next chunk. Returns whether `chunk` starts in a stream body.
+bool AppendStreamBodies(const Chunk& chunk,
+                        std::vector<StreamBody>& bodies,
+                        bool& in_stream_body) {
+  if (!in_stream_body) {
+    Append(bodies, chunk.stream_bodies);
+    in_stream_body = chunk.ends_in_stream_body;
+    return false;
+  }
+
+  if (chunk.endstream_positions.empty()) {
+    bodies.back().second = chunk.end;
+    return true;
+  }
+
+  // Whatever the chunk found before its first "endstream" keyword is part of
+  // the body that continues into it.
+  const FX_FILESIZE first_endstream = chunk.endstream_positions.front();
+  bodies.back().second = first_endstream;
+  auto it = std::lower_bound(chunk.stream_bodies.begin(),
+                             chunk.stream_bodies.end(),
+                             StreamBody(first_endstream, first_endstream));
+  bodies.insert(bodies.end(), it, chunk.stream_bodies.end());
+  in_stream_body = chunk.ends_in_stream_body;
+  return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<CPDF_RebuildScanner> CPDF_RebuildScanner::Scan(
+    CPDF_SyntaxParser* syntax,
+    size_t chunk_size) {
+  CHECK_GT(chunk_size, 0u);
+  CHECK_EQ(chunk_size % kChunkAlignment, 0u);
+
+  const FX_FILESIZE size = syntax->GetDocumentSize();
+  if (size <= 0) {
+    return nullptr;
+  }
+
+  const FX_FILESIZE saved_pos = syntax->GetPos();
+  auto scanner = pdfium::WrapUnique(new CPDF_RebuildScanner(size));
+  const size_t chunk_count =
+      (static_cast<size_t>(size) + chunk_size - 1) / chunk_size;
+  const size_t batch_size =
+      std::clamp<size_t>(g_thread_count.load(), 1, kMaxThreads);
+  bool in_stream_body = false;
+  std::vector<Chunk> batch;
+  for (size_t first = 0; first < chunk_count; first += batch_size) {
+    batch.clear();
+    batch.resize(std::min(batch_size, chunk_count - first));
+    for (size_t i = 0; i < batch.size(); ++i) {
+      const FX_FILESIZE begin =
+          static_cast<FX_FILESIZE>((first + i) * chunk_size);
+      if (!ReadChunk(syntax, size, begin, chunk_size, &batch[i])) {
+        syntax->SetPos(saved_pos);
+        return nullptr;
+      }
+    }
+    ScanChunks(batch, size);
+
+    // Chunks are in document order, and so are the results within each
+    // chunk, so concatenating them gives the same results as scanning the
+    // document in one go.
+    for (Chunk& chunk : batch) {
+      Append(scanner->events_, chunk.events);
+      Append(scanner->endstream_positions_, chunk.endstream_positions);
+      Append(scanner->endobj_positions_, chunk.endobj_positions);
+      if (!AppendStreamBodies(chunk, scanner->stream_bodies_,
+                              in_stream_body)) {
+        for (size_t i = 0; i < chunk.unclean_blocks.size(); ++i) {
+          UncleanBytes& unclean = chunk.unclean_blocks[i];
+          const UncleanBytes& leading = chunk.leading_unclean_blocks[i];
+          unclean.first = std::min(unclean.first, leading.first);
+          unclean.last = std::max(unclean.last, leading.last);
+        }
+      }
+      Append(scanner->unclean_blocks_, chunk.unclean_blocks);
+    }
+  }
+  if (in_stream_body) {
+    scanner->stream_bodies_.back().second = size;
+  }
+  syntax->SetPos(saved_pos);
+  DCHECK(std::is_sorted(scanner->events_.begin(), scanner->events_.end()));
+  return scanner;
+}
+
+// static
+bool CPDF_RebuildScanner::SetThreadCount(int thread_count) {
+  if (thread_count < 0) {
+    return false;
+  }
+  g_thread_count = thread_count;
+  return true;
+}
+
+CPDF_RebuildScanner::CPDF_RebuildScanner(FX_FILESIZE size) : size_(size) {}
+
+CPDF_RebuildScanner::~CPDF_RebuildScanner() = default;
+
+FX_FILESIZE CPDF_RebuildScanner::FindNextEvent(FX_FILESIZE pos) const {
+  auto it = std::lower_bound(events_.begin(), events_.end(), pos);
+  return it != events_.end() ? *it : -1;
+}
+
+bool CPDF_RebuildScanner::IsClean(FX_FILESIZE begin, FX_FILESIZE end) const {
+  end = std::min(end, size_);
+  if (begin >= end) {
+    return true;
+  }
+  if (begin < 0) {
+    return false;
+  }
+
+  auto body_it = std::upper_bound(stream_bodies_.begin(), stream_bodies_.end(),
+                                  begin,
+                                  [](FX_FILESIZE pos, const StreamBody& body) {
+                                    return pos < body.second;
+                                  });
+  if (body_it != stream_bodies_.end() && body_it->first < end) {
+    return false;
+  }
+
+  const size_t first_block = static_cast<size_t>(begin) / kBlockSize;
+  const size_t last_block = static_cast<size_t>(end - 1) / kBlockSize;
+  for (size_t block = first_block; block <= last_block; ++block) {
+    const UncleanBytes& unclean = unclean_blocks_[block];
+    if (unclean.first > unclean.last) {
+      continue;
+    }
+    // Treat the bytes between the first and last unclean byte as unclean.
+    const FX_FILESIZE block_begin =
+        static_cast<FX_FILESIZE>(block * kBlockSize);
+    if (block_begin + unclean.first < end &&
+        block_begin + unclean.last >= begin) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<FX_FILESIZE> CPDF_RebuildScanner::FindWordPos(
+    ByteStringView word,
+    FX_FILESIZE pos) const {
+  const std::vector<FX_FILESIZE>* positions;
+  if (word == ByteStringView(kEndStreamStr)) {
+    positions = &endstream_positions_;
+  } else if (word == ByteStringView(kEndObjStr)) {
+    positions = &endobj_positions_;
+  } else {
+    return std::nullopt;
+  }
+  auto it = std::lower_bound(positions->begin(), positions->end(), pos);
+  return it != positions->end() ? *it : -1;
+}
@@ -0,0 +1,94 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_CPDF_REBUILD_SCANNER_H_
+#define CORE_FPDFAPI_PARSER_CPDF_REBUILD_SCANNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fx_types.h"
+
+class CPDF_SyntaxParser;
+
+// Index of a whole document, built by scanning it in chunks, that lets
+// CPDF_Parser::RebuildCrossRef() skip the parts of a damaged file that cannot
+// hold anything it looks for. The chunks are scanned on the calling thread,
+// unless SetThreadCount() asks for more threads.
+//
+// The scanner finds the places where the syntax parser would read an
+// "N G obj" object header or a "trailer" keyword, and the whole-word
+// "endstream" and "endobj" keywords that ReadStream() searches for when a
+// stream has a bad /Length. Strings, hex strings and comments change how the
+// bytes after them split into words, so the scanner does not try to follow
+// them. Instead, it marks the parts of the document that contain them as
+// unclean, and RebuildCrossRef() reads those parts word by word as before.
+// Stream bodies, from a "stream" keyword to the next "endstream" keyword, are
+// unclean as a whole, so the bytes in them do not affect the parts around
+// them.
+//
+// All positions are relative to the syntax parser's header offset.
+class CPDF_RebuildScanner {
+ public:
+  // Chunk sizes must be multiples of this.
+  static constexpr size_t kChunkAlignment = 4096;
+  static constexpr size_t kDefaultChunkSize = 256 * kChunkAlignment;
+  static constexpr size_t kBlockSize = 64;
+
+  // Where the unclean bytes in a block of `kBlockSize` bytes are. Only the
+  // first and last of them are kept, so `first` > `last` if there are none.
+  struct UncleanBytes {
+    uint8_t first = 0xff;
+    uint8_t last = 0;
+  };
+
+  // Returns nullptr if `syntax` cannot read the whole document. Restores the
+  // position of `syntax` before returning.
+  static std::unique_ptr<CPDF_RebuildScanner> Scan(CPDF_SyntaxParser* syntax,
+                                                   size_t chunk_size);
+
+  // Sets how many threads Scan() may use. 0 and 1 both mean scanning on the
+  // calling thread only, which is the default. Returns false, leaving the
+  // count unchanged, if `thread_count` is negative.
+  static bool SetThreadCount(int thread_count);
+
+  ~CPDF_RebuildScanner();
+
+  // Returns the position of the first object header or "trailer" keyword at
+  // or after `pos`, or -1 if there is none.
+  FX_FILESIZE FindNextEvent(FX_FILESIZE pos) const;
+
+  // Returns whether [`begin`, `end`) is known to hold no strings, hex strings,
+  // comments or stream bodies, and no object headers the scan could not
+  // verify. May return false for ranges that are in fact clean.
+  bool IsClean(FX_FILESIZE begin, FX_FILESIZE end) const;
+
+  // Returns the same result as CPDF_SyntaxParser::FindWordPos() would for
+  // `word` at `pos`, or std::nullopt if the scanner does not index `word`.
+  std::optional<FX_FILESIZE> FindWordPos(ByteStringView word,
+                                         FX_FILESIZE pos) const;
+
+  const std::vector<FX_FILESIZE>& events() const { return events_; }
+
+ private:
+  explicit CPDF_RebuildScanner(FX_FILESIZE size);
+
+  const FX_FILESIZE size_;
+  // Sorted positions of object headers and "trailer" keywords.
+  std::vector<FX_FILESIZE> events_;
+  std::vector<FX_FILESIZE> endstream_positions_;
+  std::vector<FX_FILESIZE> endobj_positions_;
+  // Sorted, non-overlapping [begin, end) ranges of stream bodies.
+  std::vector<std::pair<FX_FILESIZE, FX_FILESIZE>> stream_bodies_;
+  // One entry per block of the document.
+  std::vector<UncleanBytes> unclean_blocks_;
+};
+
+#endif  // CORE_FPDFAPI_PARSER_CPDF_REBUILD_SCANNER_H_
@@ -0,0 +1,266 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/cpdf_rebuild_scanner.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace {
+
+constexpr size_t kSmallChunkSize = CPDF_RebuildScanner::kChunkAlignment;
+
+std::unique_ptr<CPDF_SyntaxParser> CreateSyntaxParser(const std::string& data) {
+  return CPDF_SyntaxParser::CreateForTesting(
+      pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+          ByteStringView(data.c_str(), data.size()).unsigned_span()),
+      0);
+}
+
+std::unique_ptr<CPDF_RebuildScanner> Scan(const std::string& data,
+                                          size_t chunk_size) {
+  std::unique_ptr<CPDF_SyntaxParser> syntax = CreateSyntaxParser(data);
+  return CPDF_RebuildScanner::Scan(syntax.get(), chunk_size);
+}
+
+FX_FILESIZE PosOf(const std::string& data, const char* str) {
+  const size_t pos = data.find(str);
+  CHECK_NE(pos, std::string::npos);
+  return static_cast<FX_FILESIZE>(pos);
+}
+
+}  // namespace
+
+TEST(CPDFRebuildScannerTest, Empty) {
+  EXPECT_FALSE(Scan("", CPDF_RebuildScanner::kDefaultChunkSize));
+}
+
+TEST(CPDFRebuildScannerTest, FindsObjectHeadersAndTrailers) {
+  const std::string data =
+      "1 0 obj\n<</A 2>>\nendobj\n"
+      "12  3\r\nobj[]endobj\n"
+      "/4 0 obj x5 0 obj 6 0 objx 7 0obj 8 x0 obj 1.5 0 obj\n"
+      "trailer\n<<>>\n/trailer xtrailer trailers\n"
+      "9 0 obj";
+  std::unique_ptr<CPDF_RebuildScanner> scanner =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(scanner);
+
+  const FX_FILESIZE trailer_pos = PosOf(data, "trailer\n");
+  EXPECT_THAT(scanner->events(),
+              ElementsAre(0, PosOf(data, "12"), PosOf(data, "1.5"),
+                          trailer_pos, PosOf(data, "9 0 obj")));
+  EXPECT_EQ(0, scanner->FindNextEvent(0));
+  EXPECT_EQ(trailer_pos, scanner->FindNextEvent(PosOf(data, "1.5") + 1));
+  EXPECT_EQ(trailer_pos, scanner->FindNextEvent(trailer_pos));
+  EXPECT_EQ(-1, scanner->FindNextEvent(PosOf(data, "9 0 obj") + 1));
+}
+
+TEST(CPDFRebuildScannerTest, FindWordPos) {
+  const std::string data =
+      "endstream 1 0 obj stream\nabc\r\nendstream\nendobj "
+      "[endobj] xendstream endobjx\nendobj";
+  std::unique_ptr<CPDF_RebuildScanner> scanner =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(scanner);
+
+  const FX_FILESIZE endstream_pos = PosOf(data, "endstream\nendobj");
+  const FX_FILESIZE endobj_pos = PosOf(data, "endobj ");
+  const FX_FILESIZE last_endobj_pos =
+      static_cast<FX_FILESIZE>(data.rfind("endobj"));
+  EXPECT_EQ(0, scanner->FindWordPos("endstream", 0));
+  EXPECT_EQ(endstream_pos, scanner->FindWordPos("endstream", 1));
+  EXPECT_EQ(-1, scanner->FindWordPos("endstream", endstream_pos + 1));
+  EXPECT_EQ(endobj_pos, scanner->FindWordPos("endobj", 0));
+  EXPECT_EQ(last_endobj_pos, scanner->FindWordPos("endobj", endobj_pos + 1));
+  EXPECT_EQ(-1, scanner->FindWordPos("endobj", last_endobj_pos + 1));
+  EXPECT_EQ(std::nullopt, scanner->FindWordPos("stream", 0));
+}
+
+TEST(CPDFRebuildScannerTest, IsClean) {
+  std::string data(1000, ' ');
+  data[100] = '(';
+  data[500] = '%';
+  data[999] = '<';
+  std::unique_ptr<CPDF_RebuildScanner> scanner =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(scanner);
+
+  EXPECT_TRUE(scanner->IsClean(0, 64));
+  EXPECT_FALSE(scanner->IsClean(0, 101));
+  EXPECT_TRUE(scanner->IsClean(128, 448));
+  EXPECT_FALSE(scanner->IsClean(128, 512));
+  EXPECT_FALSE(scanner->IsClean(960, 1000));
+  EXPECT_TRUE(scanner->IsClean(10, 10));
+  EXPECT_TRUE(scanner->IsClean(2000, 3000));
+  EXPECT_THAT(scanner->events(), IsEmpty());
+}
+
+TEST(CPDFRebuildScannerTest, StreamBodies) {
+  std::string body(200, 'x');
+  body[10] = '(';
+  body[100] = '<';
+  body[150] = '%';
+  const std::string data = "1 0 obj\n<</Length 200>>stream\n" + body +
+                           "\nendstream\nendobj\n2 0 obj\n[]\nendobj\n"
+                           "3 0 obj\n<</Length 5>>\nstream\n12345";
+  std::unique_ptr<CPDF_RebuildScanner> scanner =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(scanner);
+
+  // The block with the end of the first stream body holds no unclean bytes
+  // outside of the body.
+  const FX_FILESIZE endstream_pos = PosOf(data, "endstream");
+  const FX_FILESIZE obj2_pos = PosOf(data, "2 0 obj");
+  const FX_FILESIZE obj3_pos = PosOf(data, "3 0 obj");
+  EXPECT_THAT(scanner->events(), ElementsAre(0, obj2_pos, obj3_pos));
+  EXPECT_TRUE(scanner->IsClean(endstream_pos, obj3_pos));
+  EXPECT_FALSE(scanner->IsClean(endstream_pos - 1, obj3_pos));
+  EXPECT_FALSE(scanner->IsClean(PosOf(data, "xxx"), PosOf(data, "xxx") + 1));
+
+  // The last stream body lasts until the end of the document.
+  const FX_FILESIZE size = static_cast<FX_FILESIZE>(data.size());
+  EXPECT_TRUE(scanner->IsClean(obj3_pos, PosOf(data, "<</Length 5")));
+  EXPECT_FALSE(scanner->IsClean(size - 1, size));
+}
+
+TEST(CPDFRebuildScannerTest, StreamBodiesAcrossChunks) {
+  // Stream bodies of varying sizes, with unclean bytes and "stream" keywords
+  // in them, that start and end in different chunks.
+  std::string data = "%PDF-1.7\n";
+  for (int i = 1; data.size() < 5 * kSmallChunkSize; ++i) {
+    data += std::to_string(i) + " 0 obj\n<<>>stream\n";
+    for (int j = 0; j < i * 37; ++j) {
+      data += j % 7 == 0 ? "( stream " : "xyz ";
+    }
+    data += "\nendstream\nendobj\n" + std::string(i * 13 % 200, ' ');
+  }
+
+  std::unique_ptr<CPDF_RebuildScanner> expected =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(expected);
+  std::unique_ptr<CPDF_RebuildScanner> scanner = Scan(data, kSmallChunkSize);
+  ASSERT_TRUE(scanner);
+  EXPECT_EQ(expected->events(), scanner->events());
+  for (FX_FILESIZE pos = 0; pos < static_cast<FX_FILESIZE>(data.size());
+       ++pos) {
+    EXPECT_EQ(expected->IsClean(pos, pos + 1), scanner->IsClean(pos, pos + 1));
+    EXPECT_EQ(expected->IsClean(pos, pos + 100),
+              scanner->IsClean(pos, pos + 100));
+  }
+
+  // Every object but the first, which follows a comment, is in a clean range
+  // from the "endobj" keyword before it.
+  size_t clean_count = 0;
+  for (FX_FILESIZE event : expected->events()) {
+    if (expected->IsClean(event - 7, event + 7)) {
+      ++clean_count;
+    }
+  }
+  EXPECT_EQ(expected->events().size() - 1, clean_count);
+}
+
+TEST(CPDFRebuildScannerTest, ChunkBoundaries) {
+  // Objects of varying sizes, so that the object headers and keywords cross
+  // chunk boundaries in every possible way.
+  std::string data = "%PDF-1.7\n";
+  std::vector<FX_FILESIZE> expected_events;
+  for (int i = 1; data.size() < 5 * kSmallChunkSize; ++i) {
+    data += std::string(i % 5, ' ');
+    expected_events.push_back(static_cast<FX_FILESIZE>(data.size()));
+    data += std::to_string(i) + std::string(1 + i % 3, ' ') + "0" +
+            std::string(1 + i % 2, '\n') + "obj\n" + std::string(i % 11, 'x') +
+            " stream\r\nendstream\nendobj\n";
+    if (i % 50 == 0) {
+      expected_events.push_back(static_cast<FX_FILESIZE>(data.size()));
+      data += "trailer\n";
+    }
+  }
+
+  std::unique_ptr<CPDF_RebuildScanner> expected =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(expected);
+  EXPECT_EQ(expected_events, expected->events());
+
+  std::unique_ptr<CPDF_RebuildScanner> scanner = Scan(data, kSmallChunkSize);
+  ASSERT_TRUE(scanner);
+  EXPECT_EQ(expected_events, scanner->events());
+  for (FX_FILESIZE pos = 0; pos < static_cast<FX_FILESIZE>(data.size());
+       ++pos) {
+    EXPECT_EQ(expected->FindWordPos("endstream", pos),
+              scanner->FindWordPos("endstream", pos));
+    EXPECT_EQ(expected->FindWordPos("endobj", pos),
+              scanner->FindWordPos("endobj", pos));
+    EXPECT_EQ(expected->IsClean(pos, pos + 64),
+              scanner->IsClean(pos, pos + 64));
+  }
+}
+
+TEST(CPDFRebuildScannerTest, LongObjectHeaderAcrossChunks) {
+  // The object header starts long before the chunk with the "obj" keyword.
+  std::string data(kSmallChunkSize - 1000, ' ');
+  data += "1 0";
+  data += std::string(1200, ' ');
+  data += "obj";
+  const FX_FILESIZE obj_pos = PosOf(data, "obj");
+
+  std::unique_ptr<CPDF_RebuildScanner> scanner =
+      Scan(data, CPDF_RebuildScanner::kDefaultChunkSize);
+  ASSERT_TRUE(scanner);
+  EXPECT_THAT(scanner->events(), ElementsAre(PosOf(data, "1 0")));
+  EXPECT_TRUE(scanner->IsClean(0, obj_pos + 3));
+
+  // The scan of the small chunks cannot tell, so it marks the keyword as
+  // unclean.
+  scanner = Scan(data, kSmallChunkSize);
+  ASSERT_TRUE(scanner);
+  EXPECT_THAT(scanner->events(), IsEmpty());
+  EXPECT_TRUE(scanner->IsClean(0, kSmallChunkSize));
+  EXPECT_FALSE(scanner->IsClean(0, obj_pos + 3));
+}
+
+TEST(CPDFRebuildScannerTest, SetThreadCount) {
+  EXPECT_FALSE(CPDF_RebuildScanner::SetThreadCount(-1));
+  EXPECT_TRUE(CPDF_RebuildScanner::SetThreadCount(0));
+  EXPECT_TRUE(CPDF_RebuildScanner::SetThreadCount(1));
+  EXPECT_TRUE(CPDF_RebuildScanner::SetThreadCount(4));
+  EXPECT_TRUE(CPDF_RebuildScanner::SetThreadCount(0));
+}
+
+TEST(CPDFRebuildScannerTest, MultipleThreads) {
+  std::string data = "%PDF-1.7\n";
+  for (int i = 1; data.size() < 10 * kSmallChunkSize; ++i) {
+    data += std::to_string(i) + " 0 obj\n<</Length 20>>stream\n(" +
+            std::string(i % 3000, 'x') + "\nendstream\nendobj\n";
+  }
+
+  std::unique_ptr<CPDF_RebuildScanner> expected = Scan(data, kSmallChunkSize);
+  ASSERT_TRUE(expected);
+
+  ASSERT_TRUE(CPDF_RebuildScanner::SetThreadCount(4));
+  std::unique_ptr<CPDF_RebuildScanner> scanner = Scan(data, kSmallChunkSize);
+  CPDF_RebuildScanner::SetThreadCount(0);
+  ASSERT_TRUE(scanner);
+  EXPECT_EQ(expected->events(), scanner->events());
+  for (FX_FILESIZE pos = 0; pos < static_cast<FX_FILESIZE>(data.size());
+       pos += 16) {
+    EXPECT_EQ(expected->IsClean(pos, pos + 64),
+              scanner->IsClean(pos, pos + 64));
+    EXPECT_EQ(expected->FindWordPos("endstream", pos),
+              scanner->FindWordPos("endstream", pos));
+  }
+}
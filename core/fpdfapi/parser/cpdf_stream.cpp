@@ -164,6 +164,12 @@ DataVector<uint8_t> CPDF_Stream::ReadAllRawData() const {
   return result;
 }
 
+pdfium::span<const uint8_t> CPDF_Stream::GetSharedRawData() const {
+  CHECK(IsFileBased());
+  return std::get<RetainPtr<IFX_SeekableReadStream>>(data_)->GetSpanAtOffset(
+      0, GetRawSize());
+}
+
 bool CPDF_Stream::HasFilter() const {
   return dict_->KeyExist("Filter");
 }
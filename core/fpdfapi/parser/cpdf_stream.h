@@ -56,6 +56,11 @@ class CPDF_Stream final : public CPDF_Object {
   // Can only be called when a stream is not memory-based.
   DataVector<uint8_t> ReadAllRawData() const;
 
+  // Can only be called when a stream is not memory-based.
+  // Returns a view of the raw data if the underlying file keeps it in memory,
+  // or an empty span otherwise. Meant to be used by CPDF_StreamAcc only.
+  pdfium::span<const uint8_t> GetSharedRawData() const;
+
   bool IsFileBased() const {
     return std::holds_alternative<RetainPtr<IFX_SeekableReadStream>>(data_);
   }
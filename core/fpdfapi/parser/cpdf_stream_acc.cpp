@@ -79,6 +79,11 @@ pdfium::span<const uint8_t> CPDF_StreamAcc::GetSpan() const {
   if (is_owned()) {
     return std::get<DataVector<uint8_t>>(data_);
   }
+  pdfium::span<const uint8_t> unowned_data =
+      std::get<pdfium::raw_span<const uint8_t>>(data_);
+  if (!unowned_data.empty()) {
+    return unowned_data;
+  }
   if (stream_ && stream_->IsMemoryBased()) {
     return stream_->GetInMemoryRawData();
   }
@@ -113,6 +118,12 @@ void CPDF_StreamAcc::ProcessRawData() {
     return;
   }
 
+  pdfium::span<const uint8_t> shared_data = stream_->GetSharedRawData();
+  if (!shared_data.empty()) {
+    data_ = shared_data;
+    return;
+  }
+
   DataVector<uint8_t> data = ReadRawStream();
   if (data.empty()) {
     return;
@@ -129,9 +140,10 @@ void CPDF_StreamAcc::ProcessFilteredData(uint32_t estimated_size,
   }
 
   std::variant<pdfium::raw_span<const uint8_t>, DataVector<uint8_t>> src_data;
-  pdfium::span<const uint8_t> src_span;
-  if (stream_->IsMemoryBased()) {
-    src_span = stream_->GetInMemoryRawData();
+  pdfium::span<const uint8_t> src_span = stream_->IsMemoryBased()
+                                            ? stream_->GetInMemoryRawData()
+                                            : stream_->GetSharedRawData();
+  if (!src_span.empty()) {
     src_data = src_span;
   } else {
     DataVector<uint8_t> temp_src_data = ReadRawStream();
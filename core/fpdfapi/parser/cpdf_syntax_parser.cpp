@@ -7,6 +7,8 @@
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
 
 #include <algorithm>
+#include <array>
+#include <optional>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
@@ -17,9 +19,11 @@
 #include "core/fpdfapi/parser/cpdf_null.h"
 #include "core/fpdfapi/parser/cpdf_number.h"
 #include "core/fpdfapi/parser/cpdf_read_validator.h"
+#include "core/fpdfapi/parser/cpdf_rebuild_scanner.h"
 #include "core/fpdfapi/parser/cpdf_reference.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
+#include "core/fpdfapi/parser/fpdf_parser_simd.h"
 #include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/autorestorer.h"
 #include "core/fxcrt/cfx_read_only_vector_stream.h"
@@ -30,6 +34,8 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/span_util.h"
 
 namespace {
 
@@ -74,6 +80,56 @@ class ReadableSubStream final : public IFX_SeekableReadStream {
   FX_FILESIZE part_size_;
 };
 
+constexpr std::array<uint8_t, 2> kLineEndingChars = {{'\r', '\n'}};
+// The characters ReadString() cannot copy as is.
+constexpr std::array<uint8_t, 3> kStringSpecialChars = {{'(', ')', '\\'}};
+
+// Returns the number of whitespace characters at the start of `bytes`.
+size_t CountWhitespace(pdfium::span<const uint8_t> bytes) {
+  size_t count = pdfium::CountWhitespaceVectorized(bytes);
+  while (count < bytes.size() && PDFCharIsWhitespace(bytes[count])) {
+    ++count;
+  }
+  return count;
+}
+
+// Returns the number of characters at the start of `bytes` that are neither
+// whitespace nor delimiters.
+size_t CountRegular(pdfium::span<const uint8_t> bytes) {
+  size_t count = pdfium::CountRegularVectorized(bytes);
+  while (count < bytes.size() && !PDFCharIsWhitespace(bytes[count]) &&
+         !PDFCharIsDelimiter(bytes[count])) {
+    ++count;
+  }
+  return count;
+}
+
+// Returns the number of bytes at the start of `bytes` that are not one of
+// `chars`.
+size_t CountUntil(pdfium::span<const uint8_t> bytes,
+                  pdfium::span<const uint8_t> chars) {
+  size_t count = pdfium::CountUntilVectorized(bytes, chars);
+  while (count < bytes.size() &&
+         std::find(chars.begin(), chars.end(), bytes[count]) == chars.end()) {
+    ++count;
+  }
+  return count;
+}
+
+// Decodes the pairs of hex digits at the start of `bytes` and appends them to
+// `dest`. Returns the number of digits decoded.
+size_t DecodeHexPairs(pdfium::span<const uint8_t> bytes,
+                      DataVector<uint8_t>& dest) {
+  size_t count = pdfium::DecodeHexPairsVectorized(bytes, dest);
+  for (; count + 2 <= bytes.size() && FXSYS_IsHexDigit(bytes[count]) &&
+         FXSYS_IsHexDigit(bytes[count + 1]);
+       count += 2) {
+    dest.push_back(FXSYS_HexCharToInt(bytes[count]) * 16 +
+                   FXSYS_HexCharToInt(bytes[count + 1]));
+  }
+  return count;
+}
+
 }  // namespace
 
 // static
@@ -105,16 +161,43 @@ CPDF_SyntaxParser::CPDF_SyntaxParser(RetainPtr<CPDF_ReadValidator> validator,
 
 CPDF_SyntaxParser::~CPDF_SyntaxParser() = default;
 
+CPDF_SyntaxParser::CachedPage::CachedPage() = default;
+
+CPDF_SyntaxParser::CachedPage::CachedPage(CachedPage&& that) noexcept =
+    default;
+
+CPDF_SyntaxParser::CachedPage& CPDF_SyntaxParser::CachedPage::operator=(
+    CachedPage&& that) noexcept = default;
+
+CPDF_SyntaxParser::CachedPage::~CachedPage() = default;
+
 bool CPDF_SyntaxParser::GetCharAt(FX_FILESIZE pos, uint8_t& ch) {
   AutoRestorer<FX_FILESIZE> save_pos(&pos_);
   pos_ = pos;
   return GetNextChar(ch);
 }
 
-bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
+bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos, FX_FILESIZE pos) {
   if (read_pos >= file_len_) {
     return false;
   }
+
+  // When the file contents are already in memory, view all of it instead of
+  // copying it page by page.
+  pdfium::span<const uint8_t> file_view =
+      file_access_->GetSpanAtOffset(0, static_cast<size_t>(file_len_));
+  if (!file_view.empty()) {
+    buf_ = file_view;
+    buf_offset_ = 0;
+    pages_.clear();
+    block_.clear();
+    return true;
+  }
+
+  if (file_access_->IsWholeFileAvailable()) {
+    return ReadPageAt(pos);
+  }
+
   size_t read_size = read_buffer_size_;
   FX_SAFE_FILESIZE safe_end = read_pos;
   safe_end += read_size;
@@ -122,27 +205,176 @@ bool CPDF_SyntaxParser::ReadBlockAt(FX_FILESIZE read_pos) {
     read_size = file_len_ - read_pos;
   }
 
-  file_buf_.resize(read_size);
-  if (!file_access_->ReadBlockAtOffset(file_buf_, read_pos)) {
-    file_buf_.clear();
+  // `buf_` may view `block_`.
+  buf_ = pdfium::span<const uint8_t>();
+  block_.resize(read_size);
+  if (!file_access_->ReadBlockAtOffset(block_, read_pos)) {
+    block_.clear();
     return false;
   }
 
+  buf_ = block_;
   buf_offset_ = read_pos;
+  return IsPositionRead(pos);
+}
+
+bool CPDF_SyntaxParser::ReadPageAt(FX_FILESIZE pos) {
+  const FX_FILESIZE page_offset = pos - pos % page_size_;
+  auto it = FindPage(page_offset);
+  if (it != pages_.end()) {
+    UsePage(it);
+    return true;
+  }
+
+  // The front page is the one in use. Reading on right after it is a
+  // sequential scan, which reads ahead more pages each time, up to the next
+  // page that is already cached.
+  const bool sequential =
+      !pages_.empty() && page_offset == pages_.front().offset + page_size_;
+  read_ahead_pages_ =
+      sequential ? std::min(read_ahead_pages_ * 2, kMaxReadAheadPages) : 1;
+  size_t page_count = 1;
+  while (page_count < read_ahead_pages_ &&
+         FindPage(page_offset + page_count * page_size_) == pages_.end()) {
+    ++page_count;
+  }
+  if (sequential) {
+    pages_.splice(pages_.end(), pages_, pages_.begin());
+  }
+  return ReadPages(page_offset, page_count) && IsPositionRead(pos);
+}
+
+std::list<CPDF_SyntaxParser::CachedPage>::iterator CPDF_SyntaxParser::FindPage(
+    FX_FILESIZE offset) {
+  return std::find_if(
+      pages_.begin(), pages_.end(),
+      [offset](const CachedPage& page) { return page.offset == offset; });
+}
+
+bool CPDF_SyntaxParser::ReadPages(FX_FILESIZE offset, size_t page_count) {
+  const FX_FILESIZE max_size = file_len_ - offset;
+  const size_t read_size = static_cast<size_t>(
+      std::min<FX_FILESIZE>(max_size, page_count * page_size_));
+  DataVector<uint8_t> data(read_size);
+  if (!file_access_->ReadBlockAtOffset(data, offset)) {
+    return false;
+  }
+
+  // `buf_` may view a page about to be evicted.
+  buf_ = pdfium::span<const uint8_t>();
+  const auto first_old_page = pages_.begin();
+  if (read_size <= page_size_) {
+    CachedPage& page = *pages_.emplace(first_old_page);
+    page.offset = offset;
+    page.data = std::move(data);
+  } else {
+    pdfium::span<const uint8_t> remaining = data;
+    while (!remaining.empty()) {
+      const size_t size = std::min<size_t>(remaining.size(), page_size_);
+      CachedPage& page = *pages_.emplace(first_old_page);
+      page.offset = offset;
+      page.data = DataVector<uint8_t>(remaining.begin(),
+                                      remaining.begin() + size);
+      offset += size;
+      remaining = remaining.subspan(size);
+    }
+  }
+  while (pages_.size() > kMaxCachedPages) {
+    pages_.pop_back();
+  }
+
+  buf_ = pages_.front().data;
+  buf_offset_ = pages_.front().offset;
   return true;
 }
 
+void CPDF_SyntaxParser::UsePage(std::list<CachedPage>::iterator it) {
+  if (it != pages_.begin()) {
+    // Move the page a sequential scan is done with out of the way.
+    if (it->offset == pages_.front().offset + page_size_) {
+      pages_.splice(pages_.end(), pages_, pages_.begin());
+    }
+    pages_.splice(pages_.begin(), pages_, it);
+  }
+  buf_ = it->data;
+  buf_offset_ = it->offset;
+}
+
+pdfium::span<const uint8_t> CPDF_SyntaxParser::GetBufferedBytes() {
+  const FX_FILESIZE pos = pos_ + header_offset_;
+  if (pos >= file_len_) {
+    return pdfium::span<const uint8_t>();
+  }
+
+  if (!IsPositionRead(pos) && !ReadBlockAt(pos, pos)) {
+    return pdfium::span<const uint8_t>();
+  }
+
+  return pdfium::span<const uint8_t>(buf_).subspan(
+      static_cast<size_t>(pos - buf_offset_));
+}
+
+void CPDF_SyntaxParser::SkipWhitespace() {
+  while (true) {
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    const size_t count = CountWhitespace(bytes);
+    pos_ += count;
+    if (bytes.empty() || count < bytes.size()) {
+      return;
+    }
+  }
+}
+
+bool CPDF_SyntaxParser::SkipPastLineEnding() {
+  while (true) {
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty()) {
+      return false;
+    }
+    const size_t count = CountUntil(bytes, kLineEndingChars);
+    if (count < bytes.size()) {
+      pos_ += count + 1;
+      return true;
+    }
+    pos_ += count;
+  }
+}
+
+bool CPDF_SyntaxParser::ReadRegularChars() {
+  bool all_numeric = true;
+  while (true) {
+    pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+    if (bytes.empty()) {
+      return all_numeric;
+    }
+    const size_t count = CountRegular(bytes);
+    pdfium::span<const uint8_t> chars = bytes.first(count);
+    all_numeric = all_numeric &&
+                  std::all_of(chars.begin(), chars.end(), PDFCharIsNumeric);
+    // Keep the last byte of `word_buffer_` free.
+    const size_t copy_size =
+        std::min(count, word_buffer_.size() - 1 - word_size_);
+    fxcrt::spancpy(pdfium::span(word_buffer_).subspan(word_size_),
+                   chars.first(copy_size));
+    word_size_ += static_cast<uint32_t>(copy_size);
+    pos_ += count;
+    if (count < bytes.size()) {
+      return all_numeric;
+    }
+  }
+}
+
 bool CPDF_SyntaxParser::GetNextChar(uint8_t& ch) {
   FX_FILESIZE pos = pos_ + header_offset_;
   if (pos >= file_len_) {
     return false;
   }
 
-  if (!IsPositionRead(pos) && !ReadBlockAt(pos)) {
+  if (!IsPositionRead(pos) && !ReadBlockAt(pos, pos)) {
     return false;
   }
 
-  ch = file_buf_[pos - buf_offset_];
+  ch = buf_[pos - buf_offset_];
   pos_++;
   return true;
 }
@@ -162,11 +394,11 @@ bool CPDF_SyntaxParser::GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch) {
     if (pos >= CPDF_Stream::kFileBufSize) {
       block_start = pos - CPDF_Stream::kFileBufSize + 1;
     }
-    if (!ReadBlockAt(block_start) || !IsPositionRead(pos)) {
+    if (!ReadBlockAt(block_start, pos)) {
       return false;
     }
   }
-  *ch = file_buf_[pos - buf_offset_];
+  *ch = buf_[pos - buf_offset_];
   return true;
 }
 
@@ -193,20 +425,7 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
 
     word_buffer_[word_size_++] = ch;
     if (ch == '/') {
-      while (true) {
-        if (!GetNextChar(ch)) {
-          return word_type;
-        }
-
-        if (!PDFCharIsOther(ch) && !PDFCharIsNumeric(ch)) {
-          pos_--;
-          return word_type;
-        }
-
-        if (word_size_ < sizeof(word_buffer_) - 1) {
-          word_buffer_[word_size_++] = ch;
-        }
-      }
+      ReadRegularChars();
     } else if (ch == '<') {
       if (!GetNextChar(ch)) {
         return word_type;
@@ -231,23 +450,10 @@ CPDF_SyntaxParser::WordType CPDF_SyntaxParser::GetNextWordInternal() {
     return word_type;
   }
 
-  while (true) {
-    if (word_size_ < sizeof(word_buffer_) - 1) {
-      word_buffer_[word_size_++] = ch;
-    }
-
-    if (!PDFCharIsNumeric(ch)) {
-      word_type = WordType::kWord;
-    }
-
-    if (!GetNextChar(ch)) {
-      return word_type;
-    }
-
-    if (PDFCharIsDelimiter(ch) || PDFCharIsWhitespace(ch)) {
-      pos_--;
-      break;
-    }
+  word_buffer_[word_size_++] = ch;
+  const bool all_numeric = ReadRegularChars();
+  if (!all_numeric || !PDFCharIsNumeric(ch)) {
+    word_type = WordType::kWord;
   }
   return word_type;
 }
@@ -277,6 +483,11 @@ ByteString CPDF_SyntaxParser::ReadString() {
           status = ReadStatus::kBackslash;
         } else {
           buf += static_cast<char>(ch);
+          // Copy the bytes up to the next special character in one go.
+          pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+          const size_t count = CountUntil(bytes, kStringSpecialChars);
+          buf += ByteStringView(bytes.first(count));
+          pos_ += count;
         }
         break;
       case ReadStatus::kBackslash:
@@ -368,6 +579,10 @@ DataVector<uint8_t> CPDF_SyntaxParser::ReadHexString() {
       bFirst = !bFirst;
     }
 
+    if (bFirst) {
+      pos_ += DecodeHexPairs(GetBufferedBytes(), buf);
+    }
+
     if (!GetNextChar(ch)) {
       break;
     }
@@ -402,32 +617,22 @@ void CPDF_SyntaxParser::ToNextWord() {
     return;
   }
 
-  uint8_t ch;
-  if (!GetNextChar(ch)) {
-    return;
-  }
-
   while (true) {
-    while (PDFCharIsWhitespace(ch)) {
-      if (!GetNextChar(ch)) {
-        return;
-      }
+    SkipWhitespace();
+    uint8_t ch;
+    if (!GetNextChar(ch)) {
+      return;
     }
 
     if (ch != '%') {
-      break;
+      pos_--;
+      return;
     }
 
-    while (true) {
-      if (!GetNextChar(ch)) {
-        return;
-      }
-      if (PDFCharIsLineEnding(ch)) {
-        break;
-      }
+    if (!SkipPastLineEnding()) {
+      return;
     }
   }
-  pos_--;
 }
 
 // A state machine which goes % -> E -> O -> F -> line ending.
@@ -605,8 +810,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         pool_, PDF_NameDecode(ByteStringView(word_span).Substr(1)));
   }
   if (word == "<<") {
-    RetainPtr<CPDF_Dictionary> pDict =
-        pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+    CPDF_Dictionary::EntryVector entries;
     while (true) {
       WordResult inner_word_result = GetNextWord();
       const ByteString& inner_word = inner_word_result.word;
@@ -646,10 +850,13 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
       // `key` has to be "/X" at the minimum.
       // `pObj` cannot be a stream, per ISO 32000-1:2008 section 7.3.8.1.
       if (key.GetLength() > 1 && !pObj->IsStream()) {
-        pDict->SetFor(key.Substr(1), std::move(pObj));
+        entries.emplace_back(key.Substr(1), std::move(pObj));
       }
     }
 
+    auto pDict = pdfium::MakeRetain<CPDF_Dictionary>(pool_);
+    pDict->SetEntries(std::move(entries));
+
     AutoRestorer<FX_FILESIZE> pos_restorer(&pos_);
     if (GetNextWord().word != "stream") {
       return pDict;
@@ -718,6 +925,14 @@ unsigned int CPDF_SyntaxParser::ReadEOLMarkers(FX_FILESIZE pos) {
 }
 
 FX_FILESIZE CPDF_SyntaxParser::FindWordPos(ByteStringView word) {
+  if (rebuild_scanner_) {
+    std::optional<FX_FILESIZE> word_pos =
+        rebuild_scanner_->FindWordPos(word, pos_);
+    if (word_pos.has_value()) {
+      return word_pos.value();
+    }
+  }
+
   AutoRestorer<FX_FILESIZE> pos_restorer(&pos_);
   FX_FILESIZE end_offset = FindTag(word);
   while (end_offset >= 0) {
@@ -787,6 +1002,7 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
   }
 
   RetainPtr<IFX_SeekableReadStream> substream;
+  FX_FILESIZE substream_offset = 0;
   if (len > 0) {
     // Check data availability first to allow the Validator to request data
     // smoothly, without jumps.
@@ -795,8 +1011,9 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
       return nullptr;
     }
 
-    substream = pdfium::MakeRetain<ReadableSubStream>(
-        GetValidator(), header_offset_ + GetPos(), len);
+    substream_offset = header_offset_ + GetPos();
+    substream = pdfium::MakeRetain<ReadableSubStream>(GetValidator(),
+                                                      substream_offset, len);
     SetPos(GetPos() + len);
   }
 
@@ -846,8 +1063,9 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
         return nullptr;
       }
 
-      substream = pdfium::MakeRetain<ReadableSubStream>(
-          GetValidator(), header_offset_ + GetPos(), len);
+      substream_offset = header_offset_ + GetPos();
+      substream = pdfium::MakeRetain<ReadableSubStream>(GetValidator(),
+                                                        substream_offset, len);
       SetPos(GetPos() + len);
     }
   }
@@ -856,13 +1074,19 @@ RetainPtr<CPDF_Stream> CPDF_SyntaxParser::ReadStream(
   if (substream) {
     // It is unclear from CPDF_SyntaxParser's perspective what object
     // `substream` is ultimately holding references to. To avoid unexpectedly
-    // changing object lifetimes by handing `substream` to `stream`, make a
-    // copy of the data here.
-    auto data = FixedSizeDataVector<uint8_t>::Uninit(substream->GetSize());
-    bool did_read = substream->ReadBlockAtOffset(data.span(), 0);
-    CHECK(did_read);
-    auto data_as_stream =
-        pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(data));
+    // changing object lifetimes by handing `substream` to `stream`, either
+    // share the memory of a memory-backed file, which only holds on to the
+    // file itself, or make a copy of the data here.
+    RetainPtr<IFX_SeekableReadStream> data_as_stream =
+        GetValidator()->CreateSharedSubStream(
+            substream_offset, static_cast<size_t>(substream->GetSize()));
+    if (!data_as_stream) {
+      auto data = FixedSizeDataVector<uint8_t>::Uninit(substream->GetSize());
+      bool did_read = substream->ReadBlockAtOffset(data.span(), 0);
+      CHECK(did_read);
+      data_as_stream =
+          pdfium::MakeRetain<CFX_ReadOnlyVectorStream>(std::move(data));
+    }
 
     stream = pdfium::MakeRetain<CPDF_Stream>(std::move(data_as_stream),
                                              std::move(pDict));
@@ -979,7 +1203,21 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
   const int32_t taglen = tag.GetLength();
   DCHECK_GT(taglen, 0);
 
+  const std::array<uint8_t, 1> first_char = {{tag[0]}};
   while (true) {
+    // Skip to the next byte that can start `tag`.
+    while (true) {
+      pdfium::span<const uint8_t> bytes = GetBufferedBytes();
+      if (bytes.empty()) {
+        return -1;
+      }
+      const size_t count = CountUntil(bytes, first_char);
+      pos_ += count;
+      if (count < bytes.size()) {
+        break;
+      }
+    }
+
     const FX_FILESIZE match_start_pos = GetPos();
     bool match_found = true;
 
@@ -1007,5 +1245,5 @@ FX_FILESIZE CPDF_SyntaxParser::FindTag(ByteStringView tag) {
 
 bool CPDF_SyntaxParser::IsPositionRead(FX_FILESIZE pos) const {
   return buf_offset_ <= pos &&
-         pos < static_cast<FX_FILESIZE>(buf_offset_ + file_buf_.size());
+         pos < static_cast<FX_FILESIZE>(buf_offset_ + buf_.size());
 }
@@ -10,12 +10,14 @@
 #include <stdint.h>
 
 #include <array>
+#include <list>
 #include <memory>
 #include <vector>
 
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_types.h"
+#include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/string_pool_template.h"
@@ -26,6 +28,7 @@ class CPDF_Dictionary;
 class CPDF_IndirectObjectHolder;
 class CPDF_Object;
 class CPDF_ReadValidator;
+class CPDF_RebuildScanner;
 class CPDF_Stream;
 class IFX_SeekableReadStream;
 
@@ -47,9 +50,12 @@ class CPDF_SyntaxParser {
                     FX_FILESIZE HeaderOffset);
   ~CPDF_SyntaxParser();
 
+  // Sets the size of the blocks read from the file while it is not entirely
+  // available yet. Once it is, the parser reads whole pages instead.
   void SetReadBufferSize(uint32_t read_buffer_size) {
     read_buffer_size_ = read_buffer_size;
   }
+  void SetPageSizeForTesting(uint32_t page_size) { page_size_ = page_size; }
 
   FX_FILESIZE GetPos() const { return pos_; }
   void SetPos(FX_FILESIZE pos);
@@ -88,6 +94,12 @@ class CPDF_SyntaxParser {
     trailer_ends_ = trailer_ends;
   }
 
+  // When set, looks up the keywords `scanner` indexes instead of searching
+  // the file for them. The caller must reset it before destroying `scanner`.
+  void SetRebuildScanner(const CPDF_RebuildScanner* scanner) {
+    rebuild_scanner_ = scanner;
+  }
+
  private:
   enum class WordType : bool { kWord, kNumber };
 
@@ -97,8 +109,46 @@ class CPDF_SyntaxParser {
   static constexpr int kParserMaxRecursionDepth = 64;
   static int s_CurrentRecursionDepth;
 
-  bool ReadBlockAt(FX_FILESIZE read_pos);
+  // Files that are not in memory are read in pages of this size, aligned to
+  // it, once the whole file is available.
+  static constexpr uint32_t kPageSize = 64 * 1024;
+  static constexpr size_t kMaxCachedPages = 16;
+  // Most pages a sequential scan reads at once.
+  static constexpr size_t kMaxReadAheadPages = 4;
+
+  struct CachedPage {
+    CachedPage();
+    CachedPage(CachedPage&& that) noexcept;
+    CachedPage& operator=(CachedPage&& that) noexcept;
+    ~CachedPage();
+
+    FX_FILESIZE offset = 0;
+    DataVector<uint8_t> data;
+  };
+
+  // Makes `buf_` cover `pos`. Uses the page that covers `pos`, reading it
+  // first if it is not cached. While the whole file is not available, reads
+  // a block that starts at `read_pos` instead, so as not to ask for data
+  // before `read_pos` that a progressive download may not have yet.
+  bool ReadBlockAt(FX_FILESIZE read_pos, FX_FILESIZE pos);
+  bool ReadPageAt(FX_FILESIZE pos);
+  std::list<CachedPage>::iterator FindPage(FX_FILESIZE offset);
+  // Reads `page_count` pages starting at `offset`, and adds them to the front
+  // of `pages_`.
+  bool ReadPages(FX_FILESIZE offset, size_t page_count);
+  void UsePage(std::list<CachedPage>::iterator it);
   bool GetCharAtBackward(FX_FILESIZE pos, uint8_t* ch);
+  // Returns the bytes from the current position to the end of the read
+  // buffer, reading the next block first if needed. Empty at the end of the
+  // document. The fast paths below scan these instead of calling
+  // GetNextChar() for every byte.
+  pdfium::span<const uint8_t> GetBufferedBytes();
+  void SkipWhitespace();
+  // Moves past the next line ending. Returns false at the end of the document.
+  bool SkipPastLineEnding();
+  // Appends the regular characters at the current position to
+  // `word_buffer_`. Returns whether they are all numeric.
+  bool ReadRegularChars();
   WordType GetNextWordInternal();
   bool IsWholeWord(FX_FILESIZE startpos,
                    FX_FILESIZE limit,
@@ -124,14 +174,26 @@ class CPDF_SyntaxParser {
   const FX_FILESIZE file_len_;
   FX_FILESIZE pos_ = 0;
   WeakPtr<ByteStringPool> pool_;
-  DataVector<uint8_t> file_buf_;
+  // Recently read pages, most recently used first. Pages a sequential scan
+  // moves past go to the back, so that the scan does not evict the pages that
+  // random accesses keep coming back to.
+  std::list<CachedPage> pages_;
+  // The number of pages the next read of a sequential scan asks for.
+  size_t read_ahead_pages_ = 1;
+  // The block read while the whole file is not available.
+  DataVector<uint8_t> block_;
+  // The bytes at `buf_offset_`. Views the front of `pages_`, `block_`, or
+  // the file contents directly when the file keeps them in memory.
+  pdfium::raw_span<const uint8_t> buf_;
   FX_FILESIZE buf_offset_ = 0;
   uint32_t word_size_ = 0;
   uint32_t read_buffer_size_ = CPDF_Stream::kFileBufSize;
+  uint32_t page_size_ = kPageSize;
   std::array<uint8_t, 257> word_buffer_ = {};
 
   // The syntax parser records traversed trailer end byte offsets here.
   UnownedPtr<std::vector<unsigned int>> trailer_ends_;
+  UnownedPtr<const CPDF_RebuildScanner> rebuild_scanner_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_SYNTAX_PARSER_H_
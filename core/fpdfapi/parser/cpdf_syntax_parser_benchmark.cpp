@@ -0,0 +1,112 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Throughput benchmarks for CPDF_SyntaxParser. They are disabled by default;
+// run them by passing --gtest_also_run_disabled_tests and
+// --gtest_filter=SyntaxParserBenchmark.* to pdfium_unittests.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <string>
+
+#include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/cfx_read_only_span_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr size_t kDataSize = 16 * 1024 * 1024;
+constexpr int kIterations = 5;
+
+// Object-heavy content, like the object bodies of an uncompressed file.
+std::string MakeObjectData() {
+  std::string data;
+  for (int i = 1; data.size() < kDataSize; ++i) {
+    const std::string num = std::to_string(i);
+    data += num + " 0 obj\n<< /Type /Annot /Subtype /Link /Rect [ 10.5 " + num +
+            " 200 -36.25 ]\n   /Border [0 0 0] /Dest (Destination " + num +
+            ") /ID <0123456789ABCDEFfedcba9876543210>\n   /Parent " + num +
+            " 0 R >>\nendobj\n% Comment line\n\n";
+  }
+  return data;
+}
+
+// A long run of stream data without any "endstream" keyword.
+std::string MakeStreamData() {
+  std::string data;
+  data.reserve(kDataSize);
+  for (size_t i = 0; data.size() < kDataSize; ++i) {
+    data += static_cast<char>('a' + (i * 7) % 26);
+    if (i % 61 == 0) {
+      data += "end";
+    }
+  }
+  return data + "\nendstream";
+}
+
+template <typename Callback>
+void ReportThroughput(const char* name, size_t size, Callback callback) {
+  double best_seconds = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    callback();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  printf("%s: %.1f MB/s\n", name, size / best_seconds / (1024 * 1024));
+}
+
+}  // namespace
+
+TEST(SyntaxParserBenchmark, DISABLED_GetNextWord) {
+  const std::string data = MakeObjectData();
+  ReportThroughput("GetNextWord", data.size(), [&data] {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+        pdfium::as_byte_span(data)));
+    size_t words = 0;
+    while (true) {
+      const ByteString word = parser.GetNextWord().word;
+      if (word.IsEmpty()) {
+        break;
+      }
+      if (word == "(") {
+        parser.ReadString();
+      } else if (word == "<") {
+        parser.ReadHexString();
+      }
+      ++words;
+    }
+    EXPECT_GT(words, 0u);
+  });
+}
+
+TEST(SyntaxParserBenchmark, DISABLED_GetObjectBody) {
+  const std::string data = MakeObjectData();
+  ReportThroughput("GetIndirectObject", data.size(), [&data] {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+        pdfium::as_byte_span(data)));
+    while (parser.GetIndirectObject(
+        nullptr, CPDF_SyntaxParser::ParseType::kLoose)) {
+      parser.GetKeyword();
+    }
+    EXPECT_GT(parser.GetPos(), 0);
+  });
+}
+
+TEST(SyntaxParserBenchmark, DISABLED_FindTag) {
+  const std::string data = MakeStreamData();
+  ReportThroughput("FindTag", data.size(), [&data] {
+    CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+        pdfium::as_byte_span(data)));
+    EXPECT_GT(parser.FindTag("endstream"), 0);
+  });
+}
@@ -2,20 +2,61 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string.h>
+
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_object.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fpdfapi/parser/cpdf_syntax_parser.h"
+#include "core/fpdfapi/parser/fpdf_parser_utility.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/fx_extension.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/utils/path_service.h"
 
 using testing::ElementsAre;
+using testing::ElementsAreArray;
 using testing::IsEmpty;
 
+namespace {
+
+// Serves `data` through ReadBlockAtOffset() only, like a file on disk, and
+// counts the reads.
+class CountingReadStream final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // IFX_SeekableReadStream:
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override {
+    ++read_count_;
+    read_bytes_ += buffer.size();
+    return stream_->ReadBlockAtOffset(buffer, offset);
+  }
+  FX_FILESIZE GetSize() override { return stream_->GetSize(); }
+
+  int read_count() const { return read_count_; }
+  size_t read_bytes() const { return read_bytes_; }
+
+ private:
+  explicit CountingReadStream(const std::string& data)
+      : stream_(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+            pdfium::as_byte_span(data))) {}
+  ~CountingReadStream() override = default;
+
+  RetainPtr<CFX_ReadOnlySpanStream> const stream_;
+  int read_count_ = 0;
+  size_t read_bytes_ = 0;
+};
+
+}  // namespace
+
 TEST(SyntaxParserTest, ReadHexString) {
   {
     // Empty string.
@@ -147,3 +188,197 @@ TEST(SyntaxParserTest, PeekNextWord) {
   EXPECT_EQ("WORD", parser.PeekNextWord());
   EXPECT_EQ("WORD", parser.GetNextWord().word);
 }
+
+TEST(SyntaxParserTest, GetNextWordLongRuns) {
+  // Runs of every character, longer than the parser scans at once, and split
+  // across read buffers.
+  for (int i = 0; i < 256; ++i) {
+    const char ch = static_cast<char>(i);
+    const std::string run(40, ch);
+    {
+      const std::string data = "x" + run + " y";
+      CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+          pdfium::as_byte_span(data)));
+      parser.SetPageSizeForTesting(7);
+      CPDF_SyntaxParser::WordResult result = parser.GetNextWord();
+      EXPECT_FALSE(result.is_number);
+      if (PDFCharIsWhitespace(ch)) {
+        EXPECT_EQ("x", result.word) << i;
+        EXPECT_EQ("y", parser.GetNextWord().word) << i;
+      } else if (PDFCharIsDelimiter(ch)) {
+        EXPECT_EQ("x", result.word) << i;
+      } else {
+        EXPECT_EQ(ByteString(("x" + run).c_str()), result.word) << i;
+        EXPECT_EQ("y", parser.GetNextWord().word) << i;
+      }
+    }
+    if (PDFCharIsNumeric(ch) || PDFCharIsOther(ch)) {
+      const std::string data = "1" + run;
+      CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+          pdfium::as_byte_span(data)));
+      parser.SetPageSizeForTesting(7);
+      CPDF_SyntaxParser::WordResult result = parser.GetNextWord();
+      EXPECT_EQ(PDFCharIsNumeric(ch), result.is_number) << i;
+      EXPECT_EQ(41u, result.word.GetLength()) << i;
+      EXPECT_EQ(41, parser.GetPos()) << i;
+    }
+    if (PDFCharIsWhitespace(ch)) {
+      const std::string data = run + "/Name" + run;
+      CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+          pdfium::as_byte_span(data)));
+      parser.SetPageSizeForTesting(7);
+      EXPECT_EQ("/Name", parser.GetNextWord().word) << i;
+      EXPECT_EQ(45, parser.GetPos()) << i;
+      EXPECT_TRUE(parser.GetNextWord().word.IsEmpty()) << i;
+    }
+  }
+}
+
+TEST(SyntaxParserTest, GetNextWordTruncatesLongWords) {
+  const std::string data = "/" + std::string(300, 'a') + " 1";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(data)));
+  parser.SetPageSizeForTesting(7);
+  CPDF_SyntaxParser::WordResult result = parser.GetNextWord();
+  EXPECT_EQ(ByteString(("/" + std::string(255, 'a')).c_str()), result.word);
+  EXPECT_EQ(301, parser.GetPos());
+  EXPECT_EQ("1", parser.GetNextWord().word);
+}
+
+TEST(SyntaxParserTest, GetNextWordSkipsComments) {
+  static const char data[] =
+      "% a comment\r\n  %another one\n\n%%\rword % trailing comment";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      ByteStringView(data).unsigned_span()));
+  parser.SetPageSizeForTesting(5);
+  EXPECT_EQ("word", parser.GetNextWord().word);
+  EXPECT_TRUE(parser.GetNextWord().word.IsEmpty());
+  EXPECT_EQ(static_cast<FX_FILESIZE>(strlen(data)), parser.GetPos());
+}
+
+TEST(SyntaxParserTest, ReadLongHexString) {
+  static const char kDigits[] = "0123456789abcdefABCDEF";
+  std::string data;
+  std::vector<uint8_t> expected;
+  int high_nibble = -1;
+  for (int i = 0; i < 1000; ++i) {
+    const char digit = kDigits[(i * 7) % 22];
+    data += digit;
+    if (high_nibble < 0) {
+      high_nibble = FXSYS_HexCharToInt(digit);
+    } else {
+      expected.push_back(high_nibble * 16 + FXSYS_HexCharToInt(digit));
+      high_nibble = -1;
+    }
+    // Throw in some whitespace, sometimes in the middle of a byte.
+    if (i % 37 == 0) {
+      data += " \r\n";
+    }
+  }
+  data += "9>";
+  expected.push_back(high_nibble < 0 ? 0x90 : high_nibble * 16 + 9);
+
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(data)));
+  parser.SetPageSizeForTesting(7);
+  EXPECT_THAT(parser.ReadHexString(), ElementsAreArray(expected));
+  EXPECT_EQ(static_cast<FX_FILESIZE>(data.size()), parser.GetPos());
+}
+
+TEST(SyntaxParserTest, ReadLongString) {
+  const std::string data = std::string(100, 'a') + "(" + std::string(50, 'b') +
+                           ")\\n\\101" + std::string(40, 'c') + "\\)) tail";
+  const std::string expected = std::string(100, 'a') + "(" +
+                               std::string(50, 'b') + ")\nA" +
+                               std::string(40, 'c') + ")";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(data)));
+  parser.SetPageSizeForTesting(7);
+  EXPECT_EQ(ByteString(expected.c_str()), parser.ReadString());
+  EXPECT_EQ("tail", parser.GetNextWord().word);
+}
+
+TEST(SyntaxParserTest, FindTag) {
+  const std::string data =
+      std::string(200, 'x') + "endstrea" + std::string(100, 'e') + "endstream";
+  CPDF_SyntaxParser parser(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(
+      pdfium::as_byte_span(data)));
+  parser.SetPageSizeForTesting(7);
+  EXPECT_EQ(308, parser.FindTag("endstream"));
+  EXPECT_EQ(static_cast<FX_FILESIZE>(data.size()), parser.GetPos());
+  EXPECT_EQ(-1, parser.FindTag("endstream"));
+
+  parser.SetPos(0);
+  EXPECT_EQ(-1, parser.FindTag("endobj"));
+  EXPECT_EQ(static_cast<FX_FILESIZE>(data.size()), parser.GetPos());
+}
+
+TEST(SyntaxParserTest, PageCacheServesRandomReads) {
+  constexpr size_t kPageSize = 64 * 1024;
+  std::string data;
+  for (int i = 0; data.size() < 32 * kPageSize; ++i) {
+    data += std::to_string(i) + " 0 obj\n<< /Key " + std::to_string(i) +
+            " >>\nendobj\n" + std::string(2000, ' ');
+  }
+  auto stream = pdfium::MakeRetain<CountingReadStream>(data);
+  CPDF_SyntaxParser parser(stream);
+
+  // Read from random positions in every other page, more pages than fit in a
+  // single read window, but not more than the cache holds.
+  std::vector<FX_FILESIZE> positions;
+  uint32_t seed = 1;
+  for (int i = 0; i < 500; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const size_t page = ((seed >> 16) % 12) * 2;
+    positions.push_back(page * kPageSize + (seed >> 4) % kPageSize);
+  }
+  for (FX_FILESIZE pos : positions) {
+    uint8_t ch;
+    ASSERT_TRUE(parser.GetCharAt(pos, ch));
+    EXPECT_EQ(data[pos], ch);
+  }
+  // Each page was read once, as a whole.
+  EXPECT_EQ(12, stream->read_count());
+  EXPECT_EQ(12 * kPageSize, stream->read_bytes());
+
+  // Reading the same positions again does not read from the file.
+  for (FX_FILESIZE pos : positions) {
+    uint8_t ch;
+    ASSERT_TRUE(parser.GetCharAt(pos, ch));
+    EXPECT_EQ(data[pos], ch);
+  }
+  EXPECT_EQ(12, stream->read_count());
+
+  // Neither does a backwards search within a cached page.
+  parser.SetPos(2100);
+  EXPECT_TRUE(parser.BackwardsSearchToWord("obj", 2100));
+  EXPECT_EQ(12, stream->read_count());
+}
+
+TEST(SyntaxParserTest, PageCacheReadsAheadForSequentialScans) {
+  std::string data;
+  while (data.size() < 1024 * 1024) {
+    data += "abc xyz\n";
+  }
+  data += "endstream";
+  while (data.size() < 2 * 1024 * 1024) {
+    data += "abc xyz\n";
+  }
+  auto stream = pdfium::MakeRetain<CountingReadStream>(data);
+  CPDF_SyntaxParser parser(stream);
+  parser.SetPos(1536 * 1024);
+  EXPECT_EQ("abc", parser.GetNextWord().word);
+  EXPECT_EQ(1, stream->read_count());
+
+  // Scanning 1 MB one 64 KB page at a time would take 17 reads.
+  parser.SetPos(0);
+  EXPECT_EQ(1024 * 1024, parser.FindTag("endstream"));
+  EXPECT_LT(stream->read_count(), 10);
+
+  // The scan moved the pages it was done with out of the way, so the page
+  // read before it is still cached.
+  const int read_count = stream->read_count();
+  parser.SetPos(1536 * 1024);
+  EXPECT_EQ("abc", parser.GetNextWord().word);
+  EXPECT_EQ(read_count, stream->read_count());
+}
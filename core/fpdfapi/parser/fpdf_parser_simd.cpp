@@ -0,0 +1,191 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fpdfapi/parser/fpdf_parser_simd.h"
+
+// Highway compiles this file once per instruction set it targets.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fpdfapi/parser/fpdf_parser_simd.cpp"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+using DU8 = hn::ScalableTag<uint8_t>;
+using VU8 = hn::Vec<DU8>;
+using MU8 = hn::Mask<DU8>;
+
+// Must match the 'W' and 'D' entries in kPDFCharTypes.
+constexpr uint8_t kWhitespaceChars[] = {0x00, 0x09, 0x0a, 0x0c,
+                                        0x0d, 0x20, 0x80, 0xff};
+constexpr uint8_t kDelimiterChars[] = {'%', '(', ')', '/', '<',
+                                       '>', '[', ']', '{', '}'};
+
+HWY_INLINE VU8 LoadVector(pdfium::span<const uint8_t> bytes, size_t offset) {
+  const DU8 du8;
+  return hn::LoadU(du8, bytes.subspan(offset, hn::Lanes(du8)).data());
+}
+
+// Returns the lanes of `vector` that hold one of `chars`.
+HWY_INLINE MU8 MatchChars(VU8 vector, pdfium::span<const uint8_t> chars) {
+  const DU8 du8;
+  MU8 found = hn::FirstN(du8, 0);
+  for (uint8_t ch : chars) {
+    found = hn::Or(found, hn::Eq(vector, hn::Set(du8, ch)));
+  }
+  return found;
+}
+
+size_t CountWhitespaceImpl(pdfium::span<const uint8_t> bytes) {
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(du8);
+  size_t count = 0;
+  for (; count + lanes <= bytes.size(); count += lanes) {
+    const intptr_t index = hn::FindFirstTrue(
+        du8, hn::Not(MatchChars(LoadVector(bytes, count), kWhitespaceChars)));
+    if (index >= 0) {
+      return count + static_cast<size_t>(index);
+    }
+  }
+  return count;
+}
+
+size_t CountRegularImpl(pdfium::span<const uint8_t> bytes) {
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(du8);
+  size_t count = 0;
+  for (; count + lanes <= bytes.size(); count += lanes) {
+    const VU8 vector = LoadVector(bytes, count);
+    const intptr_t index = hn::FindFirstTrue(
+        du8, hn::Or(MatchChars(vector, kWhitespaceChars),
+                    MatchChars(vector, kDelimiterChars)));
+    if (index >= 0) {
+      return count + static_cast<size_t>(index);
+    }
+  }
+  return count;
+}
+
+size_t CountUntilImpl(pdfium::span<const uint8_t> bytes,
+                      pdfium::span<const uint8_t> chars) {
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(du8);
+  size_t count = 0;
+  for (; count + lanes <= bytes.size(); count += lanes) {
+    const intptr_t index =
+        hn::FindFirstTrue(du8, MatchChars(LoadVector(bytes, count), chars));
+    if (index >= 0) {
+      return count + static_cast<size_t>(index);
+    }
+  }
+  return count;
+}
+
+size_t DecodeHexPairsImpl(pdfium::span<const uint8_t> bytes,
+                          DataVector<uint8_t>& dest) {
+  const DU8 du8;
+  const hn::Half<DU8> du8_half;
+  const size_t lanes = hn::Lanes(du8);
+  const VU8 zero = hn::Set(du8, '0');
+  const VU8 lower_a = hn::Set(du8, 'a');
+  const VU8 lower_case_bit = hn::Set(du8, 0x20);
+  const VU8 six = hn::Set(du8, 6);
+  const VU8 ten = hn::Set(du8, 10);
+  size_t count = 0;
+  for (; count + lanes <= bytes.size(); count += lanes) {
+    const VU8 chars = LoadVector(bytes, count);
+    // The subtractions wrap around, so each range check is one comparison.
+    const VU8 digits = hn::Sub(chars, zero);
+    const MU8 is_digit = hn::Lt(digits, ten);
+    const VU8 letters = hn::Sub(hn::Or(chars, lower_case_bit), lower_a);
+    const MU8 is_letter = hn::Lt(letters, six);
+    if (!hn::AllTrue(du8, hn::Or(is_digit, is_letter))) {
+      break;
+    }
+
+    const VU8 nibbles =
+        hn::IfThenElse(is_digit, digits, hn::Add(letters, ten));
+    // The even lanes hold the high nibbles, and the odd lanes the low ones.
+    const VU8 values =
+        hn::Or(hn::ShiftLeft<4>(hn::ConcatEven(du8, nibbles, nibbles)),
+               hn::ConcatOdd(du8, nibbles, nibbles));
+    const size_t dest_size = dest.size();
+    dest.resize(dest_size + lanes / 2);
+    hn::StoreU(hn::LowerHalf(du8_half, values), du8_half,
+               pdfium::span(dest).subspan(dest_size).data());
+  }
+  return count;
+}
+
+size_t FindPrefixesImpl(pdfium::span<const uint8_t> bytes,
+                        pdfium::span<const std::array<uint8_t, 3>> prefixes,
+                        std::vector<size_t>& offsets) {
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(du8);
+  size_t count = 0;
+  for (; count + lanes + 2 <= bytes.size(); count += lanes) {
+    const VU8 ch0 = LoadVector(bytes, count);
+    const VU8 ch1 = LoadVector(bytes, count + 1);
+    const VU8 ch2 = LoadVector(bytes, count + 2);
+    MU8 found = hn::FirstN(du8, 0);
+    for (const std::array<uint8_t, 3>& prefix : prefixes) {
+      found = hn::Or(
+          found, hn::And(hn::And(hn::Eq(ch0, hn::Set(du8, prefix[0])),
+                                 hn::Eq(ch1, hn::Set(du8, prefix[1]))),
+                         hn::Eq(ch2, hn::Set(du8, prefix[2]))));
+    }
+    for (intptr_t index = hn::FindFirstTrue(du8, found); index >= 0;
+         index = hn::FindFirstTrue(du8, found)) {
+      offsets.push_back(count + static_cast<size_t>(index));
+      found = hn::AndNot(hn::FirstN(du8, static_cast<size_t>(index) + 1),
+                         found);
+    }
+  }
+  return count;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace pdfium {
+
+HWY_EXPORT(CountWhitespaceImpl);
+HWY_EXPORT(CountRegularImpl);
+HWY_EXPORT(CountUntilImpl);
+HWY_EXPORT(DecodeHexPairsImpl);
+HWY_EXPORT(FindPrefixesImpl);
+
+size_t CountWhitespaceVectorized(pdfium::span<const uint8_t> bytes) {
+  return HWY_DYNAMIC_DISPATCH(CountWhitespaceImpl)(bytes);
+}
+
+size_t CountRegularVectorized(pdfium::span<const uint8_t> bytes) {
+  return HWY_DYNAMIC_DISPATCH(CountRegularImpl)(bytes);
+}
+
+size_t CountUntilVectorized(pdfium::span<const uint8_t> bytes,
+                            pdfium::span<const uint8_t> chars) {
+  return HWY_DYNAMIC_DISPATCH(CountUntilImpl)(bytes, chars);
+}
+
+size_t DecodeHexPairsVectorized(pdfium::span<const uint8_t> bytes,
+                                DataVector<uint8_t>& dest) {
+  return HWY_DYNAMIC_DISPATCH(DecodeHexPairsImpl)(bytes, dest);
+}
+
+size_t FindPrefixesVectorized(
+    pdfium::span<const uint8_t> bytes,
+    pdfium::span<const std::array<uint8_t, 3>> prefixes,
+    std::vector<size_t>& offsets) {
+  return HWY_DYNAMIC_DISPATCH(FindPrefixesImpl)(bytes, prefixes, offsets);
+}
+
+}  // namespace pdfium
+#endif  // HWY_ONCE
@@ -0,0 +1,53 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FPDFAPI_PARSER_FPDF_PARSER_SIMD_H_
+#define CORE_FPDFAPI_PARSER_FPDF_PARSER_SIMD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+
+namespace pdfium {
+
+// Vectorized scans for the CPDF_SyntaxParser lexer and CPDF_RebuildScanner.
+// The instruction set is picked at runtime.
+//
+// Each function looks at the start of `bytes` in whole vectors, and returns
+// the number of bytes it handled. That is either where the scan stops, or the
+// number of bytes in the vectors it looked at. The caller handles the bytes
+// after that with scalar code, which stops right away in the first case.
+
+// Counts the whitespace characters at the start of `bytes`.
+size_t CountWhitespaceVectorized(pdfium::span<const uint8_t> bytes);
+
+// Counts the characters at the start of `bytes` that are neither whitespace
+// nor delimiters.
+size_t CountRegularVectorized(pdfium::span<const uint8_t> bytes);
+
+// Counts the bytes at the start of `bytes` that are not one of `chars`.
+size_t CountUntilVectorized(pdfium::span<const uint8_t> bytes,
+                            pdfium::span<const uint8_t> chars);
+
+// Decodes the pairs of hex digits at the start of `bytes` and appends them to
+// `dest`. Returns the number of digits decoded, which is even.
+size_t DecodeHexPairsVectorized(pdfium::span<const uint8_t> bytes,
+                                DataVector<uint8_t>& dest);
+
+// Appends the offsets in `bytes` where one of `prefixes` starts to `offsets`,
+// in order. Counts the offsets it checked, which all have a whole prefix after
+// them in `bytes`.
+size_t FindPrefixesVectorized(
+    pdfium::span<const uint8_t> bytes,
+    pdfium::span<const std::array<uint8_t, 3>> prefixes,
+    std::vector<size_t>& offsets);
+
+}  // namespace pdfium
+
+#endif  // CORE_FPDFAPI_PARSER_FPDF_PARSER_SIMD_H_
@@ -27,7 +27,7 @@ class ObjectTreeTraverser {
  public:
   explicit ObjectTreeTraverser(const CPDF_Document* document)
       : document_(document) {
-    const CPDF_Parser* parser = document_->GetParser();
+    CPDF_Parser* parser = document_->GetParser();
     const CPDF_Dictionary* trailer = parser ? parser->GetTrailer() : nullptr;
     const CPDF_Dictionary* root = trailer ? trailer : document_->GetRoot();
     const uint32_t root_object_number =
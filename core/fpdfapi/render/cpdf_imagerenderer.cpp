@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "build/build_config.h"
@@ -42,6 +43,7 @@
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/cfx_imagestretcher.h"
+#include "core/fxge/render_defines.h"
 
 #if BUILDFLAG(IS_WIN)
 #include "core/fxge/dib/cfx_imagetransformer.h"
@@ -66,17 +68,30 @@ CPDF_ImageRenderer::CPDF_ImageRenderer(CPDF_RenderStatus* pStatus)
 CPDF_ImageRenderer::~CPDF_ImageRenderer() = default;
 
 bool CPDF_ImageRenderer::StartLoadDIBBase() {
-  if (!GetUnitRect().has_value()) {
+  std::optional<FX_RECT> unit_rect = GetUnitRect();
+  if (!unit_rect.has_value()) {
     return false;
   }
 
+  // Let the decoders skip the detail that the image loses on the device. A
+  // rotated image can lay either side along either axis, so ask for the longer
+  // side both ways. Display lists get replayed at other scales, so they need
+  // everything. Likewise, decoders that can decode part of an image only need
+  // the part within the clip box.
+  CFX_RenderDevice* device = render_status_->GetRenderDevice();
+  CFX_Size max_size_required;
+  FX_RECT decode_area;
+  if (!(device->GetRenderCaps() & FXRC_DISPLAY_LIST)) {
+    const int dest_size =
+        std::max(unit_rect.value().Width(), unit_rect.value().Height());
+    max_size_required = {dest_size, dest_size};
+    decode_area = GetDecodeArea();
+  }
   if (!loader_->Start(
           image_object_, render_status_->GetContext()->GetPageCache(),
           render_status_->GetFormResource(), render_status_->GetPageResource(),
           std_cs_, render_status_->GetGroupFamily(),
-          render_status_->GetLoadMask(),
-          {render_status_->GetRenderDevice()->GetWidth(),
-           render_status_->GetRenderDevice()->GetHeight()})) {
+          render_status_->GetLoadMask(), max_size_required, decode_area)) {
     return false;
   }
   mode_ = Mode::kDefault;
@@ -88,6 +103,18 @@ bool CPDF_ImageRenderer::StartRenderDIBBase() {
     return false;
   }
 
+  // Stretch a partly decoded image over just its part of the unit square.
+  const FX_RECT& decoded_area = loader_->GetDecodedArea();
+  if (!decoded_area.IsEmpty()) {
+    const float width = image_object_->GetImage()->GetPixelWidth();
+    const float height = image_object_->GetImage()->GetPixelHeight();
+    image_matrix_ = CFX_Matrix(decoded_area.Width() / width, 0, 0,
+                               decoded_area.Height() / height,
+                               decoded_area.left / width,
+                               1 - decoded_area.bottom / height) *
+                    image_matrix_;
+  }
+
   CPDF_GeneralState& state = image_object_->mutable_general_state();
   alpha_ = state.GetFillAlpha();
   dibbase_ = loader_->GetBitmap();
@@ -657,6 +684,31 @@ std::optional<FX_RECT> CPDF_ImageRenderer::GetUnitRect() const {
   return image_rect;
 }
 
+FX_RECT CPDF_ImageRenderer::GetDecodeArea() const {
+  if (image_matrix_.a * image_matrix_.d - image_matrix_.b * image_matrix_.c ==
+      0) {
+    return FX_RECT();
+  }
+
+  const FX_RECT clip_box = render_status_->GetRenderDevice()->GetClipBox();
+  CFX_FloatRect unit_rect =
+      image_matrix_.GetInverse().TransformRect(CFX_FloatRect(clip_box));
+  unit_rect.Intersect(CFX_FloatRect(0, 0, 1, 1));
+  if (unit_rect.IsEmpty()) {
+    return FX_RECT();
+  }
+
+  // Image rows run from the top of the unit square down.
+  RetainPtr<const CPDF_Image> image = image_object_->GetImage();
+  const int width = image->GetPixelWidth();
+  const int height = image->GetPixelHeight();
+  CFX_FloatRect area(unit_rect.left * width, (1 - unit_rect.top) * height,
+                     unit_rect.right * width, (1 - unit_rect.bottom) * height);
+  FX_RECT pixel_area = area.GetOuterRect();
+  pixel_area.Intersect(FX_RECT(0, 0, width, height));
+  return pixel_area;
+}
+
 bool CPDF_ImageRenderer::GetDimensionsFromUnitRect(const FX_RECT& rect,
                                                    int* left,
                                                    int* top,
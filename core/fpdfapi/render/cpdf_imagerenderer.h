@@ -83,6 +83,9 @@ class CPDF_ImageRenderer {
       const FX_RECT& rect) const;
   const CPDF_RenderOptions& GetRenderOptions() const;
   std::optional<FX_RECT> GetUnitRect() const;
+  // Returns the pixels of the image that can show up within the device clip
+  // box, or an empty rect if they cannot be worked out.
+  FX_RECT GetDecodeArea() const;
   bool GetDimensionsFromUnitRect(const FX_RECT& rect,
                                  int* left,
                                  int* top,
@@ -51,7 +51,9 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
         return;
       }
       current_layer_ = context_->GetLayer(layer_index_);
-      last_object_rendered_ = current_layer_->GetObjectHolder()->end();
+      layer_objects_.clear();
+      next_layer_object_ = 0;
+      queried_object_count_ = 0;
       render_status_ = std::make_unique<CPDF_RenderStatus>(context_, device_);
       if (options_) {
         render_status_->SetOptions(*options_);
@@ -63,28 +65,26 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
       clip_rect_ = current_layer_->GetMatrix().GetInverse().TransformRect(
           CFX_FloatRect(device_->GetClipBox()));
     }
-    CPDF_PageObjectHolder::const_iterator iter;
-    CPDF_PageObjectHolder::const_iterator iterEnd =
-        current_layer_->GetObjectHolder()->end();
-    if (last_object_rendered_ != iterEnd) {
-      iter = last_object_rendered_;
-      ++iter;
-    } else {
-      iter = current_layer_->GetObjectHolder()->begin();
+    CPDF_PageObjectHolder* holder = current_layer_->GetObjectHolder();
+    if (holder->GetPageObjectCount() > queried_object_count_) {
+      for (size_t index : holder->GetPageObjectIndicesInRect(clip_rect_)) {
+        if (index >= queried_object_count_) {
+          layer_objects_.push_back(index);
+        }
+      }
+      queried_object_count_ = holder->GetPageObjectCount();
     }
     int nObjsToGo = kStepLimit;
     bool is_mask = false;
-    while (iter != iterEnd) {
-      CPDF_PageObject* pCurObj = iter->get();
-      if (pCurObj->IsActive() && pCurObj->GetRect().left <= clip_rect_.right &&
-          pCurObj->GetRect().right >= clip_rect_.left &&
-          pCurObj->GetRect().bottom <= clip_rect_.top &&
-          pCurObj->GetRect().top >= clip_rect_.bottom) {
+    while (next_layer_object_ < layer_objects_.size()) {
+      CPDF_PageObject* pCurObj =
+          holder->GetPageObjectByIndex(layer_objects_[next_layer_object_]);
+      if (pCurObj && pCurObj->IsActive()) {
         if (options_->GetOptions().bBreakForMasks && pCurObj->IsImage() &&
             pCurObj->AsImage()->GetImage()->IsMask()) {
 #if BUILDFLAG(IS_WIN)
           if (device_->GetDeviceType() == DeviceType::kPrinter) {
-            last_object_rendered_ = iter;
+            ++next_layer_object_;
             render_status_->ProcessClipPath(pCurObj->clip_path(),
                                             current_layer_->GetMatrix());
             return;
@@ -108,15 +108,14 @@ void CPDF_ProgressiveRenderer::Continue(PauseIndicatorIface* pPause) {
           --nObjsToGo;
         }
       }
-      last_object_rendered_ = iter;
+      ++next_layer_object_;
       if (nObjsToGo == 0) {
         if (pPause && pPause->NeedToPauseNow()) {
           return;
         }
         nObjsToGo = kStepLimit;
       }
-      ++iter;
-      if (is_mask && iter != iterEnd) {
+      if (is_mask && next_layer_object_ < layer_objects_.size()) {
         return;
       }
     }
@@ -7,9 +7,11 @@
 #ifndef CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 #define CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "core/fpdfapi/page/cpdf_pageobjectholder.h"
 #include "core/fpdfapi/render/cpdf_rendercontext.h"
@@ -54,7 +56,13 @@ class CPDF_ProgressiveRenderer {
   CFX_FloatRect clip_rect_;
   uint32_t layer_index_ = 0;
   UnownedPtr<CPDF_RenderContext::Layer> current_layer_;
-  CPDF_PageObjectHolder::const_iterator last_object_rendered_;
+  // The objects of `current_layer_` that overlap `clip_rect_`, as indices into
+  // its holder, and how many of them have been rendered.
+  std::vector<size_t> layer_objects_;
+  size_t next_layer_object_ = 0;
+  // How many objects of `current_layer_` were looked at to fill
+  // `layer_objects_`. Parsing may still be adding more.
+  size_t queried_object_count_ = 0;
 };
 
 #endif  // CORE_FPDFAPI_RENDER_CPDF_PROGRESSIVERENDERER_H_
@@ -27,6 +27,7 @@ class CPDF_RenderOptions {
 
     bool bClearType = false;
     bool bNoNativeText = false;
+    bool bSubpixelText = false;
     bool bForceHalftone = false;
     bool bRectAA = false;
     bool bBreakForMasks = false;
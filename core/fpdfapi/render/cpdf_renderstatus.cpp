@@ -31,6 +31,8 @@
 #include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/page/cpdf_pageimagecache.h"
 #include "core/fpdfapi/page/cpdf_pageobject.h"
+#include "core/fpdfapi/page/cpdf_pageobjectholder.h"
+#include "core/fpdfapi/page/cpdf_pageobjectindex.h"
 #include "core/fpdfapi/page/cpdf_pathobject.h"
 #include "core/fpdfapi/page/cpdf_shadingobject.h"
 #include "core/fpdfapi/page/cpdf_shadingpattern.h"
@@ -213,22 +215,34 @@ void CPDF_RenderStatus::RenderObjectList(
     const CFX_Matrix& mtObj2Device) {
   CFX_FloatRect clip_rect = mtObj2Device.GetInverse().TransformRect(
       CFX_FloatRect(device_->GetClipBox()));
-  for (const auto& pCurObj : *pObjectHolder) {
-    if (pCurObj.get() == stop_obj_) {
-      stopped_ = true;
-      return;
-    }
-    if (!pCurObj || !pCurObj->IsActive()) {
-      continue;
+  if (stop_obj_) {
+    // Stopping needs to see every object up to `stop_obj_`, visible or not.
+    for (const auto& pCurObj : *pObjectHolder) {
+      if (pCurObj.get() == stop_obj_) {
+        stopped_ = true;
+        return;
+      }
+      if (!pCurObj || !pCurObj->IsActive()) {
+        continue;
+      }
+
+      if (!CPDF_PageObjectIndex::Overlaps(pCurObj->GetRect(), clip_rect)) {
+        continue;
+      }
+      RenderSingleObject(pCurObj.get(), mtObj2Device);
+      if (stopped_) {
+        return;
+      }
     }
+    return;
+  }
 
-    if (pCurObj->GetRect().left > clip_rect.right ||
-        pCurObj->GetRect().right < clip_rect.left ||
-        pCurObj->GetRect().bottom > clip_rect.top ||
-        pCurObj->GetRect().top < clip_rect.bottom) {
+  for (size_t index : pObjectHolder->GetPageObjectIndicesInRect(clip_rect)) {
+    CPDF_PageObject* pCurObj = pObjectHolder->GetPageObjectByIndex(index);
+    if (!pCurObj->IsActive()) {
       continue;
     }
-    RenderSingleObject(pCurObj.get(), mtObj2Device);
+    RenderSingleObject(pCurObj, mtObj2Device);
     if (stopped_) {
       return;
     }
@@ -1055,7 +1069,8 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
       RetainPtr<CPDF_Type3Cache> pCache =
           CPDF_DocRenderData::FromDocument(pDoc)->GetCachedType3(pType3Font);
 
-      const CFX_GlyphBitmap* pBitmap = pCache->LoadGlyph(charcode, matrix);
+      RetainPtr<const CFX_GlyphBitmap> pBitmap =
+          pCache->LoadGlyph(charcode, matrix);
       if (!pBitmap) {
         continue;
       }
@@ -1079,7 +1094,7 @@ bool CPDF_RenderStatus::ProcessType3Text(CPDF_TextObject* textobj,
         device_->SetBitMask(pBitmap->GetBitmap(), left.ValueOrDie(),
                             top.ValueOrDie(), fill_argb);
       } else {
-        glyphs[iChar].glyph_ = pBitmap;
+        glyphs[iChar].glyph_ = std::move(pBitmap);
         glyphs[iChar].origin_ = origin;
       }
     }
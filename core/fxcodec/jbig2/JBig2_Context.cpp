@@ -21,6 +21,7 @@
 #include "core/fxcodec/jbig2/JBig2_PddProc.h"
 #include "core/fxcodec/jbig2/JBig2_SddProc.h"
 #include "core/fxcodec/jbig2/JBig2_TrdProc.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
@@ -57,24 +58,25 @@ std::unique_ptr<CJBig2_Context> CJBig2_Context::Create(
     uint64_t global_key,
     pdfium::span<const uint8_t> pSrcSpan,
     uint64_t src_key,
-    std::list<CJBig2_CachePair>* pSymbolDictCache) {
+    JBig2_DocumentContext* document_context) {
   auto result = pdfium::WrapUnique(
-      new CJBig2_Context(pSrcSpan, src_key, pSymbolDictCache, false));
+      new CJBig2_Context(pSrcSpan, src_key, document_context, false));
   if (!pGlobalSpan.empty()) {
     result->global_context_ = pdfium::WrapUnique(
-        new CJBig2_Context(pGlobalSpan, global_key, pSymbolDictCache, true));
+        new CJBig2_Context(pGlobalSpan, global_key, document_context, true));
   }
   return result;
 }
 
 CJBig2_Context::CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                                uint64_t src_key,
-                               std::list<CJBig2_CachePair>* pSymbolDictCache,
+                               JBig2_DocumentContext* document_context,
                                bool bIsGlobal)
     : stream_(std::make_unique<CJBig2_BitStream>(pSrcSpan, src_key)),
       huffman_tables_(CJBig2_HuffmanTable::kNumHuffmanTables),
       is_global_(bIsGlobal),
-      symbol_dict_cache_(pSymbolDictCache) {}
+      document_context_(document_context),
+      symbol_dict_cache_(document_context->GetSymbolDictCache()) {}
 
 CJBig2_Context::~CJBig2_Context() = default;
 
@@ -568,24 +570,43 @@ JBig2_Result CJBig2_Context::ParseSymbolDict(CJBig2_Segment* pSegment) {
       }
     }
   }
+  // Other documents may have decoded the same globals stream. Only hash the
+  // stream when this document has not decoded the dictionary already.
+  bool shared_cache_hit = false;
+  pdfium::span<const uint8_t> digest;
+  if (!cache_hit && is_global_ && key.first != 0 &&
+      Jbig2SymbolDictCache::Get()->IsEnabled()) {
+    digest =
+        document_context_->GetGlobalDigest(key.first, stream_->getBufSpan());
+    pSegment->symbol_dict_ =
+        Jbig2SymbolDictCache::Get()->Lookup(digest, pSegment->data_offset_);
+    shared_cache_hit = !!pSegment->symbol_dict_;
+  }
   if (!cache_hit) {
-    if (bUseGbContext) {
-      auto pArithDecoder = std::make_unique<CJBig2_ArithDecoder>(stream_.get());
-      pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeArith(
-          pArithDecoder.get(), gbContexts, grContexts);
-      if (!pSegment->symbol_dict_) {
-        return JBig2_Result::kFailure;
-      }
+    if (!shared_cache_hit) {
+      if (bUseGbContext) {
+        auto pArithDecoder =
+            std::make_unique<CJBig2_ArithDecoder>(stream_.get());
+        pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeArith(
+            pArithDecoder.get(), gbContexts, grContexts);
+        if (!pSegment->symbol_dict_) {
+          return JBig2_Result::kFailure;
+        }
 
-      stream_->alignByte();
-      stream_->addOffset(2);
-    } else {
-      pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeHuffman(
-          stream_.get(), gbContexts, grContexts);
-      if (!pSegment->symbol_dict_) {
-        return JBig2_Result::kFailure;
+        stream_->alignByte();
+        stream_->addOffset(2);
+      } else {
+        pSegment->symbol_dict_ = pSymbolDictDecoder->DecodeHuffman(
+            stream_.get(), gbContexts, grContexts);
+        if (!pSegment->symbol_dict_) {
+          return JBig2_Result::kFailure;
+        }
+        stream_->alignByte();
+      }
+      if (!digest.empty()) {
+        Jbig2SymbolDictCache::Get()->Insert(digest, pSegment->data_offset_,
+                                            *pSegment->symbol_dict_);
       }
-      stream_->alignByte();
     }
     if (is_global_) {
       std::unique_ptr<CJBig2_SymbolDict> value =
@@ -19,6 +19,7 @@
 #include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
 #include "core/fxcodec/jbig2/JBig2_Page.h"
 #include "core/fxcodec/jbig2/JBig2_Segment.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
 
@@ -37,7 +38,7 @@ class CJBig2_Context {
       uint64_t global_key,
       pdfium::span<const uint8_t> pSrcSpan,
       uint64_t src_key,
-      std::list<CJBig2_CachePair>* pSymbolDictCache);
+      JBig2_DocumentContext* document_context);
 
   ~CJBig2_Context();
 
@@ -55,7 +56,7 @@ class CJBig2_Context {
  private:
   CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                  uint64_t src_key,
-                 std::list<CJBig2_CachePair>* pSymbolDictCache,
+                 JBig2_DocumentContext* document_context,
                  bool bIsGlobal);
 
   JBig2_Result DecodeSequential(PauseIndicatorIface* pPause);
@@ -101,6 +102,7 @@ class CJBig2_Context {
   std::unique_ptr<CJBig2_Segment> segment_;
   uint32_t offset_ = 0;
   JBig2RegionInfo ri_ = {};
+  UnownedPtr<JBig2_DocumentContext> const document_context_;
   UnownedPtr<std::list<CJBig2_CachePair>> const symbol_dict_cache_;
 };
 
@@ -6,9 +6,20 @@
 
 #include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
 
+#include "core/fdrm/fx_crypt.h"
 #include "core/fxcodec/jbig2/JBig2_Image.h"
 #include "core/fxcodec/jbig2/JBig2_SymbolDict.h"
 
 JBig2_DocumentContext::JBig2_DocumentContext() = default;
 
 JBig2_DocumentContext::~JBig2_DocumentContext() = default;
+
+pdfium::span<const uint8_t> JBig2_DocumentContext::GetGlobalDigest(
+    uint64_t key,
+    pdfium::span<const uint8_t> span) {
+  auto it = global_digests_.find(key);
+  if (it == global_digests_.end()) {
+    it = global_digests_.emplace(key, CRYPT_SHA1Generate(span)).first;
+  }
+  return it->second;
+}
@@ -10,9 +10,13 @@
 #include <stdint.h>
 
 #include <list>
+#include <map>
 #include <memory>
 #include <utility>
 
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+
 class CJBig2_SymbolDict;
 
 // Cache is keyed by both the key of a stream and an index within the stream.
@@ -30,8 +34,14 @@ class JBig2_DocumentContext {
     return &symbol_dict_cache_;
   }
 
+  // Returns the digest of the globals stream with `key` and contents `span`,
+  // for Jbig2SymbolDictCache. Only computed the first time for each stream.
+  pdfium::span<const uint8_t> GetGlobalDigest(uint64_t key,
+                                              pdfium::span<const uint8_t> span);
+
  private:
   std::list<CJBig2_CachePair> symbol_dict_cache_;
+  std::map<uint64_t, DataVector<uint8_t>> global_digests_;
 };
 
 #endif  // CORE_FXCODEC_JBIG2_JBIG2_DOCUMENTCONTEXT_H_
@@ -6,6 +6,10 @@
 
 #include "core/fxcodec/jbig2/JBig2_GrdProc.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <memory>
@@ -15,6 +19,8 @@
 #include "core/fxcodec/jbig2/JBig2_ArithDecoder.h"
 #include "core/fxcodec/jbig2/JBig2_BitStream.h"
 #include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcrt/byteorder.h"
+#include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/pauseindicator_iface.h"
 
 namespace {
@@ -22,20 +28,6 @@ namespace {
 // TODO(npm): Name this constants better or merge some together.
 constexpr std::array<const uint16_t, 3> kOptConstant1 = {
     {0x9b25, 0x0795, 0x00e5}};
-constexpr std::array<const uint16_t, 3> kOptConstant2 = {
-    {0x0006, 0x0004, 0x0001}};
-constexpr std::array<const uint16_t, 3> kOptConstant3 = {
-    {0xf800, 0x1e00, 0x0380}};
-constexpr std::array<const uint16_t, 3> kOptConstant4 = {
-    {0x0000, 0x0001, 0x0003}};
-constexpr std::array<const uint16_t, 3> kOptConstant5 = {
-    {0x07f0, 0x01f8, 0x007c}};
-constexpr std::array<const uint16_t, 3> kOptConstant6 = {
-    {0x7bf7, 0x0efb, 0x01bd}};
-constexpr std::array<const uint16_t, 3> kOptConstant7 = {
-    {0x0800, 0x0200, 0x0080}};
-constexpr std::array<const uint16_t, 3> kOptConstant8 = {
-    {0x0010, 0x0008, 0x0004}};
 constexpr std::array<const uint16_t, 3> kOptConstant9 = {
     {0x000c, 0x0009, 0x0007}};
 constexpr std::array<const uint16_t, 3> kOptConstant10 = {
@@ -45,6 +37,102 @@ constexpr std::array<const uint16_t, 3> kOptConstant11 = {
 constexpr std::array<const uint16_t, 3> kOptConstant12 = {
     {0x000f, 0x0007, 0x0003}};
 
+// How the contexts for templates 0 to 3 with their nominal AT pixels are
+// formed from the rows above the one being decoded. `line1` is the row two
+// above and `line2` the row right above; template 3 only uses `line2`.
+struct Opt3Template {
+  uint32_t ltp_context;
+  uint32_t line1_shift;
+  uint32_t line1_first_mask;
+  uint32_t line2_shift;
+  uint32_t line2_first_mask;
+  uint32_t context_mask;
+  uint32_t line1_mask;
+  uint32_t line2_mask;
+};
+
+constexpr std::array<const Opt3Template, 4> kOpt3Templates = {{
+    {0x9b25, 6, 0xf800, 0, 0x07f0, 0x7bf7, 0x0800, 0x0010},
+    {0x0795, 4, 0x1e00, 1, 0x01f8, 0x0efb, 0x0200, 0x0008},
+    {0x00e5, 1, 0x0380, 3, 0x007c, 0x01bd, 0x0080, 0x0004},
+    {0x0195, 0, 0x0000, 1, 0x03f0, 0x01f7, 0x0000, 0x0010},
+}};
+
+// Pixels decoded per 64-bit window of a reference row. The last byte of the
+// window is only there for the pixels the context looks ahead to.
+constexpr uint32_t kWindowPixels = 56;
+
+// Returns 8 bytes of `row` from `index` on, the first in the top bits. Bytes
+// past the end of `row` read as zero.
+uint64_t LoadRowWindow(pdfium::span<const uint8_t> row, size_t index) {
+  if (index + 8 <= row.size()) {
+    pdfium::span<const uint8_t> bytes = row.subspan(index, 8u);
+    return (uint64_t{fxcrt::GetUInt32MSBFirst(bytes.first<4u>())} << 32) |
+           fxcrt::GetUInt32MSBFirst(bytes.last<4u>());
+  }
+  uint64_t window = 0;
+  for (size_t i = index; i < index + 8; ++i) {
+    window = (window << 8) | (i < row.size() ? row[i] : 0);
+  }
+  return window;
+}
+
+// Decodes row `y` of `image`, which is `width` pixels wide, with `tmpl`.
+// Rather than shifting the rows above in a byte at a time, the context bits
+// are taken from 64-bit windows of them. Returns false if the decoder runs out
+// of data.
+bool DecodeRowOpt3(const Opt3Template& tmpl,
+                   CJBig2_ArithDecoder* pArithDecoder,
+                   pdfium::span<JBig2ArithCtx> gbContexts,
+                   CJBig2_Image* image,
+                   uint32_t width,
+                   uint32_t y) {
+  const size_t row_size = (width + 7) / 8;
+  pdfium::span<const uint8_t> line1;
+  pdfium::span<const uint8_t> line2;
+  const int32_t row = static_cast<int32_t>(y);
+  if (y > 1 && tmpl.line1_mask) {
+    line1 = UNSAFE_TODO(pdfium::span(image->GetLine(row - 2), row_size));
+  }
+  if (y > 0) {
+    line2 = UNSAFE_TODO(pdfium::span(image->GetLine(row - 1), row_size));
+  }
+  pdfium::span<uint8_t> dest =
+      UNSAFE_TODO(pdfium::span(image->GetLine(row), row_size));
+
+  uint32_t context = 0;
+  for (uint32_t x = 0; x < width; x += kWindowPixels) {
+    const size_t index = x / 8;
+    const uint64_t window1 = LoadRowWindow(line1, index);
+    const uint64_t window2 = LoadRowWindow(line2, index);
+    if (x == 0) {
+      context = (((window1 >> 56) << tmpl.line1_shift) &
+                 tmpl.line1_first_mask) |
+                ((window2 >> (56 + tmpl.line2_shift)) & tmpl.line2_first_mask);
+    }
+    const uint32_t pixels = std::min(kWindowPixels, width - x);
+    uint64_t result = 0;
+    uint32_t i = 0;
+    for (; i < pixels && !pArithDecoder->IsComplete(); ++i) {
+      const uint32_t k = kWindowPixels - 1 - i;
+      const uint32_t bVal = pArithDecoder->Decode(&gbContexts[context]);
+      result |= uint64_t{bVal} << k;
+      context = ((context & tmpl.context_mask) << 1) | bVal |
+                (((window1 >> k) << tmpl.line1_shift) & tmpl.line1_mask) |
+                ((window2 >> (k + tmpl.line2_shift)) & tmpl.line2_mask);
+    }
+    // When the data runs out, only the bytes finished so far are stored.
+    const size_t bytes = i == pixels ? (pixels + 7) / 8 : i / 8;
+    for (size_t j = 0; j < bytes; ++j) {
+      dest[index + j] = static_cast<uint8_t>(result >> (48 - 8 * j));
+    }
+    if (i < pixels) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 CJBig2_GRDProc::ProgressiveArithDecodeState::ProgressiveArithDecodeState() =
@@ -93,7 +181,7 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArith(
                  : DecodeArithTemplateUnopt(pArithDecoder, gbContexts, 2);
     default:
       return UseTemplate23Opt3()
-                 ? DecodeArithTemplate3Opt3(pArithDecoder, gbContexts)
+                 ? DecodeArithOpt3(pArithDecoder, gbContexts, 3)
                  : DecodeArithTemplate3Unopt(pArithDecoder, gbContexts);
   }
 }
@@ -108,110 +196,25 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithOpt3(
   }
 
   int LTP = 0;
-  uint8_t* pLine = GBREG->data();
-  int32_t nStride = GBREG->stride();
-  int32_t nStride2 = nStride << 1;
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
   // TODO(npm): Why is the height only trimmed when OPT is 0?
   uint32_t height = OPT == 0 ? GBH & 0x7fffffff : GBH;
-  UNSAFE_TODO({
-    for (uint32_t h = 0; h < height; ++h) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return nullptr;
-        }
-
-        LTP = LTP ^ pArithDecoder->Decode(&gbContexts[kOptConstant1[OPT]]);
+  const Opt3Template& tmpl = kOpt3Templates[OPT];
+  for (uint32_t h = 0; h < height; ++h) {
+    if (TPGDON) {
+      if (pArithDecoder->IsComplete()) {
+        return nullptr;
       }
-      if (LTP) {
-        GBREG->CopyLine(h, h - 1);
-      } else {
-        if (h > 1) {
-          uint8_t* pLine1 = pLine - nStride2;
-          uint8_t* pLine2 = pLine - nStride;
-          uint32_t line1 = (*pLine1++) << kOptConstant2[OPT];
-          uint32_t line2 = *pLine2++;
-          uint32_t CONTEXT =
-              (line1 & kOptConstant3[OPT]) |
-              ((line2 >> kOptConstant4[OPT]) & kOptConstant5[OPT]);
-          for (int32_t cc = 0; cc < nLineBytes; ++cc) {
-            line1 = (line1 << 8) | ((*pLine1++) << kOptConstant2[OPT]);
-            line2 = (line2 << 8) | (*pLine2++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; --k) {
-              if (pArithDecoder->IsComplete()) {
-                return nullptr;
-              }
 
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT =
-                  (((CONTEXT & kOptConstant6[OPT]) << 1) | bVal |
-                   ((line1 >> k) & kOptConstant7[OPT]) |
-                   ((line2 >> (k + kOptConstant4[OPT])) & kOptConstant8[OPT]));
-            }
-            pLine[cc] = cVal;
-          }
-          line1 <<= 8;
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; ++k) {
-            if (pArithDecoder->IsComplete()) {
-              return nullptr;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = (((CONTEXT & kOptConstant6[OPT]) << 1) | bVal |
-                       ((line1 >> (7 - k)) & kOptConstant7[OPT]) |
-                       ((line2 >> (7 + kOptConstant4[OPT] - k)) &
-                        kOptConstant8[OPT]));
-          }
-          pLine[nLineBytes] = cVal1;
-        } else {
-          uint8_t* pLine2 = pLine - nStride;
-          uint32_t line2 = (h & 1) ? (*pLine2++) : 0;
-          uint32_t CONTEXT =
-              ((line2 >> kOptConstant4[OPT]) & kOptConstant5[OPT]);
-          for (int32_t cc = 0; cc < nLineBytes; ++cc) {
-            if (h & 1) {
-              line2 = (line2 << 8) | (*pLine2++);
-            }
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; --k) {
-              if (pArithDecoder->IsComplete()) {
-                return nullptr;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT =
-                  (((CONTEXT & kOptConstant6[OPT]) << 1) | bVal |
-                   ((line2 >> (k + kOptConstant4[OPT])) & kOptConstant8[OPT]));
-            }
-            pLine[cc] = cVal;
-          }
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; ++k) {
-            if (pArithDecoder->IsComplete()) {
-              return nullptr;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = (((CONTEXT & kOptConstant6[OPT]) << 1) | bVal |
-                       (((line2 >> (7 + kOptConstant4[OPT] - k))) &
-                        kOptConstant8[OPT]));
-          }
-          pLine[nLineBytes] = cVal1;
-        }
-      }
-      pLine += nStride;
+      LTP = LTP ^ pArithDecoder->Decode(&gbContexts[tmpl.ltp_context]);
     }
-    return GBREG;
-  });
+    if (LTP) {
+      GBREG->CopyLine(h, h - 1);
+    } else if (!DecodeRowOpt3(tmpl, pArithDecoder, gbContexts, GBREG.get(),
+                              GBW, h)) {
+      return nullptr;
+    }
+  }
+  return GBREG;
 }
 
 std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplateUnopt(
@@ -282,99 +285,6 @@ std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplateUnopt(
   return GBREG;
 }
 
-std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Opt3(
-    CJBig2_ArithDecoder* pArithDecoder,
-    pdfium::span<JBig2ArithCtx> gbContexts) {
-  auto GBREG = std::make_unique<CJBig2_Image>(GBW, GBH);
-  if (!GBREG->data()) {
-    return nullptr;
-  }
-
-  int LTP = 0;
-  uint8_t* pLine = GBREG->data();
-  int32_t nStride = GBREG->stride();
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
-
-  UNSAFE_TODO({
-    for (uint32_t h = 0; h < GBH; h++) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return nullptr;
-        }
-
-        LTP = LTP ^ pArithDecoder->Decode(&gbContexts[0x0195]);
-      }
-
-      if (LTP) {
-        GBREG->CopyLine(h, h - 1);
-      } else {
-        if (h > 0) {
-          uint8_t* pLine1 = pLine - nStride;
-          uint32_t line1 = *pLine1++;
-          uint32_t CONTEXT = (line1 >> 1) & 0x03f0;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            line1 = (line1 << 8) | (*pLine1++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return nullptr;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal |
-                        ((line1 >> (k + 1)) & 0x0010);
-            }
-            pLine[cc] = cVal;
-          }
-          line1 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return nullptr;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal |
-                      ((line1 >> (8 - k)) & 0x0010);
-          }
-          pLine[nLineBytes] = cVal1;
-        } else {
-          uint32_t CONTEXT = 0;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return nullptr;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal;
-            }
-            pLine[cc] = cVal;
-          }
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return nullptr;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal;
-          }
-          pLine[nLineBytes] = cVal1;
-        }
-      }
-      pLine += nStride;
-    }
-    return GBREG;
-  });
-}
-
 std::unique_ptr<CJBig2_Image> CJBig2_GRDProc::DecodeArithTemplate3Unopt(
     CJBig2_ArithDecoder* pArithDecoder,
     pdfium::span<JBig2ArithCtx> gbContexts) {
@@ -443,7 +353,6 @@ FXCODEC_STATUS CJBig2_GRDProc::StartDecodeArith(
   pImage->get()->Fill(false);
   decode_type_ = 1;
   ltp_ = 0;
-  line_ = nullptr;
   loop_index_ = 0;
   return ProgressiveDecodeArith(pState);
 }
@@ -526,113 +435,39 @@ FXCODEC_STATUS CJBig2_GRDProc::ContinueDecode(
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Opt3(
     ProgressiveArithDecodeState* pState) {
+  return ProgressiveDecodeArithOpt3(pState, 0);
+}
+
+FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithOpt3(
+    ProgressiveArithDecodeState* pState,
+    int OPT) {
   CJBig2_Image* pImage = pState->pImage->get();
   pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
   CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  if (!line_) {
-    line_ = pImage->data();
-  }
-  int32_t nStride = pImage->stride();
-  int32_t nStride2 = nStride << 1;
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
-  uint32_t height = GBH & 0x7fffffff;
-
-  UNSAFE_TODO({
-    for (; loop_index_ < height; loop_index_++) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return FXCODEC_STATUS::kError;
-        }
-
-        ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x9b25]);
+  uint32_t height = OPT == 0 ? GBH & 0x7fffffff : GBH;
+  const Opt3Template& tmpl = kOpt3Templates[OPT];
+  for (; loop_index_ < height; loop_index_++) {
+    if (TPGDON) {
+      if (pArithDecoder->IsComplete()) {
+        return FXCODEC_STATUS::kError;
       }
-      if (ltp_) {
-        pImage->CopyLine(loop_index_, loop_index_ - 1);
-      } else {
-        if (loop_index_ > 1) {
-          uint8_t* pLine1 = line_ - nStride2;
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line1 = (*pLine1++) << 6;
-          uint32_t line2 = *pLine2++;
-          uint32_t CONTEXT = ((line1 & 0xf800) | (line2 & 0x07f0));
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            line1 = (line1 << 8) | ((*pLine1++) << 6);
-            line2 = (line2 << 8) | (*pLine2++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = (((CONTEXT & 0x7bf7) << 1) | bVal |
-                         ((line1 >> k) & 0x0800) | ((line2 >> k) & 0x0010));
-            }
-            line_[cc] = cVal;
-          }
-          line1 <<= 8;
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT =
-                (((CONTEXT & 0x7bf7) << 1) | bVal |
-                 ((line1 >> (7 - k)) & 0x0800) | ((line2 >> (7 - k)) & 0x0010));
-          }
-          line_[nLineBytes] = cVal1;
-        } else {
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line2 = (loop_index_ & 1) ? (*pLine2++) : 0;
-          uint32_t CONTEXT = (line2 & 0x07f0);
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            if (loop_index_ & 1) {
-              line2 = (line2 << 8) | (*pLine2++);
-            }
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT =
-                  (((CONTEXT & 0x7bf7) << 1) | bVal | ((line2 >> k) & 0x0010));
-            }
-            line_[cc] = cVal;
-          }
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
 
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = (((CONTEXT & 0x7bf7) << 1) | bVal |
-                       ((line2 >> (7 - k)) & 0x0010));
-          }
-          line_[nLineBytes] = cVal1;
-        }
-      }
-      line_ += nStride;
-      if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-        loop_index_++;
-        progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-        return FXCODEC_STATUS::kDecodeToBeContinued;
-      }
+      ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[tmpl.ltp_context]);
     }
-    progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-    return FXCODEC_STATUS::kDecodeFinished;
-  });
+    if (ltp_) {
+      pImage->CopyLine(loop_index_, loop_index_ - 1);
+    } else if (!DecodeRowOpt3(tmpl, pArithDecoder, gbContexts,
+                              pImage, GBW, loop_index_)) {
+      return FXCODEC_STATUS::kError;
+    }
+    if (pState->pPause && pState->pPause->NeedToPauseNow()) {
+      loop_index_++;
+      progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
+      return FXCODEC_STATUS::kDecodeToBeContinued;
+    }
+  }
+  progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
+  return FXCODEC_STATUS::kDecodeFinished;
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt(
@@ -697,112 +532,7 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate0Unopt(
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Opt3(
     ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  if (!line_) {
-    line_ = pImage->data();
-  }
-  int32_t nStride = pImage->stride();
-  int32_t nStride2 = nStride << 1;
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
-
-  UNSAFE_TODO({
-    for (; loop_index_ < GBH; loop_index_++) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return FXCODEC_STATUS::kError;
-        }
-
-        ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x0795]);
-      }
-      if (ltp_) {
-        pImage->CopyLine(loop_index_, loop_index_ - 1);
-      } else {
-        if (loop_index_ > 1) {
-          uint8_t* pLine1 = line_ - nStride2;
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line1 = (*pLine1++) << 4;
-          uint32_t line2 = *pLine2++;
-          uint32_t CONTEXT = (line1 & 0x1e00) | ((line2 >> 1) & 0x01f8);
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            line1 = (line1 << 8) | ((*pLine1++) << 4);
-            line2 = (line2 << 8) | (*pLine2++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x0efb) << 1) | bVal |
-                        ((line1 >> k) & 0x0200) | ((line2 >> (k + 1)) & 0x0008);
-            }
-            line_[cc] = cVal;
-          }
-          line1 <<= 8;
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x0efb) << 1) | bVal |
-                      ((line1 >> (7 - k)) & 0x0200) |
-                      ((line2 >> (8 - k)) & 0x0008);
-          }
-          line_[nLineBytes] = cVal1;
-        } else {
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line2 = (loop_index_ & 1) ? (*pLine2++) : 0;
-          uint32_t CONTEXT = (line2 >> 1) & 0x01f8;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            if (loop_index_ & 1) {
-              line2 = (line2 << 8) | (*pLine2++);
-            }
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x0efb) << 1) | bVal |
-                        ((line2 >> (k + 1)) & 0x0008);
-            }
-            line_[cc] = cVal;
-          }
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x0efb) << 1) | bVal |
-                      ((line2 >> (8 - k)) & 0x0008);
-          }
-          line_[nLineBytes] = cVal1;
-        }
-      }
-      line_ += nStride;
-      if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-        loop_index_++;
-        progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-        return FXCODEC_STATUS::kDecodeToBeContinued;
-      }
-    }
-    progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-    return FXCODEC_STATUS::kDecodeFinished;
-  });
+  return ProgressiveDecodeArithOpt3(pState, 1);
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt(
@@ -863,112 +593,7 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate1Unopt(
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Opt3(
     ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  if (!line_) {
-    line_ = pImage->data();
-  }
-  int32_t nStride = pImage->stride();
-  int32_t nStride2 = nStride << 1;
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
-  UNSAFE_TODO({
-    for (; loop_index_ < GBH; loop_index_++) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return FXCODEC_STATUS::kError;
-        }
-
-        ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x00e5]);
-      }
-      if (ltp_) {
-        pImage->CopyLine(loop_index_, loop_index_ - 1);
-      } else {
-        if (loop_index_ > 1) {
-          uint8_t* pLine1 = line_ - nStride2;
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line1 = (*pLine1++) << 1;
-          uint32_t line2 = *pLine2++;
-          uint32_t CONTEXT = (line1 & 0x0380) | ((line2 >> 3) & 0x007c);
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            line1 = (line1 << 8) | ((*pLine1++) << 1);
-            line2 = (line2 << 8) | (*pLine2++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01bd) << 1) | bVal |
-                        ((line1 >> k) & 0x0080) | ((line2 >> (k + 3)) & 0x0004);
-            }
-            line_[cc] = cVal;
-          }
-          line1 <<= 8;
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01bd) << 1) | bVal |
-                      ((line1 >> (7 - k)) & 0x0080) |
-                      ((line2 >> (10 - k)) & 0x0004);
-          }
-          line_[nLineBytes] = cVal1;
-        } else {
-          uint8_t* pLine2 = line_ - nStride;
-          uint32_t line2 = (loop_index_ & 1) ? (*pLine2++) : 0;
-          uint32_t CONTEXT = (line2 >> 3) & 0x007c;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            if (loop_index_ & 1) {
-              line2 = (line2 << 8) | (*pLine2++);
-            }
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01bd) << 1) | bVal |
-                        ((line2 >> (k + 3)) & 0x0004);
-            }
-            line_[cc] = cVal;
-          }
-          line2 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01bd) << 1) | bVal |
-                      (((line2 >> (10 - k))) & 0x0004);
-          }
-          line_[nLineBytes] = cVal1;
-        }
-      }
-      line_ += nStride;
-      if (pState->pPause && loop_index_ % 50 == 0 &&
-          pState->pPause->NeedToPauseNow()) {
-        loop_index_++;
-        progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-        return FXCODEC_STATUS::kDecodeToBeContinued;
-      }
-    }
-    progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-    return FXCODEC_STATUS::kDecodeFinished;
-  })
+  return ProgressiveDecodeArithOpt3(pState, 2);
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt(
@@ -1029,97 +654,7 @@ FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate2Unopt(
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Opt3(
     ProgressiveArithDecodeState* pState) {
-  CJBig2_Image* pImage = pState->pImage->get();
-  pdfium::span<JBig2ArithCtx> gbContexts = pState->gbContexts;
-  CJBig2_ArithDecoder* pArithDecoder = pState->pArithDecoder;
-  if (!line_) {
-    line_ = pImage->data();
-  }
-  int32_t nStride = pImage->stride();
-  int32_t nLineBytes = ((GBW + 7) >> 3) - 1;
-  int32_t nBitsLeft = GBW - (nLineBytes << 3);
-  UNSAFE_TODO({
-    for (; loop_index_ < GBH; loop_index_++) {
-      if (TPGDON) {
-        if (pArithDecoder->IsComplete()) {
-          return FXCODEC_STATUS::kError;
-        }
-
-        ltp_ = ltp_ ^ pArithDecoder->Decode(&gbContexts[0x0195]);
-      }
-      if (ltp_) {
-        pImage->CopyLine(loop_index_, loop_index_ - 1);
-      } else {
-        if (loop_index_ > 0) {
-          uint8_t* pLine1 = line_ - nStride;
-          uint32_t line1 = *pLine1++;
-          uint32_t CONTEXT = (line1 >> 1) & 0x03f0;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            line1 = (line1 << 8) | (*pLine1++);
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal |
-                        ((line1 >> (k + 1)) & 0x0010);
-            }
-            line_[cc] = cVal;
-          }
-          line1 <<= 8;
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal |
-                      ((line1 >> (8 - k)) & 0x0010);
-          }
-          line_[nLineBytes] = cVal1;
-        } else {
-          uint32_t CONTEXT = 0;
-          for (int32_t cc = 0; cc < nLineBytes; cc++) {
-            uint8_t cVal = 0;
-            for (int32_t k = 7; k >= 0; k--) {
-              if (pArithDecoder->IsComplete()) {
-                return FXCODEC_STATUS::kError;
-              }
-
-              int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-              cVal |= bVal << k;
-              CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal;
-            }
-            line_[cc] = cVal;
-          }
-          uint8_t cVal1 = 0;
-          for (int32_t k = 0; k < nBitsLeft; k++) {
-            if (pArithDecoder->IsComplete()) {
-              return FXCODEC_STATUS::kError;
-            }
-
-            int bVal = pArithDecoder->Decode(&gbContexts[CONTEXT]);
-            cVal1 |= bVal << (7 - k);
-            CONTEXT = ((CONTEXT & 0x01f7) << 1) | bVal;
-          }
-          line_[nLineBytes] = cVal1;
-        }
-      }
-      line_ += nStride;
-      if (pState->pPause && pState->pPause->NeedToPauseNow()) {
-        loop_index_++;
-        progressive_status_ = FXCODEC_STATUS::kDecodeToBeContinued;
-        return FXCODEC_STATUS::kDecodeToBeContinued;
-      }
-    }
-    progressive_status_ = FXCODEC_STATUS::kDecodeFinished;
-    return FXCODEC_STATUS::kDecodeFinished;
-  });
+  return ProgressiveDecodeArithOpt3(pState, 3);
 }
 
 FXCODEC_STATUS CJBig2_GRDProc::ProgressiveDecodeArithTemplate3Unopt(
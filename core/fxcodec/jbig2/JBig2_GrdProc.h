@@ -16,7 +16,6 @@
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/unowned_ptr.h"
-#include "core/fxcrt/unowned_ptr_exclusion.h"
 
 class CJBig2_ArithDecoder;
 class CJBig2_BitStream;
@@ -65,6 +64,8 @@ class CJBig2_GRDProc {
   bool UseTemplate23Opt3() const;
 
   FXCODEC_STATUS ProgressiveDecodeArith(ProgressiveArithDecodeState* pState);
+  FXCODEC_STATUS ProgressiveDecodeArithOpt3(ProgressiveArithDecodeState* pState,
+                                            int OPT);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate0Opt3(
       ProgressiveArithDecodeState* pState);
   FXCODEC_STATUS ProgressiveDecodeArithTemplate0Unopt(
@@ -90,15 +91,11 @@ class CJBig2_GRDProc {
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> gbContexts,
       int UNOPT);
-  std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Opt3(
-      CJBig2_ArithDecoder* pArithDecoder,
-      pdfium::span<JBig2ArithCtx> gbContexts);
   std::unique_ptr<CJBig2_Image> DecodeArithTemplate3Unopt(
       CJBig2_ArithDecoder* pArithDecoder,
       pdfium::span<JBig2ArithCtx> gbContexts);
 
   uint32_t loop_index_ = 0;
-  UNOWNED_PTR_EXCLUSION uint8_t* line_ = nullptr;
   FXCODEC_STATUS progressive_status_;
   uint16_t decode_type_ = 0;
   int ltp_ = 0;
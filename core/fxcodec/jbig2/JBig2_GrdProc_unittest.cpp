@@ -0,0 +1,121 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/JBig2_GrdProc.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/fxcodec/jbig2/JBig2_ArithDecoder.h"
+#include "core/fxcodec/jbig2/JBig2_BitStream.h"
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/fx_2d_size.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/hash.h"
+
+namespace {
+
+// Odd sizes, so rows end part way through a byte and part way through the
+// decoder's 64-bit windows.
+constexpr uint32_t kWidth = 203;
+constexpr uint32_t kHeight = 37;
+
+// Pseudo-random arithmetic coded data, mostly zeros like a sparse page. There
+// are no 0xFF bytes, which the decoder would take for the end of the data.
+std::vector<uint8_t> MakeStream(size_t size, uint32_t seed) {
+  std::vector<uint8_t> stream(size);
+  for (uint8_t& byte : stream) {
+    seed = seed * 1103515245 + 12345;
+    byte = (seed >> 16) % 4 ? 0 : (seed >> 8) % 255;
+  }
+  return stream;
+}
+
+std::unique_ptr<CJBig2_GRDProc> CreateProc(uint8_t gb_template, bool tpgdon) {
+  auto proc = std::make_unique<CJBig2_GRDProc>();
+  proc->MMR = false;
+  proc->TPGDON = tpgdon;
+  proc->USESKIP = false;
+  proc->GBTEMPLATE = gb_template;
+  proc->GBW = kWidth;
+  proc->GBH = kHeight;
+  // The nominal AT pixels, which take the optimized decoders.
+  if (gb_template == 0) {
+    proc->GBAT = {3, -1, -3, -1, 2, -2, -2, -2};
+  } else if (gb_template == 1) {
+    proc->GBAT = {3, -1, 0, 0, 0, 0, 0, 0};
+  } else {
+    proc->GBAT = {2, -1, 0, 0, 0, 0, 0, 0};
+  }
+  return proc;
+}
+
+std::string HashImage(const CJBig2_Image* image) {
+  if (!image) {
+    return std::string();
+  }
+  return GenerateMD5Base16(UNSAFE_BUFFERS(pdfium::span(
+      image->data(), Fx2DSizeOrDie(image->stride(), image->height()))));
+}
+
+std::string DecodeArith(uint8_t gb_template, bool tpgdon) {
+  const std::vector<uint8_t> stream = MakeStream(4096, gb_template);
+  CJBig2_BitStream bit_stream(stream, 0);
+  CJBig2_ArithDecoder decoder(&bit_stream);
+  std::vector<JBig2ArithCtx> contexts(65536);
+  std::unique_ptr<CJBig2_GRDProc> proc = CreateProc(gb_template, tpgdon);
+  std::unique_ptr<CJBig2_Image> image = proc->DecodeArith(&decoder, contexts);
+  return HashImage(image.get());
+}
+
+std::string ProgressiveDecodeArith(uint8_t gb_template, bool tpgdon) {
+  const std::vector<uint8_t> stream = MakeStream(4096, gb_template);
+  CJBig2_BitStream bit_stream(stream, 0);
+  CJBig2_ArithDecoder decoder(&bit_stream);
+  std::vector<JBig2ArithCtx> contexts(65536);
+  std::unique_ptr<CJBig2_GRDProc> proc = CreateProc(gb_template, tpgdon);
+  std::unique_ptr<CJBig2_Image> image;
+  CJBig2_GRDProc::ProgressiveArithDecodeState state;
+  state.pImage = &image;
+  state.pArithDecoder = &decoder;
+  state.gbContexts = contexts;
+  if (proc->StartDecodeArith(&state) != FXCODEC_STATUS::kDecodeFinished) {
+    return std::string();
+  }
+  return HashImage(image.get());
+}
+
+}  // namespace
+
+// The expected hashes come from the bytewise decoders that the 64-bit window
+// decoders replaced.
+TEST(JBig2GRDProc, DecodeArithTemplates) {
+  static constexpr struct {
+    uint8_t gb_template;
+    bool tpgdon;
+    const char* md5;
+  } kTestCases[] = {
+      {0, false, "d28ef46759984658817590b7673127cf"},
+      {0, true, "d5df2659f3ce87f26eab19dfd4e657f5"},
+      {1, false, "025ad2034d208a2e8d14bf8728cc57f3"},
+      {1, true, "6f1022690729a94097cb9a7b4eb6fb2a"},
+      {2, false, "eb7c1f16e6da217417befd5a3c495463"},
+      {2, true, "15c5d42fb845487dfa5312ca46c9aadc"},
+      {3, false, "a57591528f46ded6bcd96ccce3eabc85"},
+      {3, true, "3fa3b325acd86d78631501e346cd1efc"},
+  };
+  for (const auto& test_case : kTestCases) {
+    SCOPED_TRACE(static_cast<int>(test_case.gb_template));
+    SCOPED_TRACE(test_case.tpgdon);
+    EXPECT_EQ(test_case.md5,
+              DecodeArith(test_case.gb_template, test_case.tpgdon));
+    EXPECT_EQ(test_case.md5,
+              ProgressiveDecodeArith(test_case.gb_template, test_case.tpgdon));
+  }
+}
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "core/fxcodec/jbig2/jbig2_compose.h"
 #include "core/fxcrt/check.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fx_2d_size.h"
@@ -483,7 +484,11 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
             sp += 4;
             dp += 4;
           }
-          for (int32_t xx = 0; xx < middleDwords; xx++) {
+          int32_t xx = pdfium::ComposeShiftedWordsVectorized(
+              dp, sp, middleDwords, shift1, op);
+          sp += xx * 4;
+          dp += xx * 4;
+          for (; xx < middleDwords; xx++) {
             uint32_t tmp1 = (JBIG2_GETDWORD(sp) << shift1) |
                             (JBIG2_GETDWORD(sp + 4) >> shift2);
             uint32_t tmp2 = JBIG2_GETDWORD(dp);
@@ -571,7 +576,11 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
             sp += 4;
             dp += 4;
           }
-          for (int32_t xx = 0; xx < middleDwords; xx++) {
+          int32_t xx =
+              pdfium::ComposeWordsVectorized(dp, sp, middleDwords, op);
+          sp += xx * 4;
+          dp += xx * 4;
+          for (; xx < middleDwords; xx++) {
             uint32_t tmp1 = JBIG2_GETDWORD(sp);
             uint32_t tmp2 = JBIG2_GETDWORD(dp);
             uint32_t tmp = 0;
@@ -656,7 +665,11 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
             JBIG2_PUTDWORD(dp, tmp);
             dp += 4;
           }
-          for (int32_t xx = 0; xx < middleDwords; xx++) {
+          int32_t xx = pdfium::ComposeShiftedWordsVectorized(
+              dp, sp, middleDwords, shift2, op);
+          sp += xx * 4;
+          dp += xx * 4;
+          for (; xx < middleDwords; xx++) {
             uint32_t tmp1 = (JBIG2_GETDWORD(sp) << shift2) |
                             ((JBIG2_GETDWORD(sp + 4)) >> shift1);
             uint32_t tmp2 = JBIG2_GETDWORD(dp);
@@ -0,0 +1,251 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Decode time benchmarks for the JBIG2 decoder. They are disabled by default;
+// run them by passing --gtest_also_run_disabled_tests and
+// --gtest_filter=JBig2Benchmark.* to pdfium_unittests.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/fpdfapi/parser/cpdf_dictionary.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcodec/jbig2/JBig2_ArithDecoder.h"
+#include "core/fxcodec/jbig2/JBig2_BitStream.h"
+#include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
+#include "core/fxcodec/jbig2/JBig2_GrdProc.h"
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcodec/jbig2/jbig2_decoder.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/path_service.h"
+
+namespace {
+
+constexpr int kIterations = 10;
+
+// A letter size page at 300 dpi.
+constexpr uint32_t kPageWidth = 2550;
+constexpr uint32_t kPageHeight = 3300;
+
+// Test files with JBIG2 images. Some images are generic regions, others text
+// regions with symbol dictionaries in their JBIG2Globals.
+constexpr const char* kCorpus[] = {
+    "bug_552046.pdf",     "bug_631912.pdf",       "bug_674771.pdf",
+    "pixel/bug_1087.pdf", "pixel/bug_867501.pdf",
+};
+
+struct Jbig2Image {
+  std::string name;
+  uint32_t width;
+  uint32_t height;
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> globals;
+};
+
+std::vector<uint8_t> LoadData(RetainPtr<const CPDF_Stream> stream) {
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->LoadAllDataFiltered();
+  pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+  return std::vector<uint8_t>(span.begin(), span.end());
+}
+
+// Returns the JBIG2 images in the test file `file_name`.
+std::vector<Jbig2Image> LoadImages(const char* file_name) {
+  std::vector<Jbig2Image> images;
+  std::string file_path = PathService::GetTestFilePath(file_name);
+  if (file_path.empty()) {
+    return images;
+  }
+  CPDF_Parser parser;
+  if (parser.StartParse(
+          IFX_SeekableReadStream::CreateFromFilename(file_path.c_str()), "",
+          0) != CPDF_Parser::SUCCESS) {
+    return images;
+  }
+  for (uint32_t objnum = 1; objnum <= parser.GetLastObjNum(); ++objnum) {
+    RetainPtr<const CPDF_Stream> stream =
+        ToStream(parser.ParseIndirectObject(objnum));
+    if (!stream) {
+      continue;
+    }
+    auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(stream);
+    stream_acc->LoadAllDataImageAcc(0);
+    if (stream_acc->GetImageDecoder() != "JBIG2Decode") {
+      continue;
+    }
+    RetainPtr<const CPDF_Dictionary> dict = stream->GetDict();
+    Jbig2Image image;
+    image.name = std::string(file_name) + " " + std::to_string(objnum);
+    image.width = dict->GetIntegerFor("Width");
+    image.height = dict->GetIntegerFor("Height");
+    pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+    image.data.assign(span.begin(), span.end());
+    RetainPtr<const CPDF_Dictionary> params = stream_acc->GetImageParam();
+    if (params) {
+      RetainPtr<const CPDF_Stream> globals =
+          params->GetStreamFor("JBIG2Globals");
+      if (globals) {
+        image.globals = LoadData(std::move(globals));
+      }
+    }
+    images.push_back(std::move(image));
+  }
+  return images;
+}
+
+// Decodes `image` without a symbol dictionary cache, so every decode parses
+// the globals again. Returns an empty vector on failure.
+std::vector<uint8_t> DecodeImage(const Jbig2Image& image) {
+  const uint32_t pitch = (image.width + 31) / 32 * 4;
+  std::vector<uint8_t> result(pitch * image.height);
+  JBig2_DocumentContext document_context;
+  Jbig2Context context;
+  FXCODEC_STATUS status = Jbig2Decoder::StartDecode(
+      &context, &document_context, image.width, image.height, image.data,
+      /*src_key=*/0, image.globals, /*global_key=*/0, result, pitch,
+      /*pPause=*/nullptr);
+  while (status == FXCODEC_STATUS::kDecodeToBeContinued) {
+    status = Jbig2Decoder::ContinueDecode(&context, /*pPause=*/nullptr);
+  }
+  if (status != FXCODEC_STATUS::kDecodeFinished) {
+    return {};
+  }
+  return result;
+}
+
+// Pseudo-random arithmetic coded data, mostly zeros like a sparse page. There
+// are no 0xFF bytes, which the decoder would take for the end of the data.
+std::vector<uint8_t> MakeStream(size_t size) {
+  std::vector<uint8_t> stream(size);
+  uint32_t seed = 1;
+  for (uint8_t& byte : stream) {
+    seed = seed * 1103515245 + 12345;
+    byte = (seed >> 16) % 4 ? 0 : (seed >> 8) % 255;
+  }
+  return stream;
+}
+
+std::unique_ptr<CJBig2_Image> DecodeGenericRegion(
+    pdfium::span<const uint8_t> stream,
+    uint8_t gb_template) {
+  CJBig2_GRDProc proc;
+  proc.MMR = false;
+  proc.TPGDON = true;
+  proc.USESKIP = false;
+  proc.GBTEMPLATE = gb_template;
+  proc.GBW = kPageWidth;
+  proc.GBH = kPageHeight;
+  if (gb_template == 0) {
+    proc.GBAT = {3, -1, -3, -1, 2, -2, -2, -2};
+  } else if (gb_template == 1) {
+    proc.GBAT = {3, -1, 0, 0, 0, 0, 0, 0};
+  } else {
+    proc.GBAT = {2, -1, 0, 0, 0, 0, 0, 0};
+  }
+  CJBig2_BitStream bit_stream(stream, 0);
+  CJBig2_ArithDecoder decoder(&bit_stream);
+  std::vector<JBig2ArithCtx> contexts(65536);
+  return proc.DecodeArith(&decoder, contexts);
+}
+
+// Runs `func` `kIterations` times and returns the best time in milliseconds.
+template <typename Func>
+double BestMilliseconds(Func func) {
+  double best_seconds = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  return best_seconds * 1000;
+}
+
+}  // namespace
+
+TEST(JBig2Benchmark, DISABLED_Corpus) {
+  for (const char* file_name : kCorpus) {
+    for (const Jbig2Image& image : LoadImages(file_name)) {
+      const std::vector<uint8_t> expected = DecodeImage(image);
+      if (expected.empty()) {
+        printf("%s: does not decode\n", image.name.c_str());
+        continue;
+      }
+      std::vector<uint8_t> result;
+      const double ms =
+          BestMilliseconds([&image, &result] { result = DecodeImage(image); });
+      EXPECT_EQ(expected, result) << image.name;
+      printf("%s: %ux%u, %.3f ms\n", image.name.c_str(), image.width,
+             image.height, ms);
+    }
+  }
+}
+
+TEST(JBig2Benchmark, DISABLED_GenericRegion) {
+  const std::vector<uint8_t> stream = MakeStream(1 << 20);
+  for (uint8_t gb_template = 0; gb_template < 4; ++gb_template) {
+    std::unique_ptr<CJBig2_Image> image;
+    const double ms = BestMilliseconds([&stream, &image, gb_template] {
+      image = DecodeGenericRegion(stream, gb_template);
+    });
+    ASSERT_TRUE(image);
+    printf("GBTEMPLATE %d: %.2f ms, %.1f Mpixels/s\n", gb_template, ms,
+           kPageWidth * kPageHeight / (ms * 1000));
+  }
+}
+
+TEST(JBig2Benchmark, DISABLED_Compose) {
+  static constexpr struct {
+    const char* name;
+    JBig2ComposeOp op;
+  } kOps[] = {
+      {"OR", JBIG2_COMPOSE_OR},     {"AND", JBIG2_COMPOSE_AND},
+      {"XOR", JBIG2_COMPOSE_XOR},   {"XNOR", JBIG2_COMPOSE_XNOR},
+      {"REPLACE", JBIG2_COMPOSE_REPLACE},
+  };
+  // Glyph sized symbols, as text regions place them, and page wide regions.
+  static constexpr struct {
+    int32_t width;
+    int32_t height;
+  } kSizes[] = {{24, 32}, {kPageWidth - 64, 256}};
+  const int32_t page_width = kPageWidth;
+  const int32_t page_height = kPageHeight;
+
+  CJBig2_Image page(page_width, page_height);
+  page.Fill(false);
+  for (const auto& size : kSizes) {
+    CJBig2_Image source(size.width, size.height);
+    source.Fill(true);
+    for (const auto& op : kOps) {
+      int64_t pixels = 0;
+      const double ms = BestMilliseconds([&] {
+        pixels = 0;
+        // Odd steps, so the source lands at every bit offset into a word.
+        for (int32_t y = 0; y + size.height <= page_height; y += size.height) {
+          for (int32_t x = 0; x + size.width <= page_width;
+               x += size.width + 5) {
+            source.ComposeTo(&page, x, y, op.op);
+            pixels += size.width * size.height;
+          }
+        }
+      });
+      printf("%dx%d %s: %.1f Mpixels/s\n", size.width, size.height, op.name,
+             pixels / (ms * 1000));
+    }
+  }
+}
@@ -0,0 +1,132 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_compose.h"
+
+#include "core/fxcrt/compiler_specific.h"
+
+// Highway compiles this file once per instruction set it targets.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxcodec/jbig2/jbig2_compose.cpp"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// The words are loaded as 32-bit lanes, in whatever byte order the target
+// has. That does not matter for the bitwise operators, but shifts have to see
+// the bytes in big-endian order.
+using DU32 = hn::ScalableTag<uint32_t>;
+using DU8 = hn::Repartition<uint8_t, DU32>;
+using VU32 = hn::Vec<DU32>;
+
+HWY_INLINE VU32 LoadWords(const uint8_t* src) {
+  const DU32 du32;
+  const DU8 du8;
+  return hn::BitCast(du32, hn::LoadU(du8, src));
+}
+
+HWY_INLINE void StoreWords(VU32 words, uint8_t* dest) {
+  const DU8 du8;
+  hn::StoreU(hn::BitCast(du8, words), du8, dest);
+}
+
+// Turns loaded words into big-endian values, and back. It is its own inverse.
+HWY_INLINE VU32 SwapToBigEndian(VU32 words) {
+#if HWY_IS_LITTLE_ENDIAN
+  return hn::ReverseLaneBytes(words);
+#else
+  return words;
+#endif
+}
+
+// The same operators as the scalar loops.
+HWY_INLINE VU32 Compose(JBig2ComposeOp op, VU32 src, VU32 dest) {
+  switch (op) {
+    case JBIG2_COMPOSE_OR:
+      return hn::Or(src, dest);
+    case JBIG2_COMPOSE_AND:
+      return hn::And(src, dest);
+    case JBIG2_COMPOSE_XOR:
+      return hn::Xor(src, dest);
+    case JBIG2_COMPOSE_XNOR:
+      return hn::Not(hn::Xor(src, dest));
+    case JBIG2_COMPOSE_REPLACE:
+      return src;
+  }
+  return dest;
+}
+
+int32_t ComposeWordsImpl(uint8_t* dest,
+                         const uint8_t* src,
+                         int32_t dwords,
+                         JBig2ComposeOp op) {
+  const DU32 du32;
+  const int32_t lanes = static_cast<int32_t>(hn::Lanes(du32));
+  int32_t i = 0;
+  UNSAFE_TODO({
+    for (; i + lanes <= dwords; i += lanes) {
+      uint8_t* dp = dest + i * 4;
+      StoreWords(Compose(op, LoadWords(src + i * 4), LoadWords(dp)), dp);
+    }
+  });
+  return i;
+}
+
+int32_t ComposeShiftedWordsImpl(uint8_t* dest,
+                                const uint8_t* src,
+                                int32_t dwords,
+                                uint32_t shift,
+                                JBig2ComposeOp op) {
+  const DU32 du32;
+  const int32_t lanes = static_cast<int32_t>(hn::Lanes(du32));
+  const int left_shift = static_cast<int>(shift);
+  const int right_shift = 32 - left_shift;
+  int32_t i = 0;
+  UNSAFE_TODO({
+    for (; i + lanes <= dwords; i += lanes) {
+      const uint8_t* sp = src + i * 4;
+      uint8_t* dp = dest + i * 4;
+      const VU32 high = SwapToBigEndian(LoadWords(sp));
+      const VU32 low = SwapToBigEndian(LoadWords(sp + 4));
+      const VU32 words = hn::Or(hn::ShiftLeftSame(high, left_shift),
+                                hn::ShiftRightSame(low, right_shift));
+      StoreWords(Compose(op, SwapToBigEndian(words), LoadWords(dp)), dp);
+    }
+  });
+  return i;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace pdfium {
+
+HWY_EXPORT(ComposeWordsImpl);
+HWY_EXPORT(ComposeShiftedWordsImpl);
+
+int32_t ComposeWordsVectorized(uint8_t* dest,
+                               const uint8_t* src,
+                               int32_t dwords,
+                               JBig2ComposeOp op) {
+  return HWY_DYNAMIC_DISPATCH(ComposeWordsImpl)(dest, src, dwords, op);
+}
+
+int32_t ComposeShiftedWordsVectorized(uint8_t* dest,
+                                      const uint8_t* src,
+                                      int32_t dwords,
+                                      uint32_t shift,
+                                      JBig2ComposeOp op) {
+  return HWY_DYNAMIC_DISPATCH(ComposeShiftedWordsImpl)(dest, src, dwords,
+                                                       shift, op);
+}
+
+}  // namespace pdfium
+#endif  // HWY_ONCE
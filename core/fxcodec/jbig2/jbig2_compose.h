@@ -0,0 +1,42 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_JBIG2_JBIG2_COMPOSE_H_
+#define CORE_FXCODEC_JBIG2_JBIG2_COMPOSE_H_
+
+#include <stdint.h>
+
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+
+namespace pdfium {
+
+// Vectorized versions of the loops in CJBig2_Image::ComposeToInternal() that
+// compose the fully covered 32-bit words in the middle of a row. They produce
+// exactly the same bits as the scalar loops. The instruction set is picked at
+// runtime.
+//
+// Each function composes words from the start of `dest` in whole vectors, as
+// far as `dwords` allows, and returns how many words it composed. The caller
+// composes the remaining words. Words hold their leftmost pixel in the top bit
+// of their first byte.
+
+// Composes word `i` of `src` onto word `i` of `dest` with `op`.
+int32_t ComposeWordsVectorized(uint8_t* dest,
+                               const uint8_t* src,
+                               int32_t dwords,
+                               JBig2ComposeOp op);
+
+// Like ComposeWordsVectorized(), but for sources that are not word aligned
+// with `dest`. Word `i` of the source is taken from the bits `shift` bits into
+// word `i` of `src`, so it reaches into word `i` + 1. `shift` must be between 1
+// and 31.
+int32_t ComposeShiftedWordsVectorized(uint8_t* dest,
+                                      const uint8_t* src,
+                                      int32_t dwords,
+                                      uint32_t shift,
+                                      JBig2ComposeOp op);
+
+}  // namespace pdfium
+
+#endif  // CORE_FXCODEC_JBIG2_JBIG2_COMPOSE_H_
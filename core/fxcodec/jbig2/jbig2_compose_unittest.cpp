@@ -0,0 +1,109 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_compose.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/byteorder.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+constexpr int32_t kDwords = 300;
+constexpr JBig2ComposeOp kOps[] = {JBIG2_COMPOSE_OR, JBIG2_COMPOSE_AND,
+                                   JBIG2_COMPOSE_XOR, JBIG2_COMPOSE_XNOR,
+                                   JBIG2_COMPOSE_REPLACE};
+
+std::vector<uint8_t> MakeBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    seed = seed * 1103515245 + 12345;
+    byte = seed >> 16;
+  }
+  return bytes;
+}
+
+uint32_t ComposeWord(JBig2ComposeOp op, uint32_t src, uint32_t dest) {
+  switch (op) {
+    case JBIG2_COMPOSE_OR:
+      return src | dest;
+    case JBIG2_COMPOSE_AND:
+      return src & dest;
+    case JBIG2_COMPOSE_XOR:
+      return src ^ dest;
+    case JBIG2_COMPOSE_XNOR:
+      return ~(src ^ dest);
+    case JBIG2_COMPOSE_REPLACE:
+      return src;
+  }
+  return dest;
+}
+
+// Like the scalar loops in CJBig2_Image::ComposeToInternal(). A `shift` of 0
+// means the source is word aligned.
+void ComposeWordsScalar(pdfium::span<uint8_t> dest,
+                        pdfium::span<const uint8_t> src,
+                        int32_t first_dword,
+                        int32_t dwords,
+                        uint32_t shift,
+                        JBig2ComposeOp op) {
+  for (int32_t i = first_dword; i < dwords; ++i) {
+    const size_t offset = static_cast<size_t>(i) * 4;
+    uint32_t word = fxcrt::GetUInt32MSBFirst(src.subspan(offset).first<4u>());
+    if (shift) {
+      word = (word << shift) |
+             (fxcrt::GetUInt32MSBFirst(src.subspan(offset + 4).first<4u>()) >>
+              (32 - shift));
+    }
+    pdfium::span<uint8_t, 4> dest_word = dest.subspan(offset).first<4u>();
+    fxcrt::PutUInt32MSBFirst(
+        ComposeWord(op, word, fxcrt::GetUInt32MSBFirst(dest_word)), dest_word);
+  }
+}
+
+}  // namespace
+
+TEST(JBig2Compose, ComposeWords) {
+  const std::vector<uint8_t> src = MakeBytes(kDwords * 4, 1);
+  for (JBig2ComposeOp op : kOps) {
+    for (int32_t dwords : {0, 1, 7, 8, 33, kDwords}) {
+      std::vector<uint8_t> expected = MakeBytes(kDwords * 4, 2);
+      std::vector<uint8_t> actual = expected;
+      const int32_t done =
+          ComposeWordsVectorized(actual.data(), src.data(), dwords, op);
+      ASSERT_GE(done, 0);
+      ASSERT_LE(done, dwords);
+      ComposeWordsScalar(actual, src, done, dwords, /*shift=*/0, op);
+      ComposeWordsScalar(expected, src, 0, dwords, /*shift=*/0, op);
+      EXPECT_EQ(expected, actual) << "op " << op << ", dwords " << dwords;
+    }
+  }
+}
+
+TEST(JBig2Compose, ComposeShiftedWords) {
+  // One extra word, for the bits the last word reaches into.
+  const std::vector<uint8_t> src = MakeBytes(kDwords * 4 + 4, 3);
+  for (JBig2ComposeOp op : kOps) {
+    for (uint32_t shift : {1u, 7u, 8u, 13u, 31u}) {
+      std::vector<uint8_t> expected = MakeBytes(kDwords * 4, 4);
+      std::vector<uint8_t> actual = expected;
+      const int32_t done = ComposeShiftedWordsVectorized(
+          actual.data(), src.data(), kDwords, shift, op);
+      ASSERT_GE(done, 0);
+      ASSERT_LE(done, kDwords);
+      ComposeWordsScalar(actual, src, done, kDwords, shift, op);
+      ComposeWordsScalar(expected, src, 0, kDwords, shift, op);
+      EXPECT_EQ(expected, actual) << "op " << op << ", shift " << shift;
+    }
+  }
+}
+
+}  // namespace pdfium
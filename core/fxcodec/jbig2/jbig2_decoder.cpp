@@ -65,7 +65,7 @@ FXCODEC_STATUS Jbig2Decoder::StartDecode(
   std::ranges::fill(dest_buf.first(Fx2DSizeOrDie(height, dest_pitch)), 0);
   pJbig2Context->context_ =
       CJBig2_Context::Create(global_span, global_key, src_span, src_key,
-                             pJBig2DocumentContext->GetSymbolDictCache());
+                             pJBig2DocumentContext);
   bool succeeded = pJbig2Context->context_->GetFirstPage(
       dest_buf, width, height, dest_pitch, pPause);
   return Decode(pJbig2Context, succeeded);
@@ -39,6 +39,9 @@ class Jbig2Context {
 
 class Jbig2Decoder {
  public:
+  // When Jbig2SymbolDictCache is enabled, documents share the symbol
+  // dictionaries decoded from identical `global_span` contents. That takes a
+  // non-zero `global_key`.
   static FXCODEC_STATUS StartDecode(
       Jbig2Context* pJbig2Context,
       JBig2_DocumentContext* pJbig2DocumentContext,
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -23,3 +24,57 @@ TEST_F(JBig2EmbedderTest, MAYBE_Bug631912) {
   ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
   CompareBitmap(bitmap.get(), 691, 432, "726c2b8c89df0ab40627322d1dddd521");
 }
+
+#if defined(PDF_USE_SKIA)
+// TODO(crbug.com/pdfium/11): Fix this test and enable.
+#define MAYBE_SharedSymbolDictCache DISABLED_SharedSymbolDictCache
+#else
+#define MAYBE_SharedSymbolDictCache SharedSymbolDictCache
+#endif
+TEST_F(JBig2EmbedderTest, MAYBE_SharedSymbolDictCache) {
+  EXPECT_FALSE(FPDF_GetJbig2SymbolDictCacheStats(nullptr));
+
+  // Start without any cached symbol dictionaries.
+  FPDF_SetJbig2SymbolDictCacheByteLimit(0);
+  FPDF_SetJbig2SymbolDictCacheByteLimit(1024 * 1024);
+  FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS before;
+  ASSERT_TRUE(FPDF_GetJbig2SymbolDictCacheStats(&before));
+  EXPECT_EQ(0u, before.bytes);
+  EXPECT_EQ(1024u * 1024, before.byte_limit);
+
+  // The JBIG2Globals of bug_631912.pdf hold a symbol dictionary.
+  ASSERT_TRUE(OpenDocument("bug_631912.pdf"));
+  {
+    ScopedPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    CompareBitmap(bitmap.get(), 691, 432, "726c2b8c89df0ab40627322d1dddd521");
+  }
+  CloseDocument();
+  FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS first;
+  ASSERT_TRUE(FPDF_GetJbig2SymbolDictCacheStats(&first));
+  EXPECT_EQ(before.hits, first.hits);
+  EXPECT_GT(first.misses, before.misses);
+  EXPECT_GT(first.bytes, 0u);
+
+  // Another document with the same globals gets the dictionary from the cache.
+  ASSERT_TRUE(OpenDocument("bug_631912.pdf"));
+  {
+    ScopedPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    CompareBitmap(bitmap.get(), 691, 432, "726c2b8c89df0ab40627322d1dddd521");
+  }
+  CloseDocument();
+  FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS second;
+  ASSERT_TRUE(FPDF_GetJbig2SymbolDictCacheStats(&second));
+  EXPECT_GT(second.hits, first.hits);
+  EXPECT_EQ(first.misses, second.misses);
+  EXPECT_EQ(first.bytes, second.bytes);
+
+  FPDF_SetJbig2SymbolDictCacheByteLimit(0);
+  FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS disabled;
+  ASSERT_TRUE(FPDF_GetJbig2SymbolDictCacheStats(&disabled));
+  EXPECT_EQ(0u, disabled.bytes);
+  EXPECT_GT(disabled.evictions, second.evictions);
+}
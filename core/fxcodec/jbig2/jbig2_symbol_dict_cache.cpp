@@ -0,0 +1,120 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcodec/jbig2/JBig2_SymbolDict.h"
+#include "core/fxcrt/fx_safe_types.h"
+
+namespace fxcodec {
+
+namespace {
+
+// Approximates the memory `dict` uses by its images and contexts.
+size_t GetDictSize(const CJBig2_SymbolDict& dict) {
+  FX_SAFE_SIZE_T size = sizeof(CJBig2_SymbolDict);
+  for (size_t i = 0; i < dict.NumImages(); ++i) {
+    const CJBig2_Image* image = dict.GetImage(i);
+    size += sizeof(CJBig2_Image);
+    if (image) {
+      FX_SAFE_SIZE_T image_size = image->stride();
+      image_size *= image->height();
+      size += image_size;
+    }
+  }
+  FX_SAFE_SIZE_T contexts_size = dict.GbContexts().size();
+  contexts_size += dict.GrContexts().size();
+  contexts_size *= sizeof(JBig2ArithCtx);
+  size += contexts_size;
+  return size.ValueOrDefault(SIZE_MAX);
+}
+
+}  // namespace
+
+Jbig2SymbolDictCache::Entry::Entry(Key key,
+                                   std::unique_ptr<CJBig2_SymbolDict> dict,
+                                   size_t bytes)
+    : key(std::move(key)), dict(std::move(dict)), bytes(bytes) {}
+
+Jbig2SymbolDictCache::Entry::~Entry() = default;
+
+// static
+Jbig2SymbolDictCache* Jbig2SymbolDictCache::Get() {
+  static Jbig2SymbolDictCache* cache = new Jbig2SymbolDictCache();
+  return cache;
+}
+
+Jbig2SymbolDictCache::Jbig2SymbolDictCache() = default;
+
+Jbig2SymbolDictCache::~Jbig2SymbolDictCache() = default;
+
+void Jbig2SymbolDictCache::SetByteLimit(size_t byte_limit) {
+  std::lock_guard<std::mutex> guard(lock_);
+  stats_.byte_limit = byte_limit;
+  ShrinkTo(byte_limit);
+}
+
+bool Jbig2SymbolDictCache::IsEnabled() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return stats_.byte_limit > 0;
+}
+
+Jbig2SymbolDictCache::Stats Jbig2SymbolDictCache::GetStats() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return stats_;
+}
+
+std::unique_ptr<CJBig2_SymbolDict> Jbig2SymbolDictCache::Lookup(
+    pdfium::span<const uint8_t> digest,
+    uint32_t offset) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (stats_.byte_limit == 0) {
+    return nullptr;
+  }
+  auto it = index_.find(
+      Key(DataVector<uint8_t>(digest.begin(), digest.end()), offset));
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->dict->DeepCopy();
+}
+
+void Jbig2SymbolDictCache::Insert(pdfium::span<const uint8_t> digest,
+                                  uint32_t offset,
+                                  const CJBig2_SymbolDict& dict) {
+  const size_t bytes = GetDictSize(dict);
+  std::lock_guard<std::mutex> guard(lock_);
+  if (bytes > stats_.byte_limit) {
+    return;
+  }
+  Key key(DataVector<uint8_t>(digest.begin(), digest.end()), offset);
+  if (index_.contains(key)) {
+    // Another thread decoded the same dictionary in the meantime.
+    return;
+  }
+  ShrinkTo(stats_.byte_limit - bytes);
+  entries_.emplace_front(key, dict.DeepCopy(), bytes);
+  index_.emplace(std::move(key), entries_.begin());
+  stats_.bytes += bytes;
+}
+
+void Jbig2SymbolDictCache::ShrinkTo(size_t bytes) {
+  while (stats_.bytes > bytes && !entries_.empty()) {
+    const Entry& victim = entries_.back();
+    stats_.bytes -= victim.bytes;
+    index_.erase(victim.key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+}  // namespace fxcodec
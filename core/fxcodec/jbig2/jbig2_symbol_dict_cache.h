@@ -0,0 +1,90 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
+#define CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/span.h"
+
+class CJBig2_SymbolDict;
+
+namespace fxcodec {
+
+// Process-wide cache of symbol dictionaries decoded from JBIG2Globals streams.
+// Unlike the cache in JBig2_DocumentContext, which is keyed by the object a
+// stream is in, entries are keyed by a digest of the stream's contents, so
+// documents with identical globals, e.g. from the same scanner, share them.
+//
+// The cache is disabled until SetByteLimit() gives it a budget. It may be
+// used from any thread.
+class Jbig2SymbolDictCache {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    // Approximate memory the cached dictionaries take up.
+    size_t bytes = 0;
+    size_t byte_limit = 0;
+  };
+
+  static Jbig2SymbolDictCache* Get();
+
+  // Evicts dictionaries right away if the cache already takes up more than
+  // `byte_limit`. 0 disables the cache.
+  void SetByteLimit(size_t byte_limit);
+  bool IsEnabled() const;
+  Stats GetStats() const;
+
+  // Returns a copy of the dictionary at `offset` in the globals stream with
+  // `digest`, or nullptr if it is not cached.
+  std::unique_ptr<CJBig2_SymbolDict> Lookup(pdfium::span<const uint8_t> digest,
+                                            uint32_t offset);
+
+  // Caches a copy of `dict` as the dictionary at `offset` in the globals
+  // stream with `digest`.
+  void Insert(pdfium::span<const uint8_t> digest,
+              uint32_t offset,
+              const CJBig2_SymbolDict& dict);
+
+ private:
+  using Key = std::pair<DataVector<uint8_t>, uint32_t>;
+
+  struct Entry {
+    Entry(Key key, std::unique_ptr<CJBig2_SymbolDict> dict, size_t bytes);
+    ~Entry();
+
+    Key key;
+    std::unique_ptr<CJBig2_SymbolDict> dict;
+    size_t bytes;
+  };
+
+  Jbig2SymbolDictCache();
+  ~Jbig2SymbolDictCache();
+
+  // Requires `lock_` to be held.
+  void ShrinkTo(size_t bytes);
+
+  mutable std::mutex lock_;
+  Stats stats_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace fxcodec
+
+using Jbig2SymbolDictCache = fxcodec::Jbig2SymbolDictCache;
+
+#endif  // CORE_FXCODEC_JBIG2_JBIG2_SYMBOL_DICT_CACHE_H_
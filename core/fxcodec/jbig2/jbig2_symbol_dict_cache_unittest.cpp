@@ -0,0 +1,105 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+
+#include "core/fxcodec/jbig2/JBig2_Image.h"
+#include "core/fxcodec/jbig2/JBig2_SymbolDict.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr uint8_t kDigest1[] = {1, 2, 3, 4};
+constexpr uint8_t kDigest2[] = {5, 6, 7, 8};
+
+std::unique_ptr<CJBig2_SymbolDict> MakeDict(int32_t width) {
+  auto dict = std::make_unique<CJBig2_SymbolDict>();
+  auto image = std::make_unique<CJBig2_Image>(width, 32);
+  image->Fill(true);
+  dict->AddImage(std::move(image));
+  return dict;
+}
+
+// Disables the cache while in scope, so every test starts with an empty one.
+class ScopedDisabledCache {
+ public:
+  ScopedDisabledCache() { Jbig2SymbolDictCache::Get()->SetByteLimit(0); }
+  ~ScopedDisabledCache() { Jbig2SymbolDictCache::Get()->SetByteLimit(0); }
+};
+
+}  // namespace
+
+TEST(Jbig2SymbolDictCache, Disabled) {
+  ScopedDisabledCache disabled;
+  Jbig2SymbolDictCache* cache = Jbig2SymbolDictCache::Get();
+  EXPECT_FALSE(cache->IsEnabled());
+
+  const Jbig2SymbolDictCache::Stats before = cache->GetStats();
+  cache->Insert(kDigest1, 0, *MakeDict(32));
+  EXPECT_FALSE(cache->Lookup(kDigest1, 0));
+  const Jbig2SymbolDictCache::Stats after = cache->GetStats();
+  EXPECT_EQ(before.hits, after.hits);
+  EXPECT_EQ(before.misses, after.misses);
+  EXPECT_EQ(0u, after.bytes);
+}
+
+TEST(Jbig2SymbolDictCache, LookupAndInsert) {
+  ScopedDisabledCache disabled;
+  Jbig2SymbolDictCache* cache = Jbig2SymbolDictCache::Get();
+  cache->SetByteLimit(1024 * 1024);
+  EXPECT_TRUE(cache->IsEnabled());
+
+  const Jbig2SymbolDictCache::Stats before = cache->GetStats();
+  EXPECT_FALSE(cache->Lookup(kDigest1, 0));
+  cache->Insert(kDigest1, 0, *MakeDict(32));
+
+  std::unique_ptr<CJBig2_SymbolDict> dict = cache->Lookup(kDigest1, 0);
+  ASSERT_TRUE(dict);
+  ASSERT_EQ(1u, dict->NumImages());
+  EXPECT_EQ(32, dict->GetImage(0)->width());
+  EXPECT_TRUE(dict->GetImage(0)->GetPixel(31, 31));
+
+  // Both the digest and the offset have to match.
+  EXPECT_FALSE(cache->Lookup(kDigest1, 1));
+  EXPECT_FALSE(cache->Lookup(kDigest2, 0));
+
+  const Jbig2SymbolDictCache::Stats after = cache->GetStats();
+  EXPECT_EQ(before.hits + 1, after.hits);
+  EXPECT_EQ(before.misses + 3, after.misses);
+  EXPECT_GT(after.bytes, 0u);
+  EXPECT_EQ(1024u * 1024, after.byte_limit);
+}
+
+TEST(Jbig2SymbolDictCache, Eviction) {
+  ScopedDisabledCache disabled;
+  Jbig2SymbolDictCache* cache = Jbig2SymbolDictCache::Get();
+  cache->SetByteLimit(1024 * 1024);
+  cache->Insert(kDigest1, 0, *MakeDict(32));
+  const size_t dict_bytes = cache->GetStats().bytes;
+
+  // Room for two dictionaries.
+  cache->SetByteLimit(dict_bytes * 2);
+  cache->Insert(kDigest1, 1, *MakeDict(32));
+  ASSERT_TRUE(cache->Lookup(kDigest1, 0));
+
+  // The least recently used dictionary makes room for the new one.
+  const Jbig2SymbolDictCache::Stats before = cache->GetStats();
+  cache->Insert(kDigest2, 0, *MakeDict(32));
+  const Jbig2SymbolDictCache::Stats after = cache->GetStats();
+  EXPECT_EQ(before.evictions + 1, after.evictions);
+  EXPECT_EQ(dict_bytes * 2, after.bytes);
+  EXPECT_TRUE(cache->Lookup(kDigest1, 0));
+  EXPECT_FALSE(cache->Lookup(kDigest1, 1));
+  EXPECT_TRUE(cache->Lookup(kDigest2, 0));
+
+  // Dictionaries bigger than the whole budget are not cached.
+  cache->Insert(kDigest2, 1, *MakeDict(1024));
+  EXPECT_FALSE(cache->Lookup(kDigest2, 1));
+  EXPECT_EQ(dict_bytes * 2, cache->GetStats().bytes);
+}
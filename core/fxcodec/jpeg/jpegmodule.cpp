@@ -6,6 +6,7 @@
 
 #include "core/fxcodec/jpeg/jpegmodule.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <type_traits>
@@ -90,7 +91,8 @@ class JpegDecoder final : public ScanlineDecoder {
               uint32_t width,
               uint32_t height,
               int nComps,
-              bool ColorTransform);
+              bool ColorTransform,
+              uint8_t resolution_levels_to_skip);
 
   // ScanlineDecoder:
   [[nodiscard]] bool Rewind() override;
@@ -128,7 +130,7 @@ class JpegDecoder final : public ScanlineDecoder {
   bool decompress_created_ = false;
   bool started_ = false;
   bool jpeg_transform_ = false;
-  uint32_t default_scale_denom_ = 1;
+  uint8_t resolution_levels_to_skip_ = 0;
 };
 
 JpegDecoder::JpegDecoder() = default;
@@ -191,9 +193,10 @@ bool JpegDecoder::InitDecode(bool bAcceptKnownBadHeader) {
 
   orig_width_ = common_.cinfo.image_width;
   orig_height_ = common_.cinfo.image_height;
-  output_width_ = orig_width_;
-  output_height_ = orig_height_;
-  default_scale_denom_ = common_.cinfo.scale_denom;
+  output_width_ = JpegModule::GetScaledDimension(orig_width_,
+                                                 resolution_levels_to_skip_);
+  output_height_ = JpegModule::GetScaledDimension(orig_height_,
+                                                  resolution_levels_to_skip_);
   return true;
 }
 
@@ -201,7 +204,8 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
                          uint32_t width,
                          uint32_t height,
                          int nComps,
-                         bool ColorTransform) {
+                         bool ColorTransform,
+                         uint8_t resolution_levels_to_skip) {
   src_span_ = JpegScanSOI(src_span);
   if (src_span_.size() < 2) {
     return false;
@@ -220,6 +224,8 @@ bool JpegDecoder::Create(pdfium::span<const uint8_t> src_span,
   common_.source_mgr.fill_input_buffer = jpeg_common_src_fill_buffer;
   common_.source_mgr.resync_to_restart = jpeg_common_src_resync;
   jpeg_transform_ = ColorTransform;
+  resolution_levels_to_skip_ = std::min(
+      resolution_levels_to_skip, JpegModule::kMaxResolutionLevelsToSkip);
   output_width_ = orig_width_ = width;
   output_height_ = orig_height_ = height;
   if (!InitDecode(/*bAcceptKnownBadHeader=*/true)) {
@@ -249,14 +255,14 @@ bool JpegDecoder::Rewind() {
       return false;
     }
   }
-  common_.cinfo.scale_denom = default_scale_denom_;
-  output_width_ = orig_width_;
-  output_height_ = orig_height_;
+  common_.cinfo.scale_num = 1;
+  common_.cinfo.scale_denom = 1u << resolution_levels_to_skip_;
   if (!jpeg_common_start_decompress(&common_)) {
     jpeg_common_destroy_decompress(&common_);
     return false;
   }
-  CHECK_LE(static_cast<int>(common_.cinfo.output_width), orig_width_);
+  CHECK_EQ(static_cast<int>(common_.cinfo.output_width), output_width_);
+  CHECK_EQ(static_cast<int>(common_.cinfo.output_height), output_height_);
   started_ = true;
   return true;
 }
@@ -276,8 +282,7 @@ uint32_t JpegDecoder::GetSrcOffset() {
 }
 
 void JpegDecoder::CalcPitch() {
-  pitch_ = static_cast<uint32_t>(common_.cinfo.image_width) *
-           common_.cinfo.num_components;
+  pitch_ = static_cast<uint32_t>(output_width_) * common_.cinfo.num_components;
   pitch_ += 3;
   pitch_ /= 4;
   pitch_ *= 4;
@@ -354,17 +359,28 @@ std::unique_ptr<ScanlineDecoder> JpegModule::CreateDecoder(
     uint32_t width,
     uint32_t height,
     int nComps,
-    bool ColorTransform) {
+    bool ColorTransform,
+    uint8_t resolution_levels_to_skip) {
   DCHECK(!src_span.empty());
 
   auto pDecoder = std::make_unique<JpegDecoder>();
-  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform)) {
+  if (!pDecoder->Create(src_span, width, height, nComps, ColorTransform,
+                        resolution_levels_to_skip)) {
     return nullptr;
   }
 
   return pDecoder;
 }
 
+// static
+uint32_t JpegModule::GetScaledDimension(uint32_t dimension,
+                                        uint8_t resolution_levels_to_skip) {
+  // Matches how libjpeg rounds the output size of a 1/2^n scaled decode.
+  const uint32_t scale = 1u << std::min(resolution_levels_to_skip,
+                                        kMaxResolutionLevelsToSkip);
+  return dimension / scale + (dimension % scale != 0);
+}
+
 // static
 std::optional<JpegModule::ImageInfo> JpegModule::LoadInfo(
     pdfium::span<const uint8_t> src_span) {
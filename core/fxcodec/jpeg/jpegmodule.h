@@ -37,12 +37,24 @@ class JpegModule {
     bool color_transform;
   };
 
+  // libjpeg can scale the image down by up to 8 while decoding, by dropping
+  // DCT coefficients, which also saves most of the IDCT work.
+  static constexpr uint8_t kMaxResolutionLevelsToSkip = 3;
+
+  // The decoder outputs the image scaled down by 2^`resolution_levels_to_skip`,
+  // capped at kMaxResolutionLevelsToSkip. See GetScaledDimension().
   static std::unique_ptr<ScanlineDecoder> CreateDecoder(
       pdfium::span<const uint8_t> src_span,
       uint32_t width,
       uint32_t height,
       int nComps,
-      bool ColorTransform);
+      bool ColorTransform,
+      uint8_t resolution_levels_to_skip);
+
+  // Returns what an image `dimension` pixels wide or high comes out as, from
+  // a decoder created with `resolution_levels_to_skip`.
+  static uint32_t GetScaledDimension(uint32_t dimension,
+                                     uint8_t resolution_levels_to_skip);
 
   static std::optional<ImageInfo> LoadInfo(
       pdfium::span<const uint8_t> src_span);
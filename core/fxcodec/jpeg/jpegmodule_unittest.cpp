@@ -0,0 +1,118 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jpeg/jpegmodule.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/fxcodec/scanlinedecoder.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/utils/file_util.h"
+#include "testing/utils/path_service.h"
+
+namespace fxcodec {
+
+namespace {
+
+// A 120x120 RGB image.
+std::vector<uint8_t> LoadTestImage() {
+  std::string file_path = PathService::GetTestFilePath("mona_lisa.jpg");
+  if (file_path.empty()) {
+    return {};
+  }
+  return GetFileContents(file_path.c_str());
+}
+
+// Returns the average of all the samples of the image.
+double GetAverageSample(ScanlineDecoder* decoder) {
+  const size_t row_size =
+      static_cast<size_t>(decoder->GetWidth()) * decoder->CountComps();
+  uint64_t sum = 0;
+  for (int row = 0; row < decoder->GetHeight(); ++row) {
+    pdfium::span<const uint8_t> scanline = decoder->GetScanline(row);
+    if (scanline.size() < row_size) {
+      ADD_FAILURE() << "Short scanline " << row;
+      return 0;
+    }
+    for (uint8_t sample : scanline.first(row_size)) {
+      sum += sample;
+    }
+  }
+  return static_cast<double>(sum) / (row_size * decoder->GetHeight());
+}
+
+}  // namespace
+
+TEST(JpegModule, GetScaledDimension) {
+  EXPECT_EQ(120u, JpegModule::GetScaledDimension(120, 0));
+  EXPECT_EQ(60u, JpegModule::GetScaledDimension(120, 1));
+  EXPECT_EQ(30u, JpegModule::GetScaledDimension(120, 2));
+  EXPECT_EQ(15u, JpegModule::GetScaledDimension(120, 3));
+
+  // Partial blocks round up, as in libjpeg.
+  EXPECT_EQ(1u, JpegModule::GetScaledDimension(1, 3));
+  EXPECT_EQ(2u, JpegModule::GetScaledDimension(9, 3));
+  EXPECT_EQ(63u, JpegModule::GetScaledDimension(125, 1));
+  EXPECT_EQ(0u, JpegModule::GetScaledDimension(0, 2));
+
+  // No more than kMaxResolutionLevelsToSkip levels get skipped.
+  EXPECT_EQ(15u, JpegModule::GetScaledDimension(120, 4));
+  EXPECT_EQ(15u, JpegModule::GetScaledDimension(120, 255));
+}
+
+TEST(JpegModule, CreateDecoderSkippingLevels) {
+  const std::vector<uint8_t> src = LoadTestImage();
+  ASSERT_FALSE(src.empty());
+  std::optional<JpegModule::ImageInfo> info = JpegModule::LoadInfo(src);
+  ASSERT_TRUE(info.has_value());
+  ASSERT_EQ(120u, info.value().width);
+  ASSERT_EQ(120u, info.value().height);
+  ASSERT_EQ(3, info.value().num_components);
+
+  std::unique_ptr<ScanlineDecoder> full = JpegModule::CreateDecoder(
+      src, 120, 120, 3, info.value().color_transform,
+      /*resolution_levels_to_skip=*/0);
+  ASSERT_TRUE(full);
+  EXPECT_EQ(120, full->GetWidth());
+  EXPECT_EQ(120, full->GetHeight());
+  EXPECT_EQ(360u, full->GetScanline(0).size());
+  const double full_average = GetAverageSample(full.get());
+
+  struct {
+    uint8_t levels;
+    int size;
+    size_t pitch;
+  } const kTestCases[] = {
+      {1, 60, 180},
+      {2, 30, 92},
+      {3, 15, 48},
+  };
+  for (const auto& test_case : kTestCases) {
+    SCOPED_TRACE(static_cast<int>(test_case.levels));
+    std::unique_ptr<ScanlineDecoder> decoder = JpegModule::CreateDecoder(
+        src, 120, 120, 3, info.value().color_transform, test_case.levels);
+    ASSERT_TRUE(decoder);
+    EXPECT_EQ(test_case.size, decoder->GetWidth());
+    EXPECT_EQ(test_case.size, decoder->GetHeight());
+    EXPECT_EQ(3, decoder->CountComps());
+    EXPECT_EQ(8, decoder->GetBPC());
+
+    // Each row is padded to 4 bytes.
+    EXPECT_EQ(test_case.pitch, decoder->GetScanline(0).size());
+    EXPECT_EQ(test_case.pitch,
+              decoder->GetScanline(test_case.size - 1).size());
+    EXPECT_TRUE(decoder->GetScanline(test_case.size).empty());
+
+    // Dropping the high frequencies keeps the overall color.
+    EXPECT_NEAR(full_average, GetAverageSample(decoder.get()), 2.0);
+  }
+}
+
+}  // namespace fxcodec
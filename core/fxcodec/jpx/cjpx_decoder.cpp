@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -30,6 +31,9 @@ namespace fxcodec {
 
 namespace {
 
+// Set through CJPX_Decoder::SetThreadCount().
+std::atomic<int> g_thread_count = 0;
+
 // Used with std::unique_ptr to call opj_image_data_free on raw memory.
 struct OpjImageDataDeleter {
   inline void operator()(void* ptr) const { opj_image_data_free(ptr); }
@@ -439,6 +443,15 @@ std::unique_ptr<CJPX_Decoder> CJPX_Decoder::Create(
   return decoder;
 }
 
+// static
+bool CJPX_Decoder::SetThreadCount(int thread_count) {
+  if (thread_count < 0 || (thread_count > 1 && !opj_has_thread_support())) {
+    return false;
+  }
+  g_thread_count = thread_count;
+  return true;
+}
+
 // static
 void CJPX_Decoder::Sycc420ToRgbForTesting(opj_image_t* img) {
   sycc420_to_rgb(img);
@@ -497,6 +510,14 @@ bool CJPX_Decoder::Init(pdfium::span<const uint8_t> src_data,
     CHECK(opj_decoder_set_strict_mode(codec_.get(), false));
   }
 
+  // Each code-block and DWT band decodes to the same pixels on any thread, so
+  // the output does not depend on the thread count. If the thread pool cannot
+  // be created, decoding stays on this thread.
+  const int thread_count = g_thread_count.load();
+  if (thread_count > 1) {
+    opj_codec_set_threads(codec_.get(), thread_count);
+  }
+
   opj_image_t* pTempImage = nullptr;
   if (!opj_read_header(stream_.get(), codec_.get(), &pTempImage)) {
     return false;
@@ -506,6 +527,39 @@ bool CJPX_Decoder::Init(pdfium::span<const uint8_t> src_data,
   return true;
 }
 
+bool CJPX_Decoder::SetDecodeArea(const FX_RECT& area) {
+  CHECK(image_);
+  if (!area.Valid() || area.IsEmpty() || area.left < 0 || area.top < 0) {
+    return false;
+  }
+
+  // The area is relative to the image, which need not start at the origin of
+  // the reference grid.
+  if (static_cast<uint32_t>(area.right) > image_->x1 - image_->x0 ||
+      static_cast<uint32_t>(area.bottom) > image_->y1 - image_->y0) {
+    return false;
+  }
+
+  FX_SAFE_INT32 left = image_->x0;
+  left += area.left;
+  FX_SAFE_INT32 top = image_->y0;
+  top += area.top;
+  FX_SAFE_INT32 right = image_->x0;
+  right += area.right;
+  FX_SAFE_INT32 bottom = image_->y0;
+  bottom += area.bottom;
+  if (!left.IsValid() || !top.IsValid() || !right.IsValid() ||
+      !bottom.IsValid()) {
+    return false;
+  }
+
+  parameters_.DA_x0 = left.ValueOrDie<uint32_t>();
+  parameters_.DA_y0 = top.ValueOrDie<uint32_t>();
+  parameters_.DA_x1 = right.ValueOrDie<uint32_t>();
+  parameters_.DA_y1 = bottom.ValueOrDie<uint32_t>();
+  return true;
+}
+
 bool CJPX_Decoder::StartDecode() {
   if (!parameters_.nb_tile_to_decode) {
     if (!opj_set_decode_area(codec_.get(), image_.get(), parameters_.DA_x0,
@@ -11,6 +11,7 @@
 
 #include <memory>
 
+#include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/span.h"
 
@@ -49,11 +50,24 @@ class CJPX_Decoder {
       uint8_t resolution_levels_to_skip,
       bool strict_mode);
 
+  // Sets how many threads decoders created afterwards may use for each image.
+  // 0 and 1 both mean decoding on the calling thread only. Returns false,
+  // leaving the count unchanged, if `thread_count` is negative, or if it asks
+  // for more threads and OpenJPEG was built without thread support.
+  static bool SetThreadCount(int thread_count);
+
   static void Sycc420ToRgbForTesting(opj_image_t* img);
 
   ~CJPX_Decoder();
 
   JpxImageInfo GetInfo() const;
+
+  // Limits StartDecode() to `area`, given in pixels of the full resolution
+  // image, so only the tiles and precincts that cover it get decoded. Returns
+  // false, leaving the whole image to be decoded, if `area` does not lie
+  // within the image.
+  bool SetDecodeArea(const FX_RECT& area);
+
   bool StartDecode();
 
   // `swap_rgb` can only be set when an image's color space type contains at
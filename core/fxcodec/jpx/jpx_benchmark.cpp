@@ -0,0 +1,62 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Decode time benchmarks for CJPX_Decoder. They are disabled by default; run
+// them by passing --gtest_also_run_disabled_tests and
+// --gtest_filter=JpxBenchmark.* to pdfium_unittests.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <vector>
+
+#include "core/fxcodec/jpx/cjpx_decoder.h"
+#include "core/fxcodec/jpx/jpx_test_support.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kIterations = 10;
+
+// Reports the best time out of `kIterations` decodes of `src` with
+// `thread_count` threads, and returns the decoded pixels.
+std::vector<uint8_t> ReportDecodeTime(pdfium::span<const uint8_t> src,
+                                      int thread_count) {
+  if (!CJPX_Decoder::SetThreadCount(thread_count)) {
+    printf("%d threads: unsupported\n", thread_count);
+    return {};
+  }
+  std::vector<uint8_t> result;
+  double best_seconds = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    result = fxcodec::DecodeJpxImage(src);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best_seconds) {
+      best_seconds = elapsed.count();
+    }
+  }
+  CJPX_Decoder::SetThreadCount(0);
+  printf("%d threads: %.2f ms\n", thread_count, best_seconds * 1000);
+  return result;
+}
+
+}  // namespace
+
+TEST(JpxBenchmark, DISABLED_Decode) {
+  const std::vector<uint8_t> src = fxcodec::LoadJpxTestImage();
+  ASSERT_FALSE(src.empty());
+
+  const std::vector<uint8_t> expected = ReportDecodeTime(src, 0);
+  ASSERT_FALSE(expected.empty());
+  for (int thread_count : {2, 4, 8}) {
+    const std::vector<uint8_t> result = ReportDecodeTime(src, thread_count);
+    if (!result.empty()) {
+      EXPECT_EQ(expected, result);
+    }
+  }
+}
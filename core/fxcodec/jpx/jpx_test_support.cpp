@@ -0,0 +1,59 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcodec/jpx/jpx_test_support.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_stream.h"
+#include "core/fpdfapi/parser/cpdf_stream_acc.h"
+#include "core/fxcodec/jpx/cjpx_decoder.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "testing/utils/path_service.h"
+
+namespace fxcodec {
+
+std::vector<uint8_t> LoadJpxTestImage() {
+  std::string file_path = PathService::GetTestFilePath("jpx_lzw.pdf");
+  if (file_path.empty()) {
+    return {};
+  }
+  CPDF_Parser parser;
+  if (parser.StartParse(
+          IFX_SeekableReadStream::CreateFromFilename(file_path.c_str()), "",
+          0) != CPDF_Parser::SUCCESS) {
+    return {};
+  }
+  RetainPtr<const CPDF_Stream> stream = ToStream(parser.ParseIndirectObject(5));
+  if (!stream) {
+    return {};
+  }
+  auto stream_acc = pdfium::MakeRetain<CPDF_StreamAcc>(std::move(stream));
+  stream_acc->LoadAllDataImageAcc(0);
+  pdfium::span<const uint8_t> span = stream_acc->GetSpan();
+  return std::vector<uint8_t>(span.begin(), span.end());
+}
+
+std::vector<uint8_t> DecodeJpxImage(pdfium::span<const uint8_t> src_span) {
+  std::unique_ptr<CJPX_Decoder> decoder =
+      CJPX_Decoder::Create(src_span, CJPX_Decoder::ColorSpaceOption::kNone,
+                           /*resolution_levels_to_skip=*/0,
+                           /*strict_mode=*/true);
+  if (!decoder || !decoder->StartDecode()) {
+    return {};
+  }
+  const CJPX_Decoder::JpxImageInfo info = decoder->GetInfo();
+  const uint32_t pitch = (info.width * info.channels + 3) / 4 * 4;
+  std::vector<uint8_t> result(pitch * info.height);
+  if (!decoder->Decode(result, pitch, /*swap_rgb=*/false, info.channels)) {
+    return {};
+  }
+  return result;
+}
+
+}  // namespace fxcodec
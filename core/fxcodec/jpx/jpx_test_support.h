@@ -0,0 +1,26 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCODEC_JPX_JPX_TEST_SUPPORT_H_
+#define CORE_FXCODEC_JPX_JPX_TEST_SUPPORT_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/span.h"
+
+namespace fxcodec {
+
+// Returns the codestream of the image in jpx_lzw.pdf, or an empty vector on
+// failure.
+std::vector<uint8_t> LoadJpxTestImage();
+
+// Decodes all of the JPX image in `src_span` at full resolution. Returns the
+// pixels, with rows padded to 4 bytes, or an empty vector on failure.
+std::vector<uint8_t> DecodeJpxImage(pdfium::span<const uint8_t> src_span);
+
+}  // namespace fxcodec
+
+#endif  // CORE_FXCODEC_JPX_JPX_TEST_SUPPORT_H_
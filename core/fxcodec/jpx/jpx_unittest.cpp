@@ -9,9 +9,11 @@
 #include <array>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "core/fxcodec/jpx/cjpx_decoder.h"
 #include "core/fxcodec/jpx/jpx_decode_utils.h"
+#include "core/fxcodec/jpx/jpx_test_support.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/fx_memory.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -463,4 +465,26 @@ TEST(fxcodec, YUV420ToRGB) {
   FX_Free(img.comps);
 }
 
+TEST(fxcodec, SetThreadCount) {
+  EXPECT_FALSE(CJPX_Decoder::SetThreadCount(-1));
+  EXPECT_TRUE(CJPX_Decoder::SetThreadCount(0));
+  EXPECT_TRUE(CJPX_Decoder::SetThreadCount(1));
+  EXPECT_EQ(!!opj_has_thread_support(), CJPX_Decoder::SetThreadCount(4));
+  EXPECT_TRUE(CJPX_Decoder::SetThreadCount(0));
+}
+
+TEST(fxcodec, DecodeWithThreads) {
+  const std::vector<uint8_t> src = LoadJpxTestImage();
+  ASSERT_FALSE(src.empty());
+  const std::vector<uint8_t> expected = DecodeJpxImage(src);
+  ASSERT_FALSE(expected.empty());
+
+  if (!CJPX_Decoder::SetThreadCount(4)) {
+    GTEST_SKIP() << "OpenJPEG was built without thread support";
+  }
+  const std::vector<uint8_t> threaded = DecodeJpxImage(src);
+  CJPX_Decoder::SetThreadCount(0);
+  EXPECT_EQ(expected, threaded);
+}
+
 }  // namespace fxcodec
@@ -0,0 +1,127 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mapped_file_stream_posix.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
+#include "core/fxcrt/stl_util.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif  // O_BINARY
+
+#ifndef O_LARGEFILE
+#define O_LARGEFILE 0
+#endif  // O_LARGEFILE
+
+// static
+RetainPtr<CFX_MappedFileStream_Posix> CFX_MappedFileStream_Posix::Create(
+    ByteStringView filename) {
+  int fd =
+      open(filename.unterminated_c_str(), O_BINARY | O_LARGEFILE | O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat s = {};
+  if (fstat(fd, &s) != 0 || !S_ISREG(s.st_mode) || s.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  FX_SAFE_SIZE_T safe_size = s.st_size;
+  if (!safe_size.IsValid()) {
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = safe_size.ValueOrDie();
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (addr == MAP_FAILED) {
+    close(fd);
+    return nullptr;
+  }
+
+  // SAFETY: mmap() succeeded for `size` bytes.
+  auto mapping =
+      UNSAFE_BUFFERS(pdfium::span(static_cast<const uint8_t*>(addr), size));
+  return pdfium::MakeRetain<CFX_MappedFileStream_Posix>(fd, mapping);
+}
+
+CFX_MappedFileStream_Posix::CFX_MappedFileStream_Posix(
+    int fd,
+    pdfium::span<const uint8_t> mapping)
+    : fd_(fd), mapping_(mapping) {}
+
+CFX_MappedFileStream_Posix::~CFX_MappedFileStream_Posix() {
+  munmap(const_cast<uint8_t*>(mapping_.data()), mapping_.size());
+  close(fd_);
+}
+
+FX_FILESIZE CFX_MappedFileStream_Posix::GetSize() {
+  return pdfium::checked_cast<FX_FILESIZE>(mapping_.size());
+}
+
+bool CFX_MappedFileStream_Posix::ReadBlockAtOffset(
+    pdfium::span<uint8_t> buffer,
+    FX_FILESIZE offset) {
+  if (buffer.empty() || !IsValidRange(offset, buffer.size())) {
+    return false;
+  }
+
+  if (IsMappingIntact()) {
+    fxcrt::Copy(
+        mapping_.subspan(pdfium::checked_cast<size_t>(offset), buffer.size()),
+        buffer);
+    return true;
+  }
+
+  while (!buffer.empty()) {
+    ssize_t bytes_read = pread(fd_, buffer.data(), buffer.size(), offset);
+    if (bytes_read <= 0) {
+      return false;
+    }
+    buffer = buffer.subspan(static_cast<size_t>(bytes_read));
+    offset += bytes_read;
+  }
+  return true;
+}
+
+pdfium::span<const uint8_t> CFX_MappedFileStream_Posix::GetSpanAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  if (size == 0 || !IsValidRange(offset, size) || !IsMappingIntact()) {
+    return {};
+  }
+  return mapping_.subspan(pdfium::checked_cast<size_t>(offset), size);
+}
+
+bool CFX_MappedFileStream_Posix::IsValidRange(FX_FILESIZE offset,
+                                              size_t size) const {
+  if (offset < 0) {
+    return false;
+  }
+  FX_SAFE_SIZE_T end = size;
+  end += offset;
+  return end.IsValid() && end.ValueOrDie() <= mapping_.size();
+}
+
+bool CFX_MappedFileStream_Posix::IsMappingIntact() {
+  if (truncated_) {
+    return false;
+  }
+  struct stat s = {};
+  if (fstat(fd_, &s) != 0 ||
+      static_cast<uint64_t>(s.st_size) < mapping_.size()) {
+    truncated_ = true;
+  }
+  return !truncated_;
+}
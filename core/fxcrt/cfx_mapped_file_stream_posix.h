@@ -0,0 +1,63 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXCRT_CFX_MAPPED_FILE_STREAM_POSIX_H_
+#define CORE_FXCRT_CFX_MAPPED_FILE_STREAM_POSIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "build/build_config.h"
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/fx_stream.h"
+#include "core/fxcrt/raw_span.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+
+#if !BUILDFLAG(IS_POSIX)
+#error "Included on the wrong platform"
+#endif
+
+// Read-only stream over a file that is mapped into memory in its entirety.
+// Hands out views straight into the mapping through GetSpanAtOffset(), so
+// callers can avoid copying the file contents.
+//
+// If the file shrinks while it is mapped, touching the pages past the new end
+// of file would fault. The stream detects this on every access, stops handing
+// out views, and serves reads through pread() instead. Views handed out before
+// the file shrank are not protected, so embedders must not truncate files that
+// are open through this stream.
+class CFX_MappedFileStream_Posix final : public IFX_SeekableReadStream {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Returns nullptr if `filename` is not a non-empty regular file, or if it
+  // cannot be mapped.
+  static RetainPtr<CFX_MappedFileStream_Posix> Create(ByteStringView filename);
+
+  // IFX_SeekableReadStream:
+  FX_FILESIZE GetSize() override;
+  bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
+                         FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> GetSpanAtOffset(FX_FILESIZE offset,
+                                              size_t size) override;
+
+  bool IsTruncatedForTesting() const { return truncated_; }
+
+ private:
+  CFX_MappedFileStream_Posix(int fd, pdfium::span<const uint8_t> mapping);
+  ~CFX_MappedFileStream_Posix() override;
+
+  // Returns true if [`offset`, `offset` + `size`) lies within the mapping.
+  bool IsValidRange(FX_FILESIZE offset, size_t size) const;
+
+  // Returns false once the file has been found to be shorter than the mapping.
+  bool IsMappingIntact();
+
+  const int fd_;
+  const pdfium::raw_span<const uint8_t> mapping_;
+  bool truncated_ = false;
+};
+
+#endif  // CORE_FXCRT_CFX_MAPPED_FILE_STREAM_POSIX_H_
@@ -0,0 +1,119 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxcrt/cfx_mapped_file_stream_posix.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <array>
+#include <string>
+
+#include "core/fxcrt/bytestring.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr char kContents[] = "0123456789abcdef";
+
+class ScopedTempFile {
+ public:
+  explicit ScopedTempFile(ByteStringView contents) {
+    std::string path_template = ::testing::TempDir() + "pdfium_mmap_XXXXXX";
+    fd_ = mkstemp(path_template.data());
+    if (fd_ < 0) {
+      return;
+    }
+    path_ = path_template;
+    if (write(fd_, contents.unterminated_c_str(), contents.GetLength()) !=
+        static_cast<ssize_t>(contents.GetLength())) {
+      path_.clear();
+    }
+  }
+  ~ScopedTempFile() {
+    if (fd_ >= 0) {
+      close(fd_);
+      unlink(path_.c_str());
+    }
+  }
+
+  const std::string& path() const { return path_; }
+  bool Truncate(off_t size) { return ftruncate(fd_, size) == 0; }
+
+ private:
+  int fd_ = -1;
+  std::string path_;
+};
+
+}  // namespace
+
+TEST(CFXMappedFileStreamPosixTest, NonexistentFile) {
+  EXPECT_FALSE(CFX_MappedFileStream_Posix::Create("/nonexistent/file.pdf"));
+}
+
+TEST(CFXMappedFileStreamPosixTest, EmptyFile) {
+  ScopedTempFile file("");
+  ASSERT_FALSE(file.path().empty());
+  EXPECT_FALSE(CFX_MappedFileStream_Posix::Create(file.path().c_str()));
+}
+
+TEST(CFXMappedFileStreamPosixTest, ReadAndView) {
+  ScopedTempFile file(kContents);
+  ASSERT_FALSE(file.path().empty());
+  RetainPtr<CFX_MappedFileStream_Posix> stream =
+      CFX_MappedFileStream_Posix::Create(file.path().c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(16, stream->GetSize());
+
+  std::array<uint8_t, 4> buffer = {};
+  ASSERT_TRUE(stream->ReadBlockAtOffset(buffer, 10));
+  EXPECT_EQ("abcd", ByteStringView(buffer));
+
+  pdfium::span<const uint8_t> view = stream->GetSpanAtOffset(12, 4);
+  EXPECT_EQ("cdef", ByteStringView(view));
+
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, 13));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, -1));
+  EXPECT_TRUE(stream->GetSpanAtOffset(13, 4).empty());
+  EXPECT_TRUE(stream->GetSpanAtOffset(0, 0).empty());
+  EXPECT_FALSE(stream->IsTruncatedForTesting());
+}
+
+TEST(CFXMappedFileStreamPosixTest, FileShrinksWhileMapped) {
+  ScopedTempFile file(kContents);
+  ASSERT_FALSE(file.path().empty());
+  RetainPtr<CFX_MappedFileStream_Posix> stream =
+      CFX_MappedFileStream_Posix::Create(file.path().c_str());
+  ASSERT_TRUE(stream);
+  ASSERT_TRUE(file.Truncate(8));
+
+  // Views are no longer handed out, and reads go through the file instead of
+  // the mapping.
+  EXPECT_TRUE(stream->GetSpanAtOffset(0, 4).empty());
+  EXPECT_TRUE(stream->IsTruncatedForTesting());
+
+  std::array<uint8_t, 4> buffer = {};
+  ASSERT_TRUE(stream->ReadBlockAtOffset(buffer, 4));
+  EXPECT_EQ("4567", ByteStringView(buffer));
+  EXPECT_FALSE(stream->ReadBlockAtOffset(buffer, 10));
+}
+
+TEST(CFXMappedFileStreamPosixTest, CreateMappedFromFilename) {
+  ScopedTempFile file(kContents);
+  ASSERT_FALSE(file.path().empty());
+  RetainPtr<IFX_SeekableReadStream> stream =
+      IFX_SeekableReadStream::CreateMappedFromFilename(file.path().c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ("0123", ByteStringView(stream->GetSpanAtOffset(0, 4)));
+
+  // Files that cannot be mapped still open through the regular path.
+  ScopedTempFile empty_file("");
+  ASSERT_FALSE(empty_file.path().empty());
+  stream = IFX_SeekableReadStream::CreateMappedFromFilename(
+      empty_file.path().c_str());
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(0, stream->GetSize());
+}
@@ -6,6 +6,8 @@
 
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 
+#include <utility>
+
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/stl_util.h"
@@ -13,6 +15,11 @@
 CFX_ReadOnlySpanStream::CFX_ReadOnlySpanStream(pdfium::span<const uint8_t> span)
     : span_(span) {}
 
+CFX_ReadOnlySpanStream::CFX_ReadOnlySpanStream(
+    pdfium::span<const uint8_t> span,
+    RetainPtr<const Retainable> owner)
+    : span_(span), owner_(std::move(owner)) {}
+
 CFX_ReadOnlySpanStream::~CFX_ReadOnlySpanStream() = default;
 
 FX_FILESIZE CFX_ReadOnlySpanStream::GetSize() {
@@ -37,3 +44,19 @@ bool CFX_ReadOnlySpanStream::ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
 
   return true;
 }
+
+pdfium::span<const uint8_t> CFX_ReadOnlySpanStream::GetSpanAtOffset(
+    FX_FILESIZE offset,
+    size_t size) {
+  if (!owner_ || size == 0 || offset < 0) {
+    return {};
+  }
+
+  FX_SAFE_SIZE_T pos = size;
+  pos += offset;
+  if (!pos.IsValid() || pos.ValueOrDie() > span_.size()) {
+    return {};
+  }
+
+  return span_.subspan(pdfium::checked_cast<size_t>(offset), size);
+}
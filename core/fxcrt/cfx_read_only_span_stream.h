@@ -20,12 +20,21 @@ class CFX_ReadOnlySpanStream final : public IFX_SeekableReadStream {
   FX_FILESIZE GetSize() override;
   bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                          FX_FILESIZE offset) override;
+  pdfium::span<const uint8_t> GetSpanAtOffset(FX_FILESIZE offset,
+                                              size_t size) override;
 
  private:
   explicit CFX_ReadOnlySpanStream(pdfium::span<const uint8_t> span);
+
+  // Keeps `owner`, which must own the memory behind `span`, alive for the
+  // lifetime of the stream. Only streams with an owner hand out views through
+  // GetSpanAtOffset(), as the memory is otherwise managed by the caller.
+  CFX_ReadOnlySpanStream(pdfium::span<const uint8_t> span,
+                         RetainPtr<const Retainable> owner);
   ~CFX_ReadOnlySpanStream() override;
 
   const pdfium::raw_span<const uint8_t> span_;
+  RetainPtr<const Retainable> const owner_;
 };
 
 #endif  // CORE_FXCRT_CFX_READ_ONLY_SPAN_STREAM_H_
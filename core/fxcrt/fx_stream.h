@@ -54,10 +54,23 @@ class IFX_SeekableReadStream : virtual public Retainable,
   static RetainPtr<IFX_SeekableReadStream> CreateFromFilename(
       const char* filename);
 
+  // Like CreateFromFilename(), but maps the file into memory where the
+  // platform supports it, so GetSpanAtOffset() can return views of it.
+  // Falls back to CreateFromFilename() otherwise.
+  static RetainPtr<IFX_SeekableReadStream> CreateMappedFromFilename(
+      const char* filename);
+
   virtual bool IsEOF();
   virtual FX_FILESIZE GetPosition();
   [[nodiscard]] virtual bool ReadBlockAtOffset(pdfium::span<uint8_t> buffer,
                                                FX_FILESIZE offset) = 0;
+
+  // Returns a view of `size` bytes at `offset` without copying, or an empty
+  // span if the stream does not keep its contents in memory. The view stays
+  // valid for as long as the stream is alive. Callers must fall back to
+  // ReadBlockAtOffset() when this returns an empty span.
+  virtual pdfium::span<const uint8_t> GetSpanAtOffset(FX_FILESIZE offset,
+                                                      size_t size);
 };
 
 class IFX_SeekableStream : public IFX_SeekableReadStream,
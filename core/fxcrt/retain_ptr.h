@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -149,12 +150,16 @@ class TRIVIAL_ABI RetainPtr {
   std::unique_ptr<T, ReleaseDeleter<T>> obj_;
 };
 
-// Trivial implementation - internal ref count with virtual destructor.
+// Trivial implementation - internal ref count with virtual destructor. The
+// count is atomic, so references to the same object may be taken and dropped
+// on different threads.
 class Retainable {
  public:
   Retainable() = default;
 
-  bool HasOneRef() const { return ref_count_ == 1; }
+  bool HasOneRef() const {
+    return ref_count_.load(std::memory_order_acquire) == 1;
+  }
 
  protected:
   virtual ~Retainable() = default;
@@ -173,18 +178,21 @@ class Retainable {
   // RetainPtr<const T> can be used for an object that is otherwise const
   // apart from the internal ref-counting.
   void Retain() const {
-    ++ref_count_;
-    CHECK(ref_count_ > 0);
+    const uintptr_t old_count =
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+    CHECK(old_count + 1 > 0);
   }
   void Release() const {
-    CHECK(ref_count_ > 0);
-    if (--ref_count_ == 0) {
+    const uintptr_t old_count =
+        ref_count_.fetch_sub(1, std::memory_order_acq_rel);
+    CHECK(old_count > 0);
+    if (old_count == 1) {
       delete this;
     }
   }
 
-  mutable uintptr_t ref_count_ = 0;
-  static_assert(std::is_unsigned<decltype(ref_count_)>::value,
+  mutable std::atomic<uintptr_t> ref_count_ = 0;
+  static_assert(std::is_unsigned<uintptr_t>::value,
                 "ref_count_ must be an unsigned type for overflow check"
                 "to work properly in Retain()");
 };
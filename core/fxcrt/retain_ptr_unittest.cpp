@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -422,6 +423,23 @@ TEST(RetainPtr, MakeRetained) {
   EXPECT_TRUE(ptr->HasOneRef());
 }
 
+TEST(RetainPtr, CopiesOnManyThreads) {
+  auto ptr = pdfium::MakeRetain<Retainable>();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&ptr] {
+      for (int j = 0; j < 100000; ++j) {
+        RetainPtr<Retainable> copy = ptr;
+        EXPECT_FALSE(copy->HasOneRef());
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(ptr->HasOneRef());
+}
+
 TEST(RetainPtr, VectorMove) {
   // Proves move ctor is selected by std::vector over copy/delete, this
   // may require the ctor to be marked "noexcept".
@@ -23,6 +23,7 @@
 #include "core/fxcrt/zip.h"
 #include "core/fxge/agg/cfx_agg_cliprgn.h"
 #include "core/fxge/agg/cfx_agg_imagerenderer.h"
+#include "core/fxge/agg/fx_agg_composite_span.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_graphstatedata.h"
 #include "core/fxge/cfx_path.h"
@@ -614,6 +615,10 @@ void CFX_AggRenderer::CompositeSpanGray(uint8_t* dest_scan,
                                         const uint8_t* clip_scan) {
   DCHECK(!rgb_byte_order_);
   const int gray = GetGray();
+  if (!clip_scan) {
+    col_start = CompositeSpanGrayVectorized(dest_scan, cover_scan, col_start,
+                                            col_end, alpha_, gray);
+  }
   UNSAFE_TODO({
     dest_scan += col_start;
     for (int col = col_start; col < col_end; col++) {
@@ -637,6 +642,10 @@ void CFX_AggRenderer::CompositeSpanARGB(uint8_t* dest_scan,
                                         const uint8_t* cover_scan,
                                         const uint8_t* clip_scan) {
   const auto& bgr = GetBGR();
+  if (!rgb_byte_order_ && !clip_scan) {
+    col_start = CompositeSpanArgbVectorized(
+        dest_scan, cover_scan, col_start, col_end, alpha_, full_cover_, bgr);
+  }
   UNSAFE_TODO({
     dest_scan += col_start * bytes_per_pixel;
     if (rgb_byte_order_) {
@@ -705,6 +714,11 @@ void CFX_AggRenderer::CompositeSpanRGB(uint8_t* dest_scan,
                                        const uint8_t* cover_scan,
                                        const uint8_t* clip_scan) {
   const auto& bgr = GetBGR();
+  if (!rgb_byte_order_ && !clip_scan) {
+    col_start = CompositeSpanRgbVectorized(dest_scan, bytes_per_pixel,
+                                           cover_scan, col_start, col_end,
+                                           alpha_, full_cover_, bgr);
+  }
   UNSAFE_TODO({
     dest_scan += col_start * bytes_per_pixel;
     if (rgb_byte_order_) {
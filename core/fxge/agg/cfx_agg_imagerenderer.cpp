@@ -31,7 +31,8 @@ CFX_AggImageRenderer::CFX_AggImageRenderer(
       matrix_(matrix),
       alpha_(alpha),
       mask_color_(mask_color),
-      rgb_byte_order_(bRgbByteOrder) {
+      rgb_byte_order_(bRgbByteOrder),
+      source_realized_(source->IsRealized()) {
   FX_RECT image_rect = matrix_.GetUnitRect().GetOuterRect();
   clip_box_ = pClipRgn
                   ? pClipRgn->GetBox()
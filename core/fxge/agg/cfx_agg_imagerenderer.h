@@ -34,6 +34,9 @@ class CFX_AggImageRenderer {
 
   bool Continue(PauseIndicatorIface* pPause);
 
+  // Whether Continue() only reads a realized source bitmap.
+  bool IsSourceRealized() const { return source_realized_; }
+
  private:
   enum class State : uint8_t { kInitial = 0, kStretching, kTransforming };
 
@@ -48,6 +51,7 @@ class CFX_AggImageRenderer {
   uint32_t mask_color_;
   State state_ = State::kInitial;
   const bool rgb_byte_order_;
+  const bool source_realized_;
 };
 
 #endif  // CORE_FXGE_AGG_CFX_AGG_IMAGERENDERER_H_
@@ -0,0 +1,197 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/fx_agg_composite_span.h"
+
+#include "core/fxcrt/compiler_specific.h"
+
+// Highway compiles this file once per instruction set it targets.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxge/agg/fx_agg_composite_span.cpp"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+
+#include "core/fxge/dib/fx_dib_simd_inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+// The alpha of the fill color, times the coverage unless the span is fully
+// covered.
+HWY_INLINE VI32 SourceAlpha(const uint8_t* cover_scan,
+                            VI32 alpha,
+                            bool full_cover) {
+  return full_cover ? alpha : Div255(hn::Mul(alpha, LoadBytes(cover_scan)));
+}
+
+int CompositeSpanGrayImpl(uint8_t* dest_scan,
+                          const uint8_t* cover_scan,
+                          int col_start,
+                          int col_end,
+                          int alpha,
+                          int gray) {
+  const DI32 di;
+  const DU8 du8;
+  const int lanes = static_cast<int>(hn::Lanes(di));
+  const VI32 alpha_vec = hn::Set(di, alpha);
+  const VI32 gray_vec = hn::Set(di, gray);
+  int col = col_start;
+  UNSAFE_TODO({
+    for (; col + lanes <= col_end; col += lanes) {
+      // The scalar code skips zero alphas and stores `gray` for opaque ones,
+      // which is what the merge gives for those alphas anyway.
+      const VI32 src_alpha =
+          SourceAlpha(cover_scan + col, alpha_vec, /*full_cover=*/false);
+      const VI32 dest = LoadBytes(dest_scan + col);
+      hn::StoreU(ToBytes(AlphaMerge(dest, gray_vec, src_alpha)), du8,
+                 dest_scan + col);
+    }
+  });
+  return col;
+}
+
+int CompositeSpanArgbImpl(uint8_t* dest_scan,
+                          const uint8_t* cover_scan,
+                          int col_start,
+                          int col_end,
+                          int alpha,
+                          bool full_cover,
+                          const FX_BGR_STRUCT<uint8_t>& bgr) {
+  const DI32 di;
+  const DU8 du8;
+  const int lanes = static_cast<int>(hn::Lanes(di));
+  const VI32 alpha_vec = hn::Set(di, alpha);
+  const VI32 blue = hn::Set(di, bgr.blue);
+  const VI32 green = hn::Set(di, bgr.green);
+  const VI32 red = hn::Set(di, bgr.red);
+  const VI32 one = hn::Set(di, 1);
+  const VI32 max_alpha = hn::Set(di, 255);
+  int col = col_start;
+  UNSAFE_TODO({
+    for (; col + lanes <= col_end; col += lanes) {
+      uint8_t* pixels = dest_scan + col * 4;
+      hn::Vec<DU8> b;
+      hn::Vec<DU8> g;
+      hn::Vec<DU8> r;
+      hn::Vec<DU8> a;
+      hn::LoadInterleaved4(du8, pixels, b, g, r, a);
+      // The scalar code special-cases zero alphas, opaque sources and
+      // transparent destinations. The general formula below gives the same
+      // pixels in all of those cases.
+      const VI32 src_alpha =
+          SourceAlpha(cover_scan + col, alpha_vec, full_cover);
+      const VI32 back_alpha = hn::PromoteTo(di, a);
+      const VI32 dest_alpha =
+          hn::Sub(hn::Add(back_alpha, src_alpha),
+                  Div255(hn::Mul(back_alpha, src_alpha)));
+      const VI32 alpha_ratio = DivideRoundingDown(
+          hn::Mul(src_alpha, max_alpha), hn::Max(dest_alpha, one));
+      hn::StoreInterleaved4(
+          ToBytes(AlphaMerge(hn::PromoteTo(di, b), blue, alpha_ratio)),
+          ToBytes(AlphaMerge(hn::PromoteTo(di, g), green, alpha_ratio)),
+          ToBytes(AlphaMerge(hn::PromoteTo(di, r), red, alpha_ratio)),
+          ToBytes(dest_alpha), du8, pixels);
+    }
+  });
+  return col;
+}
+
+int CompositeSpanRgbImpl(uint8_t* dest_scan,
+                         int bytes_per_pixel,
+                         const uint8_t* cover_scan,
+                         int col_start,
+                         int col_end,
+                         int alpha,
+                         bool full_cover,
+                         const FX_BGR_STRUCT<uint8_t>& bgr) {
+  const DI32 di;
+  const DU8 du8;
+  const int lanes = static_cast<int>(hn::Lanes(di));
+  const VI32 alpha_vec = hn::Set(di, alpha);
+  const VI32 blue = hn::Set(di, bgr.blue);
+  const VI32 green = hn::Set(di, bgr.green);
+  const VI32 red = hn::Set(di, bgr.red);
+  const VI32 max_alpha = hn::Set(di, 255);
+  int col = col_start;
+  UNSAFE_TODO({
+    for (; col + lanes <= col_end; col += lanes) {
+      uint8_t* pixels = dest_scan + col * bytes_per_pixel;
+      const VI32 src_alpha =
+          SourceAlpha(cover_scan + col, alpha_vec, full_cover);
+      hn::Vec<DU8> b;
+      hn::Vec<DU8> g;
+      hn::Vec<DU8> r;
+      if (bytes_per_pixel == 3) {
+        hn::LoadInterleaved3(du8, pixels, b, g, r);
+        hn::StoreInterleaved3(
+            ToBytes(AlphaMerge(hn::PromoteTo(di, b), blue, src_alpha)),
+            ToBytes(AlphaMerge(hn::PromoteTo(di, g), green, src_alpha)),
+            ToBytes(AlphaMerge(hn::PromoteTo(di, r), red, src_alpha)), du8,
+            pixels);
+        continue;
+      }
+      // Opaque sources store the whole fill color, which sets the unused
+      // fourth byte to 255. Other sources leave it alone.
+      hn::Vec<DU8> x;
+      hn::LoadInterleaved4(du8, pixels, b, g, r, x);
+      const VI32 x_out = hn::IfThenElse(hn::Eq(src_alpha, max_alpha),
+                                        max_alpha, hn::PromoteTo(di, x));
+      hn::StoreInterleaved4(
+          ToBytes(AlphaMerge(hn::PromoteTo(di, b), blue, src_alpha)),
+          ToBytes(AlphaMerge(hn::PromoteTo(di, g), green, src_alpha)),
+          ToBytes(AlphaMerge(hn::PromoteTo(di, r), red, src_alpha)),
+          ToBytes(x_out), du8, pixels);
+    }
+  });
+  return col;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace pdfium {
+
+HWY_EXPORT(CompositeSpanGrayImpl);
+HWY_EXPORT(CompositeSpanArgbImpl);
+HWY_EXPORT(CompositeSpanRgbImpl);
+
+int CompositeSpanGrayVectorized(uint8_t* dest_scan,
+                                const uint8_t* cover_scan,
+                                int col_start,
+                                int col_end,
+                                int alpha,
+                                int gray) {
+  return HWY_DYNAMIC_DISPATCH(CompositeSpanGrayImpl)(
+      dest_scan, cover_scan, col_start, col_end, alpha, gray);
+}
+
+int CompositeSpanArgbVectorized(uint8_t* dest_scan,
+                                const uint8_t* cover_scan,
+                                int col_start,
+                                int col_end,
+                                int alpha,
+                                bool full_cover,
+                                const FX_BGR_STRUCT<uint8_t>& bgr) {
+  return HWY_DYNAMIC_DISPATCH(CompositeSpanArgbImpl)(
+      dest_scan, cover_scan, col_start, col_end, alpha, full_cover, bgr);
+}
+
+int CompositeSpanRgbVectorized(uint8_t* dest_scan,
+                               int bytes_per_pixel,
+                               const uint8_t* cover_scan,
+                               int col_start,
+                               int col_end,
+                               int alpha,
+                               bool full_cover,
+                               const FX_BGR_STRUCT<uint8_t>& bgr) {
+  return HWY_DYNAMIC_DISPATCH(CompositeSpanRgbImpl)(
+      dest_scan, bytes_per_pixel, cover_scan, col_start, col_end, alpha,
+      full_cover, bgr);
+}
+
+}  // namespace pdfium
+#endif  // HWY_ONCE
@@ -0,0 +1,52 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_AGG_FX_AGG_COMPOSITE_SPAN_H_
+#define CORE_FXGE_AGG_FX_AGG_COMPOSITE_SPAN_H_
+
+#include <stdint.h>
+
+#include "core/fxge/dib/fx_dib.h"
+
+namespace pdfium {
+
+// Vectorized span compositors for CFX_AggRenderer, for spans without a clip
+// mask in BGR byte order. They produce exactly the same pixels as the scalar
+// compositors. The instruction set is picked at runtime.
+//
+// Each function composites columns `col_start` onwards in whole vectors, as
+// far as `col_end` allows, and returns the first column it did not composite.
+// The caller composites the remaining columns. `dest_scan` and `cover_scan`
+// point to column 0 of the span.
+
+// For 8 bpp destinations.
+int CompositeSpanGrayVectorized(uint8_t* dest_scan,
+                                const uint8_t* cover_scan,
+                                int col_start,
+                                int col_end,
+                                int alpha,
+                                int gray);
+
+// For FXDIB_Format::kBgra destinations.
+int CompositeSpanArgbVectorized(uint8_t* dest_scan,
+                                const uint8_t* cover_scan,
+                                int col_start,
+                                int col_end,
+                                int alpha,
+                                bool full_cover,
+                                const FX_BGR_STRUCT<uint8_t>& bgr);
+
+// For FXDIB_Format::kBgr and FXDIB_Format::kBgrx destinations.
+int CompositeSpanRgbVectorized(uint8_t* dest_scan,
+                               int bytes_per_pixel,
+                               const uint8_t* cover_scan,
+                               int col_start,
+                               int col_end,
+                               int alpha,
+                               bool full_cover,
+                               const FX_BGR_STRUCT<uint8_t>& bgr);
+
+}  // namespace pdfium
+
+#endif  // CORE_FXGE_AGG_FX_AGG_COMPOSITE_SPAN_H_
@@ -0,0 +1,77 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Throughput benchmarks for the AGG span compositors. They are disabled by
+// default; run them by passing --gtest_also_run_disabled_tests and
+// --gtest_filter=AggCompositeSpanBenchmark.* to pdfium_unittests.
+
+#include <stdio.h>
+
+#include <chrono>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+constexpr int kWidth = 2048;
+constexpr int kHeight = 1024;
+constexpr int kIterations = 5;
+
+// Typical span lengths: glyph stems, thin strokes, and wide fills.
+constexpr int kSpanLengths[] = {4, 16, 64, 256, 1024};
+
+// Fills rectangles `span_length` pixels wide across a bitmap of `format`, so
+// that every scanline is one span of about that length, and reports the
+// throughput for each length. The rectangles start half way into a pixel, so
+// the spans have partially covered ends, like most spans do.
+void ReportThroughput(const char* name, FXDIB_Format format) {
+  CFX_DefaultRenderDevice device;
+  ASSERT_TRUE(device.Create(kWidth, kHeight, format));
+  // Anti-aliased, so the rectangles are not drawn with FillRect().
+  CFX_FillRenderOptions fill_options(CFX_FillRenderOptions::FillType::kWinding);
+  fill_options.rect_aa = true;
+  const CFX_Matrix matrix;
+  for (int span_length : kSpanLengths) {
+    double best_seconds = 0;
+    int pixels = 0;
+    for (int i = 0; i < kIterations; ++i) {
+      pixels = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (int left = 0; left + span_length < kWidth; left += span_length) {
+        CFX_Path path;
+        path.AppendRect(left + 0.5f, 0, left + span_length + 0.5f, kHeight);
+        device.DrawPath(path, &matrix, /*pGraphState=*/nullptr, 0xC8336699,
+                        /*stroke_color=*/0, fill_options);
+        pixels += span_length * kHeight;
+      }
+      const std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      if (i == 0 || elapsed.count() < best_seconds) {
+        best_seconds = elapsed.count();
+      }
+    }
+    printf("%s, span length %d: %.1f Mpixels/s\n", name, span_length,
+           pixels / best_seconds / 1e6);
+  }
+}
+
+}  // namespace
+
+TEST(AggCompositeSpanBenchmark, DISABLED_Bgra) {
+  ReportThroughput("Bgra", FXDIB_Format::kBgra);
+}
+
+TEST(AggCompositeSpanBenchmark, DISABLED_Bgrx) {
+  ReportThroughput("Bgrx", FXDIB_Format::kBgrx);
+}
+
+TEST(AggCompositeSpanBenchmark, DISABLED_Mask) {
+  ReportThroughput("8bppMask", FXDIB_Format::k8bppMask);
+}
@@ -0,0 +1,175 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/agg/fx_agg_composite_span.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+constexpr int kSpanLength = 1000;
+constexpr int kColStart = 3;
+constexpr int kColEnd = kSpanLength - 5;
+constexpr int kAlphas[] = {0, 1, 100, 254, 255};
+constexpr FX_BGR_STRUCT<uint8_t> kColor = {.blue = 10,
+                                           .green = 128,
+                                           .red = 250};
+
+// Bytes covering every value, including the 0 and 255 edge cases, in a
+// pseudo-random order.
+std::vector<uint8_t> MakeBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t value = (seed >> 16) % 300;
+    bytes[i] = value >= 256 ? (value % 2 ? 255 : 0) : value;
+  }
+  return bytes;
+}
+
+// Copies of the scalar compositors in CFX_AggRenderer, for spans without a
+// clip mask in BGR byte order.
+void CompositeSpanGrayScalar(uint8_t* dest_scan,
+                             const uint8_t* cover_scan,
+                             int col_start,
+                             int col_end,
+                             int alpha,
+                             int gray) {
+  UNSAFE_TODO({
+    for (int col = col_start; col < col_end; col++) {
+      int src_alpha = alpha * cover_scan[col] / 255;
+      if (src_alpha == 255) {
+        dest_scan[col] = gray;
+      } else if (src_alpha) {
+        dest_scan[col] = FXDIB_ALPHA_MERGE(dest_scan[col], gray, src_alpha);
+      }
+    }
+  });
+}
+
+void CompositeSpanArgbScalar(uint8_t* dest_scan,
+                             const uint8_t* cover_scan,
+                             int col_start,
+                             int col_end,
+                             int alpha,
+                             bool full_cover) {
+  UNSAFE_TODO({
+    for (int col = col_start; col < col_end; col++) {
+      uint8_t* pixel = dest_scan + col * 4;
+      int src_alpha = full_cover ? alpha : alpha * cover_scan[col] / 255;
+      if (!src_alpha) {
+        continue;
+      }
+      if (src_alpha == 255 || pixel[3] == 0) {
+        pixel[0] = kColor.blue;
+        pixel[1] = kColor.green;
+        pixel[2] = kColor.red;
+        pixel[3] = src_alpha;
+        continue;
+      }
+      uint8_t dest_alpha = pixel[3] + src_alpha - pixel[3] * src_alpha / 255;
+      pixel[3] = dest_alpha;
+      int alpha_ratio = src_alpha * 255 / dest_alpha;
+      pixel[0] = FXDIB_ALPHA_MERGE(pixel[0], kColor.blue, alpha_ratio);
+      pixel[1] = FXDIB_ALPHA_MERGE(pixel[1], kColor.green, alpha_ratio);
+      pixel[2] = FXDIB_ALPHA_MERGE(pixel[2], kColor.red, alpha_ratio);
+    }
+  });
+}
+
+void CompositeSpanRgbScalar(uint8_t* dest_scan,
+                            int bytes_per_pixel,
+                            const uint8_t* cover_scan,
+                            int col_start,
+                            int col_end,
+                            int alpha,
+                            bool full_cover) {
+  UNSAFE_TODO({
+    for (int col = col_start; col < col_end; col++) {
+      uint8_t* pixel = dest_scan + col * bytes_per_pixel;
+      int src_alpha = full_cover ? alpha : alpha * cover_scan[col] / 255;
+      pixel[0] = FXDIB_ALPHA_MERGE(pixel[0], kColor.blue, src_alpha);
+      pixel[1] = FXDIB_ALPHA_MERGE(pixel[1], kColor.green, src_alpha);
+      pixel[2] = FXDIB_ALPHA_MERGE(pixel[2], kColor.red, src_alpha);
+      if (bytes_per_pixel == 4 && src_alpha == 255) {
+        pixel[3] = 255;
+      }
+    }
+  });
+}
+
+}  // namespace
+
+TEST(AggCompositeSpan, Gray) {
+  const std::vector<uint8_t> covers = MakeBytes(kSpanLength, 1);
+  for (int alpha : kAlphas) {
+    SCOPED_TRACE(alpha);
+    std::vector<uint8_t> expected = MakeBytes(kSpanLength, 2);
+    std::vector<uint8_t> actual = expected;
+    CompositeSpanGrayScalar(expected.data(), covers.data(), kColStart, kColEnd,
+                            alpha, /*gray=*/77);
+    const int col = CompositeSpanGrayVectorized(
+        actual.data(), covers.data(), kColStart, kColEnd, alpha, /*gray=*/77);
+    ASSERT_GE(col, kColStart);
+    ASSERT_LE(col, kColEnd);
+    CompositeSpanGrayScalar(actual.data(), covers.data(), col, kColEnd, alpha,
+                            /*gray=*/77);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(AggCompositeSpan, Argb) {
+  const std::vector<uint8_t> covers = MakeBytes(kSpanLength, 3);
+  for (bool full_cover : {false, true}) {
+    for (int alpha : kAlphas) {
+      SCOPED_TRACE(alpha);
+      std::vector<uint8_t> expected = MakeBytes(kSpanLength * 4, 4);
+      std::vector<uint8_t> actual = expected;
+      CompositeSpanArgbScalar(expected.data(), covers.data(), kColStart,
+                              kColEnd, alpha, full_cover);
+      const int col =
+          CompositeSpanArgbVectorized(actual.data(), covers.data(), kColStart,
+                                      kColEnd, alpha, full_cover, kColor);
+      ASSERT_GE(col, kColStart);
+      ASSERT_LE(col, kColEnd);
+      CompositeSpanArgbScalar(actual.data(), covers.data(), col, kColEnd,
+                              alpha, full_cover);
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+TEST(AggCompositeSpan, Rgb) {
+  const std::vector<uint8_t> covers = MakeBytes(kSpanLength, 5);
+  for (int bytes_per_pixel : {3, 4}) {
+    for (bool full_cover : {false, true}) {
+      for (int alpha : kAlphas) {
+        SCOPED_TRACE(alpha);
+        std::vector<uint8_t> expected =
+            MakeBytes(kSpanLength * bytes_per_pixel, 6);
+        std::vector<uint8_t> actual = expected;
+        CompositeSpanRgbScalar(expected.data(), bytes_per_pixel, covers.data(),
+                               kColStart, kColEnd, alpha, full_cover);
+        const int col = CompositeSpanRgbVectorized(
+            actual.data(), bytes_per_pixel, covers.data(), kColStart, kColEnd,
+            alpha, full_cover, kColor);
+        ASSERT_GE(col, kColStart);
+        ASSERT_LE(col, kColEnd);
+        CompositeSpanRgbScalar(actual.data(), bytes_per_pixel, covers.data(),
+                               col, kColEnd, alpha, full_cover);
+        EXPECT_EQ(expected, actual);
+      }
+    }
+  }
+}
+
+}  // namespace pdfium
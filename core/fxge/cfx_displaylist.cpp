@@ -0,0 +1,106 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_displaylist.h"
+
+#include <utility>
+
+#include "core/fxge/cfx_renderdevice.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+#include "core/fxge/renderdevicedriver_iface.h"
+
+namespace {
+
+class Replayer {
+ public:
+  Replayer(CFX_RenderDevice* device, const CFX_Matrix& matrix)
+      : device_(device), matrix_(matrix) {}
+
+  // Undoes the saves the list left unbalanced.
+  ~Replayer() {
+    for (; save_depth_ > 0; --save_depth_) {
+      device_->RestoreState(/*bKeepSaved=*/false);
+    }
+  }
+
+  void operator()(const CFX_DisplayList::SaveOp&) {
+    device_->SaveState();
+    ++save_depth_;
+  }
+
+  void operator()(const CFX_DisplayList::RestoreOp& op) {
+    // Never restore past the state the replay started from.
+    if (save_depth_ == 0) {
+      return;
+    }
+    device_->RestoreState(op.keep_saved);
+    if (!op.keep_saved) {
+      --save_depth_;
+    }
+  }
+
+  void operator()(const CFX_DisplayList::ClipPathFillOp& op) {
+    const CFX_Matrix matrix = op.matrix * matrix_;
+    device_->SetClip_PathFill(op.path, &matrix, op.fill_options);
+  }
+
+  void operator()(const CFX_DisplayList::ClipPathStrokeOp& op) {
+    const CFX_Matrix matrix = op.matrix * matrix_;
+    device_->SetClip_PathStroke(op.path, &matrix, &op.graph_state);
+  }
+
+  void operator()(const CFX_DisplayList::PathOp& op) {
+    const CFX_Matrix matrix = op.matrix * matrix_;
+    device_->DrawPath(op.path, &matrix,
+                      op.graph_state.has_value() ? &op.graph_state.value()
+                                                 : nullptr,
+                      op.fill_color, op.stroke_color, op.fill_options);
+  }
+
+  void operator()(const CFX_DisplayList::TextOp& op) {
+    device_->DrawNormalText(op.char_pos, op.font.get(), op.font_size,
+                            op.matrix * matrix_, op.color, op.options);
+  }
+
+  void operator()(const CFX_DisplayList::ImageOp& op) {
+    RenderDeviceDriverIface::StartResult result =
+        device_->StartDIBitsWithBlend(op.bitmap, op.alpha, op.color,
+                                      op.matrix * matrix_, op.options,
+                                      op.blend_mode);
+    if (result.result != RenderDeviceDriverIface::Result::kSuccess ||
+        !result.agg_image_renderer) {
+      return;
+    }
+    while (device_->ContinueDIBits(result.agg_image_renderer.get(),
+                                   /*pPause=*/nullptr)) {
+    }
+  }
+
+ private:
+  UnownedPtr<CFX_RenderDevice> const device_;
+  const CFX_Matrix matrix_;
+  int save_depth_ = 0;
+};
+
+}  // namespace
+
+CFX_DisplayList::CFX_DisplayList() = default;
+
+CFX_DisplayList::~CFX_DisplayList() = default;
+
+void CFX_DisplayList::Append(Op op) {
+  ops_.push_back(std::move(op));
+}
+
+void CFX_DisplayList::Replay(CFX_RenderDevice* device,
+                             const CFX_Matrix& matrix) const {
+  device->SaveState();
+  {
+    Replayer replayer(device, matrix);
+    for (const Op& op : ops_) {
+      std::visit(replayer, op);
+    }
+  }
+  device->RestoreState(/*bKeepSaved=*/false);
+}
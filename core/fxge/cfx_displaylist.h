@@ -0,0 +1,102 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_DISPLAYLIST_H_
+#define CORE_FXGE_CFX_DISPLAYLIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "core/fxcrt/fx_coordinates.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/cfx_textrenderoptions.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/text_char_pos.h"
+
+class CFX_DIBBase;
+class CFX_Font;
+class CFX_RenderDevice;
+
+// The drawing calls made on a CFX_DisplayListDevice, in order. Paths and text
+// are kept as vectors, so the list can be replayed onto any device at any
+// scale without re-interpreting the page. Fonts are kept alive through their
+// owners.
+class CFX_DisplayList {
+ public:
+  struct SaveOp {};
+  struct RestoreOp {
+    bool keep_saved;
+  };
+  struct ClipPathFillOp {
+    CFX_Path path;
+    CFX_Matrix matrix;
+    CFX_FillRenderOptions fill_options;
+  };
+  struct ClipPathStrokeOp {
+    CFX_Path path;
+    CFX_Matrix matrix;
+    CFX_GraphStateData graph_state;
+  };
+  struct PathOp {
+    CFX_Path path;
+    CFX_Matrix matrix;
+    std::optional<CFX_GraphStateData> graph_state;
+    uint32_t fill_color;
+    uint32_t stroke_color;
+    CFX_FillRenderOptions fill_options;
+  };
+  struct TextOp {
+    std::vector<TextCharPos> char_pos;
+    // Owns `font`, which is only valid while this is held.
+    RetainPtr<Retainable> font_owner;
+    UnownedPtr<CFX_Font> font;
+    float font_size;
+    CFX_Matrix matrix;
+    uint32_t color;
+    CFX_TextRenderOptions options;
+  };
+  struct ImageOp {
+    RetainPtr<const CFX_DIBBase> bitmap;
+    float alpha;
+    // The fill color for masks, or 0.
+    uint32_t color;
+    // Maps the unit square onto the image, as for StartDIBits().
+    CFX_Matrix matrix;
+    FXDIB_ResampleOptions options;
+    BlendMode blend_mode;
+  };
+  using Op = std::variant<SaveOp,
+                          RestoreOp,
+                          ClipPathFillOp,
+                          ClipPathStrokeOp,
+                          PathOp,
+                          TextOp,
+                          ImageOp>;
+
+  CFX_DisplayList();
+  CFX_DisplayList(const CFX_DisplayList&) = delete;
+  CFX_DisplayList& operator=(const CFX_DisplayList&) = delete;
+  ~CFX_DisplayList();
+
+  void Append(Op op);
+  size_t size() const { return ops_.size(); }
+  bool empty() const { return ops_.empty(); }
+
+  // Draws the recorded calls onto `device`, with `matrix` applied after the
+  // recorded transforms. Leaves the state of `device` as it found it.
+  void Replay(CFX_RenderDevice* device, const CFX_Matrix& matrix) const;
+
+ private:
+  std::vector<Op> ops_;
+};
+
+#endif  // CORE_FXGE_CFX_DISPLAYLIST_H_
@@ -0,0 +1,277 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_displaylistdevice.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/notreached.h"
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxge/agg/cfx_agg_imagerenderer.h"
+#include "core/fxge/cfx_displaylist.h"
+#include "core/fxge/cfx_fillrenderoptions.h"
+#include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_graphstatedata.h"
+#include "core/fxge/cfx_path.h"
+#include "core/fxge/dib/cfx_dibbase.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/render_defines.h"
+#include "core/fxge/renderdevicedriver_iface.h"
+
+namespace {
+
+// Decodes images that produce their scanlines on demand, so that replaying
+// the list does not depend on their decoders.
+RetainPtr<const CFX_DIBBase> Realize(RetainPtr<const CFX_DIBBase> bitmap) {
+  if (bitmap->IsRealized()) {
+    return bitmap;
+  }
+  return bitmap->Realize();
+}
+
+class DisplayListDriver final : public RenderDeviceDriverIface {
+ public:
+  DisplayListDriver(int width, int height)
+      : width_(width),
+        height_(height),
+        clip_box_(0, 0, width, height),
+        list_(std::make_unique<CFX_DisplayList>()) {}
+  ~DisplayListDriver() override = default;
+
+  std::unique_ptr<CFX_DisplayList> TakeDisplayList() {
+    return std::exchange(list_, std::make_unique<CFX_DisplayList>());
+  }
+
+  // RenderDeviceDriverIface:
+  DeviceType GetDeviceType() const override { return DeviceType::kDisplay; }
+
+  int GetDeviceCaps(int caps_id) const override {
+    switch (caps_id) {
+      case FXDC_PIXEL_WIDTH:
+        return width_;
+      case FXDC_PIXEL_HEIGHT:
+        return height_;
+      case FXDC_BITS_PIXEL:
+        return 32;
+      case FXDC_HORZ_SIZE:
+      case FXDC_VERT_SIZE:
+        return 0;
+      case FXDC_RENDER_CAPS:
+        // GetDIBits() only hands out a transparent backdrop, but claiming
+        // FXRC_GET_BITS keeps the renderer from drawing objects into
+        // offscreen buffers at the device resolution.
+        return FXRC_GET_BITS | FXRC_ALPHA_PATH | FXRC_ALPHA_IMAGE |
+               FXRC_ALPHA_OUTPUT | FXRC_BLEND_MODE | FXRC_DISPLAY_LIST;
+      default:
+        NOTREACHED();
+    }
+  }
+
+  void SaveState() override {
+    clip_box_stack_.push_back(clip_box_);
+    list_->Append(CFX_DisplayList::SaveOp());
+  }
+
+  void RestoreState(bool bKeepSaved) override {
+    list_->Append(CFX_DisplayList::RestoreOp{bKeepSaved});
+    if (clip_box_stack_.empty()) {
+      return;
+    }
+
+    clip_box_ = clip_box_stack_.back();
+    if (!bKeepSaved) {
+      clip_box_stack_.pop_back();
+    }
+  }
+
+  bool SetClip_PathFill(const CFX_Path& path,
+                        const CFX_Matrix* pObject2Device,
+                        const CFX_FillRenderOptions& fill_options) override {
+    CFX_Matrix matrix = pObject2Device ? *pObject2Device : CFX_Matrix();
+    IntersectClipBox(matrix.TransformRect(path.GetBoundingBox()));
+    list_->Append(CFX_DisplayList::ClipPathFillOp{path, matrix, fill_options});
+    return true;
+  }
+
+  bool SetClip_PathStroke(const CFX_Path& path,
+                          const CFX_Matrix* pObject2Device,
+                          const CFX_GraphStateData* pGraphState) override {
+    CFX_Matrix matrix = pObject2Device ? *pObject2Device : CFX_Matrix();
+    CFX_GraphStateData graph_state =
+        pGraphState ? *pGraphState : CFX_GraphStateData();
+    IntersectClipBox(matrix.TransformRect(path.GetBoundingBoxForStrokePath(
+        graph_state.line_width(), graph_state.miter_limit())));
+    list_->Append(CFX_DisplayList::ClipPathStrokeOp{path, matrix,
+                                                    std::move(graph_state)});
+    return true;
+  }
+
+  bool DrawPath(const CFX_Path& path,
+                const CFX_Matrix* pObject2Device,
+                const CFX_GraphStateData* pGraphState,
+                uint32_t fill_color,
+                uint32_t stroke_color,
+                const CFX_FillRenderOptions& fill_options) override {
+    list_->Append(CFX_DisplayList::PathOp{
+        path, pObject2Device ? *pObject2Device : CFX_Matrix(),
+        pGraphState ? std::make_optional(*pGraphState) : std::nullopt,
+        fill_color, stroke_color, fill_options});
+    return true;
+  }
+
+  bool FillRect(const FX_RECT& rect, uint32_t fill_color) override {
+    CFX_Path path;
+    path.AppendRect(rect.left, rect.bottom, rect.right, rect.top);
+    return DrawPath(path, nullptr, nullptr, fill_color, 0,
+                    CFX_FillRenderOptions::WindingOptions());
+  }
+
+  FX_RECT GetClipBox() const override { return clip_box_; }
+
+  bool GetDIBits(RetainPtr<CFX_DIBitmap> bitmap,
+                 int left,
+                 int top) const override {
+    // What lies underneath is only known at replay time.
+    bitmap->Clear(0);
+    return true;
+  }
+
+  bool SetDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                 uint32_t color,
+                 const FX_RECT& src_rect,
+                 int dest_left,
+                 int dest_top,
+                 BlendMode blend_type) override {
+    RetainPtr<const CFX_DIBBase> source;
+    if (src_rect == FX_RECT(0, 0, bitmap->GetWidth(), bitmap->GetHeight())) {
+      source = Realize(std::move(bitmap));
+    } else {
+      source = bitmap->ClipTo(src_rect);
+    }
+    if (!source) {
+      return false;
+    }
+    AppendImage(std::move(source), /*alpha=*/1.0f, color,
+                CFX_RenderDevice::GetFlipMatrix(src_rect.Width(),
+                                                src_rect.Height(), dest_left,
+                                                dest_top),
+                FXDIB_ResampleOptions(), blend_type);
+    return true;
+  }
+
+  bool StretchDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                     uint32_t color,
+                     int dest_left,
+                     int dest_top,
+                     int dest_width,
+                     int dest_height,
+                     const FX_RECT* pClipRect,
+                     const FXDIB_ResampleOptions& options,
+                     BlendMode blend_type) override {
+    RetainPtr<const CFX_DIBBase> source = Realize(std::move(bitmap));
+    if (!source) {
+      return false;
+    }
+    FX_RECT dest_rect(dest_left, dest_top, dest_left + dest_width,
+                      dest_top + dest_height);
+    dest_rect.Normalize();
+    FX_RECT clipped_rect = dest_rect;
+    if (pClipRect) {
+      clipped_rect.Intersect(*pClipRect);
+    }
+    const bool needs_clip = clipped_rect != dest_rect;
+    if (needs_clip) {
+      SaveState();
+      CFX_Path path;
+      path.AppendRect(clipped_rect.left, clipped_rect.bottom,
+                      clipped_rect.right, clipped_rect.top);
+      SetClip_PathFill(path, nullptr, CFX_FillRenderOptions::WindingOptions());
+    }
+    AppendImage(std::move(source), /*alpha=*/1.0f, color,
+                CFX_RenderDevice::GetFlipMatrix(dest_width, dest_height,
+                                                dest_left, dest_top),
+                options, blend_type);
+    if (needs_clip) {
+      RestoreState(/*bKeepSaved=*/false);
+    }
+    return true;
+  }
+
+  StartResult StartDIBits(RetainPtr<const CFX_DIBBase> bitmap,
+                          float alpha,
+                          uint32_t color,
+                          const CFX_Matrix& matrix,
+                          const FXDIB_ResampleOptions& options,
+                          BlendMode blend_type) override {
+    RetainPtr<const CFX_DIBBase> source = Realize(std::move(bitmap));
+    if (!source) {
+      return {Result::kFailure, nullptr};
+    }
+    AppendImage(std::move(source), alpha, color, matrix, options, blend_type);
+    return {Result::kSuccess, nullptr};
+  }
+
+  bool DrawDeviceText(pdfium::span<const TextCharPos> pCharPos,
+                      CFX_Font* font,
+                      const CFX_Matrix& mtObject2Device,
+                      float font_size,
+                      uint32_t color,
+                      const CFX_TextRenderOptions& options) override {
+    // CFX_RenderDevice records text in fonts without an owner as paths.
+    CHECK(font->GetOwner());
+    list_->Append(CFX_DisplayList::TextOp{
+        std::vector<TextCharPos>(pCharPos.begin(), pCharPos.end()),
+        RetainPtr<Retainable>(font->GetOwner()), UnownedPtr<CFX_Font>(font),
+        font_size, mtObject2Device, color, options});
+    return true;
+  }
+
+  bool MultiplyAlpha(float alpha) override {
+    // Only called on bitmap devices.
+    NOTREACHED();
+  }
+
+  bool MultiplyAlphaMask(RetainPtr<const CFX_DIBitmap> mask) override {
+    // Only called on bitmap devices.
+    NOTREACHED();
+  }
+
+ private:
+  void IntersectClipBox(const CFX_FloatRect& rect) {
+    clip_box_.Intersect(rect.GetOuterRect());
+  }
+
+  void AppendImage(RetainPtr<const CFX_DIBBase> bitmap,
+                   float alpha,
+                   uint32_t color,
+                   const CFX_Matrix& matrix,
+                   const FXDIB_ResampleOptions& options,
+                   BlendMode blend_type) {
+    list_->Append(CFX_DisplayList::ImageOp{std::move(bitmap), alpha, color,
+                                           matrix, options, blend_type});
+  }
+
+  const int width_;
+  const int height_;
+  FX_RECT clip_box_;
+  std::vector<FX_RECT> clip_box_stack_;
+  std::unique_ptr<CFX_DisplayList> list_;
+};
+
+}  // namespace
+
+CFX_DisplayListDevice::CFX_DisplayListDevice(int width, int height) {
+  SetDeviceDriver(std::make_unique<DisplayListDriver>(width, height));
+}
+
+CFX_DisplayListDevice::~CFX_DisplayListDevice() = default;
+
+std::unique_ptr<CFX_DisplayList> CFX_DisplayListDevice::TakeDisplayList() {
+  return static_cast<DisplayListDriver*>(GetDeviceDriver())->TakeDisplayList();
+}
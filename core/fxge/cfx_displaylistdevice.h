@@ -0,0 +1,27 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_DISPLAYLISTDEVICE_H_
+#define CORE_FXGE_CFX_DISPLAYLISTDEVICE_H_
+
+#include <memory>
+
+#include "core/fxge/cfx_renderdevice.h"
+
+class CFX_DisplayList;
+
+// A device that records what is drawn on it into a CFX_DisplayList, instead of
+// rasterizing it. Paths, text and images keep their own transforms, but
+// content that the renderer composites offscreen, like soft masks and
+// transparency groups, is recorded as bitmaps at the device resolution.
+class CFX_DisplayListDevice final : public CFX_RenderDevice {
+ public:
+  CFX_DisplayListDevice(int width, int height);
+  ~CFX_DisplayListDevice() override;
+
+  // Returns what has been drawn so far, and starts a new list.
+  std::unique_ptr<CFX_DisplayList> TakeDisplayList();
+};
+
+#endif  // CORE_FXGE_CFX_DISPLAYLISTDEVICE_H_
@@ -431,12 +431,13 @@ int CFX_Face::GetGlyphCount() const {
   return pdfium::checked_cast<int>(GetRec()->num_glyphs);
 }
 
-std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* font,
-                                                       uint32_t glyph_index,
-                                                       bool bFontStyle,
-                                                       const CFX_Matrix& matrix,
-                                                       int dest_width,
-                                                       int anti_alias) {
+RetainPtr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* font,
+                                                 uint32_t glyph_index,
+                                                 bool bFontStyle,
+                                                 const CFX_Matrix& matrix,
+                                                 int dest_width,
+                                                 int anti_alias,
+                                                 int x_subpixel) {
   FT_Matrix ft_matrix;
   ft_matrix.xx = matrix.a / 64 * 65536;
   ft_matrix.xy = matrix.c / 64 * 65536;
@@ -508,6 +509,11 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* font,
             36655;
     FT_Outline_Embolden(&glyph->outline, level.ValueOrDefault(0));
   }
+  if (x_subpixel && glyph->format == FT_GLYPH_FORMAT_OUTLINE) {
+    // The outline is in 26.6 fixed point.
+    FT_Outline_Translate(&glyph->outline,
+                         x_subpixel * 64 / CFX_Font::kSubpixelPositions, 0);
+  }
   FT_Library_SetLcdFilter(CFX_GEModule::Get()->GetFontMgr()->GetFTLibrary(),
                           FT_LCD_FILTER_DEFAULT);
   error = FT_Render_Glyph(glyph, static_cast<FT_Render_Mode>(anti_alias));
@@ -520,8 +526,8 @@ std::unique_ptr<CFX_GlyphBitmap> CFX_Face::RenderGlyph(const CFX_Font* font,
     return nullptr;
   }
   int dib_width = bitmap.width;
-  auto pGlyphBitmap =
-      std::make_unique<CFX_GlyphBitmap>(glyph->bitmap_left, glyph->bitmap_top);
+  auto pGlyphBitmap = pdfium::MakeRetain<CFX_GlyphBitmap>(glyph->bitmap_left,
+                                                          glyph->bitmap_top);
   const FXDIB_Format format = anti_alias == FT_RENDER_MODE_MONO
                                   ? FXDIB_Format::k1bppMask
                                   : FXDIB_Format::k8bppMask;
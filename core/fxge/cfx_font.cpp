@@ -489,16 +489,17 @@ std::unique_ptr<CFX_Path> CFX_Font::LoadGlyphPathImpl(uint32_t glyph_index,
                               subst_font_.get());
 }
 
-const CFX_GlyphBitmap* CFX_Font::LoadGlyphBitmap(
+RetainPtr<const CFX_GlyphBitmap> CFX_Font::LoadGlyphBitmap(
     uint32_t glyph_index,
     bool bFontStyle,
     const CFX_Matrix& matrix,
     int dest_width,
     int anti_alias,
+    int x_subpixel,
     CFX_TextRenderOptions* text_options) const {
-  return GetOrCreateGlyphCache()->LoadGlyphBitmap(this, glyph_index, bFontStyle,
-                                                  matrix, dest_width,
-                                                  anti_alias, text_options);
+  return GetOrCreateGlyphCache()->LoadGlyphBitmap(
+      this, glyph_index, bFontStyle, matrix, dest_width, anti_alias, x_subpixel,
+      text_options);
 }
 
 const CFX_Path* CFX_Font::LoadGlyphPath(uint32_t glyph_index,
@@ -506,6 +507,12 @@ const CFX_Path* CFX_Font::LoadGlyphPath(uint32_t glyph_index,
   return GetOrCreateGlyphCache()->LoadGlyphPath(this, glyph_index, dest_width);
 }
 
+const CFX_Path* CFX_Font::LoadPinnedGlyphPath(uint32_t glyph_index,
+                                              int dest_width) const {
+  return GetOrCreateGlyphCache()->LoadPinnedGlyphPath(this, glyph_index,
+                                                      dest_width);
+}
+
 #if defined(PDF_USE_SKIA)
 CFX_TypeFace* CFX_Font::GetDeviceCache() const {
   return GetOrCreateGlyphCache()->GetDeviceCache(this);
@@ -20,6 +20,7 @@
 #include "core/fxcrt/raw_span.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "core/fxcrt/span.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxcrt/unowned_ptr_exclusion.h"
 #include "core/fxge/cfx_face.h"
 #include "core/fxge/freetype/fx_freetype.h"
@@ -54,6 +55,10 @@ class CFX_Font {
   static const char kDefaultAnsiFontName[];
   static const char kUniversalDefaultFontName[];
 
+  // How many horizontal offsets within a pixel glyph bitmaps can be rendered
+  // at, for subpixel positioned text.
+  static constexpr int kSubpixelPositions = 4;
+
   static pdfium::span<const CharsetFontMap> GetDefaultTTFMapSpan();
   static ByteString GetDefaultFontNameByCharset(FX_Charset nCharset);
   static FX_Charset GetCharSetFromUnicode(uint16_t word);
@@ -77,6 +82,11 @@ class CFX_Font {
   CFX_SubstFont* GetSubstFont() const { return subst_font_.get(); }
   int GetSubstFontItalicAngle() const;
 
+  // The object that owns this font, if any. Retaining it keeps the font
+  // alive, for users that hold on to the font past the current call.
+  Retainable* GetOwner() const { return owner_; }
+  void SetOwner(Retainable* owner) { owner_ = owner; }
+
 #if defined(PDF_ENABLE_XFA)
   bool LoadFile(RetainPtr<IFX_SeekableReadStream> pFile, int nFaceIndex);
 
@@ -87,14 +97,19 @@ class CFX_Font {
 #endif  // !BUILDFLAG(IS_WIN)
 #endif  // defined(PDF_ENABLE_XFA)
 
-  const CFX_GlyphBitmap* LoadGlyphBitmap(
+  // `x_subpixel`, from 0 to kSubpixelPositions - 1, shifts the glyph right by
+  // that many fractions of a pixel. Native glyphs ignore it.
+  RetainPtr<const CFX_GlyphBitmap> LoadGlyphBitmap(
       uint32_t glyph_index,
       bool bFontStyle,
       const CFX_Matrix& matrix,
       int dest_width,
       int anti_alias,
+      int x_subpixel,
       CFX_TextRenderOptions* text_options) const;
   const CFX_Path* LoadGlyphPath(uint32_t glyph_index, int dest_width) const;
+  const CFX_Path* LoadPinnedGlyphPath(uint32_t glyph_index,
+                                      int dest_width) const;
   int GetGlyphWidth(uint32_t glyph_index) const;
   int GetGlyphWidth(uint32_t glyph_index, int dest_width, int weight) const;
   int GetAscent() const;
@@ -152,6 +167,7 @@ class CFX_Font {
   std::unique_ptr<CFX_SubstFont> subst_font_;
   DataVector<uint8_t> font_data_allocation_;
   pdfium::raw_span<uint8_t> font_data_;
+  UnownedPtr<Retainable> owner_;
   FontType font_type_ = FontType::kUnknown;
   uint64_t object_tag_ = 0;
   bool vertical_ = false;
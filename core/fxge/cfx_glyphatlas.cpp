@@ -0,0 +1,60 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphatlas.h"
+
+#include <algorithm>
+
+#include "core/fxcrt/span.h"
+#include "core/fxcrt/stl_util.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+
+// static
+bool CFX_GlyphAtlas::CanHold(const CFX_GlyphBitmap& glyph) {
+  const RetainPtr<CFX_DIBitmap>& bitmap = glyph.GetBitmap();
+  return bitmap->GetFormat() == FXDIB_Format::k8bppMask &&
+         !bitmap->GetBuffer().empty() && bitmap->GetWidth() <= kMaxGlyphSize &&
+         bitmap->GetHeight() <= kMaxGlyphSize;
+}
+
+CFX_GlyphAtlas::CFX_GlyphAtlas() : texture_(kTextureBytes) {}
+
+CFX_GlyphAtlas::~CFX_GlyphAtlas() = default;
+
+RetainPtr<CFX_GlyphBitmap> CFX_GlyphAtlas::Add(const CFX_GlyphBitmap& glyph) {
+  if (!CanHold(glyph)) {
+    return nullptr;
+  }
+
+  const RetainPtr<CFX_DIBitmap>& src = glyph.GetBitmap();
+  const int width = src->GetWidth();
+  const int height = src->GetHeight();
+  if (shelf_used_width_ + width > kSize) {
+    shelf_top_ += shelf_height_;
+    shelf_height_ = 0;
+    shelf_used_width_ = 0;
+  }
+  if (shelf_top_ + height > kSize) {
+    return nullptr;
+  }
+
+  const size_t offset =
+      static_cast<size_t>(shelf_top_) * kSize + shelf_used_width_;
+  pdfium::span<uint8_t> dest = pdfium::span(texture_).subspan(offset);
+  for (int row = 0; row < height; ++row) {
+    fxcrt::Copy(src->GetScanline(row).first(static_cast<size_t>(width)),
+                dest.subspan(static_cast<size_t>(row) * kSize));
+  }
+  shelf_used_width_ += width;
+  shelf_height_ = std::max(shelf_height_, height);
+
+  auto packed = pdfium::MakeRetain<CFX_GlyphBitmap>(
+      glyph.left(), glyph.top(), pdfium::WrapRetain(this));
+  if (!packed->GetBitmap()->Create(width, height, FXDIB_Format::k8bppMask,
+                                   dest.data(), kSize)) {
+    return nullptr;
+  }
+  return packed;
+}
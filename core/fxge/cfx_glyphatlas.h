@@ -0,0 +1,49 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_CFX_GLYPHATLAS_H_
+#define CORE_FXGE_CFX_GLYPHATLAS_H_
+
+#include <stdint.h>
+
+#include <stddef.h>
+
+#include "core/fxcrt/data_vector.h"
+#include "core/fxcrt/retain_ptr.h"
+
+class CFX_GlyphBitmap;
+
+// Packs the 8bpp glyph bitmaps of one font size into one texture, row by row,
+// so that the glyphs of a text run sit close together in memory. Each glyph
+// added comes back as a CFX_GlyphBitmap that points into the texture and
+// keeps the atlas alive.
+class CFX_GlyphAtlas final : public Retainable {
+ public:
+  CONSTRUCT_VIA_MAKE_RETAIN;
+
+  static constexpr int kSize = 256;
+  // `kSize` rows, plus a spare one, as the CFX_DIBitmap buffer of a glyph on
+  // the bottom shelf spans up to a row past the texture.
+  static constexpr size_t kTextureBytes = (kSize + 1) * kSize;
+  // Larger glyphs would fill an atlas too quickly to be worth packing.
+  static constexpr int kMaxGlyphSize = 64;
+
+  // Whether Add() can take `glyph` if the atlas has room.
+  static bool CanHold(const CFX_GlyphBitmap& glyph);
+
+  // Returns a copy of `glyph` in the atlas, or nullptr if CanHold() is false,
+  // or if the atlas is full.
+  RetainPtr<CFX_GlyphBitmap> Add(const CFX_GlyphBitmap& glyph);
+
+ private:
+  CFX_GlyphAtlas();
+  ~CFX_GlyphAtlas() override;
+
+  DataVector<uint8_t> texture_;
+  int shelf_top_ = 0;
+  int shelf_height_ = 0;
+  int shelf_used_width_ = 0;
+};
+
+#endif  // CORE_FXGE_CFX_GLYPHATLAS_H_
@@ -0,0 +1,129 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/cfx_glyphatlas.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/span.h"
+#include "core/fxge/cfx_glyphbitmap.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+RetainPtr<CFX_GlyphBitmap> MakeGlyph(int width,
+                                     int height,
+                                     FXDIB_Format format,
+                                     uint8_t seed) {
+  auto glyph = pdfium::MakeRetain<CFX_GlyphBitmap>(width, -height);
+  if (!glyph->GetBitmap()->Create(width, height, format)) {
+    return nullptr;
+  }
+  for (int row = 0; row < height; ++row) {
+    uint8_t value = seed + row;
+    for (uint8_t& byte : glyph->GetBitmap()->GetWritableScanline(row)) {
+      byte = value++;
+    }
+  }
+  return glyph;
+}
+
+void ExpectSamePixels(const CFX_GlyphBitmap& expected,
+                      const CFX_GlyphBitmap& actual) {
+  EXPECT_EQ(expected.left(), actual.left());
+  EXPECT_EQ(expected.top(), actual.top());
+  const RetainPtr<CFX_DIBitmap>& expected_bitmap = expected.GetBitmap();
+  const RetainPtr<CFX_DIBitmap>& actual_bitmap = actual.GetBitmap();
+  ASSERT_EQ(expected_bitmap->GetWidth(), actual_bitmap->GetWidth());
+  ASSERT_EQ(expected_bitmap->GetHeight(), actual_bitmap->GetHeight());
+  EXPECT_EQ(FXDIB_Format::k8bppMask, actual_bitmap->GetFormat());
+  const size_t width = expected_bitmap->GetWidth();
+  for (int row = 0; row < expected_bitmap->GetHeight(); ++row) {
+    pdfium::span<const uint8_t> expected_row =
+        expected_bitmap->GetScanline(row).first(width);
+    pdfium::span<const uint8_t> actual_row =
+        actual_bitmap->GetScanline(row).first(width);
+    EXPECT_EQ(std::vector<uint8_t>(expected_row.begin(), expected_row.end()),
+              std::vector<uint8_t>(actual_row.begin(), actual_row.end()));
+  }
+}
+
+}  // namespace
+
+TEST(CFXGlyphAtlas, PacksGlyphsSideBySide) {
+  auto atlas = pdfium::MakeRetain<CFX_GlyphAtlas>();
+  RetainPtr<CFX_GlyphBitmap> first =
+      MakeGlyph(10, 12, FXDIB_Format::k8bppMask, 1);
+  RetainPtr<CFX_GlyphBitmap> second =
+      MakeGlyph(7, 20, FXDIB_Format::k8bppMask, 100);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+
+  RetainPtr<CFX_GlyphBitmap> packed_first = atlas->Add(*first);
+  RetainPtr<CFX_GlyphBitmap> packed_second = atlas->Add(*second);
+  ASSERT_TRUE(packed_first);
+  ASSERT_TRUE(packed_second);
+  ExpectSamePixels(*first, *packed_first);
+  ExpectSamePixels(*second, *packed_second);
+
+  // Both share the atlas texture, one after the other.
+  EXPECT_EQ(CFX_GlyphAtlas::kSize,
+            static_cast<int>(packed_first->GetBitmap()->GetPitch()));
+  EXPECT_EQ(packed_first->GetBitmap()->GetBuffer().data() + 10,
+            packed_second->GetBitmap()->GetBuffer().data());
+}
+
+TEST(CFXGlyphAtlas, RejectsUnsuitableGlyphs) {
+  auto atlas = pdfium::MakeRetain<CFX_GlyphAtlas>();
+  RetainPtr<CFX_GlyphBitmap> mono =
+      MakeGlyph(10, 10, FXDIB_Format::k1bppMask, 0);
+  ASSERT_TRUE(mono);
+  EXPECT_FALSE(CFX_GlyphAtlas::CanHold(*mono));
+  EXPECT_FALSE(atlas->Add(*mono));
+
+  RetainPtr<CFX_GlyphBitmap> large = MakeGlyph(
+      CFX_GlyphAtlas::kMaxGlyphSize + 1, 10, FXDIB_Format::k8bppMask, 0);
+  ASSERT_TRUE(large);
+  EXPECT_FALSE(CFX_GlyphAtlas::CanHold(*large));
+  EXPECT_FALSE(atlas->Add(*large));
+
+  auto empty = pdfium::MakeRetain<CFX_GlyphBitmap>(0, 0);
+  EXPECT_FALSE(CFX_GlyphAtlas::CanHold(*empty));
+}
+
+TEST(CFXGlyphAtlas, FillsUp) {
+  constexpr int kGlyphSize = CFX_GlyphAtlas::kMaxGlyphSize;
+  constexpr int kGlyphsPerRow = CFX_GlyphAtlas::kSize / kGlyphSize;
+  auto atlas = pdfium::MakeRetain<CFX_GlyphAtlas>();
+  RetainPtr<CFX_GlyphBitmap> glyph =
+      MakeGlyph(kGlyphSize, kGlyphSize, FXDIB_Format::k8bppMask, 7);
+  ASSERT_TRUE(glyph);
+  RetainPtr<CFX_GlyphBitmap> last;
+  for (int i = 0; i < kGlyphsPerRow * kGlyphsPerRow; ++i) {
+    last = atlas->Add(*glyph);
+    ASSERT_TRUE(last);
+  }
+  EXPECT_FALSE(atlas->Add(*glyph));
+
+  // The bottom right glyph reads its last row right up to the spare row.
+  ExpectSamePixels(*glyph, *last);
+}
+
+TEST(CFXGlyphAtlas, GlyphsKeepAtlasAlive) {
+  RetainPtr<CFX_GlyphBitmap> glyph =
+      MakeGlyph(5, 6, FXDIB_Format::k8bppMask, 42);
+  ASSERT_TRUE(glyph);
+  RetainPtr<CFX_GlyphBitmap> packed;
+  {
+    auto atlas = pdfium::MakeRetain<CFX_GlyphAtlas>();
+    packed = atlas->Add(*glyph);
+  }
+  ASSERT_TRUE(packed);
+  ExpectSamePixels(*glyph, *packed);
+}
@@ -4,9 +4,20 @@
 
 #include "core/fxge/cfx_glyphbitmap.h"
 
+#include <utility>
+
+#include "core/fxge/cfx_glyphatlas.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 
 CFX_GlyphBitmap::CFX_GlyphBitmap(int left, int top)
-    : left_(left), top_(top), bitmap_(pdfium::MakeRetain<CFX_DIBitmap>()) {}
+    : CFX_GlyphBitmap(left, top, nullptr) {}
+
+CFX_GlyphBitmap::CFX_GlyphBitmap(int left,
+                                 int top,
+                                 RetainPtr<CFX_GlyphAtlas> atlas)
+    : left_(left),
+      top_(top),
+      atlas_(std::move(atlas)),
+      bitmap_(pdfium::MakeRetain<CFX_DIBitmap>()) {}
 
 CFX_GlyphBitmap::~CFX_GlyphBitmap() = default;
@@ -10,11 +10,13 @@
 #include "core/fxcrt/retain_ptr.h"
 
 class CFX_DIBitmap;
+class CFX_GlyphAtlas;
 
-class CFX_GlyphBitmap {
+// Retained, so that a glyph stays alive while it is drawn, even if the cache
+// it came from evicts it meanwhile.
+class CFX_GlyphBitmap final : public Retainable {
  public:
-  CFX_GlyphBitmap(int left, int top);
-  ~CFX_GlyphBitmap();
+  CONSTRUCT_VIA_MAKE_RETAIN;
 
   CFX_GlyphBitmap(const CFX_GlyphBitmap&) = delete;
   CFX_GlyphBitmap& operator=(const CFX_GlyphBitmap&) = delete;
@@ -24,8 +26,14 @@ class CFX_GlyphBitmap {
   int top() const { return top_; }
 
  private:
+  CFX_GlyphBitmap(int left, int top);
+  // For a bitmap that points into `atlas`.
+  CFX_GlyphBitmap(int left, int top, RetainPtr<CFX_GlyphAtlas> atlas);
+  ~CFX_GlyphBitmap() override;
+
   const int left_;
   const int top_;
+  RetainPtr<CFX_GlyphAtlas> const atlas_;
   RetainPtr<CFX_DIBitmap> bitmap_;
 };
 
@@ -8,17 +8,19 @@
 
 #include <initializer_list>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "build/build_config.h"
-#include "core/fxcrt/fx_codepage.h"
-#include "core/fxcrt/fx_memcpy_wrappers.h"
+#include "core/fxcrt/check.h"
 #include "core/fxcrt/span.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_glyphatlas.h"
 #include "core/fxge/cfx_glyphbitmap.h"
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_substfont.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 
 #if defined(PDF_USE_SKIA)
 #include "third_party/skia/include/core/SkFontMgr.h"         // nogncheck
@@ -42,134 +44,311 @@ namespace {
 
 constexpr uint32_t kInvalidGlyphIndex = static_cast<uint32_t>(-1);
 
-class UniqueKeyGen {
- public:
-  UniqueKeyGen(const CFX_Font* font,
-               const CFX_Matrix& matrix,
-               int dest_width,
-               int anti_alias,
-               bool bNative);
+// Rough size of the map and list nodes that hold a cached item, on top of the
+// item itself.
+constexpr size_t kEntryOverheadBytes = 96;
 
-  pdfium::span<const uint8_t> span() const;
+// Guarded by CFX_GlyphCache::GetLock().
+size_t g_byte_limit = CFX_GlyphCache::kDefaultByteLimit;
+CFX_GlyphCache::Stats g_stats;
 
- private:
-  void Initialize(std::initializer_list<const int> args);
+// A glyph in an atlas, whose pixels the atlas accounts for.
+constexpr size_t kAtlasGlyphBytes =
+    kEntryOverheadBytes + sizeof(CFX_GlyphBitmap) + sizeof(CFX_DIBitmap);
 
-  size_t key_len_;
-  uint32_t key_[32];
-};
+size_t GetGlyphBitmapBytes(const CFX_GlyphBitmap* bitmap) {
+  if (!bitmap) {
+    return kEntryOverheadBytes;
+  }
+  const RetainPtr<CFX_DIBitmap>& dib = bitmap->GetBitmap();
+  return kAtlasGlyphBytes +
+         static_cast<size_t>(dib->GetPitch()) * dib->GetHeight();
+}
+
+size_t GetGlyphPathBytes(const CFX_Path* path) {
+  if (!path) {
+    return kEntryOverheadBytes;
+  }
+  return kEntryOverheadBytes + sizeof(CFX_Path) +
+         path->GetPoints().size() * sizeof(CFX_Path::Point);
+}
+
+}  // namespace
 
-void UniqueKeyGen::Initialize(std::initializer_list<const int32_t> args) {
-  auto key_span = pdfium::span<uint32_t, pdfium::dynamic_extent>(key_);
-  for (const auto& arg : args) {
-    key_span.front() = arg;
-    key_span = key_span.subspan<1u>();
+size_t CFX_GlyphCache::BitmapKeyHash::operator()(const BitmapKey& key) const {
+  size_t hash = key.glyph_index;
+  for (int32_t value : {key.matrix[0], key.matrix[1], key.matrix[2],
+                        key.matrix[3], key.dest_width, key.anti_alias,
+                        key.x_subpixel, key.weight, key.italic_angle}) {
+    hash = hash * 31 + static_cast<uint32_t>(value);
   }
-  key_len_ = args.size();
+  return hash * 8 + (key.has_subst_font ? 4 : 0) + (key.vertical ? 2 : 0) +
+         (key.native ? 1 : 0);
 }
 
-pdfium::span<const uint8_t> UniqueKeyGen::span() const {
-  return pdfium::as_bytes(pdfium::span(key_).first(key_len_));
+// static
+void CFX_GlyphCache::SetByteLimit(size_t byte_limit) {
+  std::lock_guard<std::mutex> guard(GetLock());
+  g_byte_limit = byte_limit;
+  ShrinkTo(g_byte_limit);
 }
 
-UniqueKeyGen::UniqueKeyGen(const CFX_Font* font,
-                           const CFX_Matrix& matrix,
-                           int dest_width,
-                           int anti_alias,
-                           bool bNative) {
-  int nMatrixA = static_cast<int>(matrix.a * 10000);
-  int nMatrixB = static_cast<int>(matrix.b * 10000);
-  int nMatrixC = static_cast<int>(matrix.c * 10000);
-  int nMatrixD = static_cast<int>(matrix.d * 10000);
+// static
+CFX_GlyphCache::Stats CFX_GlyphCache::GetStats() {
+  std::lock_guard<std::mutex> guard(GetLock());
+  Stats stats = g_stats;
+  stats.byte_limit = g_byte_limit;
+  return stats;
+}
 
-#if BUILDFLAG(IS_APPLE)
-  if (bNative) {
-    if (font->GetSubstFont()) {
-      Initialize({nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                  anti_alias, font->GetSubstFont()->weight_,
-                  font->GetSubstFont()->italic_angle_, font->IsVertical(), 3});
-    } else {
-      Initialize(
-          {nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width, anti_alias, 3});
-    }
-    return;
+// static
+std::mutex& CFX_GlyphCache::GetLock() {
+  static std::mutex* lock = new std::mutex();
+  return *lock;
+}
+
+// static
+CFX_GlyphCache::LruList& CFX_GlyphCache::GetLruList() {
+  static LruList* list = new LruList();
+  return *list;
+}
+
+// static
+void CFX_GlyphCache::MarkUsed(LruList::iterator lru) {
+  LruList& list = GetLruList();
+  list.splice(list.begin(), list, lru);
+}
+
+// static
+void CFX_GlyphCache::ShrinkTo(size_t bytes) {
+  LruList& list = GetLruList();
+  while (g_stats.bytes > bytes && !list.empty()) {
+    const LruEntry& victim = list.back();
+    const LruKey key = victim.key;
+    victim.cache->Evict(key);
+    ++g_stats.evictions;
   }
-#endif
+}
+
+CFX_GlyphCache::LruList::iterator CFX_GlyphCache::AddToLruList(LruKey key,
+                                                               size_t bytes) {
+  ShrinkTo(bytes < g_byte_limit ? g_byte_limit - bytes : 0);
+  LruList& list = GetLruList();
+  list.push_front({UnownedPtr<CFX_GlyphCache>(this), std::move(key), bytes});
+  g_stats.bytes += bytes;
+  return list.begin();
+}
 
-  CHECK(!bNative);
-  if (font->GetSubstFont()) {
-    Initialize({nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width, anti_alias,
-                font->GetSubstFont()->weight_,
-                font->GetSubstFont()->italic_angle_, font->IsVertical()});
+void CFX_GlyphCache::RemoveFromLruList(LruList::iterator lru) {
+  g_stats.bytes -= lru->bytes;
+  GetLruList().erase(lru);
+}
+
+void CFX_GlyphCache::Evict(const LruKey& key) {
+  if (const auto* bitmap_key = std::get_if<BitmapKey>(&key)) {
+    auto it = bitmap_map_.find(*bitmap_key);
+    CHECK(it != bitmap_map_.end());
+    RemoveFromLruList(it->second.lru);
+    bitmap_map_.erase(it);
+  } else if (const auto* path_key = std::get_if<PathMapKey>(&key)) {
+    auto it = path_map_.find(*path_key);
+    CHECK(it != path_map_.end());
+    RemoveFromLruList(it->second.lru);
+    path_map_.erase(it);
+  } else if (const auto* atlas_key = std::get_if<AtlasKey>(&key)) {
+    RemoveAtlas(atlas_key->id);
   } else {
-    Initialize(
-        {nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width, anti_alias});
+    auto it = width_map_.find(std::get<WidthMapKey>(key));
+    CHECK(it != width_map_.end());
+    RemoveFromLruList(it->second.lru);
+    width_map_.erase(it);
   }
 }
 
-}  // namespace
+void CFX_GlyphCache::RemoveAtlas(uint32_t id) {
+  auto it = atlases_.find(id);
+  CHECK(it != atlases_.end());
+  AtlasEntry& entry = it->second;
+  for (const BitmapKey& glyph_key : entry.glyphs) {
+    CHECK(bitmap_map_.erase(glyph_key));
+  }
+  auto map_it = atlas_map_.find(entry.size_key);
+  if (map_it != atlas_map_.end() && map_it->second == id) {
+    atlas_map_.erase(map_it);
+  }
+  RemoveFromLruList(entry.lru);
+  atlases_.erase(it);
+}
+
+// static
+CFX_GlyphCache::PathMapKey CFX_GlyphCache::MakePathKey(const CFX_Font* font,
+                                                       uint32_t glyph_index,
+                                                       int dest_width) {
+  const auto* pSubstFont = font->GetSubstFont();
+  int weight = pSubstFont ? pSubstFont->weight_ : 0;
+  int angle = pSubstFont ? pSubstFont->italic_angle_ : 0;
+  bool vertical = pSubstFont && font->IsVertical();
+  return std::make_tuple(glyph_index, dest_width, weight, angle, vertical);
+}
+
+// static
+CFX_GlyphCache::BitmapKey CFX_GlyphCache::MakeBitmapKey(
+    const CFX_Font* font,
+    uint32_t glyph_index,
+    const CFX_Matrix& matrix,
+    int dest_width,
+    int anti_alias,
+    int x_subpixel,
+    bool bNative) {
+  BitmapKey key = {};
+  key.glyph_index = glyph_index;
+  key.matrix[0] = static_cast<int>(matrix.a * 10000);
+  key.matrix[1] = static_cast<int>(matrix.b * 10000);
+  key.matrix[2] = static_cast<int>(matrix.c * 10000);
+  key.matrix[3] = static_cast<int>(matrix.d * 10000);
+  key.dest_width = dest_width;
+  key.anti_alias = anti_alias;
+  key.x_subpixel = x_subpixel;
+  const CFX_SubstFont* subst_font = font->GetSubstFont();
+  if (subst_font) {
+    key.weight = subst_font->weight_;
+    key.italic_angle = subst_font->italic_angle_;
+    key.has_subst_font = true;
+    key.vertical = font->IsVertical();
+  }
+  key.native = bNative;
+  return key;
+}
 
 CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face)
     : face_(std::move(face)) {}
 
-CFX_GlyphCache::~CFX_GlyphCache() = default;
+CFX_GlyphCache::~CFX_GlyphCache() {
+  std::lock_guard<std::mutex> guard(GetLock());
+  for (const auto& item : pinned_path_map_) {
+    const size_t bytes = GetGlyphPathBytes(item.second.get());
+    g_stats.bytes -= bytes;
+    g_stats.pinned_bytes -= bytes;
+  }
+  g_stats.pinned_paths -= pinned_path_map_.size();
+  // This leaves only the glyphs outside atlases in `bitmap_map_`.
+  while (!atlases_.empty()) {
+    RemoveAtlas(atlases_.begin()->first);
+  }
+  for (auto& item : bitmap_map_) {
+    RemoveFromLruList(item.second.lru);
+  }
+  for (auto& item : path_map_) {
+    RemoveFromLruList(item.second.lru);
+  }
+  for (auto& item : width_map_) {
+    RemoveFromLruList(item.second.lru);
+  }
+}
 
-std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
+RetainPtr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     const CFX_Font* font,
     uint32_t glyph_index,
     bool bFontStyle,
     const CFX_Matrix& matrix,
     int dest_width,
-    int anti_alias) {
+    int anti_alias,
+    int x_subpixel) {
   if (!face_) {
     return nullptr;
   }
 
   return face_->RenderGlyph(font, glyph_index, bFontStyle, matrix, dest_width,
-                            anti_alias);
+                            anti_alias, x_subpixel);
 }
 
 const CFX_Path* CFX_GlyphCache::LoadGlyphPath(const CFX_Font* font,
                                               uint32_t glyph_index,
                                               int dest_width) {
+  std::lock_guard<std::mutex> guard(GetLock());
+  return LoadGlyphPathLocked(font, glyph_index, dest_width);
+}
+
+const CFX_Path* CFX_GlyphCache::LoadGlyphPathLocked(const CFX_Font* font,
+                                                    uint32_t glyph_index,
+                                                    int dest_width) {
   if (!GetFace() || glyph_index == kInvalidGlyphIndex) {
     return nullptr;
   }
 
-  const auto* pSubstFont = font->GetSubstFont();
-  int weight = pSubstFont ? pSubstFont->weight_ : 0;
-  int angle = pSubstFont ? pSubstFont->italic_angle_ : 0;
-  bool vertical = pSubstFont && font->IsVertical();
-  const PathMapKey key =
-      std::make_tuple(glyph_index, dest_width, weight, angle, vertical);
+  const PathMapKey key = MakePathKey(font, glyph_index, dest_width);
+  auto pinned_it = pinned_path_map_.find(key);
+  if (pinned_it != pinned_path_map_.end()) {
+    ++g_stats.hits;
+    return pinned_it->second.get();
+  }
+
   auto it = path_map_.find(key);
   if (it != path_map_.end()) {
-    return it->second.get();
+    ++g_stats.hits;
+    MarkUsed(it->second.lru);
+    return it->second.value.get();
   }
 
-  path_map_[key] = font->LoadGlyphPathImpl(glyph_index, dest_width);
-  return path_map_[key].get();
+  ++g_stats.misses;
+  std::unique_ptr<CFX_Path> path =
+      font->LoadGlyphPathImpl(glyph_index, dest_width);
+  LruList::iterator lru = AddToLruList(key, GetGlyphPathBytes(path.get()));
+  CacheEntry<std::unique_ptr<CFX_Path>>& entry = path_map_[key];
+  entry.value = std::move(path);
+  entry.lru = lru;
+  return entry.value.get();
 }
 
-const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
+const CFX_Path* CFX_GlyphCache::LoadPinnedGlyphPath(const CFX_Font* font,
+                                                    uint32_t glyph_index,
+                                                    int dest_width) {
+  std::lock_guard<std::mutex> guard(GetLock());
+  if (!LoadGlyphPathLocked(font, glyph_index, dest_width)) {
+    return nullptr;
+  }
+
+  const PathMapKey key = MakePathKey(font, glyph_index, dest_width);
+  auto it = path_map_.find(key);
+  if (it == path_map_.end()) {
+    // Already pinned.
+    return pinned_path_map_[key].get();
+  }
+
+  // The path keeps counting towards `g_stats.bytes`, just outside the LRU
+  // list.
+  const size_t bytes = it->second.lru->bytes;
+  RemoveFromLruList(it->second.lru);
+  g_stats.bytes += bytes;
+  g_stats.pinned_bytes += bytes;
+  ++g_stats.pinned_paths;
+  std::unique_ptr<CFX_Path>& path = pinned_path_map_[key];
+  path = std::move(it->second.value);
+  path_map_.erase(it);
+  return path.get();
+}
+
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::LoadGlyphBitmap(
     const CFX_Font* font,
     uint32_t glyph_index,
     bool bFontStyle,
     const CFX_Matrix& matrix,
     int dest_width,
     int anti_alias,
+    int x_subpixel,
     CFX_TextRenderOptions* text_options) {
   if (glyph_index == kInvalidGlyphIndex) {
     return nullptr;
   }
 
+  std::lock_guard<std::mutex> guard(GetLock());
 #if BUILDFLAG(IS_APPLE)
   const bool bNative = text_options->native_text;
 #else
   const bool bNative = false;
 #endif
-  UniqueKeyGen keygen(font, matrix, dest_width, anti_alias, bNative);
-  auto FaceGlyphsKey = ByteString(ByteStringView(keygen.span()));
+  const BitmapKey key = MakeBitmapKey(font, glyph_index, matrix, dest_width,
+                                      anti_alias, x_subpixel, bNative);
 
 #if BUILDFLAG(IS_APPLE)
   const bool bDoLookUp =
@@ -178,48 +357,32 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   const bool bDoLookUp = true;
 #endif
   if (bDoLookUp) {
-    return LookUpGlyphBitmap(font, matrix, FaceGlyphsKey, glyph_index,
-                             bFontStyle, dest_width, anti_alias);
+    return LookUpGlyphBitmap(font, matrix, key, bFontStyle, dest_width,
+                             anti_alias);
   }
 
 #if BUILDFLAG(IS_APPLE)
   DCHECK(!CFX_DefaultRenderDevice::UseSkiaRenderer());
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap;
-  auto it = size_map_.find(FaceGlyphsKey);
-  if (it != size_map_.end()) {
-    SizeGlyphCache* pSizeCache = &(it->second);
-    auto it2 = pSizeCache->find(glyph_index);
-    if (it2 != pSizeCache->end()) {
-      return it2->second.get();
-    }
-
-    pGlyphBitmap = RenderGlyph_Nativetext(font, glyph_index, matrix, dest_width,
-                                          anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-      return pResult;
-    }
-  } else {
-    pGlyphBitmap = RenderGlyph_Nativetext(font, glyph_index, matrix, dest_width,
-                                          anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-
-      SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
+  auto it = bitmap_map_.find(key);
+  if (it != bitmap_map_.end()) {
+    ++g_stats.hits;
+    MarkUsed(it->second.lru);
+    return it->second.value;
+  }
 
-      size_map_[FaceGlyphsKey] = std::move(cache);
-      return pResult;
-    }
+  RetainPtr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph_Nativetext(
+      font, glyph_index, matrix, dest_width, anti_alias);
+  if (pGlyphBitmap) {
+    ++g_stats.misses;
+    return AddGlyphBitmap(key, std::move(pGlyphBitmap));
   }
-  UniqueKeyGen keygen2(font, matrix, dest_width, anti_alias,
-                       /*bNative=*/false);
-  auto FaceGlyphsKey2 = ByteString(ByteStringView(keygen2.span()));
   text_options->native_text = false;
-  return LookUpGlyphBitmap(font, matrix, FaceGlyphsKey2, glyph_index,
-                           bFontStyle, dest_width, anti_alias);
+  return LookUpGlyphBitmap(
+      font, matrix,
+      MakeBitmapKey(font, glyph_index, matrix, dest_width, anti_alias,
+                    x_subpixel, /*bNative=*/false),
+      bFontStyle, dest_width, anti_alias);
 #endif  // BUILDFLAG(IS_APPLE)
 }
 
@@ -227,14 +390,20 @@ int CFX_GlyphCache::GetGlyphWidth(const CFX_Font* font,
                                   uint32_t glyph_index,
                                   int dest_width,
                                   int weight) {
+  std::lock_guard<std::mutex> guard(GetLock());
   const WidthMapKey key = std::make_tuple(glyph_index, dest_width, weight);
   auto it = width_map_.find(key);
   if (it != width_map_.end()) {
-    return it->second;
+    ++g_stats.hits;
+    MarkUsed(it->second.lru);
+    return it->second.value;
   }
 
-  width_map_[key] = font->GetGlyphWidthImpl(glyph_index, dest_width, weight);
-  return width_map_[key];
+  ++g_stats.misses;
+  const int width = font->GetGlyphWidthImpl(glyph_index, dest_width, weight);
+  LruList::iterator lru = AddToLruList(key, kEntryOverheadBytes);
+  width_map_[key] = {width, lru};
+  return width;
 }
 
 #if defined(PDF_USE_SKIA)
@@ -284,31 +453,82 @@ CFX_TypeFace* CFX_GlyphCache::GetDeviceCache(const CFX_Font* font) {
 }
 #endif  // defined(PDF_USE_SKIA)
 
-CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::LookUpGlyphBitmap(
     const CFX_Font* font,
     const CFX_Matrix& matrix,
-    const ByteString& FaceGlyphsKey,
-    uint32_t glyph_index,
+    const BitmapKey& key,
     bool bFontStyle,
     int dest_width,
     int anti_alias) {
-  SizeGlyphCache* pSizeCache;
-  auto it = size_map_.find(FaceGlyphsKey);
-  if (it == size_map_.end()) {
-    size_map_[FaceGlyphsKey] = SizeGlyphCache();
-    pSizeCache = &(size_map_[FaceGlyphsKey]);
-  } else {
-    pSizeCache = &(it->second);
+  auto it = bitmap_map_.find(key);
+  if (it != bitmap_map_.end()) {
+    ++g_stats.hits;
+    MarkUsed(it->second.lru);
+    return it->second.value;
+  }
+
+  ++g_stats.misses;
+  RetainPtr<CFX_GlyphBitmap> bitmap =
+      RenderGlyph(font, key.glyph_index, bFontStyle, matrix, dest_width,
+                  anti_alias, key.x_subpixel);
+  RetainPtr<const CFX_GlyphBitmap> packed = AddGlyphBitmapToAtlas(key, bitmap);
+  if (packed) {
+    return packed;
   }
+  return AddGlyphBitmap(key, std::move(bitmap));
+}
+
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::AddGlyphBitmap(
+    const BitmapKey& key,
+    RetainPtr<CFX_GlyphBitmap> bitmap) {
+  LruList::iterator lru = AddToLruList(key, GetGlyphBitmapBytes(bitmap.Get()));
+  bitmap_map_[key] = {bitmap, lru};
+  return bitmap;
+}
 
-  auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end()) {
-    return it2->second.get();
+RetainPtr<const CFX_GlyphBitmap> CFX_GlyphCache::AddGlyphBitmapToAtlas(
+    const BitmapKey& key,
+    const RetainPtr<CFX_GlyphBitmap>& bitmap) {
+  if (!bitmap || !CFX_GlyphAtlas::CanHold(*bitmap)) {
+    return nullptr;
+  }
+
+  BitmapKey size_key = key;
+  size_key.glyph_index = 0;
+  size_key.x_subpixel = 0;
+  AtlasEntry* entry = nullptr;
+  RetainPtr<CFX_GlyphBitmap> packed;
+  auto map_it = atlas_map_.find(size_key);
+  if (map_it != atlas_map_.end()) {
+    auto atlas_it = atlases_.find(map_it->second);
+    CHECK(atlas_it != atlases_.end());
+    entry = &atlas_it->second;
+    packed = entry->atlas->Add(*bitmap);
+  }
+  if (!packed) {
+    // The atlas is full. Start a new one, and charge it to the budget as a
+    // whole.
+    auto atlas = pdfium::MakeRetain<CFX_GlyphAtlas>();
+    packed = atlas->Add(*bitmap);
+    if (!packed) {
+      return nullptr;
+    }
+    const uint32_t id = next_atlas_id_++;
+    LruList::iterator lru = AddToLruList(
+        AtlasKey{id}, kEntryOverheadBytes + CFX_GlyphAtlas::kTextureBytes);
+    entry = &atlases_[id];
+    entry->atlas = std::move(atlas);
+    entry->size_key = size_key;
+    entry->lru = lru;
+    atlas_map_[size_key] = id;
   }
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
-      font, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
-  CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-  return pResult;
+  // The glyph shares the LRU entry of its atlas, which grows by the glyph's
+  // own overhead.
+  entry->glyphs.push_back(key);
+  entry->lru->bytes += kAtlasGlyphBytes;
+  g_stats.bytes += kAtlasGlyphBytes;
+  MarkUsed(entry->lru);
+  bitmap_map_[key] = {packed, entry->lru};
+  return packed;
 }
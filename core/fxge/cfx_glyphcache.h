@@ -7,13 +7,21 @@
 #ifndef CORE_FXGE_CFX_GLYPHCACHE_H_
 #define CORE_FXGE_CFX_GLYPHCACHE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
-#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_face.h"
 
 #if defined(PDF_USE_SKIA)
@@ -22,25 +30,67 @@
 #endif
 
 class CFX_Font;
+class CFX_GlyphAtlas;
 class CFX_GlyphBitmap;
 class CFX_Matrix;
 class CFX_Path;
 struct CFX_TextRenderOptions;
 
+// Caches the rendered bitmaps, outlines and widths of the glyphs of one face.
+// All glyph caches share one byte budget, and evict their least recently used
+// glyphs once they go over it. One lock guards all the caches, so they may be
+// used from several threads.
+//
+// Small anti-aliased glyph bitmaps of the same size get packed into shared
+// CFX_GlyphAtlas textures. The budget counts each atlas as a whole, and evicts
+// it along with all its glyphs.
 class CFX_GlyphCache final : public Retainable, public Observable {
  public:
+  // Counters across all glyph caches.
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    // Approximate memory the cached glyphs take up, including pinned paths.
+    size_t bytes = 0;
+    size_t byte_limit = 0;
+    // Paths from LoadPinnedGlyphPath() that their caches still hold, and the
+    // part of `bytes` they take up.
+    size_t pinned_paths = 0;
+    size_t pinned_bytes = 0;
+  };
+
+  static constexpr size_t kDefaultByteLimit = 64 * 1024 * 1024;
+
+  // Evicts glyphs right away if the caches already take up more than
+  // `byte_limit`.
+  static void SetByteLimit(size_t byte_limit);
+  static Stats GetStats();
+
   CONSTRUCT_VIA_MAKE_RETAIN;
 
-  const CFX_GlyphBitmap* LoadGlyphBitmap(const CFX_Font* font,
-                                         uint32_t glyph_index,
-                                         bool bFontStyle,
-                                         const CFX_Matrix& matrix,
-                                         int dest_width,
-                                         int anti_alias,
-                                         CFX_TextRenderOptions* text_options);
+  // See CFX_Font::LoadGlyphBitmap().
+  RetainPtr<const CFX_GlyphBitmap> LoadGlyphBitmap(
+      const CFX_Font* font,
+      uint32_t glyph_index,
+      bool bFontStyle,
+      const CFX_Matrix& matrix,
+      int dest_width,
+      int anti_alias,
+      int x_subpixel,
+      CFX_TextRenderOptions* text_options);
+  // The returned path may be evicted by the next load from any glyph cache,
+  // so callers copy it before then. Rendering loads glyphs under the page
+  // lock, so no other thread loads any meanwhile.
   const CFX_Path* LoadGlyphPath(const CFX_Font* font,
                                 uint32_t glyph_index,
                                 int dest_width);
+  // Like LoadGlyphPath(), but the path is never evicted, though it still
+  // counts towards the byte budget. It lives as long as this cache. For paths
+  // handed out through the public API.
+  const CFX_Path* LoadPinnedGlyphPath(const CFX_Font* font,
+                                      uint32_t glyph_index,
+                                      int dest_width);
   int GetGlyphWidth(const CFX_Font* font,
                     uint32_t glyph_index,
                     int dest_width,
@@ -55,38 +105,134 @@ class CFX_GlyphCache final : public Retainable, public Observable {
 #endif
 
  private:
-  explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
-  ~CFX_GlyphCache() override;
+  // Identifies a glyph bitmap: the glyph, and everything it is rendered with.
+  struct BitmapKey {
+    bool operator==(const BitmapKey& that) const = default;
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+    uint32_t glyph_index;
+    // The matrix a, b, c and d values, times 10000.
+    int32_t matrix[4];
+    int32_t dest_width;
+    int32_t anti_alias;
+    int32_t x_subpixel;
+    // The substitute font values, or 0 without a substitute font.
+    int32_t weight;
+    int32_t italic_angle;
+    bool has_subst_font;
+    bool vertical;
+    bool native;
+  };
+  struct BitmapKeyHash {
+    size_t operator()(const BitmapKey& key) const;
+  };
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
   // <glyph_index, dest_width, weight>
   using WidthMapKey = std::tuple<uint32_t, int, int>;
+  // Identifies an atlas within one cache.
+  struct AtlasKey {
+    uint32_t id;
+  };
+  using LruKey = std::variant<BitmapKey, PathMapKey, WidthMapKey, AtlasKey>;
+
+  // An item in the least recently used first list that all glyph caches
+  // share.
+  struct LruEntry {
+    UnownedPtr<CFX_GlyphCache> cache;
+    LruKey key;
+    size_t bytes;
+  };
+  using LruList = std::list<LruEntry>;
+
+  template <typename T>
+  struct CacheEntry {
+    T value;
+    // For glyphs in an atlas, the entry of the atlas.
+    LruList::iterator lru;
+  };
+
+  struct AtlasEntry {
+    RetainPtr<CFX_GlyphAtlas> atlas;
+    // The key of `atlas_map_` the atlas was created for.
+    BitmapKey size_key;
+    // The glyphs in `bitmap_map_` that point into the atlas.
+    std::vector<BitmapKey> glyphs;
+    LruList::iterator lru;
+  };
+
+  explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
+  ~CFX_GlyphCache() override;
+
+  // Guards the LRU list, the counters and the maps of all the caches, as
+  // evicting from one cache can happen during a load from another one.
+  static std::mutex& GetLock();
+  static LruList& GetLruList();
+  static void MarkUsed(LruList::iterator lru);
+  // Evicts the least recently used glyphs until all caches together take up
+  // at most `bytes`.
+  static void ShrinkTo(size_t bytes);
+  // Makes room for an item of `bytes` bytes, then adds it as the most
+  // recently used one.
+  LruList::iterator AddToLruList(LruKey key, size_t bytes);
+  void RemoveFromLruList(LruList::iterator lru);
+  void Evict(const LruKey& key);
+  // Drops the atlas with `id`, and all the glyphs in it, from this cache.
+  void RemoveAtlas(uint32_t id);
+
+  const CFX_Path* LoadGlyphPathLocked(const CFX_Font* font,
+                                      uint32_t glyph_index,
+                                      int dest_width);
+
+  static PathMapKey MakePathKey(const CFX_Font* font,
+                                uint32_t glyph_index,
+                                int dest_width);
+  static BitmapKey MakeBitmapKey(const CFX_Font* font,
+                                 uint32_t glyph_index,
+                                 const CFX_Matrix& matrix,
+                                 int dest_width,
+                                 int anti_alias,
+                                 int x_subpixel,
+                                 bool bNative);
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* font,
+                                         uint32_t glyph_index,
+                                         bool bFontStyle,
+                                         const CFX_Matrix& matrix,
+                                         int dest_width,
+                                         int anti_alias,
+                                         int x_subpixel);
+  RetainPtr<CFX_GlyphBitmap> RenderGlyph_Nativetext(const CFX_Font* font,
+                                                    uint32_t glyph_index,
+                                                    const CFX_Matrix& matrix,
+                                                    int dest_width,
+                                                    int anti_alias);
+  RetainPtr<const CFX_GlyphBitmap> LookUpGlyphBitmap(const CFX_Font* font,
+                                                     const CFX_Matrix& matrix,
+                                                     const BitmapKey& key,
+                                                     bool bFontStyle,
+                                                     int dest_width,
+                                                     int anti_alias);
+  RetainPtr<const CFX_GlyphBitmap> AddGlyphBitmap(
+      const BitmapKey& key,
+      RetainPtr<CFX_GlyphBitmap> bitmap);
+  // Copies `bitmap` into the atlas for the size of `key`, and adds the copy
+  // to this cache. Returns nullptr if `bitmap` does not go in an atlas.
+  RetainPtr<const CFX_GlyphBitmap> AddGlyphBitmapToAtlas(
+      const BitmapKey& key,
+      const RetainPtr<CFX_GlyphBitmap>& bitmap);
 
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph(const CFX_Font* font,
-                                               uint32_t glyph_index,
-                                               bool bFontStyle,
-                                               const CFX_Matrix& matrix,
-                                               int dest_width,
-                                               int anti_alias);
-  std::unique_ptr<CFX_GlyphBitmap> RenderGlyph_Nativetext(
-      const CFX_Font* font,
-      uint32_t glyph_index,
-      const CFX_Matrix& matrix,
-      int dest_width,
-      int anti_alias);
-  CFX_GlyphBitmap* LookUpGlyphBitmap(const CFX_Font* font,
-                                     const CFX_Matrix& matrix,
-                                     const ByteString& FaceGlyphsKey,
-                                     uint32_t glyph_index,
-                                     bool bFontStyle,
-                                     int dest_width,
-                                     int anti_alias);
   RetainPtr<CFX_Face> const face_;
-  std::map<ByteString, SizeGlyphCache> size_map_;
-  std::map<PathMapKey, std::unique_ptr<CFX_Path>> path_map_;
-  std::map<WidthMapKey, int> width_map_;
+  std::unordered_map<BitmapKey,
+                     CacheEntry<RetainPtr<CFX_GlyphBitmap>>,
+                     BitmapKeyHash>
+      bitmap_map_;
+  std::map<PathMapKey, CacheEntry<std::unique_ptr<CFX_Path>>> path_map_;
+  std::map<PathMapKey, std::unique_ptr<CFX_Path>> pinned_path_map_;
+  std::map<WidthMapKey, CacheEntry<int>> width_map_;
+  std::map<uint32_t, AtlasEntry> atlases_;
+  uint32_t next_atlas_id_ = 0;
+  // The id of the atlas that new glyphs of each size go into, keyed by
+  // BitmapKey without the glyph index and subpixel offset.
+  std::unordered_map<BitmapKey, uint32_t, BitmapKeyHash> atlas_map_;
 #if defined(PDF_USE_SKIA)
   sk_sp<SkTypeface> typeface_;
 #endif
@@ -18,8 +18,10 @@
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/span.h"
 #include "core/fxcrt/zip.h"
+#include "core/fxge/agg/cfx_agg_imagerenderer.h"
 #include "core/fxge/cfx_color.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
@@ -32,6 +34,7 @@
 #include "core/fxge/cfx_path.h"
 #include "core/fxge/cfx_textrenderoptions.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 #include "core/fxge/text_char_pos.h"
@@ -310,6 +313,69 @@ void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
   }
 }
 
+// Composites the anti-aliased glyphs of a text run onto `bitmap`, like calling
+// CFX_DIBitmap::CompositeMask() for each one, but with the compositor set up
+// once for the whole run.
+bool CompositeGlyphMasks(const RetainPtr<CFX_DIBitmap>& bitmap,
+                         pdfium::span<const TextGlyphPos> glyphs,
+                         const CFX_Point& offset,
+                         uint32_t fill_color) {
+  if (FXARGB_A(fill_color) == 0) {
+    return true;
+  }
+
+  CFX_ScanlineCompositor compositor;
+  if (!compositor.Init(bitmap->GetFormat(), FXDIB_Format::k8bppMask, {},
+                       fill_color, BlendMode::kNormal,
+                       /*bRgbByteOrder=*/false)) {
+    return false;
+  }
+
+  const int bytes_per_pixel = bitmap->GetBPP() / 8;
+  for (const TextGlyphPos& glyph : glyphs) {
+    if (!glyph.glyph_) {
+      continue;
+    }
+
+    std::optional<CFX_Point> point = glyph.GetOrigin(offset);
+    if (!point.has_value()) {
+      continue;
+    }
+
+    const RetainPtr<CFX_DIBitmap>& mask = glyph.glyph_->GetBitmap();
+    if (mask->GetFormat() != FXDIB_Format::k8bppMask) {
+      if (!bitmap->CompositeMask(point->x, point->y, mask->GetWidth(),
+                                 mask->GetHeight(), mask, fill_color, 0, 0,
+                                 BlendMode::kNormal, nullptr, false)) {
+        return false;
+      }
+      continue;
+    }
+
+    int dest_left = point->x;
+    int dest_top = point->y;
+    int width = mask->GetWidth();
+    int height = mask->GetHeight();
+    int src_left = 0;
+    int src_top = 0;
+    if (!bitmap->GetOverlapRect(dest_left, dest_top, width, height,
+                                mask->GetWidth(), mask->GetHeight(), src_left,
+                                src_top, nullptr)) {
+      continue;
+    }
+
+    for (int row = 0; row < height; ++row) {
+      compositor.CompositeByteMaskLine(
+          bitmap->GetWritableScanline(dest_top + row)
+              .subspan(static_cast<size_t>(dest_left * bytes_per_pixel)),
+          mask->GetScanline(src_top + row)
+              .subspan(static_cast<size_t>(src_left)),
+          width, {});
+    }
+  }
+  return true;
+}
+
 bool ShouldDrawDeviceText(const CFX_Font* font,
                           const CFX_TextRenderOptions& options) {
 #if BUILDFLAG(IS_APPLE)
@@ -513,6 +579,34 @@ FXDIB_Format GetCreateCompatibleBitmapFormat(int render_caps,
 
 }  // namespace
 
+// Releases the render lock of a device, if it has one, for the lifetime of
+// this object. Does nothing if the lock is already released further up the
+// stack.
+class CFX_RenderDevice::ScopedRenderUnlock {
+ public:
+  explicit ScopedRenderUnlock(CFX_RenderDevice* device)
+      : ScopedRenderUnlock(device, /*can_unlock=*/true) {}
+  ScopedRenderUnlock(CFX_RenderDevice* device, bool can_unlock)
+      : device_(can_unlock && device->render_lock_ &&
+                        !device->render_lock_released_
+                    ? device
+                    : nullptr) {
+    if (device_) {
+      device_->render_lock_released_ = true;
+      device_->render_lock_->unlock();
+    }
+  }
+  ~ScopedRenderUnlock() {
+    if (device_) {
+      device_->render_lock_->lock();
+      device_->render_lock_released_ = false;
+    }
+  }
+
+ private:
+  UnownedPtr<CFX_RenderDevice> const device_;
+};
+
 CFX_RenderDevice::CFX_RenderDevice() = default;
 
 CFX_RenderDevice::~CFX_RenderDevice() {
@@ -588,6 +682,7 @@ bool CFX_RenderDevice::SetClip_PathFill(
     const CFX_Path& path,
     const CFX_Matrix* pObject2Device,
     const CFX_FillRenderOptions& fill_options) {
+  ScopedRenderUnlock unlock(this);
   if (!device_driver_->SetClip_PathFill(path, pObject2Device, fill_options)) {
     return false;
   }
@@ -600,6 +695,7 @@ bool CFX_RenderDevice::SetClip_PathStroke(
     const CFX_Path& path,
     const CFX_Matrix* pObject2Device,
     const CFX_GraphStateData* pGraphState) {
+  ScopedRenderUnlock unlock(this);
   if (!device_driver_->SetClip_PathStroke(path, pObject2Device, pGraphState)) {
     return false;
   }
@@ -630,6 +726,12 @@ bool CFX_RenderDevice::DrawPath(const CFX_Path& path,
                                 uint32_t fill_color,
                                 uint32_t stroke_color,
                                 const CFX_FillRenderOptions& fill_options) {
+  if (render_caps_ & FXRC_DISPLAY_LIST) {
+    return device_driver_->DrawPath(path, pObject2Device, pGraphState,
+                                    fill_color, stroke_color, fill_options);
+  }
+
+  ScopedRenderUnlock unlock(this);
   const bool fill =
       fill_options.fill_type != CFX_FillRenderOptions::FillType::kNoFill;
   uint8_t fill_alpha = fill ? FXARGB_A(fill_color) : 0;
@@ -828,6 +930,7 @@ bool CFX_RenderDevice::DrawFillStrokePath(
 }
 
 bool CFX_RenderDevice::FillRect(const FX_RECT& rect, uint32_t fill_color) {
+  ScopedRenderUnlock unlock(this);
   if (device_driver_->FillRect(rect, fill_color)) {
     return true;
   }
@@ -934,6 +1037,7 @@ bool CFX_RenderDevice::SetDIBitsWithBlend(RetainPtr<const CFX_DIBBase> bitmap,
                                           int top,
                                           BlendMode blend_mode) {
   DCHECK(!bitmap->IsMaskFormat());
+  ScopedRenderUnlock unlock(this, bitmap->IsRealized());
   FX_RECT dest_rect(left, top, left + bitmap->GetWidth(),
                     top + bitmap->GetHeight());
   dest_rect.Intersect(clip_box_);
@@ -993,6 +1097,7 @@ bool CFX_RenderDevice::StretchDIBitsWithFlagsAndBlend(
     int dest_height,
     const FXDIB_ResampleOptions& options,
     BlendMode blend_mode) {
+  ScopedRenderUnlock unlock(this, bitmap->IsRealized());
   FX_RECT dest_rect(left, top, left + dest_width, top + dest_height);
   FX_RECT clip_box = clip_box_;
   clip_box.Intersect(dest_rect);
@@ -1005,6 +1110,7 @@ bool CFX_RenderDevice::SetBitMask(RetainPtr<const CFX_DIBBase> bitmap,
                                   int left,
                                   int top,
                                   uint32_t argb) {
+  ScopedRenderUnlock unlock(this, bitmap->IsRealized());
   FX_RECT src_rect(0, 0, bitmap->GetWidth(), bitmap->GetHeight());
   return device_driver_->SetDIBits(std::move(bitmap), argb, src_rect, left, top,
                                    BlendMode::kNormal);
@@ -1028,6 +1134,7 @@ bool CFX_RenderDevice::StretchBitMaskWithFlags(
     int dest_height,
     uint32_t argb,
     const FXDIB_ResampleOptions& options) {
+  ScopedRenderUnlock unlock(this, bitmap->IsRealized());
   FX_RECT dest_rect(left, top, left + dest_width, top + dest_height);
   FX_RECT clip_box = clip_box_;
   clip_box.Intersect(dest_rect);
@@ -1053,12 +1160,14 @@ RenderDeviceDriverIface::StartResult CFX_RenderDevice::StartDIBitsWithBlend(
     const CFX_Matrix& matrix,
     const FXDIB_ResampleOptions& options,
     BlendMode blend_mode) {
+  ScopedRenderUnlock unlock(this, bitmap->IsRealized());
   return device_driver_->StartDIBits(std::move(bitmap), alpha, argb, matrix,
                                      options, blend_mode);
 }
 
 bool CFX_RenderDevice::ContinueDIBits(CFX_AggImageRenderer* handle,
                                       PauseIndicatorIface* pPause) {
+  ScopedRenderUnlock unlock(this, handle && handle->IsSourceRealized());
   return device_driver_->ContinueDIBits(handle, pPause);
 }
 
@@ -1091,6 +1200,20 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
                                       const CFX_Matrix& mtText2Device,
                                       uint32_t fill_color,
                                       const CFX_TextRenderOptions& options) {
+  if (render_caps_ & FXRC_DISPLAY_LIST) {
+    // Glyphs get rasterized when the display list is replayed, which needs
+    // the list to keep the font alive. That takes an owner to retain, so
+    // text in other fonts becomes paths right away.
+    if (font->GetOwner()) {
+      return device_driver_->DrawDeviceText(pCharPos, font, mtText2Device,
+                                            font_size, fill_color, options);
+    }
+    CFX_FillRenderOptions path_options;
+    path_options.aliased_path = !options.IsSmooth();
+    return DrawTextPath(pCharPos, font, font_size, mtText2Device, nullptr,
+                        nullptr, fill_color, 0, nullptr, path_options);
+  }
+
   // `anti_alias` and `normalize` don't affect Skia rendering.
   int anti_alias = FT_RENDER_MODE_MONO;
   bool normalize = false;
@@ -1176,23 +1299,46 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
                           nullptr, fill_color, 0, nullptr, path_options);
     }
   }
+  bool subpixel_positioning = anti_alias == FT_RENDER_MODE_NORMAL &&
+                              text_options.subpixel_positioning;
+#if BUILDFLAG(IS_APPLE)
+  // Native glyphs only come at whole pixel positions.
+  subpixel_positioning &= !text_options.native_text;
+#endif
   std::vector<TextGlyphPos> glyphs(pCharPos.size());
   for (auto [charpos, glyph] : fxcrt::Zip(pCharPos, pdfium::span(glyphs))) {
     glyph.device_origin_ = text2Device.Transform(charpos.origin_);
-    glyph.origin_.x = anti_alias < FT_RENDER_MODE_LCD
-                          ? FXSYS_roundf(glyph.device_origin_.x)
-                          : static_cast<int>(floor(glyph.device_origin_.x));
+    int x_subpixel = 0;
+    if (subpixel_positioning) {
+      // Round to the nearest subpixel position, then split that into whole
+      // pixels and the subpixel offset the glyph gets rendered at.
+      const float position = floorf(
+          glyph.device_origin_.x * CFX_Font::kSubpixelPositions + 0.5f);
+      const float pixel = floorf(position / CFX_Font::kSubpixelPositions);
+      glyph.origin_.x = pdfium::saturated_cast<int>(pixel);
+      x_subpixel = static_cast<int>(position -
+                                    pixel * CFX_Font::kSubpixelPositions);
+    } else {
+      glyph.origin_.x = anti_alias < FT_RENDER_MODE_LCD
+                            ? FXSYS_roundf(glyph.device_origin_.x)
+                            : static_cast<int>(floor(glyph.device_origin_.x));
+    }
     glyph.origin_.y = FXSYS_roundf(glyph.device_origin_.y);
 
     CFX_Matrix matrix = charpos.GetEffectiveMatrix(char2device);
     glyph.glyph_ = font->LoadGlyphBitmap(
         charpos.glyph_index_, charpos.font_style_, matrix,
-        charpos.font_char_width_, anti_alias, &text_options);
+        charpos.font_char_width_, anti_alias, x_subpixel, &text_options);
   }
-  if (anti_alias < FT_RENDER_MODE_LCD && glyphs.size() > 1) {
+  // Subpixel positioned glyphs are already spaced accurately.
+  if (anti_alias < FT_RENDER_MODE_LCD && !subpixel_positioning &&
+      glyphs.size() > 1) {
     AdjustGlyphSpace(&glyphs);
   }
 
+  // The glyphs are loaded, the rest only draws them.
+  ScopedRenderUnlock unlock(this);
+
   FX_RECT bmp_rect = GetGlyphsBBox(glyphs, anti_alias);
   bmp_rect.Intersect(clip_box_);
   if (bmp_rect.IsEmpty()) {
@@ -1246,49 +1392,43 @@ bool CFX_RenderDevice::DrawNormalText(pdfium::span<const TextCharPos> pCharPos,
       return false;
     }
   }
-  int dest_width = pixel_width;
-  FX_BGRA_STRUCT<uint8_t> bgra;
-  if (anti_alias == FT_RENDER_MODE_LCD) {
-    bgra = ArgbToBGRAStruct(fill_color);
-  }
-
-  for (const TextGlyphPos& glyph : glyphs) {
-    if (!glyph.glyph_) {
-      continue;
+  if (anti_alias == FT_RENDER_MODE_NORMAL) {
+    if (!CompositeGlyphMasks(bitmap, glyphs, {pixel_left, pixel_top},
+                             fill_color)) {
+      return false;
     }
+  } else {
+    int dest_width = pixel_width;
+    const FX_BGRA_STRUCT<uint8_t> bgra = ArgbToBGRAStruct(fill_color);
+    for (const TextGlyphPos& glyph : glyphs) {
+      if (!glyph.glyph_) {
+        continue;
+      }
 
-    std::optional<CFX_Point> point = glyph.GetOrigin({pixel_left, pixel_top});
-    if (!point.has_value()) {
-      continue;
-    }
+      std::optional<CFX_Point> point = glyph.GetOrigin({pixel_left, pixel_top});
+      if (!point.has_value()) {
+        continue;
+      }
 
-    const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.glyph_->GetBitmap();
-    int ncols = pGlyph->GetWidth();
-    int nrows = pGlyph->GetHeight();
-    if (anti_alias == FT_RENDER_MODE_NORMAL) {
-      if (!bitmap->CompositeMask(point.value().x, point.value().y, ncols, nrows,
-                                 pGlyph, fill_color, 0, 0, BlendMode::kNormal,
-                                 nullptr, false)) {
-        return false;
+      const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.glyph_->GetBitmap();
+      int ncols = pGlyph->GetWidth() / 3;
+      int nrows = pGlyph->GetHeight();
+      int x_subpixel = static_cast<int>(glyph.device_origin_.x * 3) % 3;
+      int start_col = std::max(point->x, 0);
+      FX_SAFE_INT32 end_col_safe = point->x;
+      end_col_safe += ncols;
+      if (!end_col_safe.IsValid()) {
+        continue;
       }
-      continue;
-    }
-    ncols /= 3;
-    int x_subpixel = static_cast<int>(glyph.device_origin_.x * 3) % 3;
-    int start_col = std::max(point->x, 0);
-    FX_SAFE_INT32 end_col_safe = point->x;
-    end_col_safe += ncols;
-    if (!end_col_safe.IsValid()) {
-      continue;
-    }
 
-    int end_col = std::min<int>(end_col_safe.ValueOrDie(), dest_width);
-    if (start_col >= end_col) {
-      continue;
-    }
+      int end_col = std::min<int>(end_col_safe.ValueOrDie(), dest_width);
+      if (start_col >= end_col) {
+        continue;
+      }
 
-    DrawNormalTextHelper(bitmap, pGlyph, nrows, point->x, point->y, start_col,
-                         end_col, normalize, x_subpixel, bgra);
+      DrawNormalTextHelper(bitmap, pGlyph, nrows, point->x, point->y,
+                           start_col, end_col, normalize, x_subpixel, bgra);
+    }
   }
 
   if (bitmap->IsMaskFormat()) {
@@ -8,6 +8,7 @@
 #define CORE_FXGE_CFX_RENDERDEVICE_H_
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "build/build_config.h"
@@ -68,6 +69,14 @@ class CFX_RenderDevice {
                                             int width,
                                             int height) const;
   const FX_RECT& GetClipBox() const { return clip_box_; }
+
+  // Once set, callers must hold `lock` whenever they call into this device.
+  // The device releases it while it only reads realized bitmaps and writes
+  // to its own bitmap, so that devices drawing disjoint parts of one bitmap on
+  // other threads can make progress.
+  void SetRenderLock(std::mutex* lock) { render_lock_ = lock; }
+  std::mutex* GetRenderLock() const { return render_lock_; }
+
   void SetBaseClip(const FX_RECT& rect);
   bool SetClip_PathFill(const CFX_Path& path,
                         const CFX_Matrix* pObject2Device,
@@ -215,6 +224,8 @@ class CFX_RenderDevice {
   }
 
  private:
+  class ScopedRenderUnlock;
+
   void InitDeviceInfo();
   void UpdateClipBox();
   bool DrawFillStrokePath(const CFX_Path& path,
@@ -242,6 +253,8 @@ class CFX_RenderDevice {
   DeviceType device_type_ = DeviceType::kDisplay;
   FX_RECT clip_box_;
   std::unique_ptr<RenderDeviceDriverIface> device_driver_;
+  UnownedPtr<std::mutex> render_lock_;
+  bool render_lock_released_ = false;
 };
 
 #endif  // CORE_FXGE_CFX_RENDERDEVICE_H_
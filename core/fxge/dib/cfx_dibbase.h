@@ -49,6 +49,10 @@ class CFX_DIBBase : public Retainable {
   virtual pdfium::span<const uint8_t> GetScanline(int line) const = 0;
   virtual bool SkipToScanline(int line, PauseIndicatorIface* pPause) const;
   virtual size_t GetEstimatedImageMemoryBurden() const;
+  // Returns whether the scanlines are plain memory owned by this DIB, as
+  // opposed to being produced on demand. Only realized DIBs may be read from
+  // several threads at once.
+  virtual bool IsRealized() const;
 #if BUILDFLAG(IS_WIN) || defined(PDF_USE_SKIA)
   // Calls Realize() if needed. Otherwise, return `this`.
   virtual RetainPtr<const CFX_DIBitmap> RealizeIfNeeded() const;
@@ -62,6 +62,7 @@ class CFX_DIBitmap final : public CFX_DIBBase {
   // CFX_DIBBase
   pdfium::span<const uint8_t> GetScanline(int line) const override;
   size_t GetEstimatedImageMemoryBurden() const override;
+  bool IsRealized() const override;
 #if BUILDFLAG(IS_WIN) || defined(PDF_USE_SKIA)
   RetainPtr<const CFX_DIBitmap> RealizeIfNeeded() const override;
 #endif
@@ -18,6 +18,7 @@
 #include "core/fxcrt/zip.h"
 #include "core/fxge/dib/blend.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_composite_row.h"
 
 using fxge::Blend;
 
@@ -119,6 +120,19 @@ void RGB_Blend(BlendMode blend_mode,
   });
 }
 
+// Skips the first `count` pixels of an optional clip scanline.
+pdfium::span<const uint8_t> SkipClipPixels(
+    pdfium::span<const uint8_t> clip_scan,
+    size_t count) {
+  return clip_scan.empty() ? clip_scan : clip_scan.subspan(count);
+}
+
+FX_BGR_STRUCT<uint8_t> ToBgr(int red, int green, int blue) {
+  return {.blue = static_cast<uint8_t>(blue),
+          .green = static_cast<uint8_t>(green),
+          .red = static_cast<uint8_t>(red)};
+}
+
 int GetAlpha(uint8_t src_alpha, const uint8_t* clip_scan, int col) {
   return clip_scan ? UNSAFE_TODO(clip_scan[col]) * src_alpha / 255 : src_alpha;
 }
@@ -2576,7 +2590,12 @@ void CFX_ScanlineCompositor::CompositeRgbBitmapLineSrcBgra(
 
       auto dest_span =
           fxcrt::reinterpret_span<FX_BGR_STRUCT<uint8_t>>(dest_scan);
-      CompositeRowBgra2Bgr(src_span, clip_scan, dest_span, blend_type_);
+      const size_t done = pdfium::CompositeRowBgra2BgrVectorized(
+          src_scan, clip_scan, dest_scan, /*dest_bytes_per_pixel=*/3,
+          src_span.size(), blend_type_);
+      CompositeRowBgra2Bgr(src_span.subspan(done),
+                           SkipClipPixels(clip_scan, done),
+                           dest_span.subspan(done), blend_type_);
       return;
     }
     case FXDIB_Format::kBgrx: {
@@ -2589,7 +2608,12 @@ void CFX_ScanlineCompositor::CompositeRgbBitmapLineSrcBgra(
 
       auto dest_span =
           fxcrt::reinterpret_span<FX_BGRA_STRUCT<uint8_t>>(dest_scan);
-      CompositeRowBgra2Bgr(src_span, clip_scan, dest_span, blend_type_);
+      const size_t done = pdfium::CompositeRowBgra2BgrVectorized(
+          src_scan, clip_scan, dest_scan, /*dest_bytes_per_pixel=*/4,
+          src_span.size(), blend_type_);
+      CompositeRowBgra2Bgr(src_span.subspan(done),
+                           SkipClipPixels(clip_scan, done),
+                           dest_span.subspan(done), blend_type_);
       return;
     }
     case FXDIB_Format::kBgra: {
@@ -2601,7 +2625,11 @@ void CFX_ScanlineCompositor::CompositeRgbBitmapLineSrcBgra(
       }
       auto dest_span =
           fxcrt::reinterpret_span<FX_BGRA_STRUCT<uint8_t>>(dest_scan);
-      CompositeRowBgra2Bgra(src_span, clip_scan, dest_span, blend_type_);
+      const size_t done = pdfium::CompositeRowBgra2BgraVectorized(
+          src_scan, clip_scan, dest_scan, src_span.size(), blend_type_);
+      CompositeRowBgra2Bgra(src_span.subspan(done),
+                            SkipClipPixels(clip_scan, done),
+                            dest_span.subspan(done), blend_type_);
       return;
     }
 #if defined(PDF_USE_SKIA)
@@ -2785,9 +2813,13 @@ void CFX_ScanlineCompositor::CompositePalBitmapLineSrcBpp8(
             clip_scan);
         return;
       }
-      CompositeRow_8bppBgr2Bgra_NoBlend(dest_scan, src_scan, width,
-                                        src_palette_.Get32BitPalette(),
-                                        clip_scan);
+      const size_t done = pdfium::CompositeRow8bppPal2BgraVectorized(
+          src_scan, clip_scan, dest_scan, width,
+          src_palette_.Get32BitPalette());
+      CompositeRow_8bppBgr2Bgra_NoBlend(
+          dest_scan.subspan(done * 4), src_scan.subspan(done),
+          width - static_cast<int>(done), src_palette_.Get32BitPalette(),
+          SkipClipPixels(clip_scan, done));
       return;
     }
 #if defined(PDF_USE_SKIA)
@@ -2834,9 +2866,15 @@ void CFX_ScanlineCompositor::CompositeByteMaskLine(
             clip_scan);
         return;
       }
-      CompositeRow_ByteMask2Rgb(dest_scan, src_scan, mask_alpha_, mask_red_,
-                                mask_green_, mask_blue_, width, blend_type_,
-                                GetCompsFromFormat(dest_format_), clip_scan);
+      const int dest_bytes_per_pixel = GetCompsFromFormat(dest_format_);
+      const size_t done = pdfium::CompositeRowByteMask2BgrVectorized(
+          src_scan, clip_scan, dest_scan, dest_bytes_per_pixel, width,
+          mask_alpha_, ToBgr(mask_red_, mask_green_, mask_blue_), blend_type_);
+      CompositeRow_ByteMask2Rgb(
+          dest_scan.subspan(done * dest_bytes_per_pixel),
+          src_scan.subspan(done), mask_alpha_, mask_red_, mask_green_,
+          mask_blue_, width - static_cast<int>(done), blend_type_,
+          dest_bytes_per_pixel, SkipClipPixels(clip_scan, done));
       return;
     }
     case FXDIB_Format::kBgra: {
@@ -2846,9 +2884,14 @@ void CFX_ScanlineCompositor::CompositeByteMaskLine(
             mask_blue_, width, blend_type_, clip_scan);
         return;
       }
-      CompositeRow_ByteMask2Bgra(dest_scan, src_scan, mask_alpha_, mask_red_,
-                                 mask_green_, mask_blue_, width, blend_type_,
-                                 clip_scan);
+      const size_t done = pdfium::CompositeRowByteMask2BgraVectorized(
+          src_scan, clip_scan, dest_scan, width, mask_alpha_,
+          ToBgr(mask_red_, mask_green_, mask_blue_), blend_type_);
+      CompositeRow_ByteMask2Bgra(dest_scan.subspan(done * 4),
+                                 src_scan.subspan(done), mask_alpha_,
+                                 mask_red_, mask_green_, mask_blue_,
+                                 width - static_cast<int>(done), blend_type_,
+                                 SkipClipPixels(clip_scan, done));
       return;
     }
 #if defined(PDF_USE_SKIA)
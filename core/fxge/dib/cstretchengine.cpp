@@ -20,6 +20,7 @@
 #include "core/fxge/dib/cfx_dibbase.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_stretch_row.h"
 #include "core/fxge/dib/scanlinecomposer_iface.h"
 
 static_assert(
@@ -233,6 +234,7 @@ CStretchEngine::CStretchEngine(ScanlineComposerIface* pDestBitmap,
     if (UseInterpolateBilinear(options, dest_width, dest_height, src_width_,
                                src_height_)) {
       resample_options_.bInterpolateBilinear = true;
+      resample_options_.bBoxFilter = options.bBoxFilter;
     } else {
       resample_options_ = options;
     }
@@ -258,6 +260,19 @@ CStretchEngine::CStretchEngine(ScanlineComposerIface* pDestBitmap,
   FX_RECT src_rect(0, 0, src_width_, src_height_);
   src_clip_.Intersect(src_rect);
 
+  if (resample_options_.bBoxFilter && dest_width_ > 0 && dest_height_ > 0 &&
+      src_width_ >= dest_width_ && src_height_ >= dest_height_ &&
+      src_width_ % dest_width_ == 0 && src_height_ % dest_height_ == 0 &&
+      clip_rect.left >= 0 && clip_rect.top >= 0 &&
+      clip_rect.right <= dest_width_ && clip_rect.bottom <= dest_height_) {
+    box_ratio_x_ = src_width_ / dest_width_;
+    box_ratio_y_ = src_height_ / dest_height_;
+    src_clip_ = FX_RECT(clip_rect.left * box_ratio_x_,
+                        clip_rect.top * box_ratio_y_,
+                        clip_rect.right * box_ratio_x_,
+                        clip_rect.bottom * box_ratio_y_);
+  }
+
   switch (src_bpp_) {
     case 1:
       trans_method_ = dest_bpp_ == 8 ? TransformMethod::k1BppTo8Bpp
@@ -276,6 +291,71 @@ CStretchEngine::CStretchEngine(ScanlineComposerIface* pDestBitmap,
 
 CStretchEngine::~CStretchEngine() = default;
 
+std::optional<pdfium::StretchPixelFormat>
+CStretchEngine::GetHorizontalPixelFormat() const {
+  switch (trans_method_) {
+    case TransformMethod::k1BppTo8Bpp:
+    case TransformMethod::k8BppTo8Bpp:
+      return pdfium::StretchPixelFormat::kGray;
+    case TransformMethod::k1BppToManyBpp:
+      return std::nullopt;
+    case TransformMethod::k8BppToManyBpp:
+      if (dest_format_ != FXDIB_Format::kBgr) {
+        return std::nullopt;
+      }
+      return pdfium::StretchPixelFormat::kBgr;
+    case TransformMethod::kManyBpptoManyBpp:
+      return pdfium::StretchPixelFormat::kBgr;
+    case TransformMethod::kManyBpptoManyBppWithAlpha:
+      return pdfium::StretchPixelFormat::kBgra;
+  }
+}
+
+std::optional<pdfium::StretchPixelFormat>
+CStretchEngine::GetVerticalPixelFormat() const {
+  switch (trans_method_) {
+    case TransformMethod::k1BppTo8Bpp:
+    case TransformMethod::k8BppTo8Bpp:
+      return pdfium::StretchPixelFormat::kGray;
+    case TransformMethod::k1BppToManyBpp:
+      return std::nullopt;
+    case TransformMethod::k8BppToManyBpp:
+    case TransformMethod::kManyBpptoManyBpp:
+      return pdfium::StretchPixelFormat::kBgr;
+    case TransformMethod::kManyBpptoManyBppWithAlpha:
+      return pdfium::StretchPixelFormat::kBgra;
+  }
+}
+
+void CStretchEngine::UnpackSourcePixels(pdfium::span<const uint8_t> src_scan) {
+  src_pixels_.resize(src_clip_.Width());
+  const int Bpp = dest_bpp_ / 8;
+  for (int j = src_clip_.left; j < src_clip_.right; ++j) {
+    uint32_t& pixel = src_pixels_[j - src_clip_.left];
+    switch (trans_method_) {
+      case TransformMethod::k1BppTo8Bpp:
+      case TransformMethod::k1BppToManyBpp:
+        pixel = (src_scan[j / 8] & (1 << (7 - j % 8))) ? 255 : 0;
+        break;
+      case TransformMethod::k8BppTo8Bpp:
+        pixel = src_scan[j];
+        break;
+      case TransformMethod::k8BppToManyBpp:
+        pixel = src_palette_[src_scan[j]] & 0xffffff;
+        break;
+      case TransformMethod::kManyBpptoManyBpp:
+        pixel = src_scan[j * Bpp] | src_scan[j * Bpp + 1] << 8 |
+                src_scan[j * Bpp + 2] << 16;
+        break;
+      case TransformMethod::kManyBpptoManyBppWithAlpha:
+        pixel = src_scan[j * Bpp] | src_scan[j * Bpp + 1] << 8 |
+                src_scan[j * Bpp + 2] << 16 |
+                static_cast<uint32_t>(src_scan[j * Bpp + 3]) << 24;
+        break;
+    }
+  }
+}
+
 bool CStretchEngine::Continue(PauseIndicatorIface* pPause) {
   while (state_ == State::kHorizontal) {
     if (ContinueStretchHorz(pPause)) {
@@ -303,7 +383,8 @@ bool CStretchEngine::StartStretchHorz() {
   if (inter_buf_.empty()) {
     return false;
   }
-  if (!weight_table_.CalculateWeights(
+  if (!box_ratio_x_ &&
+      !weight_table_.CalculateWeights(
           dest_width_, dest_clip_.left, dest_clip_.right, src_width_,
           src_clip_.left, src_clip_.right, resample_options_)) {
     return false;
@@ -322,6 +403,9 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
   }
 
   int Bpp = dest_bpp_ / 8;
+  const std::optional<pdfium::StretchPixelFormat> format =
+      pdfium::IsStretchVectorizationEnabled() ? GetHorizontalPixelFormat()
+                                              : std::nullopt;
   static const int kStrechPauseRows = 10;
   int rows_to_go = kStrechPauseRows;
   for (; cur_row_ < src_clip_.bottom; ++cur_row_) {
@@ -333,16 +417,31 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
       rows_to_go = kStrechPauseRows;
     }
 
-    const uint8_t* src_scan = source_->GetScanline(cur_row_).data();
+    pdfium::span<const uint8_t> src_scan_span = source_->GetScanline(cur_row_);
+    const uint8_t* src_scan = src_scan_span.data();
     pdfium::span<uint8_t> dest_span = inter_buf_.subspan(
         (cur_row_ - src_clip_.top) * inter_pitch_, inter_pitch_);
-    size_t dest_span_index = 0;
+    if (box_ratio_x_) {
+      BoxFilterHorz(src_scan_span, dest_span);
+      rows_to_go--;
+      continue;
+    }
+
+    size_t done = 0;
+    if (format.has_value()) {
+      UnpackSourcePixels(src_scan_span);
+      done = pdfium::StretchRowHorizontalVectorized(
+          src_pixels_, src_clip_.left, weight_table_, dest_clip_.left,
+          dest_clip_.right, format.value(), Bpp, dest_span);
+    }
+    const int left = dest_clip_.left + static_cast<int>(done);
+    size_t dest_span_index = done * Bpp;
     // TODO(npm): reduce duplicated code here
     UNSAFE_TODO({
       switch (trans_method_) {
         case TransformMethod::k1BppTo8Bpp:
         case TransformMethod::k1BppToManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
             uint32_t dest_a = 0;
             for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
@@ -356,7 +455,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
           break;
         }
         case TransformMethod::k8BppTo8Bpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
             uint32_t dest_a = 0;
             for (int j = pWeights->src_start_; j <= pWeights->src_end_; ++j) {
@@ -368,7 +467,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
           break;
         }
         case TransformMethod::k8BppToManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
             uint32_t dest_r = 0;
             uint32_t dest_g = 0;
@@ -393,7 +492,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
           break;
         }
         case TransformMethod::kManyBpptoManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
             uint32_t dest_r = 0;
             uint32_t dest_g = 0;
@@ -414,7 +513,7 @@ bool CStretchEngine::ContinueStretchHorz(PauseIndicatorIface* pPause) {
         }
         case TransformMethod::kManyBpptoManyBppWithAlpha: {
           DCHECK(has_alpha_);
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             PixelWeight* pWeights = weight_table_.GetPixelWeight(col);
             uint32_t dest_a = 0;
             uint32_t dest_r = 0;
@@ -449,6 +548,14 @@ void CStretchEngine::StretchVert() {
     return;
   }
 
+  if (box_ratio_y_) {
+    for (int row = dest_clip_.top; row < dest_clip_.bottom; ++row) {
+      BoxFilterVert(row);
+      dest_bitmap_->ComposeScanline(row - dest_clip_.top, dest_scanline_);
+    }
+    return;
+  }
+
   WeightTable table;
   if (!table.CalculateWeights(dest_height_, dest_clip_.top, dest_clip_.bottom,
                               src_height_, src_clip_.top, src_clip_.bottom,
@@ -457,15 +564,32 @@ void CStretchEngine::StretchVert() {
   }
 
   const int DestBpp = dest_bpp_ / 8;
+  const std::optional<pdfium::StretchPixelFormat> format =
+      pdfium::IsStretchVectorizationEnabled() ? GetVerticalPixelFormat()
+                                              : std::nullopt;
   UNSAFE_TODO({
     for (int row = dest_clip_.top; row < dest_clip_.bottom; ++row) {
       unsigned char* dest_scan = dest_scanline_.data();
       PixelWeight* pWeights = table.GetPixelWeight(row);
+      size_t done = 0;
+      const int weight_count = pWeights->src_end_ - pWeights->src_start_ + 1;
+      if (format.has_value() && weight_count > 0) {
+        pdfium::span<const uint8_t> src_rows = inter_buf_.subspan(
+            static_cast<size_t>((pWeights->src_start_ - src_clip_.top) *
+                                inter_pitch_));
+        pdfium::span<const uint32_t> weights(
+            pWeights->weights_, static_cast<size_t>(weight_count));
+        done = pdfium::StretchRowVerticalVectorized(
+            src_rows, inter_pitch_, weights, format.value(), DestBpp,
+            dest_scanline_, dest_clip_.Width());
+      }
+      const int left = dest_clip_.left + static_cast<int>(done);
+      dest_scan += done * DestBpp;
       switch (trans_method_) {
         case TransformMethod::k1BppTo8Bpp:
         case TransformMethod::k1BppToManyBpp:
         case TransformMethod::k8BppTo8Bpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             pdfium::span<const uint8_t> src_span =
                 inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
             uint32_t dest_a = 0;
@@ -481,7 +605,7 @@ void CStretchEngine::StretchVert() {
         }
         case TransformMethod::k8BppToManyBpp:
         case TransformMethod::kManyBpptoManyBpp: {
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             pdfium::span<const uint8_t> src_span =
                 inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
             uint32_t dest_r = 0;
@@ -504,7 +628,7 @@ void CStretchEngine::StretchVert() {
         }
         case TransformMethod::kManyBpptoManyBppWithAlpha: {
           DCHECK(has_alpha_);
-          for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+          for (int col = left; col < dest_clip_.right; ++col) {
             pdfium::span<const uint8_t> src_span =
                 inter_buf_.subspan((col - dest_clip_.left) * DestBpp);
             uint32_t dest_a = 0;
@@ -540,3 +664,172 @@ void CStretchEngine::StretchVert() {
     }
   });
 }
+
+void CStretchEngine::BoxFilterHorz(pdfium::span<const uint8_t> src_scan,
+                                   pdfium::span<uint8_t> dest_span) const {
+  const int Bpp = dest_bpp_ / 8;
+  const uint32_t ratio = box_ratio_x_;
+  size_t dest_span_index = 0;
+  switch (trans_method_) {
+    case TransformMethod::k1BppTo8Bpp:
+    case TransformMethod::k1BppToManyBpp: {
+      for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+        const int src_start = col * box_ratio_x_;
+        uint32_t dest_a = 0;
+        for (int j = src_start; j < src_start + box_ratio_x_; ++j) {
+          if (src_scan[j / 8] & (1 << (7 - j % 8))) {
+            dest_a += 255;
+          }
+        }
+        dest_span[dest_span_index++] = dest_a / ratio;
+      }
+      break;
+    }
+    case TransformMethod::k8BppTo8Bpp: {
+      for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+        const int src_start = col * box_ratio_x_;
+        uint32_t dest_a = 0;
+        for (int j = src_start; j < src_start + box_ratio_x_; ++j) {
+          dest_a += src_scan[j];
+        }
+        dest_span[dest_span_index++] = dest_a / ratio;
+      }
+      break;
+    }
+    case TransformMethod::k8BppToManyBpp: {
+      for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+        const int src_start = col * box_ratio_x_;
+        uint32_t dest_r = 0;
+        uint32_t dest_g = 0;
+        uint32_t dest_b = 0;
+        for (int j = src_start; j < src_start + box_ratio_x_; ++j) {
+          FX_ARGB argb = src_palette_[src_scan[j]];
+          if (dest_format_ == FXDIB_Format::kBgr) {
+            dest_r += static_cast<uint8_t>(argb >> 16);
+            dest_g += static_cast<uint8_t>(argb >> 8);
+            dest_b += static_cast<uint8_t>(argb);
+          } else {
+            dest_b += static_cast<uint8_t>(argb >> 24);
+            dest_g += static_cast<uint8_t>(argb >> 16);
+            dest_r += static_cast<uint8_t>(argb >> 8);
+          }
+        }
+        dest_span[dest_span_index++] = dest_b / ratio;
+        dest_span[dest_span_index++] = dest_g / ratio;
+        dest_span[dest_span_index++] = dest_r / ratio;
+      }
+      break;
+    }
+    case TransformMethod::kManyBpptoManyBpp: {
+      for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+        const int src_start = col * box_ratio_x_;
+        uint32_t dest_r = 0;
+        uint32_t dest_g = 0;
+        uint32_t dest_b = 0;
+        for (int j = src_start; j < src_start + box_ratio_x_; ++j) {
+          pdfium::span<const uint8_t> src_pixel =
+              src_scan.subspan(static_cast<size_t>(j * Bpp), 3u);
+          dest_b += src_pixel[0];
+          dest_g += src_pixel[1];
+          dest_r += src_pixel[2];
+        }
+        dest_span[dest_span_index++] = dest_b / ratio;
+        dest_span[dest_span_index++] = dest_g / ratio;
+        dest_span[dest_span_index++] = dest_r / ratio;
+        dest_span_index += Bpp - 3;
+      }
+      break;
+    }
+    case TransformMethod::kManyBpptoManyBppWithAlpha: {
+      DCHECK(has_alpha_);
+      // Like the weighted pass, weight the color channels by alpha. Use wider
+      // sums, as these are not scaled down by the weights.
+      for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+        const int src_start = col * box_ratio_x_;
+        uint64_t dest_a = 0;
+        uint64_t dest_r = 0;
+        uint64_t dest_g = 0;
+        uint64_t dest_b = 0;
+        for (int j = src_start; j < src_start + box_ratio_x_; ++j) {
+          pdfium::span<const uint8_t> src_pixel =
+              src_scan.subspan(static_cast<size_t>(j * Bpp), 4u);
+          const uint32_t alpha = src_pixel[3];
+          dest_b += alpha * src_pixel[0];
+          dest_g += alpha * src_pixel[1];
+          dest_r += alpha * src_pixel[2];
+          dest_a += alpha;
+        }
+        dest_span[dest_span_index++] = dest_b / (255 * ratio);
+        dest_span[dest_span_index++] = dest_g / (255 * ratio);
+        dest_span[dest_span_index++] = dest_r / (255 * ratio);
+        dest_span[dest_span_index] = dest_a / ratio;
+        dest_span_index += Bpp - 3;
+      }
+      break;
+    }
+  }
+}
+
+void CStretchEngine::BoxFilterVert(int row) {
+  const int DestBpp = dest_bpp_ / 8;
+  const uint32_t ratio = box_ratio_y_;
+  const int src_start = row * box_ratio_y_ - src_clip_.top;
+  const int src_end = src_start + box_ratio_y_;
+  pdfium::span<uint8_t> dest_scan = dest_scanline_;
+  for (int col = dest_clip_.left; col < dest_clip_.right; ++col) {
+    const size_t offset = (col - dest_clip_.left) * DestBpp;
+    pdfium::span<const uint8_t> src_span = inter_buf_.subspan(offset);
+    pdfium::span<uint8_t> dest_pixel = dest_scan.subspan(offset);
+    switch (trans_method_) {
+      case TransformMethod::k1BppTo8Bpp:
+      case TransformMethod::k1BppToManyBpp:
+      case TransformMethod::k8BppTo8Bpp: {
+        uint32_t dest_a = 0;
+        for (int j = src_start; j < src_end; ++j) {
+          dest_a += src_span[j * inter_pitch_];
+        }
+        dest_pixel[0] = dest_a / ratio;
+        break;
+      }
+      case TransformMethod::k8BppToManyBpp:
+      case TransformMethod::kManyBpptoManyBpp: {
+        uint32_t dest_r = 0;
+        uint32_t dest_g = 0;
+        uint32_t dest_b = 0;
+        for (int j = src_start; j < src_end; ++j) {
+          pdfium::span<const uint8_t> src_pixel =
+              src_span.subspan(static_cast<size_t>(j * inter_pitch_), 3u);
+          dest_b += src_pixel[0];
+          dest_g += src_pixel[1];
+          dest_r += src_pixel[2];
+        }
+        dest_pixel[0] = dest_b / ratio;
+        dest_pixel[1] = dest_g / ratio;
+        dest_pixel[2] = dest_r / ratio;
+        break;
+      }
+      case TransformMethod::kManyBpptoManyBppWithAlpha: {
+        DCHECK(has_alpha_);
+        uint64_t dest_a = 0;
+        uint64_t dest_r = 0;
+        uint64_t dest_g = 0;
+        uint64_t dest_b = 0;
+        for (int j = src_start; j < src_end; ++j) {
+          pdfium::span<const uint8_t> src_pixel =
+              src_span.subspan(static_cast<size_t>(j * inter_pitch_), 4u);
+          dest_b += src_pixel[0];
+          dest_g += src_pixel[1];
+          dest_r += src_pixel[2];
+          dest_a += src_pixel[3];
+        }
+        if (dest_a) {
+          dest_pixel[0] = std::min<uint64_t>(dest_b * 255 / dest_a, 255);
+          dest_pixel[1] = std::min<uint64_t>(dest_g * 255 / dest_a, 255);
+          dest_pixel[2] = std::min<uint64_t>(dest_r * 255 / dest_a, 255);
+        }
+        dest_pixel[3] = dest_a / ratio;
+        break;
+      }
+    }
+  }
+}
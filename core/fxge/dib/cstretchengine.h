@@ -9,6 +9,8 @@
 
 #include <stdint.h>
 
+#include <optional>
+
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fixed_size_data_vector.h"
@@ -19,6 +21,10 @@
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/dib/fx_dib.h"
 
+namespace pdfium {
+enum class StretchPixelFormat;
+}  // namespace pdfium
+
 class CFX_DIBBase;
 class PauseIndicatorIface;
 class ScanlineComposerIface;
@@ -97,6 +103,9 @@ class CStretchEngine {
     const PixelWeight* GetPixelWeight(int pixel) const;
     PixelWeight* GetPixelWeight(int pixel);
 
+    // Distance in bytes between consecutive PixelWeight items.
+    size_t GetItemSizeBytes() const { return item_size_bytes_; }
+
    private:
     int dest_min_ = 0;
     size_t item_size_bytes_ = 0;
@@ -134,6 +143,22 @@ class CStretchEngine {
     kManyBpptoManyBppWithAlpha
   };
 
+  // The pixel format the vectorized passes handle `trans_method_` with, if
+  // they handle it at all.
+  std::optional<pdfium::StretchPixelFormat> GetHorizontalPixelFormat() const;
+  std::optional<pdfium::StretchPixelFormat> GetVerticalPixelFormat() const;
+
+  // Unpacks the pixels of `src_scan` within `src_clip_` into `src_pixels_`,
+  // for the vectorized horizontal pass.
+  void UnpackSourcePixels(pdfium::span<const uint8_t> src_scan);
+
+  // Box filter passes, used instead of the weight tables when
+  // `box_ratio_x_` and `box_ratio_y_` are set. Each destination pixel is the
+  // average of a `box_ratio_x_` by `box_ratio_y_` block of source pixels.
+  void BoxFilterHorz(pdfium::span<const uint8_t> src_scan,
+                     pdfium::span<uint8_t> dest_span) const;
+  void BoxFilterVert(int row);
+
   const FXDIB_Format dest_format_;
   const int dest_bpp_;
   const int src_bpp_;
@@ -148,9 +173,12 @@ class CStretchEngine {
   const FX_RECT dest_clip_;
   DataVector<uint8_t> dest_scanline_;
   FixedSizeDataVector<uint8_t> inter_buf_;
+  DataVector<uint32_t> src_pixels_;
   FX_RECT src_clip_;
   int inter_pitch_;
   int extra_mask_pitch_;
+  int box_ratio_x_ = 0;
+  int box_ratio_y_ = 0;
   FXDIB_ResampleOptions resample_options_;
   TransformMethod trans_method_;
   State state_ = State::kInitial;
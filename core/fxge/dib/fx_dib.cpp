@@ -42,7 +42,8 @@ static_assert(std::is_aggregate_v<FX_CMYK_STRUCT<float>>);
 FXDIB_ResampleOptions::FXDIB_ResampleOptions() = default;
 
 bool FXDIB_ResampleOptions::HasAnyOptions() const {
-  return bInterpolateBilinear || bHalftone || bNoSmoothing || bLossy;
+  return bInterpolateBilinear || bHalftone || bNoSmoothing || bLossy ||
+         bBoxFilter;
 }
 
 FX_BGRA_STRUCT<uint8_t> ArgbToBGRAStruct(FX_ARGB argb) {
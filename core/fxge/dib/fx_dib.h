@@ -112,6 +112,9 @@ struct FXDIB_ResampleOptions {
   bool bHalftone = false;
   bool bNoSmoothing = false;
   bool bLossy = false;
+  // Downscale by whole ratios by averaging each block of source pixels,
+  // without building a weight table.
+  bool bBoxFilter = false;
 };
 
 // See PDF 1.7 spec, table 7.2 and 7.3. The enum values need to be in the same
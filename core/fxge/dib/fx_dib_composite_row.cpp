@@ -0,0 +1,450 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/fx_dib_composite_row.h"
+
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/notreached.h"
+
+// Highway compiles this file once per instruction set it targets.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxge/dib/fx_dib_composite_row.cpp"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+
+#include "core/fxge/dib/fx_dib_simd_inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+using DU32 = hn::RebindToUnsigned<DI32>;
+
+// 2 * `a` * `b` / 255, which can exceed the range Div255() is exact for.
+HWY_INLINE VI32 DoubleProductDiv255(VI32 a, VI32 b) {
+  const DI32 di;
+  const VI32 product = hn::Mul(a, b);
+  const VI32 quotient = Div255(product);
+  const VI32 remainder = hn::Sub(product, hn::Mul(quotient, hn::Set(di, 255)));
+  const auto rounds_up =
+      hn::Ge(hn::Add(remainder, remainder), hn::Set(di, 255));
+  const VI32 round_up = hn::IfThenElseZero(rounds_up, hn::Set(di, 1));
+  return hn::Add(hn::Add(quotient, quotient), round_up);
+}
+
+HWY_INLINE VI32 BlendHardLight(VI32 back, VI32 src) {
+  const DI32 di;
+  const VI32 doubled_src = hn::Sub(hn::Add(src, src), hn::Set(di, 255));
+  const VI32 screen = hn::Sub(hn::Add(doubled_src, back),
+                              Div255(hn::Mul(doubled_src, back)));
+  return hn::IfThenElse(hn::Lt(src, hn::Set(di, 128)),
+                        DoubleProductDiv255(src, back), screen);
+}
+
+// fxge::Blend(), for the blend modes IsVectorizedBlendMode() accepts.
+HWY_INLINE VI32 BlendChannel(BlendMode blend_type, VI32 back, VI32 src) {
+  switch (blend_type) {
+    case BlendMode::kNormal:
+      return src;
+    case BlendMode::kMultiply:
+      return Div255(hn::Mul(src, back));
+    case BlendMode::kScreen:
+      return hn::Sub(hn::Add(src, back), Div255(hn::Mul(src, back)));
+    case BlendMode::kOverlay:
+      return BlendHardLight(src, back);
+    case BlendMode::kDarken:
+      return hn::Min(src, back);
+    case BlendMode::kLighten:
+      return hn::Max(src, back);
+    case BlendMode::kHardLight:
+      return BlendHardLight(back, src);
+    case BlendMode::kDifference:
+      return hn::Abs(hn::Sub(back, src));
+    case BlendMode::kExclusion:
+      return hn::Sub(hn::Add(back, src), DoubleProductDiv255(back, src));
+    default:
+      NOTREACHED();
+  }
+}
+
+// Composites `src_alpha` of a source color over BGRA pixels, like
+// CompositeRowBgra2Bgra() in cfx_scanlinecompositor.cpp. The scalar code
+// special-cases zero source alphas and transparent backdrops. The formula
+// gives the same pixels for the former. For the latter, the scalar code
+// either copies the source color, or leaves the pixel alone when the source
+// is transparent too, depending on `replace_transparent`.
+HWY_INLINE void CompositeOverBgra(BlendMode blend_type,
+                                  VI32 src_b,
+                                  VI32 src_g,
+                                  VI32 src_r,
+                                  VI32 src_alpha,
+                                  bool replace_transparent,
+                                  uint8_t* pixels) {
+  const DI32 di;
+  const DU8 du8;
+  hn::Vec<DU8> b;
+  hn::Vec<DU8> g;
+  hn::Vec<DU8> r;
+  hn::Vec<DU8> a;
+  hn::LoadInterleaved4(du8, pixels, b, g, r, a);
+  const VI32 back_alpha = hn::PromoteTo(di, a);
+  const VI32 dest_alpha = hn::Sub(hn::Add(back_alpha, src_alpha),
+                                  Div255(hn::Mul(back_alpha, src_alpha)));
+  const VI32 alpha_ratio =
+      DivideRoundingDown(hn::Mul(src_alpha, hn::Set(di, 255)),
+                          hn::Max(dest_alpha, hn::Set(di, 1)));
+  const auto transparent = hn::Eq(back_alpha, hn::Zero(di));
+  auto composite = [&](hn::Vec<DU8> back_bytes, VI32 src) {
+    const VI32 back = hn::PromoteTo(di, back_bytes);
+    VI32 blended = src;
+    if (blend_type != BlendMode::kNormal) {
+      blended =
+          AlphaMerge(src, BlendChannel(blend_type, back, src), back_alpha);
+    }
+    VI32 result = AlphaMerge(back, blended, alpha_ratio);
+    if (replace_transparent) {
+      result = hn::IfThenElse(transparent, src, result);
+    }
+    return ToBytes(result);
+  };
+  hn::StoreInterleaved4(composite(b, src_b), composite(g, src_g),
+                        composite(r, src_r), ToBytes(dest_alpha), du8, pixels);
+}
+
+// Composites `src_alpha` of a source color over BGR or BGRX pixels, like
+// CompositeRowBgra2Bgr() in cfx_scanlinecompositor.cpp.
+HWY_INLINE void CompositeOverBgr(BlendMode blend_type,
+                                 VI32 src_b,
+                                 VI32 src_g,
+                                 VI32 src_r,
+                                 VI32 src_alpha,
+                                 int bytes_per_pixel,
+                                 uint8_t* pixels) {
+  const DI32 di;
+  const DU8 du8;
+  auto composite = [&](hn::Vec<DU8> back_bytes, VI32 src) {
+    const VI32 back = hn::PromoteTo(di, back_bytes);
+    return ToBytes(
+        AlphaMerge(back, BlendChannel(blend_type, back, src), src_alpha));
+  };
+  hn::Vec<DU8> b;
+  hn::Vec<DU8> g;
+  hn::Vec<DU8> r;
+  if (bytes_per_pixel == 3) {
+    hn::LoadInterleaved3(du8, pixels, b, g, r);
+    hn::StoreInterleaved3(composite(b, src_b), composite(g, src_g),
+                          composite(r, src_r), du8, pixels);
+    return;
+  }
+  hn::Vec<DU8> x;
+  hn::LoadInterleaved4(du8, pixels, b, g, r, x);
+  hn::StoreInterleaved4(composite(b, src_b), composite(g, src_g),
+                        composite(r, src_r), x, du8, pixels);
+}
+
+// The source alpha of a byte mask pixel, like GetAlphaWithSrc() in
+// cfx_scanlinecompositor.cpp.
+HWY_INLINE VI32 ByteMaskAlpha(const uint8_t* src_scan,
+                              const uint8_t* clip_scan,
+                              VI32 mask_alpha) {
+  const DI32 di;
+  const VI32 alpha = hn::Mul(mask_alpha, LoadBytes(src_scan));
+  if (!clip_scan) {
+    return Div255(alpha);
+  }
+  return DivideRoundingDown(hn::Mul(alpha, LoadBytes(clip_scan)),
+                             hn::Set(di, 255 * 255));
+}
+
+size_t CompositeRowBgra2BgraImpl(const uint8_t* src_scan,
+                                 const uint8_t* clip_scan,
+                                 uint8_t* dest_scan,
+                                 size_t pixel_count,
+                                 BlendMode blend_type) {
+  const DI32 di;
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(di);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      hn::Vec<DU8> b;
+      hn::Vec<DU8> g;
+      hn::Vec<DU8> r;
+      hn::Vec<DU8> a;
+      hn::LoadInterleaved4(du8, src_scan + col * 4, b, g, r, a);
+      VI32 src_alpha = hn::PromoteTo(di, a);
+      if (clip_scan) {
+        src_alpha = Div255(hn::Mul(src_alpha, LoadBytes(clip_scan + col)));
+      }
+      CompositeOverBgra(blend_type, hn::PromoteTo(di, b), hn::PromoteTo(di, g),
+                        hn::PromoteTo(di, r), src_alpha,
+                        /*replace_transparent=*/true, dest_scan + col * 4);
+    }
+  });
+  return col;
+}
+
+size_t CompositeRowBgra2BgrImpl(const uint8_t* src_scan,
+                                const uint8_t* clip_scan,
+                                uint8_t* dest_scan,
+                                int dest_bytes_per_pixel,
+                                size_t pixel_count,
+                                BlendMode blend_type) {
+  const DI32 di;
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(di);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      hn::Vec<DU8> b;
+      hn::Vec<DU8> g;
+      hn::Vec<DU8> r;
+      hn::Vec<DU8> a;
+      hn::LoadInterleaved4(du8, src_scan + col * 4, b, g, r, a);
+      VI32 src_alpha = hn::PromoteTo(di, a);
+      if (clip_scan) {
+        src_alpha = Div255(hn::Mul(src_alpha, LoadBytes(clip_scan + col)));
+      }
+      CompositeOverBgr(blend_type, hn::PromoteTo(di, b), hn::PromoteTo(di, g),
+                       hn::PromoteTo(di, r), src_alpha, dest_bytes_per_pixel,
+                       dest_scan + col * dest_bytes_per_pixel);
+    }
+  });
+  return col;
+}
+
+size_t CompositeRowByteMask2BgraImpl(const uint8_t* src_scan,
+                                     const uint8_t* clip_scan,
+                                     uint8_t* dest_scan,
+                                     size_t pixel_count,
+                                     int mask_alpha,
+                                     const FX_BGR_STRUCT<uint8_t>& mask_color,
+                                     BlendMode blend_type) {
+  const DI32 di;
+  const size_t lanes = hn::Lanes(di);
+  const VI32 mask_alpha_vec = hn::Set(di, mask_alpha);
+  const VI32 blue = hn::Set(di, mask_color.blue);
+  const VI32 green = hn::Set(di, mask_color.green);
+  const VI32 red = hn::Set(di, mask_color.red);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      const VI32 src_alpha = ByteMaskAlpha(
+          src_scan + col, clip_scan ? clip_scan + col : nullptr,
+          mask_alpha_vec);
+      CompositeOverBgra(blend_type, blue, green, red, src_alpha,
+                        /*replace_transparent=*/true, dest_scan + col * 4);
+    }
+  });
+  return col;
+}
+
+size_t CompositeRowByteMask2BgrImpl(const uint8_t* src_scan,
+                                    const uint8_t* clip_scan,
+                                    uint8_t* dest_scan,
+                                    int dest_bytes_per_pixel,
+                                    size_t pixel_count,
+                                    int mask_alpha,
+                                    const FX_BGR_STRUCT<uint8_t>& mask_color,
+                                    BlendMode blend_type) {
+  const DI32 di;
+  const size_t lanes = hn::Lanes(di);
+  const VI32 mask_alpha_vec = hn::Set(di, mask_alpha);
+  const VI32 blue = hn::Set(di, mask_color.blue);
+  const VI32 green = hn::Set(di, mask_color.green);
+  const VI32 red = hn::Set(di, mask_color.red);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      const VI32 src_alpha = ByteMaskAlpha(
+          src_scan + col, clip_scan ? clip_scan + col : nullptr,
+          mask_alpha_vec);
+      CompositeOverBgr(blend_type, blue, green, red, src_alpha,
+                       dest_bytes_per_pixel,
+                       dest_scan + col * dest_bytes_per_pixel);
+    }
+  });
+  return col;
+}
+
+size_t CompositeRow8bppPal2BgraImpl(const uint8_t* src_scan,
+                                    const uint8_t* clip_scan,
+                                    uint8_t* dest_scan,
+                                    size_t pixel_count,
+                                    const uint32_t* palette) {
+  const DI32 di;
+  const DU8 du8;
+  const DU32 du32;
+  const size_t lanes = hn::Lanes(di);
+  const auto byte_mask = hn::Set(du32, 0xff);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      const auto argb =
+          hn::GatherIndex(du32, palette, LoadBytes(src_scan + col));
+      const VI32 blue = hn::BitCast(di, hn::And(argb, byte_mask));
+      const VI32 green =
+          hn::BitCast(di, hn::And(hn::ShiftRight<8>(argb), byte_mask));
+      const VI32 red =
+          hn::BitCast(di, hn::And(hn::ShiftRight<16>(argb), byte_mask));
+      uint8_t* pixels = dest_scan + col * 4;
+      if (!clip_scan) {
+        hn::StoreInterleaved4(ToBytes(blue), ToBytes(green), ToBytes(red),
+                              hn::Set(du8, 255), du8, pixels);
+        continue;
+      }
+      // Fully clipped pixels stay as they are, even transparent ones.
+      CompositeOverBgra(BlendMode::kNormal, blue, green, red,
+                        LoadBytes(clip_scan + col),
+                        /*replace_transparent=*/false, pixels);
+    }
+  });
+  return col;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace pdfium {
+
+namespace {
+
+bool g_vectorization_enabled = true;
+
+bool IsVectorizedBlendMode(BlendMode blend_type) {
+  switch (blend_type) {
+    case BlendMode::kNormal:
+    case BlendMode::kMultiply:
+    case BlendMode::kScreen:
+    case BlendMode::kOverlay:
+    case BlendMode::kDarken:
+    case BlendMode::kLighten:
+    case BlendMode::kHardLight:
+    case BlendMode::kDifference:
+    case BlendMode::kExclusion:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CanVectorize(BlendMode blend_type) {
+  return g_vectorization_enabled && IsVectorizedBlendMode(blend_type);
+}
+
+const uint8_t* GetClipData(pdfium::span<const uint8_t> clip_scan) {
+  return clip_scan.empty() ? nullptr : clip_scan.data();
+}
+
+}  // namespace
+
+HWY_EXPORT(CompositeRowBgra2BgraImpl);
+HWY_EXPORT(CompositeRowBgra2BgrImpl);
+HWY_EXPORT(CompositeRowByteMask2BgraImpl);
+HWY_EXPORT(CompositeRowByteMask2BgrImpl);
+HWY_EXPORT(CompositeRow8bppPal2BgraImpl);
+
+size_t CompositeRowBgra2BgraVectorized(pdfium::span<const uint8_t> src_scan,
+                                       pdfium::span<const uint8_t> clip_scan,
+                                       pdfium::span<uint8_t> dest_scan,
+                                       size_t pixel_count,
+                                       BlendMode blend_type) {
+  if (!CanVectorize(blend_type)) {
+    return 0;
+  }
+  CHECK_GE(src_scan.size(), pixel_count * 4);
+  CHECK_GE(dest_scan.size(), pixel_count * 4);
+  CHECK(clip_scan.empty() || clip_scan.size() >= pixel_count);
+  return HWY_DYNAMIC_DISPATCH(CompositeRowBgra2BgraImpl)(
+      src_scan.data(), GetClipData(clip_scan), dest_scan.data(), pixel_count,
+      blend_type);
+}
+
+size_t CompositeRowBgra2BgrVectorized(pdfium::span<const uint8_t> src_scan,
+                                      pdfium::span<const uint8_t> clip_scan,
+                                      pdfium::span<uint8_t> dest_scan,
+                                      int dest_bytes_per_pixel,
+                                      size_t pixel_count,
+                                      BlendMode blend_type) {
+  if (!CanVectorize(blend_type)) {
+    return 0;
+  }
+  CHECK(dest_bytes_per_pixel == 3 || dest_bytes_per_pixel == 4);
+  CHECK_GE(src_scan.size(), pixel_count * 4);
+  CHECK_GE(dest_scan.size(), pixel_count * dest_bytes_per_pixel);
+  CHECK(clip_scan.empty() || clip_scan.size() >= pixel_count);
+  return HWY_DYNAMIC_DISPATCH(CompositeRowBgra2BgrImpl)(
+      src_scan.data(), GetClipData(clip_scan), dest_scan.data(),
+      dest_bytes_per_pixel, pixel_count, blend_type);
+}
+
+size_t CompositeRowByteMask2BgraVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    size_t pixel_count,
+    int mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& mask_color,
+    BlendMode blend_type) {
+  // The scalar code ignores the clip past its end, which is not worth
+  // vectorizing.
+  if (!CanVectorize(blend_type) ||
+      (!clip_scan.empty() && clip_scan.size() < pixel_count)) {
+    return 0;
+  }
+  CHECK_GE(src_scan.size(), pixel_count);
+  CHECK_GE(dest_scan.size(), pixel_count * 4);
+  return HWY_DYNAMIC_DISPATCH(CompositeRowByteMask2BgraImpl)(
+      src_scan.data(), GetClipData(clip_scan), dest_scan.data(), pixel_count,
+      mask_alpha, mask_color, blend_type);
+}
+
+size_t CompositeRowByteMask2BgrVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    int dest_bytes_per_pixel,
+    size_t pixel_count,
+    int mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& mask_color,
+    BlendMode blend_type) {
+  if (!CanVectorize(blend_type) ||
+      (!clip_scan.empty() && clip_scan.size() < pixel_count)) {
+    return 0;
+  }
+  CHECK(dest_bytes_per_pixel == 3 || dest_bytes_per_pixel == 4);
+  CHECK_GE(src_scan.size(), pixel_count);
+  CHECK_GE(dest_scan.size(), pixel_count * dest_bytes_per_pixel);
+  return HWY_DYNAMIC_DISPATCH(CompositeRowByteMask2BgrImpl)(
+      src_scan.data(), GetClipData(clip_scan), dest_scan.data(),
+      dest_bytes_per_pixel, pixel_count, mask_alpha, mask_color, blend_type);
+}
+
+size_t CompositeRow8bppPal2BgraVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    size_t pixel_count,
+    pdfium::span<const uint32_t> palette) {
+  if (!g_vectorization_enabled) {
+    return 0;
+  }
+  CHECK_EQ(palette.size(), 256u);
+  CHECK_GE(src_scan.size(), pixel_count);
+  CHECK_GE(dest_scan.size(), pixel_count * 4);
+  CHECK(clip_scan.empty() || clip_scan.size() >= pixel_count);
+  return HWY_DYNAMIC_DISPATCH(CompositeRow8bppPal2BgraImpl)(
+      src_scan.data(), GetClipData(clip_scan), dest_scan.data(), pixel_count,
+      palette.data());
+}
+
+void SetCompositeRowVectorizationForTesting(bool enabled) {
+  g_vectorization_enabled = enabled;
+}
+
+}  // namespace pdfium
+#endif  // HWY_ONCE
@@ -0,0 +1,72 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_FX_DIB_COMPOSITE_ROW_H_
+#define CORE_FXGE_DIB_FX_DIB_COMPOSITE_ROW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/fx_dib.h"
+
+namespace pdfium {
+
+// Vectorized versions of the most common CFX_ScanlineCompositor rows, for
+// destinations in BGR byte order. Each one composites as many pixels from the
+// start of the row as fill whole vectors, and returns how many it composited.
+// The caller composites the rest with the scalar code, which gives identical
+// results. They composite nothing for blend modes without a vectorized
+// version: the non-separable ones, color dodge, color burn and soft light.
+//
+// `clip_scan` is optional. `dest_bytes_per_pixel` is 3 for kBgr and 4 for
+// kBgrx, whose last byte is left alone.
+
+size_t CompositeRowBgra2BgraVectorized(pdfium::span<const uint8_t> src_scan,
+                                       pdfium::span<const uint8_t> clip_scan,
+                                       pdfium::span<uint8_t> dest_scan,
+                                       size_t pixel_count,
+                                       BlendMode blend_type);
+
+size_t CompositeRowBgra2BgrVectorized(pdfium::span<const uint8_t> src_scan,
+                                      pdfium::span<const uint8_t> clip_scan,
+                                      pdfium::span<uint8_t> dest_scan,
+                                      int dest_bytes_per_pixel,
+                                      size_t pixel_count,
+                                      BlendMode blend_type);
+
+size_t CompositeRowByteMask2BgraVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    size_t pixel_count,
+    int mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& mask_color,
+    BlendMode blend_type);
+
+size_t CompositeRowByteMask2BgrVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    int dest_bytes_per_pixel,
+    size_t pixel_count,
+    int mask_alpha,
+    const FX_BGR_STRUCT<uint8_t>& mask_color,
+    BlendMode blend_type);
+
+// Expands 8bpp palette indices to BGRA. `palette` has 256 entries.
+size_t CompositeRow8bppPal2BgraVectorized(
+    pdfium::span<const uint8_t> src_scan,
+    pdfium::span<const uint8_t> clip_scan,
+    pdfium::span<uint8_t> dest_scan,
+    size_t pixel_count,
+    pdfium::span<const uint32_t> palette);
+
+// When disabled, the functions above composite nothing, so that tests and
+// fuzzers can run the scalar code on its own. Enabled by default.
+void SetCompositeRowVectorizationForTesting(bool enabled);
+
+}  // namespace pdfium
+
+#endif  // CORE_FXGE_DIB_FX_DIB_COMPOSITE_ROW_H_
@@ -0,0 +1,135 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/fx_dib_composite_row.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxge/dib/cfx_scanlinecompositor.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+// Odd, so the scalar code always has a remainder to composite.
+constexpr int kWidth = 1001;
+constexpr FXDIB_Format kDestFormats[] = {
+    FXDIB_Format::kBgr, FXDIB_Format::kBgrx, FXDIB_Format::kBgra};
+constexpr uint32_t kMaskColors[] = {0xff336699, 0x80ff0010, 0x00102030};
+
+// Bytes covering every value, including the 0 and 255 edge cases, in a
+// pseudo-random order.
+std::vector<uint8_t> MakeBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t value = (seed >> 16) % 300;
+    bytes[i] = value >= 256 ? (value % 2 ? 255 : 0) : value;
+  }
+  return bytes;
+}
+
+std::vector<uint32_t> MakePalette() {
+  const std::vector<uint8_t> bytes = MakeBytes(256 * 4, 7);
+  std::vector<uint32_t> palette(256);
+  for (size_t i = 0; i < palette.size(); ++i) {
+    palette[i] = ArgbEncode(bytes[i * 4], bytes[i * 4 + 1], bytes[i * 4 + 2],
+                            bytes[i * 4 + 3]);
+  }
+  return palette;
+}
+
+// Composites `src_scan` onto the same destination row with and without the
+// vectorized code, and checks that the results match.
+void CheckMatchesScalar(const CFX_ScanlineCompositor& compositor,
+                        FXDIB_Format src_format,
+                        FXDIB_Format dest_format,
+                        pdfium::span<const uint8_t> src_scan,
+                        pdfium::span<const uint8_t> clip_scan) {
+  std::vector<uint8_t> expected =
+      MakeBytes(kWidth * GetCompsFromFormat(dest_format), 3);
+  std::vector<uint8_t> actual = expected;
+  auto composite = [&](std::vector<uint8_t>& dest_scan) {
+    switch (src_format) {
+      case FXDIB_Format::k8bppMask:
+        compositor.CompositeByteMaskLine(dest_scan, src_scan, kWidth,
+                                         clip_scan);
+        break;
+      case FXDIB_Format::k8bppRgb:
+        compositor.CompositePalBitmapLine(dest_scan, src_scan, /*src_left=*/0,
+                                          kWidth, clip_scan);
+        break;
+      default:
+        compositor.CompositeRgbBitmapLine(dest_scan, src_scan, kWidth,
+                                          clip_scan);
+        break;
+    }
+  };
+  SetCompositeRowVectorizationForTesting(false);
+  composite(expected);
+  SetCompositeRowVectorizationForTesting(true);
+  composite(actual);
+  EXPECT_EQ(expected, actual);
+}
+
+}  // namespace
+
+TEST(CompositeRowVectorized, Bgra) {
+  const std::vector<uint8_t> src_scan = MakeBytes(kWidth * 4, 1);
+  const std::vector<uint8_t> clip = MakeBytes(kWidth, 2);
+  for (FXDIB_Format dest_format : kDestFormats) {
+    for (int mode = 0; mode <= static_cast<int>(BlendMode::kLast); ++mode) {
+      SCOPED_TRACE(mode);
+      CFX_ScanlineCompositor compositor;
+      ASSERT_TRUE(compositor.Init(dest_format, FXDIB_Format::kBgra, {},
+                                  /*mask_color=*/0,
+                                  static_cast<BlendMode>(mode),
+                                  /*bRgbByteOrder=*/false));
+      CheckMatchesScalar(compositor, FXDIB_Format::kBgra, dest_format,
+                         src_scan, {});
+      CheckMatchesScalar(compositor, FXDIB_Format::kBgra, dest_format,
+                         src_scan, clip);
+    }
+  }
+}
+
+TEST(CompositeRowVectorized, ByteMask) {
+  const std::vector<uint8_t> src_scan = MakeBytes(kWidth, 4);
+  const std::vector<uint8_t> clip = MakeBytes(kWidth, 5);
+  for (FXDIB_Format dest_format : kDestFormats) {
+    for (uint32_t mask_color : kMaskColors) {
+      for (int mode = 0; mode <= static_cast<int>(BlendMode::kLast); ++mode) {
+        SCOPED_TRACE(mode);
+        CFX_ScanlineCompositor compositor;
+        ASSERT_TRUE(compositor.Init(dest_format, FXDIB_Format::k8bppMask, {},
+                                    mask_color, static_cast<BlendMode>(mode),
+                                    /*bRgbByteOrder=*/false));
+        CheckMatchesScalar(compositor, FXDIB_Format::k8bppMask, dest_format,
+                           src_scan, {});
+        CheckMatchesScalar(compositor, FXDIB_Format::k8bppMask, dest_format,
+                           src_scan, clip);
+      }
+    }
+  }
+}
+
+TEST(CompositeRowVectorized, Palette) {
+  const std::vector<uint8_t> src_scan = MakeBytes(kWidth, 6);
+  const std::vector<uint8_t> clip = MakeBytes(kWidth, 8);
+  const std::vector<uint32_t> palette = MakePalette();
+  CFX_ScanlineCompositor compositor;
+  ASSERT_TRUE(compositor.Init(FXDIB_Format::kBgra, FXDIB_Format::k8bppRgb,
+                              palette, /*mask_color=*/0, BlendMode::kNormal,
+                              /*bRgbByteOrder=*/false));
+  CheckMatchesScalar(compositor, FXDIB_Format::k8bppRgb, FXDIB_Format::kBgra,
+                     src_scan, {});
+  CheckMatchesScalar(compositor, FXDIB_Format::k8bppRgb, FXDIB_Format::kBgra,
+                     src_scan, clip);
+}
+
+}  // namespace pdfium
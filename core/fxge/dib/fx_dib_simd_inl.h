@@ -0,0 +1,80 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Highway helpers shared by the vectorized pixel compositors. Like any
+// Highway "-inl" header, this gets included once per target, from files that
+// "hwy/foreach_target.h" compiles several times, after "hwy/highway.h".
+
+// Per-target include guard.
+#if defined(CORE_FXGE_DIB_FX_DIB_SIMD_INL_H_) == defined(HWY_TARGET_TOGGLE)
+#ifdef CORE_FXGE_DIB_FX_DIB_SIMD_INL_H_
+#undef CORE_FXGE_DIB_FX_DIB_SIMD_INL_H_
+#else
+#define CORE_FXGE_DIB_FX_DIB_SIMD_INL_H_
+#endif
+
+#include <stdint.h>
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+// All math happens in 32-bit lanes, on one byte per lane.
+using DI32 = hn::ScalableTag<int32_t>;
+using DU8 = hn::Rebind<uint8_t, DI32>;
+using DF32 = hn::Rebind<float, DI32>;
+using VI32 = hn::Vec<DI32>;
+
+// x / 255, exact for 0 <= x <= 255 * 255.
+HWY_INLINE VI32 Div255(VI32 x) {
+  const DI32 di;
+  return hn::ShiftRight<8>(hn::Add(hn::Add(x, hn::Set(di, 1)),
+                                   hn::ShiftRight<8>(x)));
+}
+
+// FXDIB_ALPHA_MERGE().
+HWY_INLINE VI32 AlphaMerge(VI32 backdrop, VI32 source, VI32 source_alpha) {
+  const DI32 di;
+  return Div255(
+      hn::Add(hn::Mul(backdrop, hn::Sub(hn::Set(di, 255), source_alpha)),
+              hn::Mul(source, source_alpha)));
+}
+
+HWY_INLINE VI32 LoadBytes(const uint8_t* src) {
+  const DI32 di;
+  const DU8 du8;
+  return hn::PromoteTo(di, hn::LoadU(du8, src));
+}
+
+HWY_INLINE hn::Vec<DU8> ToBytes(VI32 v) {
+  const DU8 du8;
+  return hn::DemoteTo(du8, v);
+}
+
+// `numerator` / `denominator`, rounded down, for non-negative numerators below
+// 2^24. Uses a float division, then fixes up the result, as the division is
+// approximate on some targets.
+HWY_INLINE VI32 DivideRoundingDown(VI32 numerator, VI32 denominator) {
+  const DI32 di;
+  const DF32 df;
+  const VI32 one = hn::Set(di, 1);
+  VI32 quotient =
+      hn::ConvertTo(di, hn::Div(hn::ConvertTo(df, numerator),
+                                hn::ConvertTo(df, denominator)));
+  quotient = hn::IfThenElse(hn::Gt(hn::Mul(quotient, denominator), numerator),
+                            hn::Sub(quotient, one), quotient);
+  return hn::IfThenElse(
+      hn::Le(hn::Mul(hn::Add(quotient, one), denominator), numerator),
+      hn::Add(quotient, one), quotient);
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#endif  // CORE_FXGE_DIB_FX_DIB_SIMD_INL_H_
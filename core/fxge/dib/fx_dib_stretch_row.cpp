@@ -0,0 +1,312 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/fx_dib_stretch_row.h"
+
+#include <stddef.h>
+
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/check_op.h"
+#include "core/fxcrt/compiler_specific.h"
+
+// Highway compiles this file once per instruction set it targets.
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "core/fxge/dib/fx_dib_stretch_row.cpp"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+
+#include "core/fxge/dib/fx_dib_simd_inl.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace pdfium {
+namespace HWY_NAMESPACE {
+
+using DU32 = hn::RebindToUnsigned<DI32>;
+using VU32 = hn::Vec<DU32>;
+
+// CStretchEngine::PixelFromFixed(), which keeps the low byte of the integer
+// part.
+HWY_INLINE hn::Vec<DU8> PixelFromFixed(VI32 fixed) {
+  const DI32 di;
+  return ToBytes(hn::And(hn::ShiftRight<CStretchEngine::kFixedPointBits>(fixed),
+                         hn::Set(di, 0xff)));
+}
+
+// Byte `index` of each lane.
+HWY_INLINE VI32 Channel(VU32 pixels, int index) {
+  const DI32 di;
+  const DU32 du32;
+  return hn::BitCast(
+      di, hn::And(hn::ShiftRightSame(pixels, index * 8), hn::Set(du32, 0xff)));
+}
+
+// `color` * 255 / `alpha`, clamped to 255, for colors no larger than `alpha`,
+// as the vertical pass sums always are. The numerators go past 2^31, so this
+// works on unsigned lanes. The float division is close enough for the fix-ups
+// to make the result exact.
+HWY_INLINE VI32 Unpremultiply(VI32 color, VI32 alpha) {
+  const DI32 di;
+  const DF32 df;
+  const DU32 du32;
+  const VU32 one = hn::Set(du32, 1);
+  const VU32 numerator = hn::Mul(hn::BitCast(du32, color), hn::Set(du32, 255));
+  const VU32 denominator = hn::BitCast(du32, hn::Max(alpha, hn::Set(di, 1)));
+  const hn::Vec<DF32> float_quotient =
+      hn::Div(hn::Mul(hn::ConvertTo(df, color), hn::Set(df, 255.0f)),
+              hn::ConvertTo(df, hn::BitCast(di, denominator)));
+  VU32 quotient = hn::BitCast(du32, hn::ConvertTo(di, float_quotient));
+  quotient = hn::IfThenElse(hn::Gt(hn::Mul(quotient, denominator), numerator),
+                            hn::Sub(quotient, one), quotient);
+  quotient = hn::IfThenElse(
+      hn::Le(hn::Mul(hn::Add(quotient, one), denominator), numerator),
+      hn::Add(quotient, one), quotient);
+  return hn::Min(hn::BitCast(di, quotient), hn::Set(di, 255));
+}
+
+size_t StretchRowHorizontalImpl(const uint32_t* src_pixels,
+                                size_t src_pixel_count,
+                                int src_offset,
+                                const uint8_t* weight_items,
+                                size_t weight_item_size,
+                                size_t dest_pixel_count,
+                                StretchPixelFormat format,
+                                int dest_bytes_per_pixel,
+                                uint8_t* dest_scan) {
+  const DI32 di;
+  const DU8 du8;
+  const DU32 du32;
+  const size_t lanes = hn::Lanes(di);
+  const int32_t* weight_words = reinterpret_cast<const int32_t*>(weight_items);
+  const VI32 item_size = hn::Set(di, static_cast<int32_t>(weight_item_size));
+  using PixelWeight = CStretchEngine::PixelWeight;
+  const VI32 start_offset =
+      hn::Set(di, static_cast<int32_t>(offsetof(PixelWeight, src_start_)));
+  const VI32 end_offset =
+      hn::Set(di, static_cast<int32_t>(offsetof(PixelWeight, src_end_)));
+  const VI32 weights_offset =
+      hn::Set(di, static_cast<int32_t>(offsetof(PixelWeight, weights_)));
+  const VI32 first_pixel = hn::Set(di, src_offset);
+  const VI32 last_index =
+      hn::Set(di, static_cast<int32_t>(src_pixel_count) - 1);
+  const VI32 zero = hn::Zero(di);
+  const VI32 max_alpha = hn::Set(di, 255);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= dest_pixel_count; col += lanes) {
+      // Each lane handles one destination pixel, and the loop below adds up
+      // one source pixel of each at a time.
+      const VI32 items = hn::Mul(
+          hn::Add(hn::Set(di, static_cast<int32_t>(col)), hn::Iota(di, 0)),
+          item_size);
+      const VI32 starts =
+          hn::GatherOffset(di, weight_words, hn::Add(items, start_offset));
+      const VI32 ends =
+          hn::GatherOffset(di, weight_words, hn::Add(items, end_offset));
+      const VI32 last_taps = hn::Sub(ends, starts);
+      const int tap_count = hn::ReduceMax(di, last_taps) + 1;
+      VI32 sum0 = zero;
+      VI32 sum1 = zero;
+      VI32 sum2 = zero;
+      VI32 sum_alpha = zero;
+      for (int tap = 0; tap < tap_count; ++tap) {
+        const VI32 tap_vec = hn::Set(di, tap);
+        // Lanes with fewer taps read a weight past their last one, which is
+        // still inside their table item, and ignore it.
+        VI32 weight = hn::GatherOffset(
+            di, weight_words,
+            hn::Add(hn::Add(items, weights_offset), hn::ShiftLeft<2>(tap_vec)));
+        weight = hn::IfThenElseZero(hn::Le(tap_vec, last_taps), weight);
+        const VI32 index = hn::Min(
+            hn::Max(hn::Sub(hn::Add(starts, tap_vec), first_pixel), zero),
+            last_index);
+        const VU32 pixels = hn::GatherIndex(du32, src_pixels, index);
+        if (format == StretchPixelFormat::kBgra) {
+          weight = DivideRoundingDown(hn::Mul(weight, Channel(pixels, 3)),
+                                      max_alpha);
+          sum_alpha = hn::Add(sum_alpha, weight);
+        }
+        sum0 = hn::Add(sum0, hn::Mul(weight, Channel(pixels, 0)));
+        if (format != StretchPixelFormat::kGray) {
+          sum1 = hn::Add(sum1, hn::Mul(weight, Channel(pixels, 1)));
+          sum2 = hn::Add(sum2, hn::Mul(weight, Channel(pixels, 2)));
+        }
+      }
+      uint8_t* dest = dest_scan + col * dest_bytes_per_pixel;
+      switch (format) {
+        case StretchPixelFormat::kGray:
+          hn::StoreU(PixelFromFixed(sum0), du8, dest);
+          break;
+        case StretchPixelFormat::kBgr:
+          if (dest_bytes_per_pixel == 3) {
+            hn::StoreInterleaved3(PixelFromFixed(sum0), PixelFromFixed(sum1),
+                                  PixelFromFixed(sum2), du8, dest);
+          } else {
+            hn::Vec<DU8> b;
+            hn::Vec<DU8> g;
+            hn::Vec<DU8> r;
+            hn::Vec<DU8> x;
+            hn::LoadInterleaved4(du8, dest, b, g, r, x);
+            hn::StoreInterleaved4(PixelFromFixed(sum0), PixelFromFixed(sum1),
+                                  PixelFromFixed(sum2), x, du8, dest);
+          }
+          break;
+        case StretchPixelFormat::kBgra:
+          hn::StoreInterleaved4(PixelFromFixed(sum0), PixelFromFixed(sum1),
+                                PixelFromFixed(sum2),
+                                PixelFromFixed(hn::Mul(sum_alpha, max_alpha)),
+                                du8, dest);
+          break;
+      }
+    }
+  });
+  return col;
+}
+
+size_t StretchRowVerticalImpl(const uint8_t* src,
+                              size_t src_pitch,
+                              const uint32_t* weights,
+                              size_t weight_count,
+                              StretchPixelFormat format,
+                              int bytes_per_pixel,
+                              uint8_t* dest_scan,
+                              size_t pixel_count) {
+  const DI32 di;
+  const DU8 du8;
+  const size_t lanes = hn::Lanes(di);
+  const VI32 zero = hn::Zero(di);
+  size_t col = 0;
+  UNSAFE_TODO({
+    for (; col + lanes <= pixel_count; col += lanes) {
+      // Each lane handles one pixel, and the loop below adds up one source
+      // row at a time.
+      const size_t offset = col * bytes_per_pixel;
+      uint8_t* dest = dest_scan + offset;
+      if (format == StretchPixelFormat::kGray) {
+        VI32 sum = zero;
+        for (size_t i = 0; i < weight_count; ++i) {
+          const VI32 weight = hn::Set(di, static_cast<int32_t>(weights[i]));
+          const VI32 pixels = LoadBytes(src + i * src_pitch + offset);
+          sum = hn::Add(sum, hn::Mul(weight, pixels));
+        }
+        hn::StoreU(PixelFromFixed(sum), du8, dest);
+        continue;
+      }
+      VI32 sum_b = zero;
+      VI32 sum_g = zero;
+      VI32 sum_r = zero;
+      VI32 sum_a = zero;
+      for (size_t i = 0; i < weight_count; ++i) {
+        const VI32 weight = hn::Set(di, static_cast<int32_t>(weights[i]));
+        const uint8_t* row = src + i * src_pitch + offset;
+        hn::Vec<DU8> b;
+        hn::Vec<DU8> g;
+        hn::Vec<DU8> r;
+        if (bytes_per_pixel == 3) {
+          hn::LoadInterleaved3(du8, row, b, g, r);
+        } else {
+          hn::Vec<DU8> a;
+          hn::LoadInterleaved4(du8, row, b, g, r, a);
+          if (format == StretchPixelFormat::kBgra) {
+            sum_a = hn::Add(sum_a, hn::Mul(weight, hn::PromoteTo(di, a)));
+          }
+        }
+        sum_b = hn::Add(sum_b, hn::Mul(weight, hn::PromoteTo(di, b)));
+        sum_g = hn::Add(sum_g, hn::Mul(weight, hn::PromoteTo(di, g)));
+        sum_r = hn::Add(sum_r, hn::Mul(weight, hn::PromoteTo(di, r)));
+      }
+      if (bytes_per_pixel == 3) {
+        hn::StoreInterleaved3(PixelFromFixed(sum_b), PixelFromFixed(sum_g),
+                              PixelFromFixed(sum_r), du8, dest);
+        continue;
+      }
+      hn::Vec<DU8> b;
+      hn::Vec<DU8> g;
+      hn::Vec<DU8> r;
+      hn::Vec<DU8> x;
+      hn::LoadInterleaved4(du8, dest, b, g, r, x);
+      if (format == StretchPixelFormat::kBgr) {
+        hn::StoreInterleaved4(PixelFromFixed(sum_b), PixelFromFixed(sum_g),
+                              PixelFromFixed(sum_r), x, du8, dest);
+        continue;
+      }
+      // Pixels without any alpha keep the colors already in `dest_scan`.
+      const auto transparent = hn::Eq(sum_a, zero);
+      auto unpremultiply = [&](VI32 sum, hn::Vec<DU8> old_color) {
+        return ToBytes(hn::IfThenElse(transparent, hn::PromoteTo(di, old_color),
+                                      Unpremultiply(sum, sum_a)));
+      };
+      hn::StoreInterleaved4(unpremultiply(sum_b, b), unpremultiply(sum_g, g),
+                            unpremultiply(sum_r, r), PixelFromFixed(sum_a),
+                            du8, dest);
+    }
+  });
+  return col;
+}
+
+}  // namespace HWY_NAMESPACE
+}  // namespace pdfium
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace pdfium {
+
+namespace {
+
+bool g_vectorization_enabled = true;
+
+}  // namespace
+
+HWY_EXPORT(StretchRowHorizontalImpl);
+HWY_EXPORT(StretchRowVerticalImpl);
+
+size_t StretchRowHorizontalVectorized(
+    pdfium::span<const uint32_t> src_pixels,
+    int src_offset,
+    const CStretchEngine::WeightTable& table,
+    int dest_left,
+    int dest_right,
+    StretchPixelFormat format,
+    int dest_bytes_per_pixel,
+    pdfium::span<uint8_t> dest_scan) {
+  if (!g_vectorization_enabled || src_pixels.empty() ||
+      dest_left >= dest_right) {
+    return 0;
+  }
+  const size_t dest_pixel_count = dest_right - dest_left;
+  CHECK_GE(dest_scan.size(), dest_pixel_count * dest_bytes_per_pixel);
+  return HWY_DYNAMIC_DISPATCH(StretchRowHorizontalImpl)(
+      src_pixels.data(), src_pixels.size(), src_offset,
+      reinterpret_cast<const uint8_t*>(table.GetPixelWeight(dest_left)),
+      table.GetItemSizeBytes(), dest_pixel_count, format, dest_bytes_per_pixel,
+      dest_scan.data());
+}
+
+size_t StretchRowVerticalVectorized(pdfium::span<const uint8_t> src,
+                                    size_t src_pitch,
+                                    pdfium::span<const uint32_t> weights,
+                                    StretchPixelFormat format,
+                                    int bytes_per_pixel,
+                                    pdfium::span<uint8_t> dest_scan,
+                                    size_t pixel_count) {
+  if (!g_vectorization_enabled || weights.empty()) {
+    return 0;
+  }
+  CHECK_GE(src.size(),
+           (weights.size() - 1) * src_pitch + pixel_count * bytes_per_pixel);
+  CHECK_GE(dest_scan.size(), pixel_count * bytes_per_pixel);
+  return HWY_DYNAMIC_DISPATCH(StretchRowVerticalImpl)(
+      src.data(), src_pitch, weights.data(), weights.size(), format,
+      bytes_per_pixel, dest_scan.data(), pixel_count);
+}
+
+bool IsStretchVectorizationEnabled() {
+  return g_vectorization_enabled;
+}
+
+void SetStretchVectorizationForTesting(bool enabled) {
+  g_vectorization_enabled = enabled;
+}
+
+}  // namespace pdfium
+#endif  // HWY_ONCE
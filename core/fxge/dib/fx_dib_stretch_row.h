@@ -0,0 +1,65 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CORE_FXGE_DIB_FX_DIB_STRETCH_ROW_H_
+#define CORE_FXGE_DIB_FX_DIB_STRETCH_ROW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/fxcrt/span.h"
+#include "core/fxge/dib/cstretchengine.h"
+
+namespace pdfium {
+
+// The pixels the CStretchEngine passes produce.
+enum class StretchPixelFormat {
+  // One gray or mask byte per pixel.
+  kGray,
+  // Blue, green and red bytes, in 3 or 4 byte pixels. The fourth byte is left
+  // alone.
+  kBgr,
+  // Blue, green, red and alpha bytes. The horizontal pass weights the colors
+  // by alpha, and the vertical pass divides them by alpha again.
+  kBgra,
+};
+
+// Vectorized versions of the CStretchEngine passes. Each one resamples as
+// many pixels from the start of a row as fill whole vectors, and returns how
+// many it resampled. The caller resamples the rest with the scalar code. The
+// results are identical to the scalar ones, as both add up the same integer
+// products.
+
+// Horizontal pass, for destination pixels `dest_left` to `dest_right`.
+// `src_pixels` holds the source row from source pixel `src_offset` on, with
+// the channels of each pixel packed into a uint32_t, blue or gray in the low
+// byte.
+size_t StretchRowHorizontalVectorized(
+    pdfium::span<const uint32_t> src_pixels,
+    int src_offset,
+    const CStretchEngine::WeightTable& table,
+    int dest_left,
+    int dest_right,
+    StretchPixelFormat format,
+    int dest_bytes_per_pixel,
+    pdfium::span<uint8_t> dest_scan);
+
+// Vertical pass. `src` starts at the first source row `weights` applies to,
+// and the following rows are `src_pitch` bytes apart.
+size_t StretchRowVerticalVectorized(pdfium::span<const uint8_t> src,
+                                    size_t src_pitch,
+                                    pdfium::span<const uint32_t> weights,
+                                    StretchPixelFormat format,
+                                    int bytes_per_pixel,
+                                    pdfium::span<uint8_t> dest_scan,
+                                    size_t pixel_count);
+
+// When disabled, CStretchEngine only uses its scalar code, so that tests can
+// compare the two. Enabled by default.
+bool IsStretchVectorizationEnabled();
+void SetStretchVectorizationForTesting(bool enabled);
+
+}  // namespace pdfium
+
+#endif  // CORE_FXGE_DIB_FX_DIB_STRETCH_ROW_H_
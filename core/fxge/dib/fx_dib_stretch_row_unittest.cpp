@@ -0,0 +1,121 @@
+// Copyright 2026 The PDFium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "core/fxge/dib/fx_dib_stretch_row.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/fxcrt/retain_ptr.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
+#include "core/fxge/dib/fx_dib.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pdfium {
+
+namespace {
+
+constexpr int kSrcWidth = 120;
+constexpr int kSrcHeight = 90;
+
+struct DestSize {
+  int width;
+  int height;
+};
+
+// Downscales by whole and fractional ratios, upscales, and mirror images.
+constexpr DestSize kDestSizes[] = {
+    {40, 30}, {37, 23}, {250, 151}, {-61, 45}, {7, -200}, {120, 3},
+};
+
+constexpr FXDIB_Format kSrcFormats[] = {
+    FXDIB_Format::k1bppMask, FXDIB_Format::k8bppMask, FXDIB_Format::k8bppRgb,
+    FXDIB_Format::kBgr,      FXDIB_Format::kBgrx,     FXDIB_Format::kBgra,
+};
+
+// Pseudo-random bytes, with runs of 0 and 255 mixed in.
+std::vector<uint8_t> MakeBytes(size_t size, uint32_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const uint32_t value = (seed >> 16) % 300;
+    bytes[i] = value >= 256 ? (value % 2 ? 255 : 0) : value;
+  }
+  return bytes;
+}
+
+RetainPtr<CFX_DIBitmap> MakeSource(FXDIB_Format format) {
+  auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  if (!bitmap->Create(kSrcWidth, kSrcHeight, format)) {
+    return nullptr;
+  }
+  const std::vector<uint8_t> bytes =
+      MakeBytes(bitmap->GetPitch() * kSrcHeight, 1);
+  size_t offset = 0;
+  for (int row = 0; row < kSrcHeight; ++row) {
+    for (uint8_t& byte : bitmap->GetWritableScanline(row)) {
+      byte = bytes[offset++];
+    }
+  }
+  if (format == FXDIB_Format::k8bppRgb) {
+    const std::vector<uint8_t> palette = MakeBytes(256 * 3, 2);
+    for (int i = 0; i < 256; ++i) {
+      bitmap->SetPaletteArgb(i, ArgbEncode(255, palette[i * 3],
+                                           palette[i * 3 + 1],
+                                           palette[i * 3 + 2]));
+    }
+  }
+  return bitmap;
+}
+
+std::vector<uint8_t> Stretch(const RetainPtr<CFX_DIBitmap>& src,
+                             const DestSize& size,
+                             const FXDIB_ResampleOptions& options,
+                             bool vectorized) {
+  SetStretchVectorizationForTesting(vectorized);
+  RetainPtr<CFX_DIBitmap> dest =
+      src->StretchTo(size.width, size.height, options, /*pClip=*/nullptr);
+  SetStretchVectorizationForTesting(true);
+  if (!dest) {
+    return {};
+  }
+  pdfium::span<const uint8_t> buffer = dest->GetBuffer();
+  return std::vector<uint8_t>(buffer.begin(), buffer.end());
+}
+
+void CheckMatchesScalar(const FXDIB_ResampleOptions& options) {
+  for (FXDIB_Format format : kSrcFormats) {
+    SCOPED_TRACE(static_cast<int>(format));
+    RetainPtr<CFX_DIBitmap> src = MakeSource(format);
+    ASSERT_TRUE(src);
+    for (const DestSize& size : kDestSizes) {
+      SCOPED_TRACE(testing::Message() << size.width << "x" << size.height);
+      const std::vector<uint8_t> expected =
+          Stretch(src, size, options, /*vectorized=*/false);
+      ASSERT_FALSE(expected.empty());
+      EXPECT_EQ(expected, Stretch(src, size, options, /*vectorized=*/true));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(StretchRowVectorized, Default) {
+  CheckMatchesScalar(FXDIB_ResampleOptions());
+}
+
+TEST(StretchRowVectorized, Bilinear) {
+  FXDIB_ResampleOptions options;
+  options.bInterpolateBilinear = true;
+  CheckMatchesScalar(options);
+}
+
+TEST(StretchRowVectorized, NoSmoothing) {
+  FXDIB_ResampleOptions options;
+  options.bNoSmoothing = true;
+  CheckMatchesScalar(options);
+}
+
+}  // namespace pdfium
@@ -21,6 +21,9 @@
 #define FXRC_BLEND_MODE 0x10
 #define FXRC_SOFT_CLIP 0x20
 #define FXRC_BYTEMASK_OUTPUT 0x40
+// Records drawing calls instead of rasterizing them, so paths and text must
+// reach the driver untouched by any resolution dependent adjustments.
+#define FXRC_DISPLAY_LIST 0x400
 // Assuming these are Skia-only for now. If this assumption changes, update both
 // the #if logic here, as well as the callsites that check these capabilities.
 #if defined(PDF_USE_SKIA)
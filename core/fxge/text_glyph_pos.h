@@ -10,7 +10,7 @@
 #include <optional>
 
 #include "core/fxcrt/fx_coordinates.h"
-#include "core/fxcrt/unowned_ptr.h"
+#include "core/fxcrt/retain_ptr.h"
 
 class CFX_GlyphBitmap;
 
@@ -22,7 +22,7 @@ class TextGlyphPos {
 
   std::optional<CFX_Point> GetOrigin(const CFX_Point& offset) const;
 
-  UnownedPtr<const CFX_GlyphBitmap> glyph_;
+  RetainPtr<const CFX_GlyphBitmap> glyph_;
   CFX_Point origin_;
   CFX_PointF device_origin_;
 };
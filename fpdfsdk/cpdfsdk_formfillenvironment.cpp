@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "core/fpdfapi/page/cpdf_annotcontext.h"
+#include "core/fpdfapi/page/cpdf_page.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
@@ -366,6 +367,13 @@ IJS_Runtime* CPDFSDK_FormFillEnvironment::GetIJSRuntime() {
 
 void CPDFSDK_FormFillEnvironment::Invalidate(IPDF_Page* page,
                                              const FX_RECT& rect) {
+  // For FPDF_RenderPageBitmapDirtyRect(). `rect` is in page space.
+  CPDF_Page* pdf_page = page ? page->AsPDFPage() : nullptr;
+  if (pdf_page) {
+    CFX_FloatRect dirty_rect(rect);
+    dirty_rect.Normalize();
+    pdf_page->AddDirtyRect(dirty_rect);
+  }
   if (info_ && info_->FFI_Invalidate) {
     info_->FFI_Invalidate(info_, FPDFPageFromIPDFPage(page), rect.left,
                           rect.top, rect.right, rect.bottom);
@@ -27,6 +27,7 @@
 #endif  // PDF_ENABLE_XFA
 
 class CFX_DIBitmap;
+class CFX_DisplayList;
 class CPDF_Annot;
 class CPDF_AnnotContext;
 class CPDF_ClipPath;
@@ -227,6 +228,15 @@ inline CPDF_TextPage* CPDFTextPageFromFPDFTextPage(FPDF_TEXTPAGE page) {
   return reinterpret_cast<CPDF_TextPage*>(page);
 }
 
+inline FPDF_DISPLAYLIST FPDFDisplayListFromCFXDisplayList(
+    CFX_DisplayList* list) {
+  return reinterpret_cast<FPDF_DISPLAYLIST>(list);
+}
+inline CFX_DisplayList* CFXDisplayListFromFPDFDisplayList(
+    FPDF_DISPLAYLIST list) {
+  return reinterpret_cast<CFX_DisplayList*>(list);
+}
+
 inline FPDF_SCHHANDLE FPDFSchHandleFromCPDFTextPageFind(
     CPDF_TextPageFind* handle) {
   return reinterpret_cast<FPDF_SCHHANDLE>(handle);
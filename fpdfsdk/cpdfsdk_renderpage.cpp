@@ -36,6 +36,7 @@ void RenderPageImpl(CPDF_PageRenderContext* pContext,
   auto& options = pContext->options_->GetOptions();
   options.bClearType = !!(flags & FPDF_LCD_TEXT);
   options.bNoNativeText = !!(flags & FPDF_NO_NATIVETEXT);
+  options.bSubpixelText = !!(flags & FPDF_SUBPIXEL_TEXT);
   options.bLimitedImageCache = !!(flags & FPDF_RENDER_LIMITEDIMAGECACHE);
   options.bForceHalftone = !!(flags & FPDF_RENDER_FORCEHALFTONE);
   options.bNoTextSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHTEXT);
@@ -12,6 +12,7 @@
 #include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/parser/cpdf_data_avail.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_read_validator.h"
 #include "core/fpdfapi/render/cpdf_docrenderdata.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
@@ -226,3 +227,30 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsLinearized(FPDF_AVAIL avail) {
   }
   return avail_context->data_avail()->IsLinearizedPDF();
 }
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAvail_SetReadAhead(FPDF_AVAIL avail,
+                                                           FPDF_BOOL enable) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context) {
+    return false;
+  }
+  avail_context->data_avail()->GetValidator()->SetReadAheadEnabled(!!enable);
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFAvail_GetDownloadStats(FPDF_AVAIL avail, FPDF_AVAIL_DOWNLOAD_STATS* stats) {
+  auto* avail_context = FPDFAvailContextFromFPDFAvail(avail);
+  if (!avail_context || !stats) {
+    return false;
+  }
+  const CPDF_ReadValidator::DownloadStats& download_stats =
+      avail_context->data_avail()->GetValidator()->download_stats();
+  // Counters can exceed `unsigned long` where it is 32 bits wide.
+  stats->requests =
+      pdfium::saturated_cast<unsigned long>(download_stats.requests);
+  stats->requested_bytes = download_stats.requested_bytes;
+  stats->over_fetched_bytes = download_stats.over_fetched_bytes;
+  stats->stalls = pdfium::saturated_cast<unsigned long>(download_stats.stalls);
+  return true;
+}
@@ -405,6 +405,44 @@ TEST_F(FPDFDataAvailEmbedderTest, BadInputsToAPIs) {
   EXPECT_EQ(PDF_DATA_ERROR, FPDFAvail_IsPageAvail(nullptr, 0, nullptr));
   EXPECT_EQ(PDF_FORM_ERROR, FPDFAvail_IsFormAvail(nullptr, nullptr));
   EXPECT_EQ(PDF_LINEARIZATION_UNKNOWN, FPDFAvail_IsLinearized(nullptr));
+  EXPECT_FALSE(FPDFAvail_SetReadAhead(nullptr, true));
+  FPDF_AVAIL_DOWNLOAD_STATS stats;
+  EXPECT_FALSE(FPDFAvail_GetDownloadStats(nullptr, &stats));
+}
+
+TEST_F(FPDFDataAvailEmbedderTest, LoadWithReadAhead) {
+  TestAsyncLoader loader("linearized.pdf");
+  loader.set_is_new_data_available(false);
+  CreateAvail(loader.file_avail(), loader.file_access());
+  ASSERT_TRUE(FPDFAvail_SetReadAhead(avail(), true));
+  EXPECT_FALSE(FPDFAvail_GetDownloadStats(avail(), nullptr));
+
+  int round_trips = 0;
+  while (PDF_DATA_AVAIL != FPDFAvail_IsDocAvail(avail(), loader.hints())) {
+    ASSERT_FALSE(loader.requested_segments().empty());
+    loader.FlushRequestedData();
+    ++round_trips;
+  }
+  SetDocumentFromAvail();
+  ASSERT_TRUE(document());
+
+  for (int i = 0; i < FPDF_GetPageCount(document()); ++i) {
+    while (PDF_DATA_AVAIL !=
+           FPDFAvail_IsPageAvail(avail(), i, loader.hints())) {
+      ASSERT_FALSE(loader.requested_segments().empty());
+      loader.FlushRequestedData();
+      ++round_trips;
+    }
+    ScopedFPDFPage page(FPDF_LoadPage(document(), i));
+    EXPECT_TRUE(page);
+  }
+
+  FPDF_AVAIL_DOWNLOAD_STATS stats;
+  ASSERT_TRUE(FPDFAvail_GetDownloadStats(avail(), &stats));
+  EXPECT_GE(stats.requests, static_cast<unsigned long>(round_trips));
+  EXPECT_GE(stats.stalls, stats.requests);
+  EXPECT_GT(stats.requested_bytes, 0u);
+  EXPECT_LT(stats.over_fetched_bytes, stats.requested_bytes);
 }
 
 TEST_F(FPDFDataAvailEmbedderTest, NegativePageIndex) {
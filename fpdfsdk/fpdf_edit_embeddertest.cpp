@@ -816,6 +816,184 @@ TEST_F(FPDFEditEmbedderTest, Bug1549) {
   VerifySavedDocument(100, 150, "4f9889cd5993db20f1ab37d677ac8d26");
 }
 
+TEST_F(FPDFEditEmbedderTest, RenderDirtyRect) {
+  ASSERT_TRUE(OpenDocument("rectangles.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+  ASSERT_FALSE(FPDFPage_HasTransparency(page.get()));
+
+  // Nothing changed since the page was loaded.
+  FS_RECTF dirty_rect;
+  EXPECT_FALSE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(),
+                                              nullptr, nullptr, 0xFFFFFFFF, 0,
+                                              &dirty_rect));
+  EXPECT_FALSE(FPDFPage_InvalidateObject(nullptr, FPDFPage_GetObject(
+                                                      page.get(), 0)));
+  EXPECT_FALSE(FPDFPage_InvalidateObject(page.get(), nullptr));
+
+  // Move an object, which marks where it was and where it ends up.
+  FPDF_PAGEOBJECT moved = FPDFPage_GetObject(page.get(), 1);
+  ASSERT_TRUE(moved);
+  FPDFPageObj_Transform(moved, 1, 0, 0, 1, 20, 10);
+
+  // Remove another one.
+  {
+    ScopedFPDFPageObject removed(FPDFPage_GetObject(page.get(), 0));
+    ASSERT_TRUE(FPDFPage_RemoveObject(page.get(), removed.get()));
+  }
+
+  EXPECT_FALSE(FPDF_RenderPageBitmapDirtyRect(nullptr, page.get(), nullptr,
+                                              nullptr, 0xFFFFFFFF, 0,
+                                              &dirty_rect));
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             nullptr, 0xFFFFFFFF, 0,
+                                             &dirty_rect));
+  EXPECT_LT(dirty_rect.left, dirty_rect.right);
+  EXPECT_LT(dirty_rect.top, dirty_rect.bottom);
+  EXPECT_FALSE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(),
+                                              nullptr, nullptr, 0xFFFFFFFF, 0,
+                                              &dirty_rect));
+
+  // Only the changed area was drawn again, but the result matches drawing the
+  // whole page.
+  ScopedFPDFBitmap expected = RenderLoadedPage(page.get());
+  EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(bitmap.get()));
+}
+
+TEST_F(FPDFEditEmbedderTest, RenderDirtyRectOverBackdrop) {
+  static constexpr int kPageSize = 200;
+  ScopedFPDFPage page(
+      FPDFPage_New(CreateNewDocument(), 0, kPageSize, kPageSize));
+  ASSERT_TRUE(page);
+
+  // A thin triangle, whose sharpest corner has a long miter.
+  FPDF_PAGEOBJECT path = FPDFPageObj_CreateNewPath(60, 60);
+  ASSERT_TRUE(FPDFPath_LineTo(path, 140, 70));
+  ASSERT_TRUE(FPDFPath_LineTo(path, 60, 80));
+  ASSERT_TRUE(FPDFPath_Close(path));
+  ASSERT_TRUE(FPDFPageObj_SetStrokeColor(path, 0, 0, 255, 255));
+  ASSERT_TRUE(FPDFPageObj_SetStrokeWidth(path, 6));
+  ASSERT_TRUE(FPDFPageObj_SetLineJoin(path, FPDF_LINEJOIN_MITER));
+  ASSERT_TRUE(FPDFPath_SetDrawMode(path, FPDF_FILLMODE_NONE, true));
+  FPDFPage_InsertObject(page.get(), path);
+
+  // A checkerboard of gray and transparent squares under the page.
+  auto create_backdrop = []() {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kPageSize, kPageSize, 1));
+    for (int y = 0; y < kPageSize; y += 10) {
+      for (int x = 0; x < kPageSize; x += 10) {
+        const FPDF_DWORD color = (x + y) % 20 ? 0xFFC0C0C0 : 0x00000000;
+        EXPECT_TRUE(FPDFBitmap_FillRect(bitmap.get(), x, y, 10, 10, color));
+      }
+    }
+    return bitmap;
+  };
+  auto render_page = [&]() {
+    ScopedFPDFBitmap bitmap = create_backdrop();
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, kPageSize,
+                          kPageSize, 0, 0);
+    return HashBitmap(bitmap.get());
+  };
+
+  ScopedFPDFBitmap backdrop = create_backdrop();
+  ScopedFPDFBitmap bitmap = create_backdrop();
+  FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, kPageSize, kPageSize,
+                        0, 0);
+  FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                 backdrop.get(), 0, 0, nullptr);
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+
+  // Each change marks the area it touches, without FPDFPage_InvalidateObject().
+  // Thinning the stroke must clear all of the old miter.
+  ASSERT_TRUE(FPDFPageObj_SetStrokeWidth(path, 1));
+  FS_RECTF dirty_rect;
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             backdrop.get(), 0, 0,
+                                             &dirty_rect));
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+  // The miter reaches well past the corner at x = 140.
+  EXPECT_GT(dirty_rect.right, 160);
+
+  // A backdrop that does not match the bitmap is an error, which leaves the
+  // change pending.
+  ASSERT_TRUE(FPDFPageObj_SetStrokeColor(path, 255, 0, 0, 255));
+  {
+    ScopedFPDFBitmap small(FPDFBitmap_Create(kPageSize / 2, kPageSize, 1));
+    EXPECT_FALSE(FPDF_RenderPageBitmapDirtyRect(
+        bitmap.get(), page.get(), nullptr, small.get(), 0, 0, nullptr));
+  }
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             backdrop.get(), 0, 0, nullptr));
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+
+  FPDFPageObj_Transform(path, 1, 0, 0, 1, 10, 20);
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             backdrop.get(), 0, 0, nullptr));
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+
+  ASSERT_TRUE(FPDFPath_LineTo(path, 20, 150));
+  ASSERT_TRUE(FPDFPath_SetDrawMode(path, FPDF_FILLMODE_WINDING, false));
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             backdrop.get(), 0, 0, nullptr));
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+
+  ASSERT_TRUE(FPDFPageObj_SetIsActive(path, false));
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             backdrop.get(), 0, 0, nullptr));
+  EXPECT_EQ(render_page(), HashBitmap(bitmap.get()));
+}
+
+TEST_F(FPDFEditEmbedderTest, RenderTilesOfManyObjects) {
+  static constexpr int kPageSize = 320;
+  static constexpr int kTileSize = kPageSize / 2;
+  ScopedFPDFPage page(FPDFPage_New(CreateNewDocument(), 0, kPageSize,
+                                   kPageSize));
+  ASSERT_TRUE(page);
+
+  // Enough objects for the page to index them.
+  for (int y = 0; y < kPageSize; y += 8) {
+    for (int x = 0; x < kPageSize; x += 8) {
+      FPDF_PAGEOBJECT rect = FPDFPageObj_CreateNewRect(x + 1, y + 1, 6, 6);
+      ASSERT_TRUE(FPDFPageObj_SetFillColor(rect, x % 256, y % 256, 128, 255));
+      ASSERT_TRUE(FPDFPath_SetDrawMode(rect, FPDF_FILLMODE_ALTERNATE, 0));
+      FPDFPage_InsertObject(page.get(), rect);
+    }
+  }
+
+  auto render_tiles = [&page]() {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(kPageSize, kPageSize, 0));
+    EXPECT_TRUE(FPDFBitmap_FillRect(bitmap.get(), 0, 0, kPageSize, kPageSize,
+                                    0xFFFFFFFF));
+    for (int top = 0; top < kPageSize; top += kTileSize) {
+      for (int left = 0; left < kPageSize; left += kTileSize) {
+        const FS_RECTF tile = {static_cast<float>(left),
+                               static_cast<float>(top),
+                               static_cast<float>(left + kTileSize),
+                               static_cast<float>(top + kTileSize)};
+        FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page.get(), nullptr,
+                                        &tile, 0);
+      }
+    }
+    return HashBitmap(bitmap.get());
+  };
+
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    EXPECT_EQ(HashBitmap(bitmap.get()), render_tiles());
+  }
+
+  // Moving an object must move it in the index as well.
+  FPDF_PAGEOBJECT moved = FPDFPage_GetObject(page.get(), 0);
+  ASSERT_TRUE(moved);
+  FPDFPageObj_Transform(moved, 1, 0, 0, 1, 200, 200);
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    EXPECT_EQ(HashBitmap(bitmap.get()), render_tiles());
+  }
+}
+
 TEST_F(FPDFEditEmbedderTest, SetText) {
   // Load document with some text.
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
@@ -3148,6 +3326,41 @@ TEST_F(FPDFEditEmbedderTest, GlyphPaths) {
   EXPECT_EQ(FPDF_SEGMENT_BEZIERTO, FPDFPathSegment_GetType(segment));
 }
 
+TEST_F(FPDFEditEmbedderTest, GlyphPathsCountTowardsGlyphCache) {
+  ASSERT_TRUE(OpenDocument("text_font.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  FPDF_PAGEOBJECT text = FPDFPage_GetObject(page.get(), 0);
+  ASSERT_TRUE(text);
+  FPDF_FONT font = FPDFTextObj_GetFont(text);
+  ASSERT_TRUE(font);
+
+  FPDF_SetGlyphCacheByteLimit(0);
+  FPDF_GLYPH_CACHE_STATS before;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&before));
+
+  FPDF_GLYPHPATH gpath = FPDFFont_GetGlyphPath(font, 's', 12.0f);
+  ASSERT_TRUE(gpath);
+  const int count = FPDFGlyphPath_CountGlyphSegments(gpath);
+  ASSERT_GT(count, 0);
+  FPDF_GLYPH_CACHE_STATS pinned;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&pinned));
+  EXPECT_GT(pinned.bytes, before.bytes);
+  EXPECT_EQ(before.pinned_paths + 1, pinned.pinned_paths);
+  EXPECT_GT(pinned.pinned_bytes, before.pinned_bytes);
+
+  // Going over the budget evicts other glyphs, but not the handed out path.
+  FPDF_SetGlyphCacheByteLimit(1);
+  FPDF_GLYPH_CACHE_STATS shrunk;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&shrunk));
+  EXPECT_EQ(pinned.bytes, shrunk.bytes);
+  EXPECT_EQ(pinned.pinned_paths, shrunk.pinned_paths);
+  EXPECT_EQ(count, FPDFGlyphPath_CountGlyphSegments(gpath));
+  EXPECT_EQ(gpath, FPDFFont_GetGlyphPath(font, 's', 12.0f));
+
+  FPDF_SetGlyphCacheByteLimit(64 * 1024 * 1024);
+}
+
 TEST_F(FPDFEditEmbedderTest, FormGetObjects) {
   ASSERT_TRUE(OpenDocument("form_object.pdf"));
   ScopedPage page = LoadScopedPage(0);
@@ -4,10 +4,58 @@
 
 #include "public/fpdf_edit.h"
 
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <string>
+
 #include "public/cpp/fpdf_scopers.h"
 #include "testing/embedder_test.h"
 #include "testing/utils/file_util.h"
 
+namespace {
+
+// Returns the average of the color channels of a BGRx `bitmap`.
+double GetAverageColor(FPDF_BITMAP bitmap) {
+  const int width = FPDFBitmap_GetWidth(bitmap);
+  const int height = FPDFBitmap_GetHeight(bitmap);
+  const int stride = FPDFBitmap_GetStride(bitmap);
+  const uint8_t* buffer =
+      static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(bitmap));
+  uint64_t sum = 0;
+  for (int row = 0; row < height; ++row) {
+    for (int col = 0; col < width; ++col) {
+      const uint8_t* pixel = buffer + row * stride + col * 4;
+      sum += pixel[0] + pixel[1] + pixel[2];
+    }
+  }
+  return static_cast<double>(sum) / (width * height * 3);
+}
+
+// Returns the average difference between the color channels of the top left
+// `size` by `size` pixels of the BGRx bitmaps `a` and `b`.
+double GetMeanDifference(FPDF_BITMAP a, FPDF_BITMAP b, int size) {
+  const int stride_a = FPDFBitmap_GetStride(a);
+  const int stride_b = FPDFBitmap_GetStride(b);
+  const uint8_t* buffer_a =
+      static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(a));
+  const uint8_t* buffer_b =
+      static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(b));
+  uint64_t sum = 0;
+  for (int row = 0; row < size; ++row) {
+    for (int col = 0; col < size * 4; ++col) {
+      if (col % 4 == 3) {
+        continue;
+      }
+      sum += abs(buffer_a[row * stride_a + col] -
+                 buffer_b[row * stride_b + col]);
+    }
+  }
+  return static_cast<double>(sum) / (size * size * 3);
+}
+
+}  // namespace
+
 class PDFEditImgTest : public EmbedderTest {};
 
 TEST_F(PDFEditImgTest, InsertObjectWithInvalidPage) {
@@ -133,6 +181,106 @@ TEST_F(PDFEditImgTest, NewImageObjLoadJpegInline) {
   VerifySavedDocument(kPageWidth, kPageHeight, kPageChecksum);
 }
 
+TEST_F(PDFEditImgTest, RenderJpegSmallThenLarge) {
+  CreateEmptyDocumentWithoutFormFillEnvironment();
+  static constexpr int kImageSize = 120;
+  static constexpr int kSmallSize = kImageSize / 8;
+
+  // Two pages with the same image, which each have their own image cache.
+  ScopedFPDFPage pages[2];
+  for (int i = 0; i < 2; ++i) {
+    pages[i].reset(FPDFPage_New(document(), i, kImageSize, kImageSize));
+    ASSERT_TRUE(pages[i]);
+    ScopedFPDFPageObject image(FPDFPageObj_NewImageObj(document()));
+    ASSERT_TRUE(image);
+    FileAccessForTesting file_access("mona_lisa.jpg");
+    FPDF_PAGE temp_page = pages[i].get();
+    ASSERT_TRUE(
+        FPDFImageObj_LoadJpegFile(&temp_page, 1, image.get(), &file_access));
+    ASSERT_TRUE(FPDFImageObj_SetMatrix(image.get(), kImageSize, 0, 0,
+                                       kImageSize, 0, 0));
+    FPDFPage_InsertObject(pages[i].get(), image.release());
+    ASSERT_TRUE(FPDFPage_GenerateContent(pages[i].get()));
+  }
+
+  auto render = [](FPDF_PAGE page, int size) {
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(size, size, 0));
+    EXPECT_TRUE(
+        FPDFBitmap_FillRect(bitmap.get(), 0, 0, size, size, 0xFFFFFFFF));
+    FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, size, size, 0, 0);
+    return bitmap;
+  };
+
+  // The first page only ever gets the full size image.
+  ScopedFPDFBitmap full_size = render(pages[0].get(), kImageSize);
+  const std::string full_size_hash = HashBitmap(full_size.get());
+
+  // The second page decodes the image at 1/8 scale for its small render,
+  // which keeps the overall color.
+  ScopedFPDFBitmap small = render(pages[1].get(), kSmallSize);
+  EXPECT_NEAR(GetAverageColor(full_size.get()), GetAverageColor(small.get()),
+              4.0);
+
+  // A larger render reloads the image at full size, instead of scaling up
+  // the small one in the cache.
+  ScopedFPDFBitmap reloaded = render(pages[1].get(), kImageSize);
+  EXPECT_EQ(full_size_hash, HashBitmap(reloaded.get()));
+}
+
+TEST_F(PDFEditImgTest, RenderJpegAtDeviceSize) {
+  CreateEmptyDocumentWithoutFormFillEnvironment();
+  static constexpr int kPageSize = 120;
+  static constexpr int kImageSize = 30;
+
+  // The image covers a quarter of the page in each direction, so rendering
+  // the page at its own size lets the decoder skip 2 of the 3 levels of detail
+  // in the 120 by 120 pixel JPEG. The rotated image is narrower, but gets the
+  // same levels, as its longer side counts both ways.
+  static constexpr float kMatrices[][6] = {
+      {kImageSize, 0, 0, kImageSize, 0, kPageSize - kImageSize},
+      {0, kImageSize, -kImageSize / 2, 0, kImageSize / 2,
+       kPageSize - kImageSize},
+  };
+  for (const auto& matrix : kMatrices) {
+    // One page renders the image at full size first, which keeps the full
+    // size decode in its image cache for the render after that.
+    ScopedFPDFPage pages[2];
+    for (int i = 0; i < 2; ++i) {
+      pages[i].reset(FPDFPage_New(document(), i, kPageSize, kPageSize));
+      ASSERT_TRUE(pages[i]);
+      ScopedFPDFPageObject image(FPDFPageObj_NewImageObj(document()));
+      ASSERT_TRUE(image);
+      FileAccessForTesting file_access("mona_lisa.jpg");
+      FPDF_PAGE temp_page = pages[i].get();
+      ASSERT_TRUE(
+          FPDFImageObj_LoadJpegFile(&temp_page, 1, image.get(), &file_access));
+      ASSERT_TRUE(FPDFImageObj_SetMatrix(image.get(), matrix[0], matrix[1],
+                                         matrix[2], matrix[3], matrix[4],
+                                         matrix[5]));
+      FPDFPage_InsertObject(pages[i].get(), image.release());
+      ASSERT_TRUE(FPDFPage_GenerateContent(pages[i].get()));
+    }
+
+    auto render = [](FPDF_PAGE page, int size) {
+      ScopedFPDFBitmap bitmap(FPDFBitmap_Create(size, size, 0));
+      EXPECT_TRUE(
+          FPDFBitmap_FillRect(bitmap.get(), 0, 0, size, size, 0xFFFFFFFF));
+      FPDF_RenderPageBitmap(bitmap.get(), page, 0, 0, size, size, 0, 0);
+      return bitmap;
+    };
+    render(pages[0].get(), kPageSize * 4);
+    ScopedFPDFBitmap from_full_size = render(pages[0].get(), kPageSize);
+    ScopedFPDFBitmap from_reduced_size = render(pages[1].get(), kPageSize);
+
+    // Both look alike where the image is.
+    EXPECT_NEAR(GetAverageColor(from_full_size.get()),
+                GetAverageColor(from_reduced_size.get()), 2.0);
+    EXPECT_LT(GetMeanDifference(from_full_size.get(), from_reduced_size.get(),
+                                kImageSize),
+              8.0);
+  }
+}
+
 TEST_F(PDFEditImgTest, SetBitmap) {
   ScopedFPDFDocument doc(FPDF_CreateNewDocument());
   ScopedFPDFPage page(FPDFPage_New(doc.get(), 0, 100, 100));
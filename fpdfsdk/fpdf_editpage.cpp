@@ -281,6 +281,7 @@ FPDFPage_InsertObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object) {
   pPageObj->SetDirty(true);
   pPage->AppendPageObject(std::move(pPageObjHolder));
   CalcBoundingBox(pPageObj);
+  pPage->AddDirtyRect(pPageObj->GetDrawnRect());
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
@@ -295,8 +296,31 @@ FPDFPage_RemoveObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object) {
     return false;
   }
 
+  std::unique_ptr<CPDF_PageObject> removed = pPage->RemovePageObject(pPageObj);
+  if (!removed) {
+    return false;
+  }
+
+  pPage->AddDirtyRect(removed->GetDrawnRect());
   // Caller takes ownership.
-  return !!pPage->RemovePageObject(pPageObj).release();
+  removed.release();
+  return true;
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFPage_InvalidateObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object) {
+  CPDF_PageObject* pPageObj = CPDFPageObjectFromFPDFPageObject(page_object);
+  if (!pPageObj) {
+    return false;
+  }
+
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!IsPageObject(pPage)) {
+    return false;
+  }
+
+  pPage->AddDirtyRect(pPageObj->GetDrawnRect());
+  return true;
 }
 
 FPDF_EXPORT int FPDF_CALLCONV FPDFPage_CountObjects(FPDF_PAGE page) {
@@ -1010,7 +1034,10 @@ FPDFPageObj_SetStrokeWidth(FPDF_PAGEOBJECT page_object, float width) {
     return false;
   }
 
+  // A thinner stroke leaves the old one to draw over.
+  pPageObj->InvalidateDrawnRect();
   pPageObj->mutable_graph_state().SetLineWidth(width);
+  CalcBoundingBox(pPageObj);
   pPageObj->SetDirty(true);
   return true;
 }
@@ -1044,6 +1071,7 @@ FPDFPageObj_SetLineJoin(FPDF_PAGEOBJECT page_object, int line_join) {
     return false;
   }
 
+  pPageObj->InvalidateDrawnRect();
   pPageObj->mutable_graph_state().SetLineJoin(
       static_cast<CFX_GraphStateData::LineJoin>(line_join));
   pPageObj->SetDirty(true);
@@ -52,6 +52,15 @@ CPDF_PathObject* CPDFPathObjectFromFPDFPageObject(FPDF_PAGEOBJECT page_object) {
   return obj ? obj->AsPath() : nullptr;
 }
 
+// Paths on a page keep their bounds current, which also marks the old and
+// new areas dirty. Loose paths get their bounds once inserted.
+void OnPathChanged(CPDF_PathObject* path_obj) {
+  if (path_obj->HasHolder()) {
+    path_obj->CalcBoundingBox();
+  }
+  path_obj->SetDirty(true);
+}
+
 }  // namespace
 
 FPDF_EXPORT FPDF_PAGEOBJECT FPDF_CALLCONV FPDFPageObj_CreateNewPath(float x,
@@ -108,7 +117,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPath_MoveTo(FPDF_PAGEOBJECT path,
   }
 
   pPathObj->path().AppendPoint(CFX_PointF(x, y), CFX_Path::Point::Type::kMove);
-  pPathObj->SetDirty(true);
+  OnPathChanged(pPathObj);
   return true;
 }
 
@@ -121,7 +130,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPath_LineTo(FPDF_PAGEOBJECT path,
   }
 
   pPathObj->path().AppendPoint(CFX_PointF(x, y), CFX_Path::Point::Type::kLine);
-  pPathObj->SetDirty(true);
+  OnPathChanged(pPathObj);
   return true;
 }
 
@@ -141,7 +150,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPath_BezierTo(FPDF_PAGEOBJECT path,
   cpath.AppendPoint(CFX_PointF(x1, y1), CFX_Path::Point::Type::kBezier);
   cpath.AppendPoint(CFX_PointF(x2, y2), CFX_Path::Point::Type::kBezier);
   cpath.AppendPoint(CFX_PointF(x3, y3), CFX_Path::Point::Type::kBezier);
-  pPathObj->SetDirty(true);
+  OnPathChanged(pPathObj);
   return true;
 }
 
@@ -157,7 +166,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPath_Close(FPDF_PAGEOBJECT path) {
   }
 
   cpath.ClosePath();
-  pPathObj->SetDirty(true);
+  OnPathChanged(pPathObj);
   return true;
 }
 
@@ -177,7 +186,7 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFPath_SetDrawMode(FPDF_PAGEOBJECT path,
   } else {
     pPathObj->set_no_filltype();
   }
-  pPathObj->SetDirty(true);
+  OnPathChanged(pPathObj);
   return true;
 }
 
@@ -1073,8 +1073,9 @@ FPDFFont_GetGlyphPath(FPDF_FONT font, uint32_t glyph, float font_size) {
     }
   }
 
-  const CFX_Path* pPath =
-      pCfxFont->LoadGlyphPath(pos[0].glyph_index_, pos[0].font_char_width_);
+  // The handle outlives later glyph loads, so the path must not be evicted.
+  const CFX_Path* pPath = pCfxFont->LoadPinnedGlyphPath(
+      pos[0].glyph_index_, pos[0].font_char_width_);
 
   return FPDFGlyphPathFromCFXPath(pPath);
 }
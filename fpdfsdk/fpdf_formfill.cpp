@@ -249,6 +249,7 @@ void FFLCommon(FPDF_FORMHANDLE hHandle,
 
     CPDF_RenderOptions options;
     options.GetOptions().bClearType = !!(flags & FPDF_LCD_TEXT);
+    options.GetOptions().bSubpixelText = !!(flags & FPDF_SUBPIXEL_TEXT);
 
     // Grayscale output
     if (flags & FPDF_GRAYSCALE) {
@@ -1570,6 +1570,31 @@ TEST_F(FPDFFormFillEmbedderTest, RemoveFormFieldHighlight) {
   CompareBitmap(bitmap3.get(), 300, 300, TextFormChecksum());
 }
 
+TEST_F(FPDFFormFillEmbedderTest, TypingMarksPageDirty) {
+  ASSERT_TRUE(OpenDocument("text_form.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+  // Drop whatever loading the page marked.
+  FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr, nullptr,
+                                 0xFFFFFFFF, 0, nullptr);
+
+  FORM_OnMouseMove(form_handle(), page.get(), 0, 120.0, 120.0);
+  FORM_OnLButtonDown(form_handle(), page.get(), 0, 120.0, 120.0);
+  FORM_OnLButtonUp(form_handle(), page.get(), 0, 120.0, 120.0);
+  FORM_OnChar(form_handle(), page.get(), 'A', 0);
+
+  // The text field at (120, 120) in page space is at (120, 180) on the bitmap.
+  FS_RECTF dirty_rect;
+  ASSERT_TRUE(FPDF_RenderPageBitmapDirtyRect(bitmap.get(), page.get(), nullptr,
+                                             nullptr, 0xFFFFFFFF, 0,
+                                             &dirty_rect));
+  EXPECT_LE(dirty_rect.left, 120.0f);
+  EXPECT_GE(dirty_rect.right, 120.0f);
+  EXPECT_LE(dirty_rect.top, 180.0f);
+  EXPECT_GE(dirty_rect.bottom, 180.0f);
+}
+
 TEST_F(FPDFFormFillEmbedderTest, HasFormInfoNone) {
   ASSERT_TRUE(OpenDocument("hello_world.pdf"));
   EXPECT_EQ(FORMTYPE_NONE, FPDF_GetFormType(document()));
@@ -8,6 +8,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,6 +25,7 @@
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/parser/cpdf_name.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
+#include "core/fpdfapi/parser/cpdf_rebuild_scanner.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fpdfapi/parser/cpdf_string.h"
 #include "core/fpdfapi/parser/fpdf_parser_decode.h"
@@ -31,10 +35,13 @@
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
+#include "core/fxcodec/jbig2/jbig2_symbol_dict_cache.h"
+#include "core/fxcodec/jpx/cjpx_decoder.h"
 #include "core/fxcrt/cfx_read_only_span_stream.h"
 #include "core/fxcrt/cfx_timer.h"
 #include "core/fxcrt/check_op.h"
 #include "core/fxcrt/compiler_specific.h"
+#include "core/fxcrt/data_vector.h"
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_memcpy_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -44,9 +51,12 @@
 #include "core/fxcrt/numerics/safe_conversions.h"
 #include "core/fxcrt/ptr_util.h"
 #include "core/fxcrt/span.h"
+#include "core/fxcrt/span_util.h"
 #include "core/fxcrt/stl_util.h"
 #include "core/fxcrt/unowned_ptr.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "core/fxge/cfx_displaylist.h"
+#include "core/fxge/cfx_displaylistdevice.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphcache.h"
 #include "core/fxge/cfx_renderdevice.h"
@@ -119,8 +129,51 @@ static_assert(static_cast<int>(CFX_DefaultRenderDevice::RendererType::kSkia) ==
 
 namespace {
 
+constexpr size_t kMaxRenderThreads = 8;
+
 bool g_bLibraryInitialized = false;
 
+// Whether the current thread holds GetPageLock().
+thread_local bool g_page_lock_held = false;
+
+std::mutex& GetPageLock() {
+  static std::mutex* lock = new std::mutex();
+  return *lock;
+}
+
+// Holds the page lock for the duration of a public function that may run on
+// several threads at once. Does nothing if the current thread already holds
+// it further up the stack.
+class ScopedPageLock {
+ public:
+  ScopedPageLock() : owns_lock_(!g_page_lock_held) {
+    if (owns_lock_) {
+      GetPageLock().lock();
+      g_page_lock_held = true;
+    }
+  }
+  ~ScopedPageLock() {
+    if (owns_lock_) {
+      g_page_lock_held = false;
+      GetPageLock().unlock();
+    }
+  }
+
+ private:
+  const bool owns_lock_;
+};
+
+// Lets `device` release the page lock while it rasterizes. Skia keeps state
+// of its own while drawing, so its devices hold the lock throughout.
+void SetPageLock(CFX_DefaultRenderDevice* device) {
+#if defined(PDF_USE_SKIA)
+  if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
+    return;
+  }
+#endif
+  device->SetRenderLock(&GetPageLock());
+}
+
 void SetRendererType(FPDF_RENDERER_TYPE public_type) {
   // Internal definition of renderer types must stay updated with respect to
   // the public definition, such that all public definitions can be mapped to
@@ -206,8 +259,21 @@ std::vector<XFAPacket> GetXFAPackets(RetainPtr<const CPDF_Object> xfa_object) {
   return packets;
 }
 
+uint32_t GetParserLoadFlags(unsigned int flags) {
+  uint32_t load_flags = 0;
+  if (flags & FPDF_LOAD_CROSS_REF_LAZILY) {
+    load_flags |= CPDF_Parser::kLoadCrossRefLazily;
+  }
+  if (flags & FPDF_LOAD_PREFETCH_OBJECT_STREAMS) {
+    load_flags |= CPDF_Parser::kPrefetchObjectStreams;
+  }
+  return load_flags;
+}
+
 FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
-                               FPDF_BYTESTRING password) {
+                               FPDF_BYTESTRING password,
+                               uint32_t load_flags,
+                               pdfium::span<const uint8_t> cross_ref_index) {
   if (!pFileAccess) {
     ProcessParseError(CPDF_Parser::FILE_ERROR);
     return nullptr;
@@ -218,7 +284,10 @@ FPDF_DOCUMENT LoadDocumentImpl(RetainPtr<IFX_SeekableReadStream> pFileAccess,
                                       std::make_unique<CPDF_DocPageData>());
 
   CPDF_Parser::Error error =
-      document->LoadDoc(std::move(pFileAccess), password);
+      cross_ref_index.empty()
+          ? document->LoadDoc(std::move(pFileAccess), password, load_flags)
+          : document->LoadDocWithCrossRefIndex(std::move(pFileAccess), password,
+                                               cross_ref_index);
   if (error != CPDF_Parser::SUCCESS) {
     ProcessParseError(error);
     return nullptr;
@@ -271,6 +340,9 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary() {
   }
 
   // Note: we teardown/destroy things in reverse order.
+  Jbig2SymbolDictCache::Get()->SetByteLimit(0);
+  CJPX_Decoder::SetThreadCount(0);
+  CPDF_RebuildScanner::SetThreadCount(0);
   ResetRendererType();
 
   IJS_Runtime::Destroy();
@@ -296,6 +368,16 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
   return SetPDFSandboxPolicy(policy, enable);
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetJpxDecodeThreadCount(int thread_count) {
+  return CJPX_Decoder::SetThreadCount(thread_count);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetRebuildScanThreadCount(int thread_count) {
+  return CPDF_RebuildScanner::SetThreadCount(thread_count);
+}
+
 #if BUILDFLAG(IS_WIN)
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode) {
   if (mode < FPDF_PRINTMODE_EMF ||
@@ -313,7 +395,36 @@ FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password) {
   // NOTE: the creation of the file needs to be by the embedder on the
   // other side of this API.
   return LoadDocumentImpl(IFX_SeekableReadStream::CreateFromFilename(file_path),
-                          password);
+                          password, /*load_flags=*/0, /*cross_ref_index=*/{});
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentMapped(FPDF_STRING file_path, FPDF_BYTESTRING password) {
+  return LoadDocumentImpl(
+      IFX_SeekableReadStream::CreateMappedFromFilename(file_path), password,
+      /*load_flags=*/0, /*cross_ref_index=*/{});
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithFlags(FPDF_STRING file_path,
+                           FPDF_BYTESTRING password,
+                           unsigned int flags) {
+  return LoadDocumentImpl(IFX_SeekableReadStream::CreateFromFilename(file_path),
+                          password, GetParserLoadFlags(flags),
+                          /*cross_ref_index=*/{});
+}
+
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithCrossRefIndex(FPDF_STRING file_path,
+                                   FPDF_BYTESTRING password,
+                                   const void* index,
+                                   unsigned long index_size) {
+  // SAFETY: required from caller.
+  auto index_span = UNSAFE_BUFFERS(
+      pdfium::span(static_cast<const uint8_t*>(index),
+                   index ? static_cast<size_t>(index_size) : 0u));
+  return LoadDocumentImpl(IFX_SeekableReadStream::CreateFromFilename(file_path),
+                          password, /*load_flags=*/0, index_span);
 }
 
 FPDF_EXPORT int FPDF_CALLCONV FPDF_GetFormType(FPDF_DOCUMENT document) {
@@ -365,7 +476,7 @@ FPDF_LoadMemDocument(const void* data_buf, int size, FPDF_BYTESTRING password) {
   auto data_span = UNSAFE_BUFFERS(pdfium::span(
       static_cast<const uint8_t*>(data_buf), static_cast<size_t>(size)));
   return LoadDocumentImpl(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data_span),
-                          password);
+                          password, /*load_flags=*/0, /*cross_ref_index=*/{});
 }
 
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
@@ -376,7 +487,7 @@ FPDF_LoadMemDocument64(const void* data_buf,
   auto data_span =
       UNSAFE_BUFFERS(pdfium::span(static_cast<const uint8_t*>(data_buf), size));
   return LoadDocumentImpl(pdfium::MakeRetain<CFX_ReadOnlySpanStream>(data_span),
-                          password);
+                          password, /*load_flags=*/0, /*cross_ref_index=*/{});
 }
 
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
@@ -386,7 +497,7 @@ FPDF_LoadCustomDocument(FPDF_FILEACCESS* pFileAccess,
     return nullptr;
   }
   return LoadDocumentImpl(pdfium::MakeRetain<CPDFSDK_CustomAccess>(pFileAccess),
-                          password);
+                          password, /*load_flags=*/0, /*cross_ref_index=*/{});
 }
 
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_GetFileVersion(FPDF_DOCUMENT doc,
@@ -469,6 +580,7 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageCount(FPDF_DOCUMENT document) {
 
 FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
                                                   int page_index) {
+  ScopedPageLock lock;
   auto* pDoc = CPDFDocumentFromFPDFDocument(document);
   if (!pDoc) {
     return nullptr;
@@ -499,6 +611,7 @@ FPDF_EXPORT FPDF_PAGE FPDF_CALLCONV FPDF_LoadPage(FPDF_DOCUMENT document,
 }
 
 FPDF_EXPORT float FPDF_CALLCONV FPDF_GetPageWidthF(FPDF_PAGE page) {
+  ScopedPageLock lock;
   IPDF_Page* pPage = IPDFPageFromFPDFPage(page);
   return pPage ? pPage->GetPageWidth() : 0.0f;
 }
@@ -508,6 +621,7 @@ FPDF_EXPORT double FPDF_CALLCONV FPDF_GetPageWidth(FPDF_PAGE page) {
 }
 
 FPDF_EXPORT float FPDF_CALLCONV FPDF_GetPageHeightF(FPDF_PAGE page) {
+  ScopedPageLock lock;
   IPDF_Page* pPage = IPDFPageFromFPDFPage(page);
   return pPage ? pPage->GetPageHeight() : 0.0f;
 }
@@ -754,6 +868,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
                                                      int size_y,
                                                      int rotate,
                                                      int flags) {
+  ScopedPageLock lock;
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
   if (!pPage) {
     return;
@@ -776,6 +891,7 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageBitmap(FPDF_BITMAP bitmap,
   auto device = std::make_unique<CFX_DefaultRenderDevice>();
   device->AttachWithRgbByteOrder(std::move(pBitmap),
                                  !!(flags & FPDF_REVERSE_BYTE_ORDER));
+  SetPageLock(device.get());
   context->device_ = std::move(device);
 
   CPDFSDK_RenderPageWithContext(context, pPage, start_x, start_y, size_x,
@@ -790,6 +906,7 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_MATRIX* matrix,
                                 const FS_RECTF* clipping,
                                 int flags) {
+  ScopedPageLock lock;
   CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
   if (!pPage) {
     return;
@@ -812,6 +929,7 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
   auto device = std::make_unique<CFX_DefaultRenderDevice>();
   device->AttachWithRgbByteOrder(std::move(pBitmap),
                                  !!(flags & FPDF_REVERSE_BYTE_ORDER));
+  SetPageLock(device.get());
   context->device_ = std::move(device);
 
   CFX_FloatRect clipping_rect;
@@ -828,11 +946,283 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                      /*color_scheme=*/nullptr);
 }
 
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapDirtyRect(FPDF_BITMAP bitmap,
+                               FPDF_PAGE page,
+                               const FS_MATRIX* matrix,
+                               FPDF_BITMAP backdrop,
+                               FPDF_DWORD fill_color,
+                               int flags,
+                               FS_RECTF* dirty_rect) {
+  ScopedPageLock lock;
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage) {
+    return false;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pBitmap) {
+    return false;
+  }
+
+  RetainPtr<const CFX_DIBitmap> pBackdrop(CFXDIBitmapFromFPDFBitmap(backdrop));
+  if (pBackdrop && (pBackdrop->GetWidth() != pBitmap->GetWidth() ||
+                    pBackdrop->GetHeight() != pBitmap->GetHeight() ||
+                    pBackdrop->GetFormat() != pBitmap->GetFormat())) {
+    return false;
+  }
+
+  std::optional<CFX_FloatRect> page_rect = pPage->TakeDirtyRect();
+  if (!page_rect.has_value()) {
+    return false;
+  }
+
+  CFX_Matrix transform_matrix = pPage->GetDisplayMatrix();
+  if (matrix) {
+    transform_matrix *= CFXMatrixFromFSMatrix(*matrix);
+  }
+  FX_RECT rect = transform_matrix.TransformRect(page_rect.value())
+                     .GetOuterRect();
+  // Anti-aliasing reaches one pixel past the object bounds.
+  rect = FX_RECT(rect.left - 1, rect.top - 1, rect.right + 1, rect.bottom + 1);
+  rect.Intersect(FX_RECT(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()));
+  if (rect.IsEmpty()) {
+    return false;
+  }
+
+  // Start over from what was under the page, as only the objects overlapping
+  // `rect` get drawn. Both replace the old pixels rather than blend with them.
+  if (pBackdrop) {
+    const int bytes_per_pixel = pBitmap->GetBPP() / 8;
+    const size_t offset = static_cast<size_t>(rect.left) * bytes_per_pixel;
+    const size_t size = static_cast<size_t>(rect.Width()) * bytes_per_pixel;
+    for (int row = rect.top; row < rect.bottom; ++row) {
+      fxcrt::spancpy(pBitmap->GetWritableScanline(row).subspan(offset, size),
+                     pBackdrop->GetScanline(row).subspan(offset, size));
+    }
+  } else {
+    FPDFBitmap_FillRect(bitmap, rect.left, rect.top, rect.Width(),
+                        rect.Height(), fill_color);
+  }
+  const FS_RECTF clipping = {static_cast<float>(rect.left),
+                             static_cast<float>(rect.top),
+                             static_cast<float>(rect.right),
+                             static_cast<float>(rect.bottom)};
+  FPDF_RenderPageBitmapWithMatrix(bitmap, page, matrix, &clipping, flags);
+  if (dirty_rect) {
+    *dirty_rect = clipping;
+  }
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count) {
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage) {
+    return;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pBitmap) {
+    return;
+  }
+
+  const FX_RECT rect(start_x, start_y, start_x + size_x, start_y + size_y);
+  FX_RECT visible_rect = rect;
+  visible_rect.Intersect(
+      FX_RECT(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight()));
+  size_t band_count = thread_count > 0 ? thread_count
+                                       : std::thread::hardware_concurrency();
+  band_count = std::clamp<size_t>(band_count, 1, kMaxRenderThreads);
+#if defined(PDF_USE_SKIA)
+  if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
+    band_count = 1;
+  }
+#endif
+  if (visible_rect.IsEmpty() ||
+      band_count > static_cast<size_t>(visible_rect.Height())) {
+    band_count = 1;
+  }
+  if (band_count == 1) {
+    FPDF_RenderPageBitmap(bitmap, page, start_x, start_y, size_x, size_y,
+                          rotate, flags);
+    return;
+  }
+  ValidateBitmapPremultiplyState(pBitmap);
+
+  // Split by rows, so that no two bands write to the same byte.
+  std::vector<FX_RECT> bands;
+  const size_t height = visible_rect.Height();
+  for (size_t i = 0; i < band_count; ++i) {
+    FX_RECT band = visible_rect;
+    band.top = visible_rect.top + static_cast<int>(height * i / band_count);
+    band.bottom =
+        visible_rect.top + static_cast<int>(height * (i + 1) / band_count);
+    bands.push_back(band);
+  }
+
+  // The bands share the page, and the document and font caches behind it,
+  // none of which are thread-safe. So each thread holds the page lock while
+  // it renders, and its device only releases it while rasterizing.
+  const CFX_Matrix matrix = pPage->GetDisplayMatrixForRect(rect, rotate);
+  auto render_band = [&](const FX_RECT& band) {
+    ScopedPageLock lock;
+    CPDF_PageRenderContext context;
+    auto device = std::make_unique<CFX_DefaultRenderDevice>();
+    device->AttachWithRgbByteOrder(pBitmap,
+                                   !!(flags & FPDF_REVERSE_BYTE_ORDER));
+    device->SetRenderLock(&GetPageLock());
+    context.device_ = std::move(device);
+    CPDFSDK_RenderPage(&context, pPage, matrix, band, flags,
+                       /*color_scheme=*/nullptr);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < bands.size(); ++i) {
+    threads.emplace_back(render_band, bands[i]);
+  }
+  render_band(bands[0]);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheByteLimit(size_t byte_limit) {
+  ScopedPageLock lock;
+  CFX_GlyphCache::SetByteLimit(byte_limit);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetGlyphCacheStats(FPDF_GLYPH_CACHE_STATS* stats) {
+  if (!stats) {
+    return false;
+  }
+
+  CFX_GlyphCache::Stats cache_stats;
+  {
+    ScopedPageLock lock;
+    cache_stats = CFX_GlyphCache::GetStats();
+  }
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->evictions = cache_stats.evictions;
+  stats->bytes = cache_stats.bytes;
+  stats->byte_limit = cache_stats.byte_limit;
+  stats->pinned_paths = cache_stats.pinned_paths;
+  stats->pinned_bytes = cache_stats.pinned_bytes;
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetJbig2SymbolDictCacheByteLimit(size_t byte_limit) {
+  Jbig2SymbolDictCache::Get()->SetByteLimit(byte_limit);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetJbig2SymbolDictCacheStats(FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS* stats) {
+  if (!stats) {
+    return false;
+  }
+
+  const Jbig2SymbolDictCache::Stats cache_stats =
+      Jbig2SymbolDictCache::Get()->GetStats();
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->evictions = cache_stats.evictions;
+  stats->bytes = cache_stats.bytes;
+  stats->byte_limit = cache_stats.byte_limit;
+  return true;
+}
+
+FPDF_EXPORT FPDF_DISPLAYLIST FPDF_CALLCONV
+FPDF_RecordPageDisplayList(FPDF_PAGE page, int flags) {
+  ScopedPageLock lock;
+  CPDF_Page* pPage = CPDFPageFromFPDFPage(page);
+  if (!pPage) {
+    return nullptr;
+  }
+
+  const FX_RECT page_rect =
+      CFX_FloatRect(0, 0, pPage->GetPageWidth(), pPage->GetPageHeight())
+          .GetOuterRect();
+  if (page_rect.IsEmpty()) {
+    return nullptr;
+  }
+
+  auto owned_context = std::make_unique<CPDF_PageRenderContext>();
+  CPDF_PageRenderContext* context = owned_context.get();
+  CPDF_Page::RenderContextClearer clearer(pPage);
+  pPage->SetRenderContext(std::move(owned_context));
+
+  auto device = std::make_unique<CFX_DisplayListDevice>(page_rect.Width(),
+                                                        page_rect.Height());
+  CFX_DisplayListDevice* recorder = device.get();
+  context->device_ = std::move(device);
+  CPDFSDK_RenderPage(context, pPage, pPage->GetDisplayMatrix(), page_rect,
+                     flags, /*color_scheme=*/nullptr);
+
+  // Caller takes ownership.
+  return FPDFDisplayListFromCFXDisplayList(
+      recorder->TakeDisplayList().release());
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderDisplayList(FPDF_BITMAP bitmap,
+                       FPDF_DISPLAYLIST display_list,
+                       const FS_MATRIX* matrix,
+                       const FS_RECTF* clipping) {
+  const CFX_DisplayList* list = CFXDisplayListFromFPDFDisplayList(display_list);
+  if (!list) {
+    return false;
+  }
+
+  RetainPtr<CFX_DIBitmap> pBitmap(CFXDIBitmapFromFPDFBitmap(bitmap));
+  if (!pBitmap) {
+    return false;
+  }
+
+  // The replay loads glyphs into the shared glyph caches.
+  ScopedPageLock lock;
+  ValidateBitmapPremultiplyState(pBitmap);
+  FX_RECT clip_rect(0, 0, pBitmap->GetWidth(), pBitmap->GetHeight());
+  if (clipping) {
+    clip_rect = CFXFloatRectFromFSRectF(*clipping).ToFxRect();
+  }
+
+#if defined(PDF_USE_SKIA)
+  CFX_DIBitmap::ScopedPremultiplier scoped_premultiplier(pBitmap);
+#endif
+  CFX_DefaultRenderDevice device;
+  device.Attach(std::move(pBitmap));
+  device.SaveState();
+  device.SetClip_Rect(clip_rect);
+  list->Replay(&device, matrix ? CFXMatrixFromFSMatrix(*matrix) : CFX_Matrix());
+  device.RestoreState(/*bKeepSaved=*/false);
+  return true;
+}
+
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_CloseDisplayList(FPDF_DISPLAYLIST display_list) {
+  // The list may share bitmaps with the page image caches.
+  ScopedPageLock lock;
+  // Take it back across the API and throw it away.
+  std::unique_ptr<CFX_DisplayList>(
+      CFXDisplayListFromFPDFDisplayList(display_list));
+}
+
 #if defined(PDF_USE_SKIA)
 FPDF_EXPORT void FPDF_CALLCONV FPDF_RenderPageSkia(FPDF_SKIA_CANVAS canvas,
                                                    FPDF_PAGE page,
                                                    int size_x,
                                                    int size_y) {
+  ScopedPageLock lock;
   SkCanvas* sk_canvas = SkCanvasFromFPDFSkiaCanvas(canvas);
   if (!sk_canvas) {
     return;
@@ -865,6 +1255,9 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_ClosePage(FPDF_PAGE page) {
     return;
   }
 
+  // Declared before `pPage`, so the page is destroyed under the lock.
+  ScopedPageLock lock;
+
   // Take it back across the API and hold for duration of this function.
   RetainPtr<IPDF_Page> pPage;
   pPage.Unleak(IPDFPageFromFPDFPage(page));
@@ -1112,6 +1505,7 @@ FPDF_GetPageSizeByIndexF(FPDF_DOCUMENT document,
     return false;
   }
 
+  ScopedPageLock lock;
   auto* pDoc = CPDFDocumentFromFPDFDocument(document);
   if (!pDoc) {
     return false;
@@ -1506,6 +1900,25 @@ FPDF_GetXFAPacketContent(FPDF_DOCUMENT document,
   return true;
 }
 
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetCrossRefIndex(FPDF_DOCUMENT document,
+                      void* buffer,
+                      unsigned long buflen) {
+  auto* doc = CPDFDocumentFromFPDFDocument(document);
+  if (!doc || !doc->GetParser()) {
+    return 0;
+  }
+
+  DataVector<uint8_t> index = doc->GetParser()->SerializeCrossRefIndex();
+  const unsigned long index_len = fxcrt::CollectionSize<unsigned long>(index);
+  if (buffer && buflen >= index_len) {
+    // SAFETY: required from caller.
+    fxcrt::Copy(index, UNSAFE_BUFFERS(pdfium::span(
+                           static_cast<uint8_t*>(buffer), buflen)));
+  }
+  return index_len;
+}
+
 FPDF_EXPORT unsigned long FPDF_CALLCONV
 FPDF_GetTrailerEnds(FPDF_DOCUMENT document,
                     unsigned int* buffer,
@@ -129,11 +129,13 @@ int CheckPDFiumCApi() {
     CHK(FPDFAvail_Create);
     CHK(FPDFAvail_Destroy);
     CHK(FPDFAvail_GetDocument);
+    CHK(FPDFAvail_GetDownloadStats);
     CHK(FPDFAvail_GetFirstPageNum);
     CHK(FPDFAvail_IsDocAvail);
     CHK(FPDFAvail_IsFormAvail);
     CHK(FPDFAvail_IsLinearized);
     CHK(FPDFAvail_IsPageAvail);
+    CHK(FPDFAvail_SetReadAhead);
 
     // fpdf_doc.h
     CHK(FPDFAction_GetDest);
@@ -250,6 +252,7 @@ int CheckPDFiumCApi() {
     CHK(FPDFPage_GetRotation);
     CHK(FPDFPage_HasTransparency);
     CHK(FPDFPage_InsertObject);
+    CHK(FPDFPage_InvalidateObject);
     CHK(FPDFPage_New);
     CHK(FPDFPage_RemoveObject);
     CHK(FPDFPage_SetRotation);
@@ -497,6 +500,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_BStr_Init);
     CHK(FPDF_BStr_Set);
 #endif
+    CHK(FPDF_CloseDisplayList);
     CHK(FPDF_CloseDocument);
     CHK(FPDF_ClosePage);
     CHK(FPDF_CountNamedDests);
@@ -506,9 +510,12 @@ int CheckPDFiumCApi() {
 #ifdef PDF_ENABLE_V8
     CHK(FPDF_GetArrayBufferAllocatorSharedInstance);
 #endif
+    CHK(FPDF_GetCrossRefIndex);
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetDocUserPermissions);
     CHK(FPDF_GetFileVersion);
+    CHK(FPDF_GetGlyphCacheStats);
+    CHK(FPDF_GetJbig2SymbolDictCacheStats);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
     CHK(FPDF_GetNamedDestByName);
@@ -532,21 +539,32 @@ int CheckPDFiumCApi() {
     CHK(FPDF_InitLibraryWithConfig);
     CHK(FPDF_LoadCustomDocument);
     CHK(FPDF_LoadDocument);
+    CHK(FPDF_LoadDocumentMapped);
+    CHK(FPDF_LoadDocumentWithCrossRefIndex);
+    CHK(FPDF_LoadDocumentWithFlags);
     CHK(FPDF_LoadMemDocument);
     CHK(FPDF_LoadMemDocument64);
     CHK(FPDF_LoadPage);
     CHK(FPDF_PageToDevice);
+    CHK(FPDF_RecordPageDisplayList);
+    CHK(FPDF_RenderDisplayList);
 #ifdef _WIN32
     CHK(FPDF_RenderPage);
 #endif
     CHK(FPDF_RenderPageBitmap);
+    CHK(FPDF_RenderPageBitmapDirtyRect);
     CHK(FPDF_RenderPageBitmapWithMatrix);
+    CHK(FPDF_RenderPageBitmapParallel);
 #if defined(PDF_USE_SKIA)
     CHK(FPDF_RenderPageSkia);
 #endif
+    CHK(FPDF_SetGlyphCacheByteLimit);
+    CHK(FPDF_SetJbig2SymbolDictCacheByteLimit);
 #if defined(_WIN32)
     CHK(FPDF_SetPrintMode);
 #endif
+    CHK(FPDF_SetJpxDecodeThreadCount);
+    CHK(FPDF_SetRebuildScanThreadCount);
     CHK(FPDF_SetSandBoxPolicy);
     CHK(FPDF_VIEWERREF_GetDuplex);
     CHK(FPDF_VIEWERREF_GetName);
@@ -3,20 +3,24 @@
 // found in the LICENSE file.
 
 #include <math.h>
+#include <stdlib.h>
 
 #include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "build/build_config.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
+#include "core/fpdfapi/parser/cpdf_parser.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "fpdfsdk/cpdfsdk_helpers.h"
 #include "fpdfsdk/fpdf_view_c_api_test.h"
 #include "public/cpp/fpdf_scopers.h"
+#include "public/fpdf_doc.h"
 #include "public/fpdfview.h"
 #include "testing/embedder_test.h"
 #include "testing/embedder_test_constants.h"
@@ -519,6 +523,128 @@ TEST_F(FPDFViewEmbedderTest, LoadDocument64) {
   EXPECT_EQ(14, version);
 }
 
+TEST_F(FPDFViewEmbedderTest, LoadDocumentMapped) {
+  std::string file_path = PathService::GetTestFilePath("hello_world.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  ScopedFPDFDocument doc(FPDF_LoadDocumentMapped(file_path.c_str(), nullptr));
+  ASSERT_TRUE(doc);
+  ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+
+  ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+  ASSERT_TRUE(page);
+  ScopedFPDFBitmap bitmap = RenderPage(page.get());
+  CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithCrossRefIndex) {
+  std::string file_path = PathService::GetTestFilePath("hello_world.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  std::vector<uint8_t> index;
+  {
+    ScopedFPDFDocument doc(FPDF_LoadDocument(file_path.c_str(), nullptr));
+    ASSERT_TRUE(doc);
+    EXPECT_EQ(0u, FPDF_GetCrossRefIndex(nullptr, nullptr, 0));
+    const unsigned long size = FPDF_GetCrossRefIndex(doc.get(), nullptr, 0);
+    ASSERT_GT(size, 0u);
+
+    // A buffer that is too small is left alone.
+    index.resize(size, 0xab);
+    EXPECT_EQ(size, FPDF_GetCrossRefIndex(doc.get(), index.data(), size - 1));
+    EXPECT_EQ(0xab, index[0]);
+    EXPECT_EQ(size, FPDF_GetCrossRefIndex(doc.get(), index.data(), size));
+    EXPECT_NE(0xab, index[0]);
+  }
+
+  ScopedFPDFDocument doc(FPDF_LoadDocumentWithCrossRefIndex(
+      file_path.c_str(), nullptr, index.data(), index.size()));
+  ASSERT_TRUE(doc);
+  EXPECT_TRUE(FPDF_DocumentHasValidCrossReferenceTable(doc.get()));
+  ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+  {
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+  }
+
+  // An index for a different file gets ignored.
+  std::string other_file_path = PathService::GetTestFilePath("rectangles.pdf");
+  ASSERT_FALSE(other_file_path.empty());
+  ScopedFPDFDocument other_doc(FPDF_LoadDocumentWithCrossRefIndex(
+      other_file_path.c_str(), nullptr, index.data(), index.size()));
+  ASSERT_TRUE(other_doc);
+  EXPECT_EQ(1, FPDF_GetPageCount(other_doc.get()));
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithFlags) {
+  std::string file_path =
+      PathService::GetTestFilePath("incremental_update_trailer.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  for (unsigned int flags : {0u, FPDF_LOAD_CROSS_REF_LAZILY}) {
+    SCOPED_TRACE(flags);
+    ScopedFPDFDocument doc(
+        FPDF_LoadDocumentWithFlags(file_path.c_str(), nullptr, flags));
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(FPDF_DocumentHasValidCrossReferenceTable(doc.get()));
+    ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+
+    // The page comes from the update.
+    FS_SIZEF size;
+    ASSERT_TRUE(FPDF_GetPageSizeByIndexF(doc.get(), 0, &size));
+    EXPECT_EQ(300.0f, size.width);
+
+    // /Info and /ID only appear in the trailer of the original section.
+    unsigned short buffer[32];
+    ASSERT_EQ(38u, FPDF_GetMetaText(doc.get(), "Title", buffer,
+                                    sizeof(buffer)));
+    EXPECT_EQ(L"Incremental Update", GetPlatformWString(buffer));
+    EXPECT_EQ(17u, FPDF_GetFileIdentifier(doc.get(), FILEIDTYPE_PERMANENT,
+                                          nullptr, 0));
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadDocumentWithPrefetchedObjectStreams) {
+  std::string file_path =
+      PathService::GetTestFilePath("annotation_stamp_with_ap.pdf");
+  ASSERT_FALSE(file_path.empty());
+
+  std::string expected_hash;
+  for (unsigned int flags : {0u, FPDF_LOAD_PREFETCH_OBJECT_STREAMS}) {
+    SCOPED_TRACE(flags);
+    ScopedFPDFDocument doc(
+        FPDF_LoadDocumentWithFlags(file_path.c_str(), nullptr, flags));
+    ASSERT_TRUE(doc);
+
+    // All 3 object streams are only decoded up front with the flag.
+    const CPDF_Parser* parser =
+        CPDFDocumentFromFPDFDocument(doc.get())->GetParser();
+    if (flags) {
+      EXPECT_EQ(3u, parser->GetObjectStreamCountForTesting());
+    } else {
+      EXPECT_LT(parser->GetObjectStreamCountForTesting(), 3u);
+    }
+
+    ASSERT_EQ(1, FPDF_GetPageCount(doc.get()));
+    ScopedFPDFPage page(FPDF_LoadPage(doc.get(), 0));
+    ASSERT_TRUE(page);
+    ScopedFPDFBitmap bitmap = RenderPage(page.get());
+    if (expected_hash.empty()) {
+      expected_hash = HashBitmap(bitmap.get());
+    } else {
+      EXPECT_EQ(expected_hash, HashBitmap(bitmap.get()));
+    }
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, LoadNonexistentDocumentMapped) {
+  FPDF_DOCUMENT doc = FPDF_LoadDocumentMapped("nonexistent_document.pdf", "");
+  ASSERT_FALSE(doc);
+  EXPECT_EQ(static_cast<int>(FPDF_GetLastError()), FPDF_ERR_FILE);
+}
+
 TEST_F(FPDFViewEmbedderTest, LoadNonexistentDocument) {
   FPDF_DOCUMENT doc = FPDF_LoadDocument("nonexistent_document.pdf", "");
   ASSERT_FALSE(doc);
@@ -1199,6 +1325,342 @@ TEST_F(FPDFViewEmbedderTest, FPDFRenderPageBitmapWithMatrix) {
                                  tile_checksum);
 }
 
+TEST_F(FPDFViewEmbedderTest, RenderPageBitmapParallel) {
+  for (const char* file_name :
+       {"hello_world.pdf", "rotated_text.pdf", "many_rectangles.pdf",
+        "embedded_images.pdf", "annotation_stamp_with_ap.pdf"}) {
+    SCOPED_TRACE(file_name);
+    ASSERT_TRUE(OpenDocument(file_name));
+    {
+      ScopedPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+      const int width = static_cast<int>(FPDF_GetPageWidth(page.get()));
+      const int height = static_cast<int>(FPDF_GetPageHeight(page.get()));
+      for (int flags : {0, FPDF_ANNOT | FPDF_LCD_TEXT}) {
+        ScopedFPDFBitmap expected(FPDFBitmap_Create(width, height, 0));
+        ASSERT_TRUE(FPDFBitmap_FillRect(expected.get(), 0, 0, width, height,
+                                        0xFFFFFFFF));
+        FPDF_RenderPageBitmap(expected.get(), page.get(), 0, 0, width, height,
+                              0, flags);
+
+        // Rendering in bands must not change a single pixel, whatever the
+        // number of threads.
+        for (int thread_count : {0, 2, 3, 8}) {
+          ScopedFPDFBitmap actual(FPDFBitmap_Create(width, height, 0));
+          ASSERT_TRUE(FPDFBitmap_FillRect(actual.get(), 0, 0, width, height,
+                                          0xFFFFFFFF));
+          FPDF_RenderPageBitmapParallel(actual.get(), page.get(), 0, 0, width,
+                                        height, 0, flags, thread_count);
+          EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(actual.get()));
+        }
+      }
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, RenderPagesOnManyThreads) {
+  static constexpr int kThreadCount = 4;
+  auto render_page = [](FPDF_DOCUMENT doc, int page_index) {
+    ScopedFPDFPage page(FPDF_LoadPage(doc, page_index));
+    if (!page) {
+      return std::string();
+    }
+    const int width = static_cast<int>(FPDF_GetPageWidth(page.get()));
+    const int height = static_cast<int>(FPDF_GetPageHeight(page.get()));
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    if (!FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF)) {
+      return std::string();
+    }
+    FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, width, height, 0,
+                          FPDF_ANNOT);
+    return HashBitmap(bitmap.get());
+  };
+
+  for (const char* file_name :
+       {"hello_world_2_pages_shared_resources_dict.pdf",
+        "rectangles_multi_pages.pdf", "tagged_mcr_multipage.pdf",
+        "text_in_page_marked.pdf", "embedded_images.pdf"}) {
+    SCOPED_TRACE(file_name);
+    ASSERT_TRUE(OpenDocument(file_name));
+    const int page_count = FPDF_GetPageCount(document());
+    ASSERT_GT(page_count, 0);
+
+    std::vector<std::string> expected;
+    for (int i = 0; i < page_count; ++i) {
+      expected.push_back(render_page(document(), i));
+      ASSERT_FALSE(expected.back().empty());
+    }
+
+    // Each thread loads, renders and closes every page, starting at a
+    // different one, so that the same resources are loaded concurrently.
+    std::vector<std::vector<std::string>> actual(kThreadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreadCount; ++t) {
+      threads.emplace_back([&, t] {
+        actual[t].resize(page_count);
+        for (int i = 0; i < page_count; ++i) {
+          const int page_index = (t + i) % page_count;
+          actual[t][page_index] = render_page(document(), page_index);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    for (const std::vector<std::string>& hashes : actual) {
+      EXPECT_EQ(expected, hashes);
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, MixedPageCallsOnManyThreads) {
+  // Each thread renders every page of the same document through a different
+  // function, while another one keeps loading pages and reading page sizes.
+  // Under TSAN, this checks that all the functions listed at the top of
+  // fpdfview.h share the page lock.
+  enum class RenderCall { kBitmap, kMatrix, kParallel, kDisplayList };
+  auto render_page = [](FPDF_DOCUMENT doc, int page_index, RenderCall call) {
+    ScopedFPDFPage page(FPDF_LoadPage(doc, page_index));
+    if (!page) {
+      return std::string();
+    }
+    const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+    const int height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+    ScopedFPDFBitmap bitmap(FPDFBitmap_Create(width, height, 0));
+    if (!FPDFBitmap_FillRect(bitmap.get(), 0, 0, width, height, 0xFFFFFFFF)) {
+      return std::string();
+    }
+    switch (call) {
+      case RenderCall::kBitmap:
+        FPDF_RenderPageBitmap(bitmap.get(), page.get(), 0, 0, width, height, 0,
+                              0);
+        break;
+      case RenderCall::kMatrix: {
+        const FS_MATRIX matrix{1, 0, 0, 1, 0, 0};
+        const FS_RECTF clip{0, 0, static_cast<float>(width),
+                            static_cast<float>(height)};
+        FPDF_RenderPageBitmapWithMatrix(bitmap.get(), page.get(), &matrix,
+                                        &clip, 0);
+        break;
+      }
+      case RenderCall::kParallel:
+        FPDF_RenderPageBitmapParallel(bitmap.get(), page.get(), 0, 0, width,
+                                      height, 0, 0, 2);
+        break;
+      case RenderCall::kDisplayList: {
+        FPDF_DISPLAYLIST display_list =
+            FPDF_RecordPageDisplayList(page.get(), 0);
+        if (!display_list) {
+          return std::string();
+        }
+        FPDF_RenderDisplayList(bitmap.get(), display_list, nullptr, nullptr);
+        FPDF_CloseDisplayList(display_list);
+        break;
+      }
+    }
+    return HashBitmap(bitmap.get());
+  };
+
+  for (const char* file_name :
+       {"rectangles_multi_pages.pdf", "text_in_page_marked.pdf",
+        "embedded_images.pdf"}) {
+    SCOPED_TRACE(file_name);
+    ASSERT_TRUE(OpenDocument(file_name));
+    const int page_count = FPDF_GetPageCount(document());
+    ASSERT_GT(page_count, 0);
+
+    static constexpr RenderCall kCalls[] = {
+        RenderCall::kBitmap, RenderCall::kMatrix, RenderCall::kParallel,
+        RenderCall::kDisplayList};
+    std::vector<std::vector<std::string>> expected(std::size(kCalls));
+    for (size_t t = 0; t < std::size(kCalls); ++t) {
+      for (int i = 0; i < page_count; ++i) {
+        expected[t].push_back(render_page(document(), i, kCalls[t]));
+        ASSERT_FALSE(expected[t].back().empty());
+      }
+    }
+
+    std::vector<std::vector<std::string>> actual(std::size(kCalls));
+    std::vector<FS_SIZEF> sizes(page_count);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < std::size(kCalls); ++t) {
+      threads.emplace_back([&, t] {
+        actual[t].resize(page_count);
+        for (int i = 0; i < page_count; ++i) {
+          const int page_index = (static_cast<int>(t) + i) % page_count;
+          actual[t][page_index] =
+              render_page(document(), page_index, kCalls[t]);
+        }
+      });
+    }
+    threads.emplace_back([&] {
+      for (int i = 0; i < page_count; ++i) {
+        ScopedFPDFPage page(FPDF_LoadPage(document(), i));
+        FPDF_GetPageSizeByIndexF(document(), i, &sizes[i]);
+        FPDF_GLYPH_CACHE_STATS stats;
+        FPDF_GetGlyphCacheStats(&stats);
+      }
+    });
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    EXPECT_EQ(expected, actual);
+    for (int i = 0; i < page_count; ++i) {
+      ScopedFPDFPage page(FPDF_LoadPage(document(), i));
+      ASSERT_TRUE(page);
+      EXPECT_EQ(FPDF_GetPageWidthF(page.get()), sizes[i].width);
+      EXPECT_EQ(FPDF_GetPageHeightF(page.get()), sizes[i].height);
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, GlyphCacheStats) {
+  if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
+    GTEST_SKIP() << "Skia does not render glyphs through the glyph caches";
+  }
+
+  EXPECT_FALSE(FPDF_GetGlyphCacheStats(nullptr));
+
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  ScopedPage page = LoadScopedPage(0);
+  ASSERT_TRUE(page);
+
+  // Start without any cached glyphs.
+  FPDF_SetGlyphCacheByteLimit(0);
+  FPDF_SetGlyphCacheByteLimit(64 * 1024 * 1024);
+  FPDF_GLYPH_CACHE_STATS before;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&before));
+  EXPECT_EQ(0u, before.bytes);
+  EXPECT_EQ(64u * 1024 * 1024, before.byte_limit);
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+  }
+  FPDF_GLYPH_CACHE_STATS first;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&first));
+  EXPECT_GT(first.misses, before.misses);
+  // The small glyphs go into an atlas, which counts as a whole.
+  EXPECT_GT(first.bytes, 256u * 256);
+
+  // The same glyphs again come from the caches.
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+  }
+  FPDF_GLYPH_CACHE_STATS second;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&second));
+  EXPECT_GT(second.hits, first.hits);
+  EXPECT_EQ(first.misses, second.misses);
+
+  // With a tiny budget, glyphs get evicted and rendered again, with the same
+  // result.
+  FPDF_SetGlyphCacheByteLimit(1);
+  FPDF_GLYPH_CACHE_STATS shrunk;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&shrunk));
+  EXPECT_EQ(0u, shrunk.bytes);
+  EXPECT_EQ(1u, shrunk.byte_limit);
+  EXPECT_GT(shrunk.evictions, second.evictions);
+  {
+    ScopedFPDFBitmap bitmap = RenderLoadedPage(page.get());
+    CompareBitmap(bitmap.get(), 200, 200, pdfium::HelloWorldChecksum());
+  }
+  FPDF_GLYPH_CACHE_STATS evicting;
+  ASSERT_TRUE(FPDF_GetGlyphCacheStats(&evicting));
+  EXPECT_GT(evicting.misses, shrunk.misses);
+  EXPECT_GT(evicting.evictions, shrunk.evictions);
+
+  FPDF_SetGlyphCacheByteLimit(64 * 1024 * 1024);
+}
+
+TEST_F(FPDFViewEmbedderTest, DisplayList) {
+  EXPECT_FALSE(FPDF_RecordPageDisplayList(nullptr, 0));
+  FPDF_CloseDisplayList(nullptr);
+
+  for (const char* file : {"hello_world.pdf", "rectangles.pdf"}) {
+    SCOPED_TRACE(file);
+    ASSERT_TRUE(OpenDocument(file));
+    {
+      ScopedPage page = LoadScopedPage(0);
+      ASSERT_TRUE(page);
+
+      FPDF_DISPLAYLIST display_list =
+          FPDF_RecordPageDisplayList(page.get(), 0);
+      ASSERT_TRUE(display_list);
+
+      const float page_width = FPDF_GetPageWidthF(page.get());
+      const float page_height = FPDF_GetPageHeightF(page.get());
+      for (float scale : {1.0f, 2.0f}) {
+        SCOPED_TRACE(scale);
+        const int bitmap_width = static_cast<int>(page_width * scale);
+        const int bitmap_height = static_cast<int>(page_height * scale);
+        const FS_MATRIX matrix{scale, 0, 0, scale, 0, 0};
+        const FS_RECTF clip_rect{0, 0, static_cast<float>(bitmap_width),
+                                 static_cast<float>(bitmap_height)};
+
+        ScopedFPDFBitmap expected(
+            FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+        ASSERT_TRUE(FPDFBitmap_FillRect(expected.get(), 0, 0, bitmap_width,
+                                        bitmap_height, 0xFFFFFFFF));
+        FPDF_RenderPageBitmapWithMatrix(expected.get(), page.get(), &matrix,
+                                        &clip_rect, 0);
+
+        // Replaying the list gives the same pixels as rendering the page.
+        ScopedFPDFBitmap replayed(
+            FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+        ASSERT_TRUE(FPDFBitmap_FillRect(replayed.get(), 0, 0, bitmap_width,
+                                        bitmap_height, 0xFFFFFFFF));
+        EXPECT_FALSE(FPDF_RenderDisplayList(nullptr, display_list, &matrix,
+                                            &clip_rect));
+        EXPECT_FALSE(FPDF_RenderDisplayList(replayed.get(), nullptr, &matrix,
+                                            &clip_rect));
+        ASSERT_TRUE(FPDF_RenderDisplayList(replayed.get(), display_list,
+                                           &matrix, &clip_rect));
+        EXPECT_EQ(HashBitmap(expected.get()), HashBitmap(replayed.get()));
+      }
+
+      FPDF_CloseDisplayList(display_list);
+    }
+    CloseDocument();
+  }
+}
+
+TEST_F(FPDFViewEmbedderTest, DisplayListOutlivesDocument) {
+  ASSERT_TRUE(OpenDocument("hello_world.pdf"));
+  FPDF_DISPLAYLIST display_list;
+  std::string expected_hash;
+  int bitmap_width;
+  int bitmap_height;
+  {
+    ScopedPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    display_list = FPDF_RecordPageDisplayList(page.get(), 0);
+    ASSERT_TRUE(display_list);
+
+    bitmap_width = static_cast<int>(FPDF_GetPageWidthF(page.get()));
+    bitmap_height = static_cast<int>(FPDF_GetPageHeightF(page.get()));
+    ScopedFPDFBitmap expected(
+        FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+    ASSERT_TRUE(FPDFBitmap_FillRect(expected.get(), 0, 0, bitmap_width,
+                                    bitmap_height, 0xFFFFFFFF));
+    ASSERT_TRUE(
+        FPDF_RenderDisplayList(expected.get(), display_list, nullptr, nullptr));
+    expected_hash = HashBitmap(expected.get());
+  }
+  CloseDocument();
+
+  // The list still has the fonts of the text it recorded.
+  ScopedFPDFBitmap replayed(FPDFBitmap_Create(bitmap_width, bitmap_height, 0));
+  ASSERT_TRUE(FPDFBitmap_FillRect(replayed.get(), 0, 0, bitmap_width,
+                                  bitmap_height, 0xFFFFFFFF));
+  ASSERT_TRUE(
+      FPDF_RenderDisplayList(replayed.get(), display_list, nullptr, nullptr));
+  EXPECT_EQ(expected_hash, HashBitmap(replayed.get()));
+  FPDF_CloseDisplayList(display_list);
+}
+
 TEST_F(FPDFViewEmbedderTest, FPDFGetPageSizeByIndexF) {
   ASSERT_TRUE(OpenDocument("rectangles.pdf"));
 
@@ -1538,6 +2000,77 @@ TEST_F(FPDFViewEmbedderTest, RenderJpxLzwImageWithFlags) {
                                 kNormalChecksum);
 }
 
+TEST_F(FPDFViewEmbedderTest, RenderJpxImageAsTiles) {
+  // Allows for rounding in the resamplers at the edges of partial images.
+  static constexpr int kTolerance = 3;
+  static constexpr int kTiles = 2;
+
+  ASSERT_TRUE(OpenDocument("jpx_lzw.pdf"));
+  for (float scale : {1.0f, 0.5f}) {
+    SCOPED_TRACE(scale);
+    // Load the page for each scale, so its image cache starts out empty.
+    ScopedPage page = LoadScopedPage(0);
+    ASSERT_TRUE(page);
+    const int width = static_cast<int>(FPDF_GetPageWidthF(page.get()) * scale);
+    const int height =
+        static_cast<int>(FPDF_GetPageHeightF(page.get()) * scale);
+    const int tile_width = width / kTiles;
+    const int tile_height = height / kTiles;
+
+    // Render the tiles first, so that each only decodes its part of the
+    // image.
+    std::vector<ScopedFPDFBitmap> tiles;
+    for (int y = 0; y < kTiles; ++y) {
+      for (int x = 0; x < kTiles; ++x) {
+        ScopedFPDFBitmap tile(FPDFBitmap_Create(tile_width, tile_height, 0));
+        ASSERT_TRUE(FPDFBitmap_FillRect(tile.get(), 0, 0, tile_width,
+                                        tile_height, 0xFFFFFFFF));
+        const FS_MATRIX matrix{scale,
+                               0,
+                               0,
+                               scale,
+                               static_cast<float>(-x * tile_width),
+                               static_cast<float>(-y * tile_height)};
+        const FS_RECTF clip_rect{0, 0, static_cast<float>(tile_width),
+                                 static_cast<float>(tile_height)};
+        FPDF_RenderPageBitmapWithMatrix(tile.get(), page.get(), &matrix,
+                                        &clip_rect, 0);
+        tiles.push_back(std::move(tile));
+      }
+    }
+
+    ScopedFPDFBitmap full(FPDFBitmap_Create(width, height, 0));
+    ASSERT_TRUE(
+        FPDFBitmap_FillRect(full.get(), 0, 0, width, height, 0xFFFFFFFF));
+    FPDF_RenderPageBitmap(full.get(), page.get(), 0, 0, width, height, 0, 0);
+
+    const int full_stride = FPDFBitmap_GetStride(full.get());
+    const uint8_t* full_buffer =
+        static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(full.get()));
+    for (int y = 0; y < kTiles; ++y) {
+      for (int x = 0; x < kTiles; ++x) {
+        SCOPED_TRACE(testing::Message() << "tile " << x << ", " << y);
+        FPDF_BITMAP tile = tiles[y * kTiles + x].get();
+        const int tile_stride = FPDFBitmap_GetStride(tile);
+        const uint8_t* tile_buffer =
+            static_cast<const uint8_t*>(FPDFBitmap_GetBuffer(tile));
+        int max_difference = 0;
+        for (int row = 0; row < tile_height; ++row) {
+          const uint8_t* full_row =
+              full_buffer + (y * tile_height + row) * full_stride +
+              x * tile_width * 4;
+          const uint8_t* tile_row = tile_buffer + row * tile_stride;
+          for (int i = 0; i < tile_width * 4; ++i) {
+            max_difference =
+                std::max(max_difference, abs(full_row[i] - tile_row[i]));
+          }
+        }
+        EXPECT_LE(max_difference, kTolerance);
+      }
+    }
+  }
+}
+
 TEST_F(FPDFViewEmbedderTest, RenderManyRectanglesWithFlags) {
   const char* grayscale_checksum = []() {
     if (CFX_DefaultRenderDevice::UseSkiaRenderer()) {
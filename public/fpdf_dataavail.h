@@ -197,6 +197,49 @@ FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsFormAvail(FPDF_AVAIL avail,
 // if the PDF is linearlized.
 FPDF_EXPORT int FPDF_CALLCONV FPDFAvail_IsLinearized(FPDF_AVAIL avail);
 
+// Experimental API.
+// Counters for the download hints produced by an availability provider.
+// |requests| and |stalls| stop at ULONG_MAX.
+typedef struct _FPDF_AVAIL_DOWNLOAD_STATS {
+  // Number of sections passed to FX_DOWNLOADHINTS::AddSegment().
+  unsigned long requests;
+  // Total size of those sections, in bytes.
+  unsigned long long requested_bytes;
+  // Part of |requested_bytes| that was not needed by the checks that asked
+  // for it, because of alignment, merging and read-ahead.
+  unsigned long long over_fetched_bytes;
+  // Number of times a check found the data it needed unavailable.
+  unsigned long stalls;
+} FPDF_AVAIL_DOWNLOAD_STATS;
+
+// Experimental API.
+// Enable or disable adaptive read-ahead for the download hints of |avail|.
+//
+//   avail  - handle to document availability provider.
+//   enable - whether to enable read-ahead.
+//
+// Returns true on success.
+//
+// With read-ahead, the sections requested by one call to
+// FPDFAvail_IsDocAvail(), FPDFAvail_IsPageAvail() or FPDFAvail_IsFormAvail()
+// are reported together just before the call returns, with nearby sections
+// merged. Sections are extended beyond the data that was needed when the file
+// is being read sequentially, and for linearized files, to cover the whole
+// page or shared object group described by the hint tables. This trades a
+// little extra data for fewer round trips. Read-ahead is disabled by default.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFAvail_SetReadAhead(FPDF_AVAIL avail,
+                                                           FPDF_BOOL enable);
+
+// Experimental API.
+// Get the download statistics of |avail|.
+//
+//   avail - handle to document availability provider.
+//   stats - receives the statistics.
+//
+// Returns true on success.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFAvail_GetDownloadStats(FPDF_AVAIL avail, FPDF_AVAIL_DOWNLOAD_STATS* stats);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -202,6 +202,25 @@ FPDFPage_InsertObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object);
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
 FPDFPage_RemoveObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object);
 
+// Experimental API.
+// Mark the area |page_object| covers on |page| as changed, so that
+// FPDF_RenderPageBitmapDirtyRect() renders it again.
+//
+//   page        - handle to a page.
+//   page_object - handle to a page object of |page|, not one nested inside a
+//                 form object.
+//
+// Returns TRUE on success.
+//
+// The functions that change objects directly on a page, such as
+// FPDFPage_InsertObject(), FPDFPage_RemoveObject(), FPDFPageObj_Transform(),
+// FPDFPageObj_SetFillColor() or FPDFPath_LineTo(), already mark the old and
+// new areas. Changes to the objects inside a form object are not seen by the
+// page, so call this on the form object before changing them, to cover its
+// old area, and again after, to cover its new area.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDFPage_InvalidateObject(FPDF_PAGE page, FPDF_PAGEOBJECT page_object);
+
 // Get number of page objects inside |page|.
 //
 //   page - handle to a page.
@@ -1576,7 +1595,8 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDFFont_GetGlyphWidth(FPDF_FONT font,
 // glyph      - the glyph being drawn.
 // font_size  - the size of the font.
 //
-// Returns the handle to the segment, or NULL on faiure.
+// Returns the handle to the segment, or NULL on faiure. The handle belongs to
+// |font|, and stays valid until |font| is closed.
 FPDF_EXPORT FPDF_GLYPHPATH FPDF_CALLCONV FPDFFont_GetGlyphPath(FPDF_FONT font,
                                                                uint32_t glyph,
                                                                float font_size);
@@ -12,6 +12,26 @@
 // from a single thread. Barring that, embedders are required to ensure (via
 // a mutex or similar) that only a single PDFium call can be made at a time.
 //
+// The one exception is page loading and rendering. Only the functions below
+// may be called on several threads at once, for the same or different
+// documents:
+//
+//   FPDF_LoadPage(), FPDF_ClosePage(), FPDF_GetPageWidth(),
+//   FPDF_GetPageWidthF(), FPDF_GetPageHeight(), FPDF_GetPageHeightF(),
+//   FPDF_GetPageSizeByIndex(), FPDF_GetPageSizeByIndexF(),
+//   FPDF_RenderPageBitmap(), FPDF_RenderPageBitmapWithMatrix(),
+//   FPDF_RenderPageBitmapParallel(), FPDF_RenderPageBitmapDirtyRect(),
+//   FPDF_RecordPageDisplayList(), FPDF_RenderDisplayList(),
+//   FPDF_CloseDisplayList(), FPDF_SetGlyphCacheByteLimit() and
+//   FPDF_GetGlyphCacheStats().
+//
+// Each page must only be rendered by one call at a time, and no other PDFium
+// call may run meanwhile. The FPDFBitmap_*() functions are the exception, for
+// bitmaps that no other thread uses. Everything else, such as the page object,
+// text, annotation, form fill and document editing functions, still needs the
+// embedder to serialize it against these calls. The calls above take turns at
+// parsing and loading resources, and rasterize in parallel.
+//
 // NOTE: External docs refer to this file as "fpdfview.h", so do not rename
 // despite lack of consistency with other public files.
 
@@ -67,6 +87,7 @@ typedef struct fpdf_bitmap_t__* FPDF_BITMAP;
 typedef struct fpdf_bookmark_t__* FPDF_BOOKMARK;
 typedef struct fpdf_clippath_t__* FPDF_CLIPPATH;
 typedef struct fpdf_dest_t__* FPDF_DEST;
+typedef struct fpdf_displaylist_t__* FPDF_DISPLAYLIST;
 typedef struct fpdf_document_t__* FPDF_DOCUMENT;
 typedef struct fpdf_font_t__* FPDF_FONT;
 typedef struct fpdf_form_handle_t__* FPDF_FORMHANDLE;
@@ -337,6 +358,36 @@ FPDF_EXPORT void FPDF_CALLCONV FPDF_DestroyLibrary();
 FPDF_EXPORT void FPDF_CALLCONV FPDF_SetSandBoxPolicy(FPDF_DWORD policy,
                                                      FPDF_BOOL enable);
 
+// Experimental API.
+// Function: FPDF_SetJpxDecodeThreadCount
+//          Set how many threads may decode each JPEG 2000 image.
+// Parameters:
+//          thread_count -   The number of threads. 0 or 1 means decoding on
+//                           the calling thread only, which is the default.
+// Return value:
+//          TRUE on success. FALSE if |thread_count| is negative, or if it is
+//          greater than 1 and this build cannot decode on multiple threads.
+// Comments:
+//          Applies to images decoded afterwards, until FPDF_DestroyLibrary()
+//          is called. Decoded images are the same for any thread count.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetJpxDecodeThreadCount(int thread_count);
+
+// Experimental API.
+// Function: FPDF_SetRebuildScanThreadCount
+//          Set how many threads may scan a damaged document when its cross
+//          reference table has to be rebuilt.
+// Parameters:
+//          thread_count -   The number of threads. 0 or 1 means scanning on
+//                           the calling thread only, which is the default.
+// Return value:
+//          TRUE on success. FALSE if |thread_count| is negative.
+// Comments:
+//          Applies to documents loaded afterwards, until FPDF_DestroyLibrary()
+//          is called. The rebuilt tables are the same for any thread count.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_SetRebuildScanThreadCount(int thread_count);
+
 #if defined(_WIN32)
 // Experimental API.
 // Function: FPDF_SetPrintMode
@@ -390,6 +441,101 @@ FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV FPDF_SetPrintMode(int mode);
 FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
 FPDF_LoadDocument(FPDF_STRING file_path, FPDF_BYTESTRING password);
 
+// Experimental API.
+// Function: FPDF_LoadDocumentMapped
+//          Open and load a PDF document, mapping the file into memory.
+// Parameters:
+//          file_path -  Path to the PDF file (including extension).
+//          password  -  A string used as the password for the PDF file.
+//                       If no password is needed, empty or NULL can be used.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Same as FPDF_LoadDocument(), except that on platforms that support
+//          it, the file is memory-mapped and parsed objects refer to the
+//          mapping rather than to copies of the file contents. This reduces
+//          memory usage and copying for large files. Where the file cannot be
+//          mapped, this behaves exactly like FPDF_LoadDocument().
+//
+//          The file must not be truncated while the document is open.
+//          Truncation is detected on later reads, which then fall back to
+//          reading the file, but data that was already handed out from the
+//          mapping cannot be protected.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentMapped(FPDF_STRING file_path, FPDF_BYTESTRING password);
+
+// Experimental API.
+// Flags for FPDF_LoadDocumentWithFlags().
+//
+// Only load the newest cross reference section up front. Older sections, from
+// earlier incremental updates, are loaded when an object is not found in the
+// sections loaded so far. Their trailers are still read right away. Speeds up
+// opening documents with many incremental updates.
+#define FPDF_LOAD_CROSS_REF_LAZILY 0x01
+// Decode all the object streams on worker threads while loading, instead of
+// one at a time as objects in them are first needed. Speeds up uses that read
+// most objects, like extracting all the text, at the cost of memory for the
+// streams that go unused.
+#define FPDF_LOAD_PREFETCH_OBJECT_STREAMS 0x02
+
+// Experimental API.
+// Function: FPDF_LoadDocumentWithFlags
+//          Open and load a PDF document with the given loading options.
+// Parameters:
+//          file_path -  Path to the PDF file (including extension).
+//          password  -  A string used as the password for the PDF file.
+//                       If no password is needed, empty or NULL can be used.
+//          flags     -  0 for the default behavior, or a combination of the
+//                       FPDF_LOAD_* flags above. Unknown flags are ignored.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Same as FPDF_LoadDocument() apart from |flags|, which only change
+//          how the document gets loaded, not its contents.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithFlags(FPDF_STRING file_path,
+                           FPDF_BYTESTRING password,
+                           unsigned int flags);
+
+// Experimental API.
+// Function: FPDF_LoadDocumentWithCrossRefIndex
+//          Open and load a PDF document, using a cross reference index from
+//          FPDF_GetCrossRefIndex().
+// Parameters:
+//          file_path  -  Path to the PDF file (including extension).
+//          password   -  A string used as the password for the PDF file.
+//                        If no password is needed, empty or NULL can be used.
+//          index      -  Pointer to the index data.
+//          index_size -  Size of the index data, in bytes.
+// Return value:
+//          A handle to the loaded document, or NULL on failure.
+// Comments:
+//          Same as FPDF_LoadDocument(), except that the cross reference data
+//          comes from |index| instead of being parsed, or rebuilt, from the
+//          file. This makes opening the same damaged file, or file with many
+//          incremental updates, repeatedly faster.
+//
+//          Before |index| is used, its file size and a digest of the end of
+//          the file are checked against the file. If they do not match, or
+//          |index| is malformed, it is ignored and the document loads as with
+//          FPDF_LoadDocument(). Each object offset from |index| is checked
+//          when first used as well, and if one is wrong, the cross reference
+//          data gets parsed from the file at that point.
+//
+//          See the comments for FPDF_LoadDocument() regarding the encoding for
+//          |file_path| and |password|.
+FPDF_EXPORT FPDF_DOCUMENT FPDF_CALLCONV
+FPDF_LoadDocumentWithCrossRefIndex(FPDF_STRING file_path,
+                                   FPDF_BYTESTRING password,
+                                   const void* index,
+                                   unsigned long index_size);
+
 // Function: FPDF_LoadMemDocument
 //          Open and load a PDF document from memory.
 // Parameters:
@@ -619,6 +765,27 @@ FPDF_EXPORT unsigned long FPDF_CALLCONV FPDF_GetLastError();
 FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
 FPDF_DocumentHasValidCrossReferenceTable(FPDF_DOCUMENT document);
 
+// Experimental API.
+// Function: FPDF_GetCrossRefIndex
+//          Get the cross reference index of a document, for use with
+//          FPDF_LoadDocumentWithCrossRefIndex().
+// Parameters:
+//          document    -   Handle to document. Returned by FPDF_LoadDocument().
+//          buffer      -   A buffer for the index data. May be NULL.
+//          buflen      -   The length of |buffer|, in bytes.
+// Return value:
+//          Returns the size of the index data in bytes, or 0 on error.
+//
+// The index holds the resolved cross reference table and trailer, and the
+// object offsets inside the object streams parsed so far. It can be stored
+// next to the file and handed to later opens of the same file. If |buflen| is
+// less than the returned length, or |document| or |buffer| is NULL, |buffer|
+// will not be modified.
+FPDF_EXPORT unsigned long FPDF_CALLCONV
+FPDF_GetCrossRefIndex(FPDF_DOCUMENT document,
+                      void* buffer,
+                      unsigned long buflen);
+
 // Experimental API.
 // Function: FPDF_GetTrailerEnds
 //          Get the byte offsets of trailer ends.
@@ -827,6 +994,11 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
 // FPDF_COLORSCHEME is passed in, since with a single fill color for paths the
 // boundaries of adjacent fill paths are less visible.
 #define FPDF_CONVERT_FILL_TO_STROKE 0x20
+// Experimental. Set to position anti-aliased text at fractions of a pixel
+// horizontally, instead of snapping each glyph to whole pixels. Has no effect
+// with FPDF_LCD_TEXT or FPDF_RENDER_NO_SMOOTHTEXT, which already position or
+// snap glyphs in their own way.
+#define FPDF_SUBPIXEL_TEXT 0x8000
 
 // Struct for color scheme.
 // Each should be a 32-bit value specifying the color, in 8888 ARGB format.
@@ -930,6 +1102,247 @@ FPDF_RenderPageBitmapWithMatrix(FPDF_BITMAP bitmap,
                                 const FS_RECTF* clipping,
                                 int flags);
 
+// Experimental API.
+// Function: FPDF_RenderPageBitmapDirtyRect
+//          Render again the part of a page that changed since the last call,
+//          into a bitmap the page was already rendered into.
+// Parameters:
+//          bitmap      -   Handle to the device independent bitmap the page
+//                          was rendered into.
+//          page        -   Handle to the page. Returned by FPDF_LoadPage.
+//          matrix      -   The transform matrix the page was rendered with, as
+//                          for FPDF_RenderPageBitmapWithMatrix(), or NULL for
+//                          the identity matrix.
+//          backdrop    -   Optional. A bitmap of the same size and format as
+//                          |bitmap|, holding what |bitmap| held before the
+//                          page was rendered into it. Use it when that was not
+//                          a single color, such as a pattern drawn by the
+//                          embedder.
+//          fill_color  -   The color the bitmap was filled with before the
+//                          page was rendered, as for FPDFBitmap_FillRect().
+//                          Ignored if |backdrop| is given.
+//          flags       -   The flags the page was rendered with, as for
+//                          FPDF_RenderPageBitmapWithMatrix().
+//          dirty_rect  -   Optional. Receives the rect of the bitmap that was
+//                          rendered again, in device coords.
+// Return value:
+//          True if part of |bitmap| was rendered again, false if nothing
+//          visible changed or on error.
+// Comments:
+//          The changed areas are the ones covered by page objects before and
+//          after they were changed through the FPDFPage_*(), FPDFPageObj_*(),
+//          FPDFPath_*(), FPDFText_*() and FPDFImageObj_*() functions, the ones
+//          passed to FPDFPage_InvalidateObject(), and the ones form fill
+//          passes to FFI_Invalidate(). Only the objects overlapping them are
+//          rendered again, so the cost depends on the size of the change
+//          rather than that of the page.
+//
+//          The changed area of |bitmap| is first restored from |backdrop|, or
+//          set to |fill_color|. Either replaces the pixels there rather than
+//          blending with them, so a transparent |fill_color| clears them.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderPageBitmapDirtyRect(FPDF_BITMAP bitmap,
+                               FPDF_PAGE page,
+                               const FS_MATRIX* matrix,
+                               FPDF_BITMAP backdrop,
+                               FPDF_DWORD fill_color,
+                               int flags,
+                               FS_RECTF* dirty_rect);
+
+// Experimental API.
+// Function: FPDF_RenderPageBitmapParallel
+//          Render contents of a page to a device independent bitmap, using
+//          several threads. The result is the same as FPDF_RenderPageBitmap()
+//          with the same arguments.
+// Parameters:
+//          bitmap       -   Handle to the device independent bitmap (as the
+//                           output buffer). The bitmap handle can be created
+//                           by FPDFBitmap_Create or retrieved from an image
+//                           object by FPDFImageObj_GetBitmap.
+//          page         -   Handle to the page. Returned by FPDF_LoadPage.
+//          start_x      -   Left pixel position of the display area in
+//                           bitmap coordinates.
+//          start_y      -   Top pixel position of the display area in bitmap
+//                           coordinates.
+//          size_x       -   Horizontal size (in pixels) for displaying the
+//                           page.
+//          size_y       -   Vertical size (in pixels) for displaying the page.
+//          rotate       -   Page orientation, as for FPDF_RenderPageBitmap().
+//          flags        -   0 for normal display, or combination of the Page
+//                           Rendering flags defined above.
+//          thread_count -   Number of threads to render with, including the
+//                           calling thread, or 0 to use one per processor.
+//                           At most 8 threads are used.
+// Return value:
+//          None.
+// Comments:
+//          The display area is split into horizontal bands, which are
+//          rendered concurrently from the same parsed page. The threads take
+//          turns at loading fonts, images and other shared resources, and
+//          rasterize in parallel. See the note at the top of this file for
+//          the functions that may run meanwhile. With the Skia renderer, the
+//          page is rendered on the calling thread only.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_RenderPageBitmapParallel(FPDF_BITMAP bitmap,
+                              FPDF_PAGE page,
+                              int start_x,
+                              int start_y,
+                              int size_x,
+                              int size_y,
+                              int rotate,
+                              int flags,
+                              int thread_count);
+
+// Experimental API.
+// Counters of the glyph caches that all documents share.
+typedef struct FPDF_GLYPH_CACHE_STATS_ {
+  // Glyph lookups served from the caches.
+  unsigned long long hits;
+  // Glyph lookups that had to render or load the glyph.
+  unsigned long long misses;
+  // Glyphs dropped from the caches to stay within |byte_limit|.
+  unsigned long long evictions;
+  // Approximate memory the cached glyphs take up, in bytes.
+  size_t bytes;
+  // The budget set with FPDF_SetGlyphCacheByteLimit().
+  size_t byte_limit;
+  // Glyph paths returned by FPDFFont_GetGlyphPath() that are still held.
+  // They are never dropped to stay within |byte_limit|, and live as long as
+  // their fonts.
+  size_t pinned_paths;
+  // The part of |bytes| these glyph paths take up.
+  size_t pinned_bytes;
+} FPDF_GLYPH_CACHE_STATS;
+
+// Experimental API.
+// Function: FPDF_SetGlyphCacheByteLimit
+//          Set the memory budget of the glyph caches.
+// Parameters:
+//          byte_limit  -   Approximate number of bytes all cached glyph
+//                          bitmaps, outlines and widths may take up together.
+// Return value:
+//          None.
+// Comments:
+//          Once the caches go over the budget, they drop their least recently
+//          used glyphs. Glyphs are dropped right away if the caches already
+//          take up more than |byte_limit|. The default is 64 MB.
+FPDF_EXPORT void FPDF_CALLCONV FPDF_SetGlyphCacheByteLimit(size_t byte_limit);
+
+// Experimental API.
+// Function: FPDF_GetGlyphCacheStats
+//          Get the counters of the glyph caches.
+// Parameters:
+//          stats       -   Receives the counters. The counters cover the
+//                          lifetime of the process.
+// Return value:
+//          True on success, false if |stats| is NULL.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetGlyphCacheStats(FPDF_GLYPH_CACHE_STATS* stats);
+
+// Experimental API.
+// Counters of the JBIG2 symbol dictionary cache that all documents share.
+typedef struct FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS_ {
+  // Symbol dictionaries served from the cache.
+  unsigned long long hits;
+  // Symbol dictionaries that had to be decoded while the cache was enabled.
+  unsigned long long misses;
+  // Symbol dictionaries dropped from the cache to stay within |byte_limit|.
+  unsigned long long evictions;
+  // Approximate memory the cached symbol dictionaries take up, in bytes.
+  size_t bytes;
+  // The budget set with FPDF_SetJbig2SymbolDictCacheByteLimit().
+  size_t byte_limit;
+} FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS;
+
+// Experimental API.
+// Function: FPDF_SetJbig2SymbolDictCacheByteLimit
+//          Set the memory budget of the JBIG2 symbol dictionary cache.
+// Parameters:
+//          byte_limit  -   Approximate number of bytes all cached symbol
+//                          dictionaries may take up together. 0 disables the
+//                          cache, which is the default.
+// Return value:
+//          None.
+// Comments:
+//          The cache holds the symbol dictionaries decoded from JBIG2Globals
+//          streams, keyed by the contents of the streams, so that documents
+//          with identical globals, e.g. from the same scanner, decode them
+//          only once. Once the cache goes over the budget, it drops its least
+//          recently used dictionaries. FPDF_DestroyLibrary() disables it.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetJbig2SymbolDictCacheByteLimit(size_t byte_limit);
+
+// Experimental API.
+// Function: FPDF_GetJbig2SymbolDictCacheStats
+//          Get the counters of the JBIG2 symbol dictionary cache.
+// Parameters:
+//          stats       -   Receives the counters. The counters cover the
+//                          lifetime of the process.
+// Return value:
+//          True on success, false if |stats| is NULL.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetJbig2SymbolDictCacheStats(FPDF_JBIG2_SYMBOL_DICT_CACHE_STATS* stats);
+
+// Experimental API.
+// Function: FPDF_RecordPageDisplayList
+//          Record the drawing of a page into a display list, which can then
+//          be rendered at any scale without interpreting the page again.
+// Parameters:
+//          page        -   Handle to the page. Returned by FPDF_LoadPage.
+//          flags       -   0 for normal display, or combination of the Page
+//                          Rendering flags defined above, as for
+//                          FPDF_RenderPageBitmapWithMatrix(), except for
+//                          FPDF_REVERSE_BYTE_ORDER.
+// Return value:
+//          A handle to the display list, or NULL on failure. Must be released
+//          with FPDF_CloseDisplayList().
+// Comments:
+//          The list is in the same space FPDF_RenderPageBitmapWithMatrix()
+//          renders the page in before applying its |matrix|. Paths, text and
+//          images stay vectors, but soft masks, transparency groups and
+//          shadings are recorded as bitmaps at 72 dpi. The list keeps the
+//          fonts it uses alive, so it may outlive the page and the document.
+FPDF_EXPORT FPDF_DISPLAYLIST FPDF_CALLCONV
+FPDF_RecordPageDisplayList(FPDF_PAGE page, int flags);
+
+// Experimental API.
+// Function: FPDF_RenderDisplayList
+//          Render a display list to a device independent bitmap.
+// Parameters:
+//          bitmap       -   Handle to the device independent bitmap (as the
+//                           output buffer). The bitmap handle can be created
+//                           by FPDFBitmap_Create or retrieved by
+//                           FPDFImageObj_GetBitmap.
+//          display_list -   Handle to the display list. Returned by
+//                           FPDF_RecordPageDisplayList().
+//          matrix       -   The transform matrix, as for
+//                           FPDF_RenderPageBitmapWithMatrix(), or NULL for
+//                           the identity matrix.
+//          clipping     -   The rect to clip to in device coords, or NULL
+//                           for the whole bitmap.
+// Return value:
+//          True on success, false if |bitmap| or |display_list| is NULL.
+// Comments:
+//          Rendering a list with the same |matrix| and |clipping| gives about
+//          the same result as calling FPDF_RenderPageBitmapWithMatrix() with
+//          the flags the list was recorded with.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_RenderDisplayList(FPDF_BITMAP bitmap,
+                       FPDF_DISPLAYLIST display_list,
+                       const FS_MATRIX* matrix,
+                       const FS_RECTF* clipping);
+
+// Experimental API.
+// Function: FPDF_CloseDisplayList
+//          Release a display list.
+// Parameters:
+//          display_list -   Handle to the display list. Returned by
+//                           FPDF_RecordPageDisplayList().
+// Return value:
+//          None.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_CloseDisplayList(FPDF_DISPLAYLIST display_list);
+
 #if defined(PDF_USE_SKIA)
 // Experimental API.
 // Function: FPDF_RenderPageSkia
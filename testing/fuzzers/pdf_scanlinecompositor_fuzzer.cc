@@ -2,14 +2,19 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <utility>
 
+#include "core/fxcrt/check.h"
+#include "core/fxcrt/compiler_specific.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/span.h"
 #include "core/fxge/agg/cfx_agg_cliprgn.h"
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/dib/fx_dib.h"
+#include "core/fxge/dib/fx_dib_composite_row.h"
 #include "testing/fuzzers/pdfium_fuzzer_util.h"
 
 namespace {
@@ -33,6 +38,19 @@ constexpr FXDIB_Format kFormat[] = {
     FXDIB_Format::kInvalid /* Was FXDIB_Format::k8bppCmyka */,
     FXDIB_Format::kInvalid /* Was FXDIB_Format::kCmyka */};
 
+// Fills `bitmap` with `pixels`, repeated as needed.
+void FillBitmap(CFX_DIBitmap* bitmap, pdfium::span<const uint8_t> pixels) {
+  if (pixels.empty()) {
+    return;
+  }
+  size_t offset = 0;
+  for (int row = 0; row < bitmap->GetHeight(); ++row) {
+    for (uint8_t& byte : bitmap->GetWritableScanline(row)) {
+      byte = pixels[offset++ % pixels.size()];
+    }
+  }
+}
+
 }  // namespace
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
@@ -57,6 +75,8 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   bool is_rgb_byte_order = !(data[32] % 2);
   size -= kParameterSize;
   data += kParameterSize;
+  // SAFETY: trusted arguments from fuzzer.
+  auto pixels = UNSAFE_BUFFERS(pdfium::span(data, size));
 
   static constexpr uint32_t kMemLimit = 128'000'000;
   static constexpr uint32_t kComponents = 4;
@@ -69,26 +89,51 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
 
   auto src_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
   auto dest_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
+  auto scalar_dest_bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
   if (!src_bitmap->Create(width, height, src_format) ||
-      !dest_bitmap->Create(width, height, dest_format)) {
+      !dest_bitmap->Create(width, height, dest_format) ||
+      !scalar_dest_bitmap->Create(width, height, dest_format)) {
     return 0;
   }
   if (src_bitmap->GetBuffer().empty() || dest_bitmap->GetBuffer().empty()) {
     return 0;
   }
 
+  // The rest of the input provides the pixels: the first half for the source,
+  // and the second half for the destination and the clip mask.
+  auto [src_pixels, dest_pixels] = pixels.split_at(pixels.size() / 2);
+  FillBitmap(src_bitmap.Get(), src_pixels);
+  FillBitmap(dest_bitmap.Get(), dest_pixels);
+  FillBitmap(scalar_dest_bitmap.Get(), dest_pixels);
+
   std::unique_ptr<CFX_AggClipRgn> clip_rgn;
   if (is_clip) {
     clip_rgn = std::make_unique<CFX_AggClipRgn>(width, height);
+    auto clip_mask = pdfium::MakeRetain<CFX_DIBitmap>();
+    if (clip_mask->Create(width, height, FXDIB_Format::k8bppMask)) {
+      FillBitmap(clip_mask.Get(), dest_pixels);
+      clip_rgn->IntersectMaskF(0, 0, std::move(clip_mask));
+    }
   }
-  if (src_bitmap->IsMaskFormat()) {
-    dest_bitmap->CompositeMask(dest_left, dest_top, width, height,
-                               std::move(src_bitmap), argb, src_left, src_top,
-                               blend_mode, clip_rgn.get(), is_rgb_byte_order);
-  } else {
-    dest_bitmap->CompositeBitmap(dest_left, dest_top, width, height,
-                                 std::move(src_bitmap), src_left, src_top,
-                                 blend_mode, clip_rgn.get(), is_rgb_byte_order);
-  }
+
+  // Composite with and without the vectorized compositors, which must give
+  // identical pixels.
+  auto composite = [&](CFX_DIBitmap* dest) {
+    if (src_bitmap->IsMaskFormat()) {
+      dest->CompositeMask(dest_left, dest_top, width, height, src_bitmap, argb,
+                          src_left, src_top, blend_mode, clip_rgn.get(),
+                          is_rgb_byte_order);
+    } else {
+      dest->CompositeBitmap(dest_left, dest_top, width, height, src_bitmap,
+                            src_left, src_top, blend_mode, clip_rgn.get(),
+                            is_rgb_byte_order);
+    }
+  };
+  pdfium::SetCompositeRowVectorizationForTesting(false);
+  composite(scalar_dest_bitmap.Get());
+  pdfium::SetCompositeRowVectorizationForTesting(true);
+  composite(dest_bitmap.Get());
+  CHECK(std::ranges::equal(dest_bitmap->GetBuffer(),
+                           scalar_dest_bitmap->GetBuffer()));
   return 0;
 }
@@ -159,6 +159,7 @@ struct Options {
   bool render_oneshot = false;
   bool lcd_text = false;
   bool no_nativetext = false;
+  bool subpixel_text = false;
   bool grayscale = false;
   bool forced_color = false;
   bool fill_to_stroke = false;
@@ -211,6 +212,9 @@ int PageRenderFlagsFromOptions(const Options& options) {
   if (options.no_nativetext) {
     flags |= FPDF_NO_NATIVETEXT;
   }
+  if (options.subpixel_text) {
+    flags |= FPDF_SUBPIXEL_TEXT;
+  }
   if (options.grayscale) {
     flags |= FPDF_GRAYSCALE;
   }
@@ -496,6 +500,8 @@ bool ParseCommandLine(const std::vector<std::string>& args,
       options->lcd_text = true;
     } else if (cur_arg == "--no-nativetext") {
       options->no_nativetext = true;
+    } else if (cur_arg == "--subpixel-text") {
+      options->subpixel_text = true;
     } else if (cur_arg == "--grayscale") {
       options->grayscale = true;
     } else if (cur_arg == "--forced-color") {
@@ -1777,6 +1783,7 @@ constexpr char kUsageString[] =
     "renderer\n"
     "  --lcd-text             - render text optimized for LCD displays\n"
     "  --no-nativetext        - render without using the native text output\n"
+    "  --subpixel-text        - render text at subpixel positions\n"
     "  --grayscale            - render grayscale output\n"
     "  --forced-color         - render in forced color mode\n"
     "  --fill-to-stroke       - render fill as stroke in forced color mode\n"
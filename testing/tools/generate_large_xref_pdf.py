@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# Copyright 2026 The PDFium Authors
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Generates a valid one page PDF with a very large number of objects.
+
+The output is meant to be measured with safetynet_compare.py, to track the
+time and memory it takes to open documents with huge cross reference tables.
+All objects besides the catalog, the page tree and the page are small
+dictionaries reachable from the page's /Resources, so pdfium_test has to parse
+the cross reference table fully, but only touches a handful of objects when
+rendering.
+"""
+
+import argparse
+import sys
+
+# Fixed objects: 1 = catalog, 2 = page tree, 3 = page, 4 = content stream,
+# 5 = resources.
+FIRST_FILLER_OBJECT = 6
+CONTENT = b'0 0 1 rg 10 10 80 80 re f\n'
+
+
+def GeneratePdf(out, num_objects):
+  offsets = [0] * (num_objects + 1)
+  position = 0
+
+  def Write(data):
+    nonlocal position
+    out.write(data)
+    position += len(data)
+
+  def BeginObject(obj_num):
+    offsets[obj_num] = position
+    Write(b'%d 0 obj\n' % obj_num)
+
+  Write(b'%PDF-1.7\n%\xa0\xf2\xa4\xf4\n')
+
+  BeginObject(1)
+  Write(b'<< /Type /Catalog /Pages 2 0 R >>\nendobj\n')
+  BeginObject(2)
+  Write(b'<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n')
+  BeginObject(3)
+  Write(b'<< /Type /Page /Parent 2 0 R /MediaBox [0 0 100 100] '
+        b'/Contents 4 0 R /Resources 5 0 R >>\nendobj\n')
+  BeginObject(4)
+  Write(b'<< /Length %d >>\nstream\n%sendstream\nendobj\n' %
+        (len(CONTENT), CONTENT))
+  BeginObject(5)
+  Write(b'<< /Filler %d 0 R >>\nendobj\n' % FIRST_FILLER_OBJECT)
+
+  for obj_num in range(FIRST_FILLER_OBJECT, num_objects + 1):
+    BeginObject(obj_num)
+    Write(b'<< /N %d >>\nendobj\n' % obj_num)
+
+  xref_offset = position
+  Write(b'xref\n0 %d\n' % (num_objects + 1))
+  Write(b'0000000000 65535 f\r\n')
+  for obj_num in range(1, num_objects + 1):
+    Write(b'%010d 00000 n\r\n' % offsets[obj_num])
+  Write(b'trailer\n<< /Size %d /Root 1 0 R >>\n' % (num_objects + 1))
+  Write(b'startxref\n%d\n%%%%EOF\n' % xref_offset)
+
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument('output_path', help='where to write the generated PDF')
+  parser.add_argument(
+      '--num-objects',
+      type=int,
+      default=1000000,
+      help='number of indirect objects in the document. Default is 1000000.')
+  args = parser.parse_args()
+
+  if args.num_objects < FIRST_FILLER_OBJECT:
+    print(
+        '--num-objects must be at least %d' % FIRST_FILLER_OBJECT,
+        file=sys.stderr)
+    return 1
+
+  with open(args.output_path, 'wb') as out:
+    GeneratePdf(out, args.num_objects)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -648,7 +648,7 @@ def main():
       '--profiler',
       default='callgrind',
       help='which profiler to use. Supports callgrind, '
-      'perfstat, and none. Default is callgrind.')
+      'perfstat, maxrss, and none. Default is callgrind.')
   parser.add_argument(
       '--interesting-section',
       action='store_true',
@@ -10,6 +10,7 @@ The output is a number that is a metric which depends on the profiler specified.
 import argparse
 import os
 import re
+import resource
 import subprocess
 import sys
 
@@ -17,6 +18,7 @@ from common import PrintErr
 
 CALLGRIND_PROFILER = 'callgrind'
 PERFSTAT_PROFILER = 'perfstat'
+MAXRSS_PROFILER = 'maxrss'
 NONE_PROFILER = 'none'
 
 PDFIUM_TEST = 'pdfium_test'
@@ -55,6 +57,8 @@ class PerformanceRun:
       time = self._RunCallgrind()
     elif self.args.profiler == PERFSTAT_PROFILER:
       time = self._RunPerfStat()
+    elif self.args.profiler == MAXRSS_PROFILER:
+      time = self._RunMaxRss()
     elif self.args.profiler == NONE_PROFILER:
       time = self._RunWithoutProfiler()
     else:
@@ -107,6 +111,19 @@ class PerformanceRun:
     # '        12345      instructions'
     return self._ExtractIrCount(r'\b(\d+)\b.*\binstructions\b', output)
 
+  def _RunMaxRss(self):
+    """Runs test harness and measures its peak resident set size.
+
+    Returns:
+      int with the peak resident set size of the test harness, in kilobytes.
+    """
+    cmd_to_run = self._BuildTestHarnessCommand()
+    subprocess.check_output(cmd_to_run, stderr=subprocess.STDOUT)
+
+    # This script only ever runs the test harness as a child, so the maximum
+    # over all children is the value for this run.
+    return resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+
   def _RunWithoutProfiler(self):
     """Runs test harness and measures performance without a profiler.
 
@@ -158,7 +175,7 @@ def main():
       '--profiler',
       default=CALLGRIND_PROFILER,
       help='which profiler to use. Supports callgrind, '
-      'perfstat, and none.')
+      'perfstat, maxrss, and none.')
   parser.add_argument(
       '--interesting-section',
       action='store_true',